@@ -0,0 +1,63 @@
+#pragma once
+/* bigfft.h — Çok thread'li büyük FFT (2^12 .. 2^20 nokta), ince çözünürlük modu
+ *
+ * fft_cpx tek thread'lidir ve FFT_CPX_MAX'ı aşan boylarda adımları önbelleğe
+ * sığmaz. BigFft n = n1 × n2 noktayı dört adımda (four-step) çözer; her alt
+ * FFT fft_cpx ile önbellekte kalan bir satır üzerinde yapılır:
+ *
+ *   A  sütunlar: BIGFFT_COLS sütun birlikte toplanır (satır başına bitişik
+ *      okuma), n1 noktalı FFT, W_n^(j2·k1) düzeltme çarpanı, yerine yazılır
+ *   B  satırlar: n1 adet bitişik n2 noktalı FFT
+ *   C  çıkış: sonuç k1 + n1·k2 sırasında; bloklu okunup doğal sıraya
+ *      (ya da fftshift'li güç olarak) yazılır
+ *
+ * Her adım iş parçalarına bölünür; havuzdaki thread'ler ve çağıran thread
+ * parçaları atomik sayaçla paylaşır. Havuz plan ömrü boyunca yaşar; boşta
+ * thread'ler koşul değişkeninde uyur. Aynı plan aynı anda tek çağırandan
+ * kullanılabilir.
+ *
+ * Ham IQ yolu (bigfft_power_u8) pencereyi A adımında, fftshift + |X|²'yi C
+ * adımında uygular; ara kopya yoktur. Güç FFT_SIZE yoluyla aynı gürültü
+ * tabanını verecek biçimde ölçeklenir (FFT_SIZE / n): taban aynı kalır,
+ * dar taşıyıcılar 10·log10(n / FFT_SIZE) dB daha belirgin görünür.
+ */
+
+#include <stdint.h>
+#include "fft.h"      /* FftCpx, FFT_SIZE */
+#include "thread.h"
+
+#define BIGFFT_MIN_LOG2   12
+#define BIGFFT_MAX_LOG2   20
+#define BIGFFT_MAX_THREADS 32
+#define BIGFFT_COLS       16     /* A / C adımında birlikte işlenen sütun */
+
+typedef struct BigFft BigFft;
+
+/*
+ * log2n noktalı plan; threads 0 ise cpu_count(). Pencere (Hann) ve
+ * düzeltme çarpanı tabloları burada hesaplanır. Hata varsa NULL.
+ */
+BigFft *bigfft_create(int log2n, int threads);
+void    bigfft_free(BigFft *b);
+
+int     bigfft_size(const BigFft *b);
+int     bigfft_threads(const BigFft *b);
+
+/* İleri FFT, pencere yok, doğal sıra; in ve out n uzunluklu (aynı olabilir) */
+void bigfft_forward(BigFft *b, const FftCpx *in, FftCpx *out);
+
+/*
+ * raw: n IQ çifti (uint8, 127.5 ortalı). pwr_out: n bin, fftshift'li
+ * (negatif → pozitif frekans), doğrusal güç, FFT_SIZE yoluna ölçekli.
+ */
+void bigfft_power_u8(BigFft *b, const uint8_t *raw, float *pwr_out);
+
+/*
+ * [lo, hi) bin aralığını cols sütuna indir. peak = 1 sütundaki en güçlü
+ * bin (dar taşıyıcı kaybolmaz), 0 ortalama. Sütun başına bin tam sayı
+ * olmak zorunda değildir.
+ */
+void bigfft_decimate(const float *pwr, int lo, int hi, float *out, int cols, int peak);
+
+/* "20" ya da "1M" / "512k" biçimi → log2 (geçersizse -1) */
+int  bigfft_parse_size(const char *s);
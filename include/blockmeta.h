@@ -0,0 +1,25 @@
+#pragma once
+/* blockmeta.h — Blok etiketi (SdrBlockMeta)
+ *
+ * sdr.h'dan ayrı tutulur: aşama eklentileri (stage_api.h) librtlsdr
+ * başlıklarına bağımlı olmadan aynı etiketi görür.
+ */
+
+#include <stdint.h>
+
+/*
+ * Her bloğa eşlik eden etiket. gen, frekans / örnekleme hızı / kazanç
+ * her değiştiğinde artar; tüketiciler tampon boşaltmak yerine bloğu
+ * kuşağına göre atar ya da işaretler.
+ */
+typedef struct {
+    uint64_t sample;     /* bloğun ilk örneğinin akıştaki sırası */
+    uint64_t t_us;       /* aktarımın host varış zamanı (stats_now_us) */
+    uint64_t gen_t_us;   /* bu ayarın istendiği an (stats_now_us) */
+    uint32_t gen;        /* ayar kuşağı */
+    uint32_t freq;       /* Hz */
+    uint32_t sr;         /* S/s */
+    float    gain_db;
+    uint8_t  agc;
+    uint8_t  settling;   /* 1 = eski ayar verisi olabilir ya da PLL oturuyor */
+} SdrBlockMeta;
@@ -0,0 +1,92 @@
+#pragma once
+/* chan.h — Çok kanallı hızlı evrişim (overlap-save) kanal ayırıcı
+ *
+ * Tek geniş akıştan (ör. 2.4 MS/s) onlarca dar kanalı (ör. 12.5 kHz) aynı
+ * anda, her biri ayrı desimasyonlu karmaşık akış olarak çıkarır:
+ *
+ *   ham IQ ──► N noktalı giriş penceresi (N/4 örtüşme) ──► tek ileri FFT
+ *                 │
+ *                 ├─► kanal 0: merkez bini etrafındaki M bin × H ──► M noktalı ters FFT
+ *                 ├─► kanal 1: ...                                   (ilk M/4 atılır)
+ *                 └─► ...
+ *
+ * İleri FFT tüm kanallarca paylaşılır; kanal başına maliyet yalnızca M bin
+ * çarpımı + M noktalı ters FFT'dir (M = N / D, D desimasyon). Bin seçimi
+ * karıştırma + desimasyonu birlikte yapar; filtre Kaiser pencereli sinc'tir
+ * (P = N/4 + 1 katsayı) ve frekans yanıtı ayar değişince bir kez hesaplanır.
+ *
+ * Bin ızgarasının dışında kalan kayma (en çok fs/2N) çıkış hızında küçük
+ * bir NCO ile giderilir; blok başına faz düzeltmesi çıkışı bloklar arasında
+ * sürekli tutar. Ayar kuşağı değişince ya da blok kaybında (örnek sayacı
+ * atlarsa) giriş penceresi boşaltılır.
+ */
+
+#include <stdint.h>
+#include "fft.h"    /* FftCpx, fft_cpx */
+#include "sdr.h"    /* SdrBlockMeta */
+#include "thread.h"
+
+#define CHAN_FFT       16384                     /* ileri FFT boyu (N) */
+#define CHAN_OVERLAP   (CHAN_FFT / 4)            /* filtre boyu - 1 */
+#define CHAN_HOP       (CHAN_FFT - CHAN_OVERLAP) /* blok başına yeni örnek */
+#define CHAN_MAX       64
+#define CHAN_MIN_BINS  16                        /* en küçük ters FFT (M) */
+#define CHAN_ATTEN_DB  70.0                      /* durdurma bandı bastırması */
+
+typedef struct {
+    int      id;           /* 0..CHAN_MAX-1, chan_add dönüşü */
+    int      used;
+    uint32_t freq_hz;      /* mutlak merkez frekansı */
+    uint32_t bw_hz;        /* geçirme bandı genişliği */
+
+    /* ── Plan (ayar değişince yeniden kurulur) ─────────────────── */
+    int      planned;
+    int      live;         /* 0 = kanal mevcut bandın dışında */
+    uint32_t plan_id;      /* her yeniden planda artar (çıktı dosyası vb.) */
+    int      dec;          /* D */
+    int      bins;         /* M = CHAN_FFT / D */
+    int      k_c;          /* merkez bini, 0..CHAN_FFT-1 */
+    uint32_t out_sr;       /* çıkış örnek hızı = fs / D */
+    double   fine_step;    /* NCO adımı (radyan / çıkış örneği) */
+    double   nco_ph;
+    FftCpx  *H;            /* M bin filtre yanıtı (1/N ölçekli) */
+    FftCpx  *work;         /* M */
+    uint64_t out_count;    /* bu plandan beri üretilen çıkış örneği */
+} Chan;
+
+/*
+ * Her FFT bloğunda canlı kanal başına çağrılır (chan_feed'in thread'inde,
+ * kanal kilidi tutulurken: içinden chan_add / chan_remove çağrılmamalı).
+ * iq: desimasyonlu karmaşık akış, n = CHAN_HOP / dec örnek.
+ */
+typedef void (*ChanOutFn)(const Chan *ch, const FftCpx *iq, int n, void *ud);
+
+typedef struct {
+    FftCpx   *in;          /* CHAN_FFT: örtüşen giriş penceresi */
+    FftCpx   *X;           /* CHAN_FFT: ileri FFT çalışma alanı */
+    int       fill;
+    uint64_t  blocks;      /* pencere sıfırlandığından beri işlenen blok */
+    uint64_t  next_sample; /* süreklilik denetimi */
+    uint32_t  gen, center_hz, sr;
+    Chan      ch[CHAN_MAX];
+    int       n_used;
+    Mutex     cs;          /* kanal listesi: GUI / komut thread'i ekleyebilir */
+    ChanOutFn out;
+    void     *ud;
+} Channelizer;
+
+int  chan_init(Channelizer *c, ChanOutFn out, void *ud);   /* 0 / -1 */
+void chan_free(Channelizer *c);
+
+/* Kanal ekle; dönüş kimlik (0..CHAN_MAX-1), yer yoksa -1. Her thread'den. */
+int  chan_add   (Channelizer *c, uint32_t freq_hz, uint32_t bw_hz);
+void chan_remove(Channelizer *c, int id);
+
+/* Bir ham blok (FFT_SIZE IQ çifti) ekle; blok dolduğunda kanalları üret */
+void chan_feed(Channelizer *c, const uint8_t *raw, const SdrBlockMeta *m);
+
+/* sr hızında bw_hz genişliğindeki kanalın desimasyonu (D); çıkış hızı sr / D */
+int  chan_decimation(uint32_t sr, uint32_t bw_hz);
+
+/* "145.500:12.5" (MHz:kHz) çöz; başarılıysa 0 */
+int  chan_parse(const char *spec, uint32_t *freq_hz, uint32_t *bw_hz);
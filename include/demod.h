@@ -0,0 +1,148 @@
+#pragma once
+/* demod.h — Tıklanan frekansta düşük gecikmeli FM / AM / USB / LSB demodülatör
+ *
+ * Şelalede görülen bir sinyali dinlemek ya da çözmek için. Demod kendi
+ * halkasına ve thread'ine sahiptir (recorder.h gibi); USB callback'i bloğu
+ * yalnızca kopyalar, DSP thread'inin bütçesinden hiçbir şey harcanmaz:
+ *
+ *   blok ──► tek kanallı kanal ayırıcı (chan.h: karıştırma + süzgeç + desimasyon)
+ *              │ fs_c = sr / D karmaşık akış
+ *              ├─ FM : z·z*[-1] açısı (dallanmasız atan2, vektörleşir) → de-emfazi
+ *              ├─ AM : |z| / taşıyıcı düzeyi − 1
+ *              └─ SSB: karmaşık akış olduğu gibi
+ *            ──► pencereli sinc kesirli yeniden örnekleyici (fs_c → 48 kHz)
+ *              └─ SSB: taşıyıcıyı sıfıra kaydır (döndürme tablosu), Re, AGC
+ *            ──► int16 mono: WAV dosyası, boru ("|komut") ya da boş çıkış
+ *
+ * USB / LSB'de kanal yan bandın ortasına kurulur (merkez ± bw/2); süzgeç
+ * karşı yan bandı bastırır. fs_c bw'ye yakın olabildiğinden (reel ses
+ * için Nyquist yetmez) kaydırma ve reel kısım 48 kHz'de alınır. AM ve SSB
+ * düzeyleri blok hızında izlenir (iqcorr.h'deki gibi): örnek başına
+ * özyineleme yalnız de-emfazidedir.
+ *
+ * Gecikme: bir çıkış bloğunun en eski örneği bir USB aktarımı (xfer_len/2
+ * örnek; varış zamanı aktarımın sonudur) + kanal ayırıcının bir adımı
+ * (CHAN_HOP giriş örneği) + süzgeç gecikmesi (CHAN_OVERLAP/2) + yeniden
+ * örnekleyicinin yarım çekirdeği kadar bekler. STAT_H_DEMOD_LAT bu sınırı
+ * en yeni bloğun varışından çıkışa yazılana kadar geçen süreye ekleyerek
+ * ölçer: 2.048 MS/s ve 64 KB aktarımda ~16 + 7 ms + işlem. Sınır
+ * DEMOD_LAT_BUDGET_MS'i aşarsa (64 KB'ta ~950 kS/s altı) plan kurulurken
+ * uyarı basılır.
+ *
+ * Çıkış (demod_init sonrası out): "" → "<dizin>/audio_<etiket>_<zaman>.wav",
+ * "null" → atılır, "|komut" → komutun stdin'ine ham s16le, ".wav" ile biten
+ * yol → WAV, başka yol (ör. FIFO) → ham s16le. Dosya ilk ses örneğinde
+ * açılır; WAV başlığı saniyede bir güncellenir (süreç öldürülse de geçerli).
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include "thread.h"
+#include "sdr.h"        /* SdrBlockMeta */
+#include "chan.h"
+#include "stats.h"
+#include "recorder.h"   /* REC_BLOCK */
+
+#define DEMOD_RING          256     /* blok (2 MS/s'de 128 ms) */
+#define DEMOD_AUDIO_SR    48000
+#define DEMOD_DEEMPH_US      50     /* FM de-emfazi zaman sabiti */
+#define DEMOD_FM_DEV       0.4f     /* en büyük sapma / kanal genişliği */
+#define DEMOD_MAX_BW     250000
+#define DEMOD_LAT_BUDGET_MS  50
+#define DEMOD_RS_PHASES     256     /* yeniden örnekleyici kesir adımı */
+#define DEMOD_RS_ZEROS        8     /* yarım çekirdekteki sinc sıfır geçişi */
+
+enum { DEMOD_OFF, DEMOD_FM, DEMOD_AM, DEMOD_USB, DEMOD_LSB, DEMOD_COUNT };
+
+typedef struct {
+    /* ── Ayarlar (demod_init sonrası, demod_start öncesi) ───────── */
+    char     dir[192];
+    char     tag[32];
+    char     out[256];       /* çıkış (yukarıya bakın) */
+    int      cpu;            /* thread çekirdeği, -1 = serbest */
+    Stats   *stats;          /* hattın ölçümleri, NULL olabilir */
+    uint32_t xfer_len;       /* USB aktarım boyu (bayt; sdr.xfer_len) */
+
+    /* ── İstek (cs ile; demod_set) ───────────────────────────── */
+    int      mode;           /* DEMOD_* */
+    uint32_t freq_hz;        /* taşıyıcı / sıfır vuru frekansı */
+    uint32_t bw_hz;
+    uint32_t req_seq;
+    volatile int on;         /* mode != OFF && freq_hz != 0: push kopyalar */
+
+    /* ── Halka (recorder.h ile aynı düzen) ───────────────────── */
+    uint8_t (*ring)[REC_BLOCK];
+    SdrBlockMeta *meta;
+    volatile int wi, ri;
+    volatile int alive;
+    uint32_t drops;
+
+    /* ── Demod thread'inin durumu ────────────────────────────── */
+    Channelizer *ch;
+    int      ch_id;          /* -1 = kanal yok */
+    uint32_t seq;            /* uygulanan istek */
+    int      cur_mode;
+    uint32_t cur_freq, cur_bw;
+    uint32_t plan_id;        /* kurulu plan (Chan.plan_id) */
+    uint32_t fs_c;           /* kanal çıkış hızı */
+    uint32_t in_sr;          /* son bloğun giriş hızı */
+    uint64_t t_newest_us;    /* chan_feed'e verilen son bloğun varışı */
+    double   lat_fixed_us;   /* aktarım + adım + süzgeç + yeniden örnekleyici */
+
+    FftCpx   prev;           /* FM: önceki kanal örneği */
+    float    fm_gain;        /* radyan → tam ölçek */
+    float    de_a, de_y;     /* de-emfazi */
+    float    level;          /* AM taşıyıcı / SSB AGC düzeyi */
+    float    dc;             /* FM çıkışında ayar kaymasının DC'si */
+    FftCpx  *zbuf;           /* CHAN_HOP + 1 (önceki örnek başta) */
+    float   *aud;            /* FM / AM: fs_c hızında ses, CHAN_HOP */
+
+    float   *rs_h;           /* DEMOD_RS_PHASES × rs_taps */
+    int      rs_taps, rs_half;
+    double   rs_step;        /* çıkış başına giriş örneği */
+    double   rs_pos;         /* sonraki çıkışın rs_re içindeki konumu */
+    float   *rs_re, *rs_im;  /* giriş geçmişi (SSB karmaşık yeniden örneklenir) */
+    int      rs_fill, rs_cap;
+    float   *o_re, *o_im;    /* 48 kHz çıkış, pcm_cap */
+    FftCpx  *rot;            /* SSB: e^(±jπ·bw·k/48000), pcm_cap */
+    double   rot_w, rot_phase;
+    int16_t *pcm;
+    int      pcm_cap;
+
+    FILE    *fp;
+    int      sink;           /* DEMOD_SINK_* (demod.c) */
+    char     path[320];
+    uint64_t samples;        /* çıkışa yazılan ses örneği */
+    uint64_t hdr_at;         /* WAV başlığının son güncellendiği örnek */
+
+    Thread   thread;
+    Mutex    cs;
+    Cond     cv;             /* push / istek → thread uyandırma */
+} Demod;
+
+/* Yapıyı sıfırla, halkayı ayır (program başında bir kez). Başarılıysa 0. */
+int  demod_init (Demod *d);
+void demod_free (Demod *d);   /* demod_stop çağrılmış olmalı */
+
+/* Thread'i başlat / durdur; stop çıkışı kapatır (WAV başlığı tamamlanır) */
+void demod_start(Demod *d);
+void demod_stop (Demod *d);
+
+/* USB thread'inden her blokta; kapalıysa hiçbir şey yapmaz. Halka doluysa -1. */
+int  demod_push (Demod *d, const uint8_t *blk, const SdrBlockMeta *meta);
+
+/*
+ * Kip, frekans ve kanal genişliği (bw_hz 0 = kipin varsayılanı); her
+ * thread'den. mode DEMOD_OFF ya da freq_hz 0 ise demod durur. Yeni plan
+ * demod thread'inde sonraki blokta kurulur.
+ */
+void demod_set  (Demod *d, int mode, uint32_t freq_hz, uint32_t bw_hz);
+
+/* "fm" / "am:10" / "usb:2.8" (kip[:kHz]) çöz; bw yoksa 0. Geçerliyse 0. */
+int  demod_parse(const char *spec, int *mode, uint32_t *bw_hz);
+
+/* "fm" / "am" / "usb" / "lsb" / "off" */
+const char *demod_mode_name(int mode);
+
+/* Kipin varsayılan kanal genişliği (Hz) */
+uint32_t demod_default_bw(int mode);
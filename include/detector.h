@@ -0,0 +1,78 @@
+#pragma once
+/* detector.h — Artımlı CFAR sinyal dedektörü + olay kaydı
+ *
+ * Her yeni PSD satırında (dB) hücre ortalamalı CFAR uygulanır:
+ *   gürültü(k) = k'nın iki yanındaki guard hücreden sonraki window
+ *                hücrenin ortalaması (önek toplamıyla O(1))
+ *   tespit(k)  = psd[k] > gürültü(k) + thresh_db
+ * Satır başına maliyet O(bin), pencere genişliğinden bağımsızdır. Satır
+ * boyu satırdan satıra değişebilir (çoklu çözünürlük, multires.h); boy
+ * değişirse frekans ekseni değişmiş sayılır.
+ *
+ * Bitişik tespit bin'leri bir parçaya, zamanda örtüşen parçalar bir olaya
+ * birleştirilir. hang_rows satır boyunca güncellenmeyen olay kapanır ve
+ * günlüğe yazılır:
+ *   t_start_ms,t_stop_ms,freq_hz,bw_hz,peak_db
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include "fft.h"   /* FFT_CPX_MAX için */
+
+#define DET_MAX_OPEN    64    /* aynı anda açık olay */
+#define DET_RECENT     128    /* şelale üstü için saklanan kapanmış olay */
+#define DET_MAX_BINS   FFT_CPX_MAX   /* en uzun satır */
+
+typedef struct {
+    uint64_t t_start_ms, t_stop_ms;   /* epoch ms */
+    uint32_t row_start,  row_stop;    /* detector satır sayacı */
+    int      bin_lo, bin_hi;          /* kapsanan bin aralığı (dahil) */
+    double   f_lo_hz, f_hi_hz;
+    float    peak_db;
+} DetEvent;
+
+typedef struct {
+    /* ── Ayarlar ──────────────────────────────────────────────── */
+    int    guard;        /* CUT'un iki yanındaki koruma hücresi */
+    int    window;       /* her yanda referans hücre sayısı */
+    float  thresh_db;    /* gürültü ortalamasının üstündeki eşik */
+    int    merge_gap;    /* bu kadar bin boşluk birleştirilir */
+    int    hang_rows;    /* olay kapanmadan önce beklenen boş satır */
+    int    min_rows;     /* daha kısa olaylar günlüğe yazılmaz */
+
+    /* ── Durum ────────────────────────────────────────────────── */
+    uint32_t row;                      /* işlenen satır sayısı */
+    double   center_hz, span_hz;       /* son satırın frekans ekseni */
+    int      bins;                     /* son satırın boyu */
+    float    prefix[DET_MAX_BINS + 1]; /* psd önek toplamı */
+    uint8_t  hit[DET_MAX_BINS];
+
+    DetEvent open[DET_MAX_OPEN];
+    int      n_open;
+    uint32_t n_started;                /* açılan olay sayısı (tetikler için) */
+    DetEvent recent[DET_RECENT];       /* halka: son kapanan olaylar */
+    int      recent_head, n_recent;
+
+    FILE    *log;
+    uint32_t n_logged;
+} Detector;
+
+/* detector_init: varsayılan ayarlar, günlük kapalı */
+void detector_init(Detector *d);
+
+/* Günlük dosyasını aç (ekleme kipinde). Başarılıysa 0, hata varsa -1. */
+int  detector_open_log(Detector *d, const char *path);
+
+/* Açık olayları kapat/günlüğe yaz ve dosyayı kapat */
+void detector_free(Detector *d);
+
+/*
+ * detector_process: yeni PSD satırını işle.
+ *   psd        — bins uzunluğunda dB değerleri (fftshift uygulanmış),
+ *                bins <= DET_MAX_BINS; ana satırlarda FFT_SIZE
+ *   t_ms       — satırın zaman damgası (epoch ms)
+ *   center_hz  — satırın merkez frekansı, span_hz — toplam genişlik
+ * Frekans ekseni değişirse (yeniden ayar) açık olaylar kapatılır.
+ */
+void detector_process(Detector *d, const float *psd, int bins, uint64_t t_ms,
+                      double center_hz, double span_hz);
@@ -4,6 +4,10 @@
 #include <stdint.h>
 
 #define FFT_SIZE 1024
+#define FFT_CPX_MAX 16384   /* fft_cpx'in kabul ettiği en büyük boy */
+
+/* Karmaşık örnek: kanal ayırıcı gibi modüllerin ara tamponları */
+typedef struct { float r, i; } FftCpx;
 
 /* Hann penceresini önceden hesapla (program başında bir kez çağır) */
 void fft_init(void);
@@ -11,5 +15,34 @@ void fft_init(void);
 /*
  * raw: RTL-SDR'den gelen ham uint8_t IQ tamponu, uzunluk = FFT_SIZE*2
  * psd_out: FFT shift uygulanmış güç değerleri (dB), uzunluk = FFT_SIZE
+ * Çalışma tamponu yığında tutulur; farklı thread'lerden aynı anda çağrılabilir.
+ */
+void fft_compute_psd(const uint8_t *raw, float *psd_out);
+
+/*
+ * fft_compute_psd ile aynı, fakat çıktı doğrusal güçtür (|X|^2, dB değil).
+ * Birden çok bloğun ortalamasını alan modüller (tarama vb.) bunu kullanır;
+ * ortalama doğrusal alanda alınıp sonra dB'ye çevrilmelidir.
+ */
+void fft_compute_power(const uint8_t *raw, float *pwr_out);
+
+/*
+ * Doğrusal güç satırını dB'ye çevir: db_out[k] = 10·log10(pwr[k]·scale).
+ * Sabit noktalı yol seçiliyse log10f yerine fftq tablosu (±0.01 dB).
+ */
+void fft_power_db(const float *pwr, float scale, float *db_out, int n);
+
+/*
+ * Yerinde karmaşık FFT; n ikinin kuvveti, 2 <= n <= FFT_CPX_MAX.
+ * inverse = 1 ters yön (e^{+j}); ölçekleme yapılmaz, ileri + ters n katıdır.
+ * Twiddle'lar fft_init'in kurduğu tablodan okunur; eşzamanlı çağrılabilir.
+ */
+void fft_cpx(FftCpx *x, int n, int inverse);
+
+/*
+ * Sabit noktalı yolu seç (fftq.h): 0 = float (varsayılan), 1 = int16 blok
+ * kayan noktalı FFT. Süreç geneli; hatlar başlamadan önce çağrılır.
+ * fft_compute_power / fft_compute_psd seçime göre yönlendirilir.
  */
-void fft_compute_psd(const uint8_t *raw, float *psd_out);
\ No newline at end of file
+void fft_set_fixed(int on);
+int  fft_is_fixed(void);
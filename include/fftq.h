@@ -0,0 +1,46 @@
+#pragma once
+/* fftq.h — Sabit noktalı (int16, blok kayan noktalı) FFT + güç / dB yolu
+ *
+ * RTL-SDR yalnızca 8 bit örnek üretir; float yolunun taşıdığı hassasiyetin
+ * çoğu veride yoktur. Düşük güçlü ARM düğümlerinde bu yol seçilir
+ * (fft_set_fixed):
+ *   - Ham bayt, blokta en büyük genlik int16 sınırına yaklaşacak biçimde
+ *     ölçeklenip Hann (Q15) ile çarpılır ve bit-ters sırayla yüklenir
+ *   - Radix-2 kelebekler int16 üzerinde; her aşamadan önce en büyük bileşen
+ *     ölçülür, taşma riski varsa tüm blok sağa kaydırılır ve ortak üs artar
+ *     (block floating point — zayıf sinyaller gereksiz yere kırpılmaz)
+ *   - |X|^2 tamsayıdır (uint32); dB'ye CLZ + 256 girdili tablo ile çevrilir.
+ *     DSP thread'i blokları doğrusal alanda ortaladığından satırı aynı
+ *     tabloyla float'ın üs / mantis bitlerinden çevirir (fft_power_db)
+ *
+ * Çıktı ölçeği fft_compute_power / fft_compute_psd ile aynıdır, iki yol
+ * birbirinin yerine kullanılabilir. x86'da SSE2 tamsayı komutları
+ * (_mm_madd_epi16) kullanılır; diğer mimarilerde taşınabilir C döngüsü
+ * derlenir. Doğruluk / hız karşılaştırması: tools/fft_bench.
+ */
+
+#include <stdint.h>
+#include "fft.h"   /* FFT_SIZE */
+
+/* Twiddle / Hann / bit-ters tablolarını kur (fft_init çağırır) */
+void fftq_init(void);
+
+/*
+ * Tamsayı çekirdek. mag_out: fftshift uygulanmış |X|^2, uzunluk = FFT_SIZE.
+ * Dönüş: ikili üs e; doğrusal güç = mag * 2^e (float yoluyla aynı ölçek).
+ */
+int  fftq_compute_mag(const uint8_t *raw, uint32_t *mag_out);
+
+/* fftq_compute_mag sonucunu dB'ye çevir (hızlı log2, ±0.01 dB) */
+float fftq_db(uint32_t mag, int exp2);
+
+/*
+ * Doğrusal gücü (ör. blok ortalaması) aynı tabloyla dB'ye çevir: float'ın
+ * üssü CLZ'nin, mantisin üst 8 biti tablo indeksinin yerini tutar.
+ * 1e-10 ve altı -100 dB.
+ */
+float fftq_db_pow(float p);
+
+/* fft_compute_power / fft_compute_psd ile aynı arayüz */
+void fftq_compute_power(const uint8_t *raw, float *pwr_out);
+void fftq_compute_psd  (const uint8_t *raw, float *psd_out);
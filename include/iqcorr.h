@@ -0,0 +1,67 @@
+#pragma once
+/* iqcorr.h — Akan DC giderme + IQ dengesizliği düzeltmesi (tam hızda, hep açık)
+ *
+ * RTL-SDR örneklerinde LO sızıntısı merkez bin'de bir DC çivisi, I / Q
+ * kollarının kazanç ve faz farkı da her sinyalin aynasını (−f) üretir.
+ * IqCorr USB callback'inde her bloğa, tüm tüketicilerden önce uygulanır:
+ *
+ *   1. Blok momentleri tek geçişte tamsayı toplamlarıyla (Σi, Σq, Σi², Σq²,
+ *      Σiq) toplanır; tamsayı indirgeme -O2'de SIMD'e çevrilir
+ *   2. DC: blok ortalaması tek kutuplu süzgeçle izlenir (IQC_DC_TAU_MS)
+ *      ve her örnekten çıkarılır — blok hızında güncellenen tek kutuplu
+ *      DC engelleyici; kestirimde örnek başına özyineleme yoktur
+ *   3. IQ: blok varyans / kovaryansı daha yavaş süzülür (IQC_IQ_TAU_MS);
+ *      α = √(P_I / P_Q), ρ = C_IQ / √(P_I·P_Q) ile
+ *          Q' = (α·Q − ρ·I) / √(1 − ρ²)
+ *      I ile aynı güçte ve ondan ilintisiz Q' üretir (kör kestirim:
+ *      bant içindeki toplam sinyalin dairesel olduğu varsayılır)
+ *   4. Uygulama Q8 sabit noktada (katsayılar Q12) yapılır, çıkış yeniden
+ *      uint8'e nicemlenir: tüketicilerin hiçbiri değişmez
+ *
+ * Düz yuvarlama (floor(x + 0.5)) burada sistematik hatadır: çıkış
+ * in − dc'nin tamsayıya yuvarlanmışı olur, DC kestiriminin yalnız tam
+ * kısmı giderilir ve ±0.5 LSB altındaki kayma (merkez çivisinin kendisi)
+ * olduğu gibi kalır; küçük k_qq / k_qi düzeltmeleri de çoğunlukla
+ * nicemlemede kaybolur. Bu yüzden birinci derece hata geri beslemesi
+ * kullanılır: her örneğin nicemleme artığı sonrakine eklenir. Hata
+ * spektrumu (1 − z⁻¹) ile biçimlenir: DC'de sıfır, toplam gücü düz
+ * yuvarlamanın 2 katı ve bandın kenarlarına (±fs/2) yığılmış. Çıkışın
+ * ortalaması ve düzeltmenin doğrusal kısmı kesirli değerleriyle korunur.
+ * Geri besleme örnek başına özyinelemedir (uygulama döngüsü vektörleşmez);
+ * blok başına maliyet yine birkaç µs'dir (2 MS/s'de bir çekirdeğin ~%1'i).
+ */
+
+#include <stdint.h>
+#include "fft.h"   /* FFT_SIZE için */
+
+#define IQC_DC_TAU_MS  50     /* DC kestiriminin zaman sabiti */
+#define IQC_IQ_TAU_MS 500     /* kazanç / faz kestiriminin zaman sabiti */
+#define IQC_RHO_MAX   0.5f    /* |ρ| üstü kestirim hatası sayılır (~30°) */
+
+typedef struct {
+    uint32_t sample_rate;      /* katsayıların hesaplandığı hız */
+    float    a_dc, a_iq;       /* blok başına süzgeç katsayıları */
+    int      seeded;
+
+    /* ── Kestirimler (LSB, 127.5 merkezli) ────────────────────── */
+    float    dc_i, dc_q;
+    float    p_i, p_q, c_iq;   /* AC güç ve çapraz moment */
+    float    gain_db, phase_deg;   /* Q'nun I'ya göre kazanç / faz hatası */
+
+    /* ── Uygulanan (sabit nokta) ─────────────────────────────── */
+    int32_t  mi8, mq8;         /* (127.5 + dc) · 256 */
+    int32_t  k_qq, k_qi;       /* Q12: Q' = k_qq·Q + k_qi·I */
+    int32_t  err_i, err_q;     /* hata geri beslemesi: taşınan Q8 artık */
+
+    uint64_t blocks;
+} IqCorr;
+
+void iqcorr_init(IqCorr *c);
+
+/*
+ * in: FFT_SIZE IQ çifti (uint8). Kestirimleri bu blokla günceller ve
+ * düzeltilmiş bloğu out'a yazar (in ile aynı olamaz). sample_rate
+ * değişince süzgeç katsayıları yeniden hesaplanır. Tek thread'den çağrılır.
+ */
+void iqcorr_process(IqCorr *c, const uint8_t *in, uint8_t *out,
+                    uint32_t sample_rate);
@@ -0,0 +1,73 @@
+#pragma once
+/* multires.h — Aynı örnek akışından eşzamanlı çoklu çözünürlüklü spektrum
+ *
+ * Ana satır yolu (FFT_SIZE, avg_blocks) değişmeden kalır; MultiRes ona ek
+ * olarak MRES_MAX düzeye kadar bağımsız FFT boyu ve ortalama derinliği
+ * taşır (ör. geçici sinyaller için hızlı 256 bin, ayrıntı için yavaş 16k).
+ *
+ * Ham uint8 → float dönüşümü blok başına bir kez yapılır (256 girişli
+ * tablo) ve tüm düzeyler aynı dönüşmüş bloğu okur; düzey başına maliyet
+ * yalnız pencere + FFT + birikimdir. İki süreç çalıştırmaya göre USB,
+ * kuyruk, dönüşüm ve ana satır yolu tek kez ödenir.
+ *
+ *   boy <  FFT_SIZE  blok FFT_SIZE / boy bitişik çerçeveye bölünür
+ *   boy == FFT_SIZE  blok başına bir çerçeve
+ *   boy >  FFT_SIZE  bloklar boy örnek dolana dek biriktirilir
+ *
+ * avg çerçevenin doğrusal güç ortalaması bir satırdır (fftshift'li dB);
+ * küçük boylarda avg en az FFT_SIZE / boy olur, blok başına en çok bir satır.
+ * Güç FFT_SIZE / boy ile ölçeklenir: gürültü tabanı ana yolla aynı kalır.
+ * Durum yalnız çağıran (DSP) thread'e aittir.
+ */
+
+#include <stdint.h>
+#include "fft.h"   /* FftCpx, FFT_SIZE, FFT_CPX_MAX */
+
+#define MRES_MAX       4
+#define MRES_MIN_SIZE 64
+#define MRES_MAX_SIZE FFT_CPX_MAX
+
+typedef struct {
+    int      size;       /* FFT boyu = satırdaki bin sayısı */
+    int      avg_req;    /* istenen çerçeve / satır, 0 = ~row_rate satır/s */
+    int      avg;        /* geçerli (mres_reset'te çözülür, alt sınırlı) */
+    float   *win;        /* Hann, size */
+    FftCpx  *buf;        /* çerçeve; boy > FFT_SIZE ise biriktirme tamponu */
+    int      fill;       /* buf'taki örnek */
+    float   *acc;        /* fftshift'li doğrusal güç toplamı */
+    int      acc_n;
+    float   *row;        /* son satır (dB), size */
+    uint32_t rows;       /* üretilen satır */
+} MresLevel;
+
+typedef struct {
+    MresLevel lv[MRES_MAX];
+    int       n;
+    FftCpx    x[FFT_SIZE];   /* bloğun paylaşılan dönüşümü */
+    uint64_t  next_sample;   /* süreklilik denetimi */
+} MultiRes;
+
+void mres_init(MultiRes *m);
+void mres_free(MultiRes *m);
+
+/*
+ * Düzey ekle: size ikinin kuvveti, MRES_MIN_SIZE..MRES_MAX_SIZE; avg 0 =
+ * otomatik. Dönüş düzey indeksi, yer / bellek yoksa ya da boy geçersizse -1.
+ */
+int  mres_add(MultiRes *m, int size, int avg);
+
+/*
+ * Yarım çerçeve ve ortalamaları at, otomatik derinlikleri örnekleme
+ * hızına göre yeniden çöz (~row_rate satır/s). Ayar kuşağı değişince çağrılır.
+ */
+void mres_reset(MultiRes *m, uint32_t sample_rate, int row_rate);
+
+/*
+ * Oturmuş bir bloğu (FFT_SIZE IQ çifti, ilk akış örneği sample) tüm
+ * düzeylere ver; kayıp blokta yarım biriktirme tamponları atılır. Dönüş bit
+ * maskesi: bit i set ise lv[i].row yeni bir satırdır (sonraki çağrıya dek geçerli).
+ */
+unsigned mres_feed(MultiRes *m, const uint8_t *raw, uint64_t sample);
+
+/* "256", "16k:8" → boy, ortalama (yoksa 0). Başarılıysa 0, hata varsa -1. */
+int  mres_parse(const char *s, int *size, int *avg);
@@ -0,0 +1,75 @@
+#pragma once
+/* noisefloor.h — Akan gürültü tabanı + yüzdelik kestirimi, otomatik ölçek
+ *
+ * Her PSD satırı sabit kovalı (0.5 dB) histogramlara atılır; sıralama
+ * yoktur, satır başına maliyet O(bin + kova) ve kova sayısı bin sayısından
+ * küçüktür, yani hep açık kalabilir:
+ *
+ *   satır histogramı   her satırda sıfırlanır → row_floor / row_median / row_top
+ *   uzun dönem         üstel unutmalı (tau_s) → floor_db / top_db, auto_min / auto_max
+ *   bölüt histogramı   NF_SEGS frekans bölütü, uzun dönem → seg_floor[]
+ *
+ * Unutma kovaları tek tek küçülterek değil, yeni satırın ağırlığını (w)
+ * her satırda büyüterek yapılır; w çok büyüyünce tüm kovalar bir kez
+ * yeniden ölçeklenir. Bölüt tabanları satır başına NF_SEG_PER_ROW bölüt
+ * olmak üzere sırayla yenilenir.
+ *
+ * Otomatik ölçek histerezislidir: hedef (taban - NF_MARGIN_LO, tepe +
+ * NF_MARGIN_HI) geçerli değerden hyst_db'den fazla uzaklaşmadıkça ekran
+ * aralığı değişmez; gürültüdeki küçük oynamalar şelaleyi titretmez.
+ */
+
+#include <stdint.h>
+#include "fft.h"   /* FFT_SIZE için */
+
+#define NF_BUCKETS      400       /* -150 .. +50 dB */
+#define NF_DB_LO        -150.0f
+#define NF_DB_STEP      0.5f
+#define NF_SEGS         16
+#define NF_SEG_BINS     (FFT_SIZE / NF_SEGS)
+#define NF_SEG_PER_ROW  2         /* satır başına yenilenen bölüt tabanı */
+#define NF_Q_FLOOR      0.20f     /* taban yüzdeliği */
+#define NF_Q_TOP        0.999f    /* tepe yüzdeliği */
+#define NF_MARGIN_LO    6.0f      /* ekran altı: tabanın bu kadar altı */
+#define NF_MARGIN_HI    6.0f      /* ekran üstü: tepenin bu kadar üstü */
+#define NF_MIN_SPAN     30.0f     /* en dar otomatik aralık (dB) */
+
+typedef struct {
+    /* ── Son satır ─────────────────────────────────────────────── */
+    float    row_floor, row_median, row_top;
+
+    /* ── Uzun dönem (tau_s) ────────────────────────────────────── */
+    float    floor_db, top_db;
+    float    seg_floor[NF_SEGS];    /* bölüt başına taban, bin k → k / NF_SEG_BINS */
+
+    /* ── Otomatik ekran aralığı ────────────────────────────────── */
+    float    auto_min, auto_max;
+    int      auto_valid;
+
+    /* ── Ayarlar ──────────────────────────────────────────────── */
+    float    tau_s;                 /* uzun dönem unutma zaman sabiti */
+    float    hyst_db;
+
+    /* ── İç durum ─────────────────────────────────────────────── */
+    float    row_h[NF_BUCKETS];
+    float    long_h[NF_BUCKETS];
+    float    seg_h[NF_SEGS][NF_BUCKETS];
+    float    w;                     /* yeni satır örneğinin ağırlığı */
+    float    tot;                   /* long_h toplamı (bölüt başına tot / NF_SEGS) */
+    uint32_t rows;                  /* son sıfırlamadan beri */
+    int      seg_next;
+} NoiseFloor;
+
+void nf_init (NoiseFloor *n);
+
+/* Frekans ekseni değişince: uzun dönem geçmişi atılır, ölçek yeniden oturur */
+void nf_reset(NoiseFloor *n);
+
+/* Yeni satırla güncelle; dt_s önceki satırdan geçen süre */
+void nf_update(NoiseFloor *n, const float *psd, float dt_s);
+
+/* Uzun dönem q yüzdeliği (0..1), O(NF_BUCKETS) */
+float nf_quantile(const NoiseFloor *n, float q);
+
+/* Bin'in (0..FFT_SIZE-1) bölüt tabanı */
+float nf_bin_floor(const NoiseFloor *n, int bin);
@@ -3,8 +3,7 @@
 
 #include "render.h"
 #include "widgets.h"
-#include "sdr.h"
-#include "recorder.h"
+#include "pipeline.h"
 
 /* Desteklenen sample rate seçenekleri */
 #define SR_COUNT 3
@@ -18,27 +17,46 @@ typedef struct {
     Slider    sl_gain;
     Slider    sl_dbmin;
     Slider    sl_dbmax;
+    Button    btn_autoscale;
     Button    btn_setfreq;
     Button    btn_sr[SR_COUNT];
     Button    btn_agc;
     Button    btn_rec;
     Button    btn_stop;
+    TextInput ti_sw_start;
+    TextInput ti_sw_stop;
+    Button    btn_sweep;
+    Button    btn_trace[TRACE_COUNT];
+    Button    btn_trace_reset;
+    Slider    sl_tau;
 
     /* Sürükleme takibi */
     Slider   *drag;
 
     /* Geçerli SR seçim indeksi */
     int sr_sel;
+
+    /* 1 = Min/Max Güç hattın gürültü tabanı kestiriminden (noisefloor.h) */
+    int auto_scale;
 } Panel;
 
 /* Panel widget'larını ilklendir (ekran boyutlarına göre konum hesapla) */
 void panel_init(Panel *p);
 
-/* Tüm panel widget'larını çiz */
-void panel_draw(RenderCtx *ctx, const Panel *p,
-                const SdrDevice *sdr, const RecorderState *rec);
+/* Widget durumunu seçili hattın ayarlarına eşitle (cihaz değişince) */
+void panel_sync(Panel *p, const Pipeline *pl);
+
+/* Tüm panel widget'larını çiz; pl = panelin kontrol ettiği hat */
+void panel_draw(RenderCtx *ctx, const Panel *p, const Pipeline *pl,
+                int n_pipes);
 
 /* SDL2 olaylarını işle: tıklama, sürükle, tuş, metin girişi */
-void panel_handle_event(Panel *p, SDL_Event *ev,
-                        SdrDevice *sdr, RecorderState *rec,
-                        RenderCtx *ctx);
\ No newline at end of file
+void panel_handle_event(Panel *p, SDL_Event *ev, Pipeline *pl,
+                        RenderCtx *ctx);
+
+/*
+ * Otomatik ölçek açıksa v'nin histerezisli aralığını ctx'e uygula; follow
+ * ise sürgüler de izler (kapatınca aralık olduğu yerde kalır). Döşeli
+ * görünümde her döşeme için kendi görünümüyle çağrılır.
+ */
+void panel_auto_scale(Panel *p, RenderCtx *ctx, const PipeView *v, int follow);
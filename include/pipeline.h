@@ -0,0 +1,268 @@
+#pragma once
+/* pipeline.h — Cihaz başına bağımsız işleme hattı
+ *
+ * Her Pipeline tek bir RTL-SDR cihazına aittir ve kendi thread'lerini taşır:
+ *
+ *   USB / rtl_tcp async thread ──► on_pipe_data ──► iqcorr ──┬─► recorder_push (kayıt thread'i)
+ *                                                           ├─► snap_push (ön tetik halkası)
+ *                                                           ├─► stage_push_block (aşama halkası)
+ *                                                           ├─► demod_push (demod thread'i)
+ *                                                           └─► blok kuyruğu ──► DSP thread'i
+ *
+ *   Her blok önce iqcorr_process'ten geçer (DC + IQ dengesizliği, iqcorr.h);
+ *   aşamalar, shm ve DSP düzeltilmiş bloğu görür. Kayıt ve ön tetik halkası
+ *   varsayılan olarak ham bloğu alır (rec_corr = 1 ise düzeltilmişi).
+ *
+ *   DSP thread'i: blokları doğrusal güçte ortalar (avg_blocks), her satırda
+ *   dedektörü, izleri ve gürültü tabanı kestirimini (noisefloor.h)
+ *   günceller, şelale halkasına yazar. Tarama etkinse bloklar sweep_feed'e
+ *   gider ve satırlar panoramik taramalardan gelir.
+ *
+ * İnce çözünürlük modu açıksa (fine_log2, bigfft.h) DSP thread'i oturmuş
+ * blokları 2^fine_log2 örnek dolana dek biriktirir ve tek büyük FFT'yi
+ * havuz thread'lerine dağıtarak hesaplar; satır, FFT_SIZE sütuna en güçlü
+ * bin ile indirilmiş güçtür (2^20 noktada 2.048 MS/s'de ~2 Hz/bin).
+ * Dedektör ve gürültü tabanı aynı bin'lerin ortalamasını görür. Satır
+ * yalnızca yakınlaştırma penceresini (pipeline_set_fine_zoom) kapsar;
+ * merkez / açıklık pencereye göre yayınlanır.
+ *
+ * Ek çözünürlük düzeyleri (mres_size / mres_avg, multires.h) varsa oturmuş
+ * her blok bir kez float'a çevrilir ve tüm düzeylere verilir; düzeyler ana
+ * satır yolundan bağımsız FFT boyu ve ortalama derinliği taşır. Her düzeyin
+ * kendi dedektörü ("det_<etiket>_r<boy>_<zaman>.csv"), shm açıksa yerel bin
+ * sayılı "radar_<etiket>_r<boy>" PSD halkası ve GUI için FFT_SIZE sütuna en
+ * güçlü bin ile indirilmiş bir kopyası vardır. Tarama modunda çalışmaz.
+ *
+ * Kanal ayırıcıya (chan.h) kanal eklenmişse DSP thread'i oturmuş blokları
+ * ona da verir; her kanal desimasyonlu cf32 akışı olarak kayıt açıkken
+ * "<dizin>/ch<N>_<etiket>_<kHz>k_<hız>sps_<zaman>.cf32" dosyasına yazılır ve
+ * shm açıksa "radar_<etiket>_ch<N>" halkasında yayınlanır. Tarama modunda
+ * kanal çıkışı yoktur.
+ *
+ * Ön tetik halkası açıksa (snap_pre_ms / snap_post_ms) son saniyeler hep
+ * bellektedir; pipeline_snapshot ya da (snap_det ile) yeni dedektör olayı
+ * tetikten önceki ve sonraki IQ'yu "snap_<etiket>_<zaman>.bin" olarak yazar.
+ *
+ * Demodülatör (demod.h) açıksa düzeltilmiş bloklar kendi halkasına kopyalanır;
+ * kanal ayırma, FM / AM / SSB algılama ve 48 kHz'e yeniden örnekleme demod
+ * thread'inde yapılır, DSP thread'i hiç etkilenmez. GUI tıklanan frekansı
+ * demod_set ile verir; ses "audio_<etiket>_<zaman>.wav" ya da audio_out'a gider.
+ *
+ * Kayıtlı DSP aşamaları (stage.h) varsa her ham blok ve her satır bir kez
+ * aşama halkalarına kopyalanır; eklentiler kendi thread'lerinde okur.
+ *
+ * Yayın sunucusu bağlıysa (srv) her satır ayrıca specsrv_publish ile uzak
+ * izleyicilere bırakılır. Paylaşılan bellek halkası açıksa (shm) her ham
+ * blok ve her satır aynı makinedeki diğer süreçlere de yayınlanır.
+ *
+ * GUI thread'i hiçbir hesap yapmaz; pipeline_view() ile son durumun bir
+ * kopyasını alır. Böylece bir süreçte 4–8 cihaz birbirini beklemeden çalışır.
+ */
+
+#include <stdint.h>
+#include "thread.h"
+#include "fft.h"
+#include "sdr.h"
+#include "recorder.h"
+#include "sweep.h"
+#include "detector.h"
+#include "trace.h"
+#include "noisefloor.h"
+#include "specsrv.h"
+#include "shmring.h"
+#include "stats.h"
+#include "chan.h"
+#include "snapshot.h"
+#include "stage.h"
+#include "bigfft.h"
+#include "multires.h"
+#include "iqcorr.h"
+#include "demod.h"
+
+#define PIPE_MAX        8      /* süreç başına en çok cihaz */
+#define PIPE_QUEUE   1024      /* USB → DSP blok kuyruğu (~512 ms @ 2 MS/s,
+                                  en büyük aktarımın 8 katı) */
+#define PIPE_WF_ROWS   55      /* şelale geçmişi (render.h WATERFALL_ROWS ile aynı) */
+#define PIPE_ROW_RATE  60      /* hedef satır hızı (satır/s) */
+
+/* Cihaz seçimi ve çekirdek sabitleme */
+typedef struct {
+    int         dev_index;     /* serial ve tcp_host NULL ise kullanılır */
+    const char *serial;        /* NULL değilse indeks yerine seri no ile seç */
+    const char *tcp_host;      /* NULL değilse USB yerine rtl_tcp sunucusu */
+    uint16_t    tcp_port;
+    int         shm;           /* 1 = blokları/satırları paylaşılan belleğe yayınla */
+    uint32_t    xfer_len;      /* USB aktarım boyutu, 0 = varsayılan */
+    uint32_t    xfer_num;      /* USB aktarım sayısı, 0 = varsayılan */
+    int         cpu_usb;       /* -1 = serbest */
+    int         cpu_dsp;
+    int         cpu_rec;
+    int         rt_prio;       /* USB + kayıt thread'leri SCHED_FIFO, 0 = normal */
+    const char *out_dir;       /* kayıt / olay günlüğü dizini, NULL = REC_DEFAULT_DIR */
+    uint32_t    snap_pre_ms;   /* ön tetik halkası (snapshot.h), ikisi 0 = kapalı */
+    uint32_t    snap_post_ms;
+    int         snap_det;      /* 1 = her yeni dedektör olayı anlık kaydı tetikler */
+    int         fine_log2;     /* ince çözünürlük FFT boyu (log2), 0 = kapalı */
+    int         rec_corr;      /* 1 = kayıt / anlık kayıt DC + IQ düzeltilmiş blokları yazar */
+    int         mres_n;        /* ek çözünürlük düzeyi sayısı */
+    int         mres_size[MRES_MAX];   /* FFT boyu */
+    int         mres_avg[MRES_MAX];    /* çerçeve / satır, 0 = ~PIPE_ROW_RATE */
+    int         demod_mode;    /* DEMOD_*, açılışta demodülatör (GUI tıklamayla da açar) */
+    uint32_t    demod_freq;    /* Hz, 0 = tıklanana kadar bekle */
+    uint32_t    demod_bw;      /* 0 = kipin varsayılanı */
+    const char *audio_out;     /* demod.h çıkışı, NULL = <dizin>/audio_*.wav */
+} PipeConfig;
+
+typedef struct {
+    int           id;          /* süreç içi sıra (0..PIPE_MAX-1) */
+    char          name[32];    /* "#0", "SN:xxxx" veya "TCP host:port" */
+    SdrDevice     sdr;
+    RecorderState rec;
+    SnapRing      snap;        /* ön tetik halkası + anlık kayıt */
+    int           snap_det;
+    uint32_t      snap_det_seen;   /* tetiklenmiş son det.n_started */
+    Sweep         sweep;
+    Detector      det;
+    TraceSet      traces;
+    NoiseFloor    nf;          /* gürültü tabanı + otomatik ölçek (view_cs ile) */
+    StageHost     stages;      /* eklenti aşamaları (stage.h) */
+    IqCorr        iqc;         /* DC + IQ düzeltmesi (yalnız USB thread'i) */
+    Demod         demod;       /* tıklanan frekansta ses (kendi thread'i) */
+    int           rec_corr;
+
+    /* ── USB → DSP blok kuyruğu ───────────────────────────────── */
+    uint8_t (*queue)[FFT_SIZE * 2];
+    SdrBlockMeta  q_meta[PIPE_QUEUE];   /* blok etiketleri (varış zamanı dahil) */
+    volatile uint32_t q_wi, q_ri;
+    Mutex         q_cs;
+    Cond          q_cv;        /* blok geldi → DSP uyandırma */
+    uint64_t      last_cb_us;  /* önceki callback varışı */
+
+    /* ── DSP thread'i ─────────────────────────────────────────── */
+    Thread        dsp_thread;
+    volatile int  dsp_running;
+    int           cpu_dsp;
+    int           avg_blocks;  /* satır başına ortalanan blok */
+    float         acc[FFT_SIZE];
+    int           acc_n;
+    uint32_t      acc_gen;     /* birikimin ait olduğu ayar kuşağı */
+    uint32_t      row_gen;     /* son satırın kuşağı (yeniden ayar gecikmesi için) */
+    uint64_t      last_row_ms;
+    Stats         stats;       /* sayaçlar + gecikme histogramları */
+
+    /* ── İnce çözünürlük (istek her thread'den, durum yalnız DSP) ─ */
+    volatile int  fine_req;    /* istenen log2, 0 = kapalı */
+    int           fine_log2;   /* geçerli */
+    BigFft       *fine;
+    uint8_t      *fine_raw;    /* 2^fine_log2 IQ çifti */
+    float        *fine_pwr;
+    uint32_t      fine_fill;   /* dolu blok */
+    uint64_t      fine_next;   /* beklenen akış örneği (süreklilik denetimi) */
+    double        fine_zoom_off;   /* pencere: ayarlı merkeze göre Hz (view_cs) */
+    double        fine_zoom_span;  /* Hz, 0 = tüm bant */
+
+    /* ── Ek çözünürlükler (yalnız DSP; mres_view view_cs ile) ─── */
+    MultiRes      mres;
+    Detector     *mres_det[MRES_MAX];   /* düzey başına dedektör + günlük */
+    ShmRing      *mres_shm[MRES_MAX];   /* "radar_<etiket>_r<boy>", yerel bin'ler */
+    float         mres_view[MRES_MAX][FFT_SIZE];
+
+    /* ── Kanal ayırıcı (yalnız DSP thread'i çıkış üretir) ─────── */
+    Channelizer   chan;
+    FILE         *ch_fp[CHAN_MAX];     /* kayıt açıkken kanal başına cf32 */
+    uint32_t      ch_plan[CHAN_MAX];   /* açık dosyanın ait olduğu plan */
+    ShmRing      *ch_shm[CHAN_MAX];     /* IQ yuvaları cf32, rate_hz = çıkış hızı */
+    uint32_t      ch_shm_bytes[CHAN_MAX];
+
+    /* ── GUI'ye yayınlanan durum (view_cs ile korunur) ────────── */
+    float         psd[FFT_SIZE];
+    float         wf[PIPE_WF_ROWS][FFT_SIZE];   /* halka */
+    int           wf_head;                      /* sonraki yazılacak satır */
+    double        row_center_hz, row_span_hz;
+    uint64_t      row_t_us;    /* satırın en yeni bloğunun varışı */
+    Mutex         view_cs;
+
+    SpecServer   *srv;         /* NULL değilse satırlar buraya da yayınlanır */
+    ShmRing      *shm;         /* NULL değilse "radar_<etiket>" halkası */
+} Pipeline;
+
+/* GUI tarafının çizim için aldığı kopya */
+typedef struct {
+    float    psd[FFT_SIZE];
+    float    waterfall[PIPE_WF_ROWS][FFT_SIZE];  /* eski → yeni */
+    float    trace[TRACE_COUNT][FFT_SIZE];
+    int      trace_seeded;
+    DetEvent open[DET_MAX_OPEN];
+    int      n_open;
+    DetEvent recent[DET_RECENT];
+    int      n_recent;
+    uint32_t row;              /* dedektör satır sayacı (olay yaşları için) */
+    float    nf_floor, nf_top; /* uzun dönem taban / tepe (dB) */
+    float    nf_seg[NF_SEGS];  /* frekans bölütü başına taban */
+    float    auto_min, auto_max;   /* histerezisli önerilen ekran aralığı */
+    int      auto_valid;
+    int      fine_log2;        /* satırın ince FFT boyu, 0 = normal */
+    int      mres_n;           /* ek çözünürlük düzeyleri */
+    int      mres_size[MRES_MAX];
+    float    mres[MRES_MAX][FFT_SIZE];   /* son satırları, FFT_SIZE sütun */
+    double   center_hz, span_hz;
+    uint64_t t_arrival_us;     /* örnekten fotona ölçümü için */
+} PipeView;
+
+/*
+ * Komut satırı / yapılandırma cihaz tanımını çöz:
+ *   kind 'd': "1@2,3,4"  indeks (@ sonrası USB,DSP,kayıt çekirdekleri)
+ *   kind 's': "SERIAL@2" seri no
+ *   kind 'r': "host:port@2" rtl_tcp sunucusu
+ * spec yerinde bölünür ve c içinden gösterilir; ömrü c'yi aşmalıdır.
+ */
+void pipeline_parse_spec(char *spec, char kind, PipeConfig *c);
+
+/*
+ * Cihazı aç, alt modülleri ilklendir. Başarılıysa 0; hata varsa -1 ve
+ * açılan her şey geri alınmıştır (pipeline_close çağrılmaz).
+ */
+int  pipeline_open (Pipeline *pl, int id, const PipeConfig *cfg);
+void pipeline_close(Pipeline *pl);
+
+/* USB async okumasını ve DSP thread'ini başlat / durdur */
+void pipeline_start(Pipeline *pl);
+void pipeline_stop (Pipeline *pl);
+
+/*
+ * Dar kanal ekle (mutlak merkez, geçirme bandı); her thread'den çağrılabilir.
+ * Dönüş kanal kimliği, yer yoksa -1. Plan ilk uygun blokta kurulur.
+ */
+int  pipeline_add_channel(Pipeline *pl, uint32_t freq_hz, uint32_t bw_hz);
+
+/*
+ * İnce çözünürlük modunu aç (log2n, BIGFFT_MIN_LOG2..BIGFFT_MAX_LOG2) ya da
+ * kapat (0); her thread'den. Plan DSP thread'inde sonraki blokta kurulur.
+ */
+void pipeline_set_fine(Pipeline *pl, int log2n);
+
+/*
+ * İnce modun gösterdiği pencere: ayarlı merkeze göre ofset ve açıklık (Hz);
+ * span_hz 0 = tüm bant. Pencere en az FFT_SIZE bin'dir (sütun başına bir
+ * bin); dar pencerede sütun başına daha az bin en büyüğe girer. Her thread'den.
+ */
+void pipeline_set_fine_zoom(Pipeline *pl, double offset_hz, double span_hz);
+
+/* Anlık kaydı tetikle (ön tetik halkası kapalıysa -1); her thread'den */
+int  pipeline_snapshot(Pipeline *pl, const char *reason);
+
+/*
+ * pipeline_view: son satırdan beri yeni veri varsa v'yi günceller ve 1 döner.
+ * v->row ile karşılaştırıldığı için v ilk kullanımdan önce sıfırlanmalıdır.
+ */
+int  pipeline_view(Pipeline *pl, PipeView *v);
+
+/* Sample rate'e göre satır başına blok sayısı (~PIPE_ROW_RATE satır/s) */
+int  pipeline_avg_blocks(uint32_t sample_rate);
+
+/*
+ * Tüm hatların (ve varsa GUI'nin) ölçümlerini JSON olarak yaz. Dosya önce
+ * geçici adla yazılıp yeniden adlandırılır; okuyan yarım dosya görmez.
+ */
+void pipeline_dump_stats(const char *path, Pipeline *const *pipes, int n,
+                         const Stats *ui);
@@ -1,28 +1,180 @@
 #pragma once
-/* recorder.h — Arka plan IQ kayıt sistemi (Windows thread + ring buffer)
+/* recorder.h — Arka plan IQ kayıt sistemi (yazıcı thread + ring buffer)
  *
  * Kayıt formatı: ham uint8_t IQ çiftleri (RTL-SDR natif)
  * Python'da okumak:
  *   data = np.fromfile("iq_YYYYMMDD_HHMMSS.bin", dtype=np.uint8)
  *   iq   = (data[0::2] - 127.5) / 128 + 1j * (data[1::2] - 127.5) / 128
+ *
+ * Her RecorderState kendi ring buffer'ına ve yazıcı thread'ine sahiptir;
+ * birden çok cihaz aynı anda bağımsız kayıt yapabilir.
+ *
+ * Ayar değişimleri kayıt dosyasının yanındaki "<ad>_marks.csv" dosyasına
+ * örnek hassasiyetinde işlenir (tampon boşaltmadan):
+ *   file_sample,stream_sample,t_us,gen,freq_hz,sample_rate,gain_db,agc,event
+ * file_sample, satırın geçerli olduğu ilk örneğin .bin içindeki sırasıdır
+ * (bayt ofseti = 2 x file_sample). event:
+ *   start    kaydın ilk bloğu
+ *   retune   yeni ayar kuşağı; ardından gelen örnekler oturma sürecinde
+ *   settled  oturma bitti, örnekler güvenilir
+ *   gap      halka taştığı için atılan bloklardan sonra akış devam ediyor
+ *
+ * Alt bant kaydı (recorder_set_subband): tam bant yerine yalnız seçilen
+ * pencere kaydedilir. Yazıcı thread'i oturmuş blokları tek kanallı bir
+ * kanal ayırıcıdan (chan.h) geçirir; dosya karıştırılmış, süzülmüş ve
+ * desime edilmiş karmaşık akıştır (I,Q sıralı; ci8 / ci16 / cf32):
+ *   <dizin>/sub_<etiket>_<kHz>k_<bw>kbw_YYYYMMDD_HHMMSS.ci16
+ * Disk hızı desimasyon oranı kadar düşer (2.4 MS/s'de 25 kHz ≈ 64 kat).
+ * İşaret dosyasında file_sample çıkış örneği, freq_hz pencere merkezi,
+ * sample_rate çıkış hızıdır; iki ek sütun ayarlı merkezi ve pencerenin
+ * ondan uzaklığını verir:
+ *   ...,event,tuner_hz,offset_hz
+ * İşaretli bloğun ilk çıkış örneği süzgeç gecikmesi kadar (CHAN_OVERLAP/2
+ * giriş örneği) sonrasına aittir. Pencere bant dışına düşerse akış durur.
+ *
+ * Her kayıt dosyasının yanına kapanışta SigMF biçiminde bir
+ * "<ad>.sigmf-meta" yazılır (core:dataset veri dosyasını gösterir):
+ * veri tipi (cu8 / ci8 / ci16_le / cf32_le), örnekleme hızı, kazanç, akıştaki
+ * başlangıç örneği; her start / retune bir capture, retune / settled / gap
+ * birer annotation olur.
+ *
+ * Bölütleme (recorder_set_segments): kayıt sabit süreli (akış örneği
+ * sayısıyla, tam) ya da sabit boyutlu parçalara bölünür; örnekleme hızı
+ * değişince de yeni bölüt açılır. Her bölüt kendi işaret ve SigMF
+ * dosyasıyla bağımsız işlenebilir:
+ *   iq_<etiket>_YYYYMMDD_HHMMSS_s000001.bin (+ _marks.csv, .sigmf-meta)
+ * Saklama bütçesi (retention.h) verilmişse kapanan bölütler ona eklenir;
+ * bütçe aynı dizine yazan bütün cihazlarca paylaşılır ve dizindeki bütün
+ * bölütler onu aşınca en eskiden başlayarak arka plan thread'inde silinir.
  */
 
 #include <stdint.h>
+#include <stdio.h>
+#include "thread.h"
 #include "fft.h"   /* FFT_SIZE için */
+#include "sdr.h"   /* SdrBlockMeta */
+#include "chan.h"  /* alt bant kaydı */
+#include "retention.h"
+
+#define REC_RING_SIZE 512   /* 1 MB: en büyük USB aktarımının (256 KB) 4 katı */
+#define REC_BLOCK     (FFT_SIZE * 2)
+#define REC_MARKS_HEADER "file_sample,stream_sample,t_us,gen,freq_hz," \
+                         "sample_rate,gain_db,agc,event\n"
+#define REC_SUB_MARKS_HEADER "file_sample,stream_sample,t_us,gen,freq_hz," \
+                         "sample_rate,gain_db,agc,event,tuner_hz,offset_hz\n"
+
+#define REC_SEG_EVENTS 256   /* bölüt başına SigMF'e işlenen en çok olay */
+
+/* Alt bant örnek biçimi */
+enum { REC_FMT_CI8, REC_FMT_CI16, REC_FMT_CF32, REC_FMT_COUNT };
+
+#ifdef _WIN32
+#define REC_DEFAULT_DIR "C:\\RtlSdr"
+#else
+#define REC_DEFAULT_DIR "."
+#endif
+
+/* İşaret olayı: bölüt kapanınca SigMF captures / annotations olur */
+typedef struct {
+    uint64_t    file_sample, stream_sample, t_us;
+    uint32_t    freq, sr;            /* dosyanın ekseni (alt bantta pencere / çıkış) */
+    uint32_t    tuner;               /* ayarlı merkez */
+    float       gain_db;
+    uint8_t     agc;
+    const char *kind;                /* "start" / "retune" / "settled" / "gap" */
+} RecEvent;
 
 typedef struct {
     int  active;             /* 1 = kayıt devam ediyor */
-    char filepath[256];      /* Son/aktif dosya yolu */
+    char filepath[320];      /* Son/aktif dosya (bölüt) yolu */
+    char tag[32];            /* Dosya adı öneki (çoklu cihazda ayırt etmek için) */
+    char dir[192];           /* Kayıt dizini (recorder_init: REC_DEFAULT_DIR) */
+    int  cpu;                /* Yazıcı thread'in çekirdeği, -1 = serbest */
+    int  rt_prio;            /* Yazıcı thread SCHED_FIFO önceliği, 0 = normal */
+
+    /* ── Ring buffer (recorder_init ayırır) ───────────────────── */
+    uint8_t (*ring)[REC_BLOCK];
+    SdrBlockMeta *meta;      /* her halka yuvasının etiketi */
+    volatile int wi;         /* yazma indeksi */
+    volatile int ri;         /* okuma indeksi */
+    volatile int alive;      /* thread çalışıyor mu */
+    uint32_t drops;          /* halka doluyken atılan blok (bu kayıtta) */
+    FILE   *fp;
+    FILE   *mfp;             /* ayar işaretleri (CSV) */
+    char    markpath[320];
+
+    /* ── Yazıcı thread'inin işaret durumu ───────────────────── */
+    uint64_t file_samples;   /* .bin'e yazılan örnek */
+    uint64_t next_sample;    /* beklenen sonraki akış örneği */
+    uint32_t mark_gen;
+    int      mark_settling;
+
+    /* ── Alt bant (ayar: recorder_set_subband; sub yalnız kayıtta) ── */
+    uint32_t sub_freq;       /* pencere merkezi, 0 = tam bant */
+    uint32_t sub_bw;
+    int      sub_fmt;        /* REC_FMT_* */
+    Channelizer *sub;        /* kayıt başında ayrılır, yazıcı thread'i besler */
+    void    *sub_buf;        /* ci8 / ci16 dönüşüm tamponu */
+    int      rec_fmt;        /* bu kaydın biçimi (sub_fmt o anki hali) */
+
+    /* ── Bölütleme + saklama (ayar: recorder_set_segments) ───── */
+    uint32_t seg_s;          /* bölüt süresi (s), 0 = süre sınırı yok */
+    uint64_t seg_bytes;      /* bölüt boyu (bayt), 0 = boyut sınırı yok */
+    uint32_t seg_no;         /* geçerli bölüt (1'den), 0 = bölütleme kapalı */
+    char     stamp[32];      /* kaydın başlangıç damgası (dosya adları) */
+    uint64_t seg_stream0;    /* bölütün ilk akış örneği */
+    uint64_t seg_t0_us;      /* bölütün ilk bloğunun varışı */
+    uint64_t seg_wall_ms;    /* aynı anın duvar saati */
+    uint32_t seg_sr;         /* bölütün giriş örnekleme hızı */
+    RecEvent ev[REC_SEG_EVENTS];
+    int      n_ev;
+    uint32_t ev_lost;
+    Retention *ret;          /* paylaşılan dizin bütçesi, NULL = silme yok */
+    Thread  thread;
+    Mutex   cs;
+    Cond    cv;              /* push → yazıcı uyandırma */
 } RecorderState;
 
-/* recorder_init: yapıyı sıfırla (program başında bir kez) */
+/* recorder_init: yapıyı sıfırla, ring'i ayır (program başında bir kez) */
 void recorder_init(RecorderState *r);
 
+/* recorder_free: ring'i serbest bırak (kayıt durdurulmuş olmalı) */
+void recorder_free(RecorderState *r);
+
 /* recorder_start: yeni dosya aç, arka plan thread'ini başlat */
 void recorder_start(RecorderState *r);
 
 /* recorder_stop: thread'i durdur, dosyayı kapat */
 void recorder_stop(RecorderState *r);
 
-/* recorder_push: ana döngüden çağrılır; blok ring buffer'a yazılır */
-void recorder_push(RecorderState *r, const uint8_t *raw);
\ No newline at end of file
+/* recorder_push: async thread'den çağrılır; blok etiketiyle ring buffer'a yazılır.
+   Halka doluysa blok atılır ve -1 döner (kayıt yoksa ya da yazıldıysa 0). */
+int  recorder_push(RecorderState *r, const uint8_t *raw, const SdrBlockMeta *meta);
+
+/*
+ * Alt bant penceresi (mutlak merkez, genişlik, REC_FMT_*); freq_hz 0 ise
+ * tam bant. Bir sonraki recorder_start'ta geçerli olur. Geçerliyse 0.
+ */
+int  recorder_set_subband(RecorderState *r, uint32_t freq_hz, uint32_t bw_hz, int fmt);
+
+/*
+ * Bölüt süresi / boyutu ve saklama bütçesi (ret_init'lenmiş, aynı dizine
+ * yazan kaydedicilerle paylaşılır; NULL = silme yok). Bir sonraki
+ * recorder_start'ta geçerli olur; ret kaydedici durana dek yaşamalıdır.
+ */
+void recorder_set_segments(RecorderState *r, uint32_t seg_s, uint64_t seg_bytes,
+                           Retention *ret);
+
+/* "60" / "60s" (tam saniye) ya da "512M" / "0.5G" (boyut) → bölüt ayarı. Geçerliyse 0. */
+int  recorder_parse_segment(const char *spec, uint32_t *seg_s, uint64_t *seg_bytes);
+
+/* "433.92:25[:ci8|ci16|cf32]" (MHz:kHz[:biçim]) çöz; biçim yoksa ci16 */
+int  recorder_parse_subband(const char *spec, uint32_t *freq_hz, uint32_t *bw_hz,
+                            int *fmt);
+
+/* Biçimin dosya uzantısı / adı ("ci16") */
+const char *recorder_fmt_name(int fmt);
+
+/* İşaret satırı (biçim yukarıda); anlık kayıtlar da (snapshot.h) aynısını yazar */
+void recorder_write_mark(FILE *fp, uint64_t file_sample, const SdrBlockMeta *m,
+                         const char *ev);
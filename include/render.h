@@ -5,6 +5,7 @@
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
 #include "fft.h"
+#include "tilepyr.h"
 
 /* ── Sanal kanvas ──────────────────────────────── */
 /* SDL_RenderSetLogicalSize ile DPI'dan bağımsız            */
@@ -30,8 +31,24 @@ typedef struct {
     TTF_Font     *font_md;   /* 15 px */
     float         db_min;
     float         db_max;
+
+    /* Grafik yerleşimi — render_set_layout ile değişir */
+    int           spec_top, spec_h;
+    int           wfall_top, wfall_h;
+    int           compact;   /* döşeli görünüm: başlıklar/ara etiketler yok */
+
+    /* Arşiv görünümü dokusu: görünüm / renk aralığı değişmedikçe yeniden dolmaz */
+    SDL_Texture  *pyr_tex;
+    int           pyr_w, pyr_h;
+    double        pyr_key[6];
 } RenderCtx;
 
+/* Arşiv (döşeme piramidi) görünüm penceresi: düzey 0 satır × bin */
+typedef struct {
+    double t0, t1;
+    double b0, b1;
+} PyrView;
+
 /* ── Başlatma / Kapatma ────────────────────────────────────── */
 int  render_init(RenderCtx *ctx, SDL_Renderer *renderer);
 void render_free(RenderCtx *ctx);
@@ -47,8 +64,25 @@ void render_text_center  (RenderCtx *ctx, TTF_Font *f, const char *s, int cx, in
 void render_clear    (RenderCtx *ctx);
 void render_grid     (RenderCtx *ctx, float fc_mhz, float bw_mhz);
 void render_spectrum (RenderCtx *ctx, const float *psd);
+void render_trace    (RenderCtx *ctx, const float *psd, SDL_Color c);  /* dolgusuz çizgi */
 void render_waterfall(RenderCtx *ctx, const float waterfall[WATERFALL_ROWS][FFT_SIZE]);
+/* Şelale üstüne çerçeve: bin aralığı [bin_lo, bin_hi], satır yaşı
+   age_new..age_old (0 = en yeni satır, en altta) */
+void render_waterfall_mark(RenderCtx *ctx, int bin_lo, int bin_hi,
+                           int age_new, int age_old, SDL_Color c);
+/* Spektrum + şelale boyunca yarı saydam dikey şerit, x1..x2 piksel (alt bant) */
+void render_band     (RenderCtx *ctx, int x1, int x2, SDL_Color c);
 void render_present  (RenderCtx *ctx);
 
+/* Piramidi spektrum + şelale alanının tamamına çiz (üst = t0), eksen etiketleriyle */
+void render_pyramid  (RenderCtx *ctx, const TilePyr *p, const PyrView *v);
+
+/* ── Çoklu cihaz yerleşimi ─────────────────────────────────── */
+/* n_tiles ≤ 1: tek görünüm (varsayılan sabitler). Aksi halde grafik alanı
+   dikey döşemelere bölünür; tile sıradaki döşemenin indeksidir. */
+void render_set_layout(RenderCtx *ctx, int tile, int n_tiles);
+/* Ekran y koordinatının düştüğü döşeme */
+int  render_tile_at(int y, int n_tiles);
+
 /* ── Renk haritası ─────────────────────────────────────────── */
 SDL_Color render_colormap(float v, float vmin, float vmax);
\ No newline at end of file
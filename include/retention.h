@@ -0,0 +1,60 @@
+#pragma once
+/* retention.h — Kayıt bölütleri için kayan disk bütçesi (arka plan silici)
+ *
+ * Kaydedici kapanan her bölütü ret_add ile bildirir; silici thread'i
+ * toplam boyut bütçeyi aşınca en eski bölütleri siler. Bölüt, veri
+ * dosyası ve yan dosyalarıdır ("<kök>_marks.csv", "<kök>.sigmf-meta");
+ * boyut ve silme üçü için birlikte yapılır. Açık (yazılan) bölüt listeye
+ * hiç girmez, silinemez.
+ *
+ * Bütçe dizin başınadır: aynı dizine yazan bütün kaydediciler (her cihaz)
+ * tek Retention'ı paylaşır, N cihaz dizini N katına büyütmez. İlk
+ * kullanıcının ret_start'ı dizindeki bütün eski bölütleri ("iq_*",
+ * "sub_*", her etiket) değişiklik zamanına göre sıralayıp listeye alır;
+ * süreç yeniden başlasa da bütçe 7/24 korunur. Yazıcı thread'leri dosya
+ * silmeyi hiç beklemez.
+ */
+
+#include <stdint.h>
+#include "thread.h"
+
+typedef struct {
+    char     path[320];      /* veri dosyası */
+    uint64_t bytes;          /* veri + yan dosyalar */
+    int64_t  mtime;          /* sıralama anahtarı (s) */
+} RetSeg;
+
+typedef struct {
+    char     dir[192];
+    uint64_t budget;         /* bayt, 0 = kapalı */
+    int      users;          /* çalışan kaydedici (ret_start - ret_stop) */
+    RetSeg  *seg;            /* eskiden yeniye */
+    int      n, cap;
+    uint64_t total;          /* listedeki bölütlerin toplamı */
+    uint64_t n_deleted, bytes_deleted;
+
+    Thread        thread;
+    volatile int  alive;
+    Mutex         cs;
+    Cond          cv;
+} Retention;
+
+/* Dizini ve bütçeyi ayarla (program başında bir kez); budget 0 = kapalı */
+void ret_init(Retention *rt, const char *dir, uint64_t budget);
+void ret_free(Retention *rt);   /* bütün kullanıcılar ret_stop çağırmış olmalı */
+
+/*
+ * Bir kaydedici başlıyor (recorder_start, kontrol thread'i). İlk kullanıcı
+ * dizini tarar ve silici thread'i başlatır. Thread başlatılamazsa -1 ama
+ * kullanıcı yine sayılır: her ret_start'a bir ret_stop düşer.
+ */
+int  ret_start(Retention *rt);
+
+/* Kapanmış bölütü listenin sonuna ekle (yazıcı thread'i); silici uyanır */
+void ret_add(Retention *rt, const char *data_path);
+
+/* Kaydedici durdu; son kullanıcı bekleyen silmeleri bitirip thread'i durdurur */
+void ret_stop(Retention *rt);
+
+/* "<n>T" / "<n>G" / "<n>M" / "<n>k" → bayt (ek yoksa MB). Geçersizse 0. */
+uint64_t ret_parse_size(const char *s);
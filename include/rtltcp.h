@@ -0,0 +1,66 @@
+#pragma once
+/* rtltcp.h — rtl_tcp protokol istemcisi (uzak RTL-SDR'ı IQ kaynağı olarak kullanır)
+ *
+ * Protokol:
+ *   Bağlantıda sunucu 12 baytlık başlık yollar:
+ *     "RTL0" | tuner tipi (uint32 BE) | kazanç adım sayısı (uint32 BE)
+ *   Ardından kesintisiz ham uint8 IQ akışı gelir.
+ *   İstemci 5 baytlık komutlar yollar: komut (uint8) | parametre (uint32 BE)
+ *
+ * API librtlsdr'ın async modelini taklit eder: rtltcp_read_async çağıran
+ * thread'de bloklar ve her FFT bloğu için aynı callback imzasını çağırır.
+ * Alınan veri büyük bir tampona doğrudan recv edilir; callback'e bu
+ * tampondaki blokların işaretçisi verilir (ara kopya yok).
+ */
+
+#include <stdint.h>
+
+/* Standart rtl_tcp komut kodları */
+#define RTLTCP_CMD_FREQ        0x01
+#define RTLTCP_CMD_SAMPLE_RATE 0x02
+#define RTLTCP_CMD_GAIN_MODE   0x03   /* 0 = otomatik, 1 = manuel */
+#define RTLTCP_CMD_GAIN        0x04   /* 0.1 dB birimi */
+#define RTLTCP_CMD_FREQ_CORR   0x05
+#define RTLTCP_CMD_AGC_MODE    0x08
+
+#define RTLTCP_DEFAULT_PORT    1234
+#define RTLTCP_RXBUF       (1u << 20)   /* 1 MB alım tamponu */
+#define RTLTCP_SOCKBUF     (4u << 20)   /* çekirdek soket tamponu (SO_RCVBUF) */
+
+typedef void (*RtlTcpCb)(unsigned char *buf, uint32_t len, void *ctx);
+
+/* Gecikme / verim sayaçları (alım thread'i yazar, diğerleri okur) */
+typedef struct {
+    uint64_t bytes;            /* alınan toplam IQ baytı */
+    uint64_t blocks;           /* callback'e teslim edilen blok */
+    uint64_t recv_calls;
+    uint32_t gap_max_us;       /* ardışık iki recv dönüşü arasındaki en uzun süre */
+    uint32_t dispatch_max_us;  /* bir recv parçasının tüketicilerde geçirdiği en uzun süre */
+    double   rate_mbs;         /* son ~1 s ortalama alım hızı (MB/s) */
+    uint32_t cmds;             /* yollanan komut sayısı */
+} RtlTcpStats;
+
+typedef struct RtlTcp RtlTcp;
+
+/* Bağlan ve başlığı oku. Hata varsa NULL. */
+RtlTcp *rtltcp_open (const char *host, uint16_t port);
+void    rtltcp_close(RtlTcp *c);
+
+uint32_t rtltcp_tuner_type(const RtlTcp *c);
+uint32_t rtltcp_gain_count(const RtlTcp *c);
+
+/* Komutlar: başarılıysa 0 */
+int rtltcp_set_center_freq    (RtlTcp *c, uint32_t hz);
+int rtltcp_set_sample_rate    (RtlTcp *c, uint32_t sr);
+int rtltcp_set_tuner_gain_mode(RtlTcp *c, int manual);
+int rtltcp_set_tuner_gain     (RtlTcp *c, int tenth_db);
+
+/*
+ * Akışı oku ve her block_len baytlık blok için cb'yi çağır.
+ * rtltcp_cancel_async çağrılana ya da bağlantı kopana dek dönmez.
+ * Bağlantı koptuysa -1, iptal edildiyse 0 döner.
+ */
+int  rtltcp_read_async  (RtlTcp *c, RtlTcpCb cb, void *ctx, uint32_t block_len);
+void rtltcp_cancel_async(RtlTcp *c);
+
+const RtlTcpStats *rtltcp_stats(const RtlTcp *c);
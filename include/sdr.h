@@ -3,50 +3,112 @@
 
 #include <stdint.h>
 #include <rtl-sdr.h>
-#include <windows.h>
+#include "thread.h"
 #include "fft.h"   /* FFT_SIZE için */
+#include "rtltcp.h"
+#include "stats.h"
+#include "blockmeta.h"   /* SdrBlockMeta */
 
 #define SDR_DEFAULT_FREQ   100000000u   /* 100 MHz */
 #define SDR_DEFAULT_SR     2048000u     /* 2.048 MS/s */
 
+/*
+ * USB aktarım tamponları. Küçük aktarımlar (ör. 2 KB) 2.4 MS/s'de saniyede
+ * ~2400 callback demektir: bağlam geçişi CPU yer, yoğun makinede USB
+ * taşması riski artar. Her aktarım callback içinde FFT_SIZE*2 baytlık
+ * bloklara dilimlenir ve blokların HEPSİ tüketicilere gider.
+ */
+#define SDR_XFER_LEN_MIN   (16u  * 1024u)
+#define SDR_XFER_LEN_MAX   (256u * 1024u)
+#define SDR_XFER_LEN_DEF   (64u  * 1024u)   /* 2.048 MS/s'de ~16 ms */
+#define SDR_XFER_NUM_MIN   8u
+#define SDR_XFER_NUM_MAX   32u
+#define SDR_XFER_NUM_DEF   16u
+
+/*
+ * Yeniden ayar sonrası oturma. İstek anında henüz teslim edilmemiş ama
+ * ESKİ ayarla yakalanmış olabilecek örnekler: dolmakta olan aktarım +
+ * callback'e verilmeyi bekleyen bir aktarım (SDR_INFLIGHT_XFERS). Bunlara
+ * PLL / AGC oturma süresi eklenir. rtl_tcp'de ağ gecikmesi bilinmediğinden
+ * ek pay kullanılır.
+ */
+#define SDR_INFLIGHT_XFERS 2u
+#define SDR_SETTLE_MS      5u
+#define SDR_SETTLE_SR_MS   20u    /* örnekleme hızı değişimi (ADC + filtre) */
+#define SDR_SETTLE_TCP_MS  50u
+
 /*
  * Asenkron veri callback'i: rtlsdr_read_async thread'inden her I/Q bloğu
- * geldiğinde çağrılır. Kaydedici gibi TÜM bloklara erişmesi gereken
- * bileşenler buraya bağlanır. GUI bu yolu kullanmaz; GUI sdr_pop_block()
- * ile en son bloğu alır.
+ * (FFT_SIZE*2 bayt) için bloğun etiketiyle çağrılır; büyük USB aktarımları
+ * önce bloklara dilimlenir. Kaydedici gibi TÜM bloklara erişmesi gereken
+ * bileşenler buraya bağlanır. Tek tüketici pipeline'dır; GUI satırlarını
+ * pipeline'ın DSP thread'inden alır.
  */
-typedef void (*SdrDataCb)(const uint8_t *buf, uint32_t len, void *userdata);
+typedef void (*SdrDataCb)(const uint8_t *buf, uint32_t len,
+                          const SdrBlockMeta *meta, void *userdata);
 
 typedef struct {
     rtlsdr_dev_t *dev;
+    RtlTcp       *tcp;          /* NULL değilse kaynak uzak rtl_tcp sunucusu */
+    uint32_t      index;        /* librtlsdr cihaz indeksi */
+    char          serial[256];  /* USB seri numarası (yoksa boş) */
     uint32_t      center_freq;
     uint32_t      sample_rate;
     int           agc_on;       /* 1 = AGC, 0 = manuel */
     float         gain_db;      /* Manuel kazanç (0–49.6 dB) */
 
     /* ── Asenkron okuma alanları ──────────────────────────────── */
-    HANDLE           async_thread;   /* rtlsdr_read_async'i çalıştıran thread */
+    Thread           async_thread;   /* rtlsdr_read_async'i çalıştıran thread */
     volatile int     async_running;  /* 0 yapılırsa thread durur */
+    int              cpu;            /* async thread'in sabitleneceği çekirdek, -1 = serbest */
+    int              rt_prio;        /* async thread SCHED_FIFO önceliği, 0 = normal */
+    uint32_t         xfer_len;       /* aktarım başına bayt (blok katı) */
+    uint32_t         xfer_num;       /* kuyruktaki aktarım tamponu sayısı */
+
+    /* Aktarım sınırına denk gelen yarım blok bir sonraki aktarımla tamamlanır */
+    uint8_t          carry[FFT_SIZE * 2];
+    uint32_t         carry_len;
+
+    Stats           *stats;          /* NULL değilse aktarım aralıkları buraya */
+    uint64_t         last_xfer_us;
 
     /*
-     * GUI görüntüleme çift tamponu:
-     *   - Async thread her blokta disp_buf'u günceller ve disp_fresh=1 yapar.
-     *   - GUI thread sdr_pop_block() ile bunu okur ve disp_fresh=0 sıfırlar.
-     *   - VSYNC hızındaki GUI kaçırdığı blokları sorunsuz atlar.
+     * Blok etiketleri. sdr_set_* çağıran thread (GUI, tarama) cfg'yi ve
+     * settle_to'yu cfg_cs altında günceller; async thread her blokta
+     * bunları okur. sample_count yalnızca async thread'de artar.
      */
-    uint8_t          disp_buf[FFT_SIZE * 2];
-    volatile int     disp_fresh;
-    CRITICAL_SECTION disp_cs;
+    SdrBlockMeta     cfg;            /* geçerli ayar (sample/t_us/settling boş) */
+    uint64_t         settle_to;      /* bu örneğe kadar settling = 1 */
+    volatile uint64_t sample_count;  /* teslim edilen örnek */
+    Mutex            cfg_cs;
 
     /* Tüm blokları görmesi gereken bileşen için callback (kaydedici) */
     SdrDataCb  data_cb;
     void      *data_cb_ud;
 } SdrDevice;
 
-/* Cihazı aç ve varsayılan ayarları uygula. Başarılıysa 0, hata varsa -1. */
-int  sdr_open  (SdrDevice *s);
+/* index numaralı cihazı aç ve varsayılan ayarları uygula.
+   Başarılıysa 0, hata varsa -1. */
+int  sdr_open  (SdrDevice *s, uint32_t index);
 void sdr_close (SdrDevice *s);
 
+/* Uzak rtl_tcp sunucusuna bağlan. Sonraki tüm sdr_* çağrıları (ayar,
+   async okuma) USB yerine bu bağlantı üzerinden yürür. */
+int  sdr_open_tcp(SdrDevice *s, const char *host, uint16_t port);
+
+/* Seri numarasından cihaz indeksi; bulunamazsa -1 */
+int  sdr_find_serial(const char *serial);
+
+/* Bağlı tüm cihazları indeks + seri numarasıyla listele */
+void sdr_list_devices(void);
+
+/*
+ * Aktarım boyutu / sayısı (sdr_start_async'ten önce). len blok katına
+ * yuvarlanır ve [SDR_XFER_LEN_MIN, SDR_XFER_LEN_MAX], num ise
+ * [SDR_XFER_NUM_MIN, SDR_XFER_NUM_MAX] aralığına sıkıştırılır.
+ */
+void sdr_set_xfer(SdrDevice *s, uint32_t len, uint32_t num);
+
 /*
  * Asenkron okumayı başlat:
  *   cb        — Her blokta çağrılacak işlev (kaydediciye bağla).
@@ -60,14 +122,15 @@ void sdr_start_async(SdrDevice *s, SdrDataCb cb, void *userdata);
 void sdr_stop_async(SdrDevice *s);
 
 /*
- * GUI döngüsü için: async thread yeni bir blok yazdıysa out'a kopyalar
- * ve 1 döner. Henüz yeni blok yoksa (GUI async'ten daha hızlıysa) 0 döner
- * ve GUI bu kareyi çizmeyebilir.
+ * Ayar değişiklikleri. Her biri yeni bir kuşak (gen) açar: istek anından
+ * sonra teslim edilen bloklar yeni ayarla etiketlenir ve oturma süresi
+ * boyunca settling = 1 taşır. Tampon boşaltılmaz (rtlsdr_reset_buffer yok).
  */
-int  sdr_pop_block(SdrDevice *s, uint8_t *out);
-
 void sdr_set_freq   (SdrDevice *s, uint32_t hz);
 void sdr_set_sr     (SdrDevice *s, uint32_t sr);
 void sdr_set_agc    (SdrDevice *s, int on);
 void sdr_set_gain   (SdrDevice *s, float db);
-void sdr_shift_freq (SdrDevice *s, int32_t delta_hz);
\ No newline at end of file
+void sdr_shift_freq (SdrDevice *s, int32_t delta_hz);
+
+/* Son istenen ayarın kuşağı (herhangi bir thread'den) */
+uint32_t sdr_generation(SdrDevice *s);
@@ -0,0 +1,105 @@
+#pragma once
+/* shmring.h — IQ bloklarının ve PSD satırlarının paylaşılan bellekten yayını
+ *
+ * Aynı makinedeki başka süreçler (çözücüler, kaydediciler) dongle'ı ikinci
+ * kez açamaz; bunun yerine hattın yayınladığı paylaşılan bellek halkasına
+ * bağlanırlar. Üretici her bloğu bir kez halkaya yazar; okuyucu sayısı
+ * üreticinin maliyetini değiştirmez.
+ *
+ * Bölüt düzeni (Windows: "Local\<ad>" dosya eşlemesi, POSIX: "/<ad>" shm):
+ *   ShmHeader | IQ yuvaları (iq_slots × [ShmSlotMeta + iq_bytes])
+ *             | PSD yuvaları (psd_slots × [ShmSlotMeta + psd_bins*4])
+ *
+ * Her yuva bir seqlock taşır: yazım sırasında seq = 2*i+1, bitince 2*i+2
+ * (i = yayın sırası). Okuyucu veriyi kopyalamadan önce ve sonra seq'e
+ * bakar; değiştiyse yuva okunurken ezilmiştir (taşma). Okuyucular bölüte
+ * hiç yazmaz — istedikleri an bağlanıp ayrılabilir, üretici beklemez.
+ */
+
+#include <stdint.h>
+
+#define SHMRING_MAGIC      0x31524853u   /* "SHR1" */
+#define SHMRING_IQ_SLOTS   512           /* ~256 ms @ 2.048 MS/s */
+#define SHMRING_PSD_SLOTS  256
+
+/* Yuva başındaki üstveri (64 bayt, yuva verisi hizalı kalsın) */
+typedef struct {
+    volatile uint64_t seq;       /* seqlock (yukarıya bkz.) */
+    uint64_t index;              /* yayın sırası (0'dan) */
+    uint64_t t_us;               /* yayın anı, epoch µs */
+    double   center_hz;
+    double   rate_hz;            /* IQ: örnekleme hızı, PSD: açıklık */
+    uint32_t len;                /* geçerli veri baytı */
+    uint32_t flags;
+    uint8_t  _pad[16];
+} ShmSlotMeta;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t iq_slots, iq_bytes;       /* yuva sayısı, yuva başına veri baytı */
+    uint32_t psd_slots, psd_bins;
+    uint64_t iq_off, psd_off;          /* bölüt başından bayt ofseti */
+    uint64_t total_bytes;
+    uint64_t instance;                 /* üretici başlangıcı (epoch µs) */
+    volatile uint64_t iq_head;         /* yayınlanan IQ blok sayısı */
+    volatile uint64_t psd_head;
+    volatile uint32_t alive;           /* üretici kapanınca 0 */
+    uint8_t  _pad[52];                 /* 128 bayt */
+} ShmHeader;
+
+/* ── Üretici ──────────────────────────────────────────────────── */
+typedef struct ShmRing ShmRing;
+
+/* name: "radar_d0" gibi; platform ön eki eklenir. Hata varsa NULL. */
+ShmRing *shmring_create (const char *name, uint32_t iq_bytes, uint32_t psd_bins);
+void     shmring_destroy(ShmRing *r);
+
+void shmring_publish_iq (ShmRing *r, const uint8_t *buf, uint32_t len,
+                         double center_hz, double sample_rate);
+void shmring_publish_psd(ShmRing *r, const float *row, uint32_t bins,
+                         double center_hz, double span_hz);
+
+/* ── Okuyucu ──────────────────────────────────────────────────── */
+typedef struct {
+    const ShmHeader *hdr;
+    void     *map;             /* platforma özgü eşleme tutamaçları */
+    void     *handle;
+    uint64_t  size;
+    uint64_t  instance;
+
+    uint64_t  iq_next, psd_next;     /* sıradaki okunacak yayın sırası */
+    uint64_t  iq_lost, psd_lost;     /* taşma nedeniyle kaçırılan */
+    uint64_t  iq_torn, psd_torn;     /* okunurken ezilen (kaçırılana dahil) */
+
+    const ShmSlotMeta *pend;         /* shmring_iq_begin ile açık yuva */
+    uint64_t  pend_seq;
+} ShmReader;
+
+/* Bağlan; okuma en yeni yayından başlar. Başarılıysa 0. */
+int  shmring_attach(ShmReader *rd, const char *name);
+void shmring_detach(ShmReader *rd);
+
+/* Üretici hâlâ yazıyor mu (kapandıysa ya da yeniden başladıysa 0) */
+int  shmring_alive(const ShmReader *rd);
+
+/* Okunmayı bekleyen yayın sayısı (gecikme) */
+uint64_t shmring_iq_lag (const ShmReader *rd);
+uint64_t shmring_psd_lag(const ShmReader *rd);
+
+/*
+ * Kopyalayarak oku: yeni yayın varsa out'a (en az iq_bytes / psd_bins*4)
+ * kopyalar, meta'yı doldurur ve 1 döner; yoksa 0. Okuyucu geride kalıp
+ * yuvalar ezildiyse kaçırılanlar *_lost'a eklenir ve en eski geçerli
+ * yayından devam edilir.
+ */
+int shmring_read_iq (ShmReader *rd, uint8_t *out, ShmSlotMeta *meta);
+int shmring_read_psd(ShmReader *rd, float   *out, ShmSlotMeta *meta);
+
+/*
+ * Kopyasız okuma: sıradaki IQ yuvasının verisini yerinde gösterir
+ * (yoksa NULL). İşlem bitince shmring_iq_end çağrılır; yuva bu arada
+ * ezildiyse 0 döner ve veri atılmalıdır.
+ */
+const uint8_t *shmring_iq_begin(ShmReader *rd, ShmSlotMeta *meta);
+int            shmring_iq_end  (ShmReader *rd);
@@ -0,0 +1,81 @@
+#pragma once
+/* snapshot.h — Ön tetik IQ halkası + tetiklemeli anlık kayıt
+ *
+ * recorder_start yalnız düğmeye basıldığı andan sonrasını yakalar; olayın
+ * başı hep kaybolur. SnapRing son pre_ms milisaniyelik ham IQ'yu sürekli
+ * bellekte tutar (boyu sabit, snap_init'te bir kez ayrılır). snap_trigger
+ * (kısayol, API ya da dedektör) çağrılınca yazıcı thread'i tetikten pre_ms
+ * öncesinden post_ms sonrasına kadarki blokları diske yazar:
+ *
+ *   <dizin>/snap_<etiket>_YYYYMMDD_HHMMSS.bin        ham uint8 IQ (recorder ile aynı)
+ *   <dizin>/snap_<etiket>_YYYYMMDD_HHMMSS_marks.csv  recorder.h işaret biçimi;
+ *                                                    ek olay "trigger" tetik bloğu
+ *
+ * Üretici (USB thread'i) kilit almaz ve hiç beklemez: bloğu yuvaya kopyalar,
+ * sayaçları atomik ilerletir. Yazıcı kopyaladığı blokların bu arada üzerine
+ * yazılmadığını sayaçla doğrular (seqlock gibi); disk geride kalırsa ezilen
+ * bloklar atlanır ve işaret dosyasında "gap" olarak görünür.
+ * Yazım sürerken gelen yeni tetik bitişi uzatır (aynı dosya); yazıcı
+ * dosyayı kapatmaya karar verdikten sonra gelen tetik yeni dosya açar.
+ */
+
+#include <stdint.h>
+#include "thread.h"
+#include "sdr.h"        /* SdrBlockMeta */
+#include "recorder.h"   /* REC_BLOCK, işaret biçimi */
+
+#define SNAP_SLACK_MS  1000   /* pre_ms üstü pay: yazıcı en eski bloklara yetişsin */
+#define SNAP_CHUNK     64     /* yazıcının tek seferde kopyaladığı blok (128 KB) */
+
+typedef struct {
+    /* ── Ayarlar (snap_init sonrası, snap_start öncesi) ─────────── */
+    uint32_t pre_ms, post_ms;
+    char     dir[192];
+    char     tag[32];
+    int      cpu;            /* yazıcı thread çekirdeği, -1 = serbest */
+    int      rt_prio;
+
+    /* ── Halka (yalnız üretici yazar) ─────────────────────────── */
+    uint8_t (*ring)[REC_BLOCK];    /* NULL = kapalı */
+    SdrBlockMeta *meta;
+    uint32_t cap;            /* blok */
+    volatile uint64_t wr;    /* yazımına başlanan blok (üzerine yazma sınırı) */
+    volatile uint64_t wi;    /* tamamlanan blok */
+    volatile uint32_t last_sr;
+
+    /* ── Tetik (cs ile) ───────────────────────────────────────── */
+    int      pending;        /* yazıcı henüz almadı */
+    uint64_t trig;           /* son tetik bloğu (halka sırası) */
+    uint64_t end;            /* yazılacak son blok + 1 */
+    char     reason[32];
+    volatile int busy;       /* dosya yazılıyor */
+    char     last_path[320];
+    uint32_t n_snaps;
+    uint64_t lost;           /* yazıcı geride kaldığı için ezilen blok */
+
+    Thread   thread;
+    volatile int alive;
+    Mutex    cs;
+    Cond     cv;             /* tetik → yazıcı */
+} SnapRing;
+
+/*
+ * Halkayı ayır: pre_ms + SNAP_SLACK_MS, sample_rate hızında. Daha sonra
+ * hız yükselirse ön pencere halkaya sığdığı kadar kısalır. pre_ms ve
+ * post_ms ikisi de 0 ise halka kapalı kalır. Başarılıysa 0, hata -1.
+ */
+int  snap_init (SnapRing *s, uint32_t pre_ms, uint32_t post_ms, uint32_t sample_rate);
+void snap_free (SnapRing *s);   /* snap_stop çağrılmış olmalı */
+
+/* Yazıcı thread'i; snap_stop bekleyen anlık kaydı eldeki bloklarla kapatır */
+void snap_start(SnapRing *s);
+void snap_stop (SnapRing *s);
+
+/* USB thread'inden her blokta (kapalıysa hiçbir şey yapmaz) */
+void snap_push(SnapRing *s, const uint8_t *raw, const SdrBlockMeta *meta);
+
+/* Şu anki bloğu tetik say. reason günlüğe yazılır. Halka kapalıysa -1. */
+int  snap_trigger(SnapRing *s, const char *reason);
+
+/* "ön[:son]" saniye → ms (son verilmezse ön ile aynı). Geçerliyse 0. */
+int  snap_parse(const char *spec, uint32_t *pre_ms, uint32_t *post_ms);
@@ -0,0 +1,64 @@
+#pragma once
+/* specsrv.h — Uzak izleyiciler için ikili spektrum yayın sunucusu
+ *
+ * DSP thread'leri her ortalanmış PSD satırını specsrv_publish ile bırakır
+ * (yalnızca bir memcpy; ağ beklenmez). Ayrı bir gönderici thread'i her
+ * istemci için satırı nicemler, istemcinin son aldığı satıra göre fark
+ * kodlar ve bloklamayan sokete yazar. Yavaş istemcinin tamponu boşalmadan
+ * gelen satırlar o istemci için atlanır; DSP'ye geri basınç yoktur.
+ *
+ * Çerçeve (TCP, little-endian, SPECSRV_HDR_SIZE bayt başlık + yük):
+ *   0  u32  magic  "SPF1"
+ *   4  u8   flags  (SPECSRV_F_KEY = yük ham nicemli satır)
+ *   5  u8   hat (pipeline) numarası
+ *   6  u16  n_bins (abonelikte istenen kutu sayısı)
+ *   8  u32  seq     (hattın satır sayacı)
+ *   12 u64  t_ms    (epoch ms)
+ *   20 f64  center_hz
+ *   28 f64  span_hz
+ *   36 f32  db_base  — dB = db_base + q * db_step
+ *   40 f32  db_step
+ *   44 u32  yük baytı
+ *
+ * Yük:
+ *   Anahtar çerçeve: n_bins adet uint8 q.
+ *   Fark çerçevesi : d = q - q_önceki (mod 256), 4 bitlik öbeklerde (yüksek
+ *                    öbek önce). -7..7 arası d tek öbek; aksi halde 0x8
+ *                    kaçış öbeği ve ardından d'nin iki öbeği.
+ *
+ * İstemci → sunucu abonelik komutları (rtl_tcp gibi 5 bayt: kod + u32 BE):
+ *   0x01  satır seyreltme: her N. satırı yolla (1..SPECSRV_MAX_DECIM)
+ *   0x02  kutu sayısı: 2'nin kuvveti, 64..FFT_SIZE (gruplar max ile indirgenir)
+ *   0x03  hat maskesi (bit i = hat i)
+ */
+
+#include <stdint.h>
+
+#define SPECSRV_DEFAULT_PORT  5555
+#define SPECSRV_MAX_CLIENTS   16
+#define SPECSRV_MAX_PIPES      8
+#define SPECSRV_MAX_DECIM     60
+#define SPECSRV_KEY_EVERY    120      /* bu kadar fark çerçevesinde bir anahtar */
+#define SPECSRV_HDR_SIZE      48
+#define SPECSRV_DB_BASE     (-60.0f)
+#define SPECSRV_DB_STEP       0.5f    /* -60 .. +67.5 dB */
+
+#define SPECSRV_F_KEY       0x01
+
+#define SPECSRV_CMD_DECIM   0x01
+#define SPECSRV_CMD_BINS    0x02
+#define SPECSRV_CMD_PIPES   0x03
+
+typedef struct SpecServer SpecServer;
+
+/* Dinlemeye başla ve gönderici thread'ini aç. Hata varsa NULL. */
+SpecServer *specsrv_start(uint16_t port);
+void        specsrv_stop (SpecServer *sv);
+
+/* DSP thread'inden: hattın yeni satırını yayınla (row FFT_SIZE float dB) */
+void specsrv_publish(SpecServer *sv, int pipe, const float *row, uint32_t seq,
+                     uint64_t t_ms, double center_hz, double span_hz);
+
+/* Bağlı istemci sayısı ve toplam yollanan bayt (panel/durum için) */
+int      specsrv_clients   (const SpecServer *sv);
+uint64_t specsrv_bytes_sent(const SpecServer *sv);
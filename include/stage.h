@@ -0,0 +1,89 @@
+#pragma once
+/* stage.h — DSP aşamaları: kayıt defteri, paylaşılan kütüphane yükleme, hat başına barındırıcı
+ *
+ * Süreç başında aşamalar kaydedilir (stage_register: derlenmiş aşama,
+ * stage_load: paylaşılan kütüphane). pipeline_open her kayıtlı aşamanın
+ * hat başına bir örneğini açar; her örneğin kendi thread'i ve kendi
+ * ölçüm sayaçları (Stats) vardır.
+ *
+ *   USB thread'i ──► stage_push_block ──► IQ halkası (tek kopya) ──┬─► aşama A thread'i
+ *   DSP thread'i ──► stage_push_row   ──► satır halkası          ──┴─► aşama B thread'i
+ *
+ * Akış hattın içinde yalnız bir kez kopyalanır; aşamalar halka yuvalarını
+ * yerinde okur. Halka kilitsizdir (snapshot.h ile aynı sınır + sayaç
+ * düzeni); üretici hiç beklemez. Kayıpsız / en iyi çaba anlamı için
+ * stage_api.h'a bakınız.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include "stage_api.h"
+#include "thread.h"
+#include "fft.h"      /* FFT_SIZE */
+#include "stats.h"
+
+#define STAGE_MAX        16
+#define STAGE_IQ_SLOTS   1024   /* 2 MB, 2.048 MS/s'de ~0.5 s */
+#define STAGE_ROW_SLOTS  256    /* ~4 s satır */
+
+/* Kilitsiz tek üreticili halka; yuva ve etiket dizileri ayrı */
+typedef struct {
+    uint8_t  *slots;
+    uint8_t  *meta;
+    uint32_t  slot_size, meta_size, cap;
+    volatile uint64_t wr;      /* yazımına başlanan (üzerine yazma sınırı) */
+    volatile uint64_t wi;      /* tamamlanan */
+} StageRing;
+
+typedef struct StageHost StageHost;
+
+typedef struct {
+    const StageDesc *d;
+    void            *ctx;
+    StageHost       *host;
+    volatile uint64_t rd_iq, rd_row;   /* sonraki okunacak (kayıpsızda üreticiyi sınırlar) */
+    Thread           thread;
+    volatile int     alive;
+    Stats            stats;    /* STAT_H_STAGE_*, STAT_C_STAGE_* */
+} StageInst;
+
+struct StageHost {
+    StageInst  st[STAGE_MAX];
+    int        n;
+    uint32_t   wants;          /* örneklerin birleşik STAGE_WANT_* */
+    StageRing  iq, rows;
+    Stats     *pipe_stats;     /* giriş kayıpları (STAT_C_STAGE_DROPS) */
+    Mutex      cs;
+    Cond       cv;             /* yeni veri → uyuyan aşamalar */
+    volatile uint32_t sleepers;
+};
+
+/* ── Süreç kayıt defteri (hatlar açılmadan önce) ─────────────── */
+
+/* Derlenmiş aşama ekle; args örneklere StageInfo.args olarak geçer. 0 / -1 */
+int  stage_register(const StageDesc *d, const char *args);
+
+/* "yol[,argüman]": paylaşılan kütüphaneyi aç, STAGE_ENTRY_SYMBOL ile kaydet */
+int  stage_load(const char *spec);
+
+int  stage_registered(void);
+
+/* ── Hat başına barındırıcı ──────────────────────────────────── */
+
+/*
+ * Her kayıtlı aşamanın örneğini aç; aşama yoksa halkalar ayrılmaz. 0 / -1.
+ * -1'de de barındırıcı boş ama geçerlidir: stage_host_free çağrılmalıdır.
+ */
+int  stage_host_init(StageHost *h, const char *pipe_name, const char *tag,
+                     const char *out_dir, Stats *pipe_stats);
+void stage_host_start(StageHost *h);
+/* Thread'leri durdur: kayıpsız aşamalar halkada kalanı bitirir */
+void stage_host_stop (StageHost *h);
+void stage_host_free (StageHost *h);   /* close çağrılır */
+
+/* Üreticiler (USB / DSP thread'i); aşama yoksa hiçbir şey yapmaz */
+void stage_push_block(StageHost *h, const uint8_t *raw, const SdrBlockMeta *m);
+void stage_push_row  (StageHost *h, const float *psd, const StageRowMeta *r);
+
+/* [{"name":..., "mode":..., "stats":{...}}, ...] dizisi */
+void stage_write_json(FILE *fp, const StageHost *h);
@@ -0,0 +1,72 @@
+#pragma once
+/* stage_api.h — DSP aşama eklentisi arayüzü (eklenti yazarları yalnız bunu içerir)
+ *
+ * Bir aşama her hattın ham IQ bloklarını ve/veya PSD satırlarını kendi
+ * thread'inde alır. Veriler kopyalanmaz: on_block / on_row'a verilen
+ * işaretçiler hattın ortak halkasındaki yuvaları gösterir (salt okunur) ve
+ * yalnız çağrı süresince geçerlidir; saklanacaksa aşama kendisi kopyalar.
+ *
+ *   STAGE_LOSSLESS     aşamanın okumadığı yuvanın üzerine yazılmaz. Aşama
+ *                      geride kalırsa halka dolar ve YENİ bloklar girişte
+ *                      atılır (tüm aşamalar için; hattın stage_drops sayacı).
+ *                      Atlama etiketteki sample sırasından görülür.
+ *   STAGE_BEST_EFFORT  üreticiyi hiç tutmaz. Geride kalan aşama en yeni
+ *                      bloklara atlar (skipped); çağrı sürerken yuvanın
+ *                      üzerine yazıldıysa torn sayılır.
+ *
+ * Paylaşılan kütüphane olarak yükleme (-L yol[,argüman]): kütüphane
+ * STAGE_ENTRY_SYMBOL adıyla const StageDesc * döndüren bir işlev dışa
+ * aktarır. Örnek: tools/stage_example.c.
+ *
+ *   STAGE_EXPORT const StageDesc *radar_stage_entry(void) { return &MY_STAGE; }
+ */
+
+#include <stdint.h>
+#include "blockmeta.h"   /* SdrBlockMeta */
+
+#define STAGE_API_VERSION   1
+#define STAGE_ENTRY_SYMBOL  "radar_stage_entry"
+
+#ifdef _WIN32
+#define STAGE_EXPORT __declspec(dllexport)
+#else
+#define STAGE_EXPORT __attribute__((visibility("default")))
+#endif
+
+enum { STAGE_LOSSLESS = 0, STAGE_BEST_EFFORT = 1 };
+enum { STAGE_WANT_IQ = 1u, STAGE_WANT_PSD = 2u };
+
+/* Aşama örneği açılırken verilen bilgiler (hat başına bir örnek) */
+typedef struct {
+    int         api_version;
+    const char *pipe_name;     /* "#0", "SN:xxxx", "TCP host:port" */
+    const char *tag;           /* dosya adı etiketi (recorder ile aynı) */
+    const char *out_dir;       /* kayıt dizini */
+    const char *args;          /* -L yol,argüman kısmı ("" olabilir) */
+    uint32_t    block_samples; /* on_block: IQ çifti (uint8 I,Q, 127.5 ortalı) */
+    uint32_t    row_bins;      /* on_row: dB değerleri, negatif → pozitif frekans */
+} StageInfo;
+
+/* PSD satırının etiketi */
+typedef struct {
+    uint32_t seq;              /* hattın satır sayacı */
+    uint32_t bins;
+    double   center_hz, span_hz;
+    uint64_t t_us;             /* satırın en yeni bloğunun varışı (stats_now_us) */
+} StageRowMeta;
+
+typedef struct {
+    int         api_version;   /* STAGE_API_VERSION */
+    const char *name;
+    int         mode;          /* STAGE_LOSSLESS / STAGE_BEST_EFFORT */
+    uint32_t    wants;         /* STAGE_WANT_* bitleri */
+
+    /* Hat başına bir kez; dönen bağlam diğer çağrılara geçer. NULL = açılamadı. */
+    void *(*open)(const StageInfo *info);
+    /* Aşamanın kendi thread'inden; NULL olabilir (wants ile uyumlu olmalı) */
+    void  (*on_block)(void *ctx, const uint8_t *iq, const SdrBlockMeta *m);
+    void  (*on_row)  (void *ctx, const float *psd, const StageRowMeta *r);
+    void  (*close)(void *ctx);
+} StageDesc;
+
+typedef const StageDesc *(*StageEntryFn)(void);
@@ -0,0 +1,101 @@
+#pragma once
+/* stats.h — Düşük maliyetli hat ölçümleri: sayaçlar ve gecikme histogramları
+ *
+ * Tüm güncellemeler kilitsizdir (GCC __atomic, relaxed) ve USB callback'i
+ * dahil her thread'den çağrılabilir. Histogramlar sabit kovalıdır: her
+ * ikilik aralık 4 alt kovaya bölünür (~%19 çözünürlük), 1 µs .. ~35 dk.
+ *
+ * Zaman damgaları:
+ *   varış     — on_pipe_data (USB / rtl_tcp callback'i)
+ *   DSP sonu  — emit_row (satır yayınlandı)
+ *   ekran     — render_present sonrası (GUI), "örnekten fotona" gecikme
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define STATS_BUCKETS 128
+
+typedef enum {
+    STAT_H_XFER_GAP,    /* ardışık iki USB aktarımı (callback) arası */
+    STAT_H_CB_GAP,      /* ardışık iki blok varışı arası */
+    STAT_H_CB_TIME,     /* callback içinde geçen süre */
+    STAT_H_IQCORR,      /* iqcorr_process (callback içinde, blok başına) */
+    STAT_H_QUEUE,       /* varış → DSP kuyruktan alma */
+    STAT_H_FFT,         /* fft_compute_power */
+    STAT_H_FINE_FFT,    /* ince çözünürlük büyük FFT'si (satır başına bir) */
+    STAT_H_MRES,        /* mres_feed + düzey satırları (blok başına, düzey varsa) */
+    STAT_H_CHAN,        /* chan_feed (kanal ayırıcı, kanal varsa) */
+    STAT_H_DEMOD,       /* demod thread'inde blok başına (kanal + ses) */
+    STAT_H_DEMOD_LAT,   /* ses çıkış bloğunun en eski örneğinin varışı → çıkışa yazıldı */
+    STAT_H_ROW,         /* satır işleme (dedektör + iz + şelale) */
+    STAT_H_DSP_LAT,     /* satırın en yeni bloğunun varışı → satır hazır */
+    STAT_H_RETUNE,      /* ayar isteği → yeni ayarın ilk geçerli satırı */
+    STAT_H_E2E,         /* aynı varış → render_present (örnekten fotona) */
+    STAT_H_RENDER_WF,   /* render_waterfall */
+    STAT_H_FRAME,       /* bir GUI karesinin çizimi (present hariç) */
+    STAT_H_PRESENT,     /* render_present (VSYNC beklemesi dahil) */
+    STAT_H_STAGE_BLOCK, /* aşama on_block çağrısı (aşama başına Stats) */
+    STAT_H_STAGE_ROW,   /* aşama on_row çağrısı */
+    STAT_H_STAGE_LAG,   /* varış → aşamanın bloğu alması */
+    STAT_H_COUNT
+} StatHistId;
+
+typedef enum {
+    STAT_C_XFERS,       /* gelen USB aktarımı (birden çok blok taşır) */
+    STAT_C_BLOCKS,      /* gelen blok */
+    STAT_C_REC_DROPS,   /* kayıt halkası doluyken atılan blok */
+    STAT_C_Q_DROPS,     /* DSP kuyruğu doluyken atılan blok */
+    STAT_C_DEMOD_DROPS, /* demod halkası doluyken atılan blok */
+    STAT_C_ROWS,        /* üretilen satır */
+    STAT_C_MRES_ROWS,   /* ek çözünürlük düzeylerinin ürettiği satır (toplam) */
+    STAT_C_SETTLE,      /* eski ayar / oturma nedeniyle DSP'de atılan blok */
+    STAT_C_VIEW_STALE,  /* GUI karesinde yeni satır yoktu */
+    STAT_C_FRAMES,      /* çizilen GUI karesi */
+    STAT_C_STAGE_DROPS, /* kayıpsız aşama halkası doluyken girişte atılan blok / satır */
+    STAT_C_STAGE_BLOCKS,/* aşamaya verilen blok (aşama başına Stats) */
+    STAT_C_STAGE_ROWS,  /* aşamaya verilen satır */
+    STAT_C_STAGE_SKIP,  /* en iyi çaba aşaması geride kaldığı için atlanan */
+    STAT_C_STAGE_TORN,  /* çağrı sürerken üzerine yazılan yuva */
+    STAT_C_COUNT
+} StatCounterId;
+
+typedef struct {
+    volatile uint64_t count, sum_us, max_us;
+    volatile uint64_t bucket[STATS_BUCKETS];
+} StatHist;
+
+typedef struct {
+    StatHist          h[STAT_H_COUNT];
+    volatile uint64_t c[STAT_C_COUNT];
+} Stats;
+
+/* Monoton saat, µs */
+uint64_t stats_now_us(void);
+
+void stats_reset(Stats *s);
+
+static inline void stats_inc(Stats *s, StatCounterId id) {
+    __atomic_fetch_add(&s->c[id], 1, __ATOMIC_RELAXED);
+}
+static inline void stats_add(Stats *s, StatCounterId id, uint64_t n) {
+    __atomic_fetch_add(&s->c[id], n, __ATOMIC_RELAXED);
+}
+static inline uint64_t stats_get(const Stats *s, StatCounterId id) {
+    return __atomic_load_n(&s->c[id], __ATOMIC_RELAXED);
+}
+
+/* Süreyi histograma ekle */
+void stats_record(Stats *s, StatHistId id, uint64_t us);
+
+/* t0'dan şimdiye geçen süreyi ekle, şimdiki zamanı döndür (zincirleme ölçüm için) */
+uint64_t stats_since(Stats *s, StatHistId id, uint64_t t0);
+
+/* Yüzdelik (0..1) — kova üst sınırı, µs. Örnek yoksa 0. */
+double stats_percentile(const StatHist *h, double p);
+
+const char *stats_hist_name   (StatHistId id);
+const char *stats_counter_name(StatCounterId id);
+
+/* Tek bir Stats'ı JSON nesnesi olarak yaz (boş histogramlar atlanır) */
+void stats_write_json(FILE *fp, const Stats *s);
@@ -0,0 +1,118 @@
+#pragma once
+/* sweep.h — Geniş bant tarama: ardışık ayar noktalarını tek panoramik spektruma birleştirir
+ *
+ * Çalışma şekli:
+ *   - [f_start, f_stop] aralığı, her biri sample_rate genişliğinde örtüşen
+ *     adımlara (hop) bölünür. Her adımda yalnızca bandın ortadaki
+ *     SWEEP_USABLE kadarı kullanılır (kenarlardaki filtre düşümü atılır).
+ *   - Yeniden ayardan sonra, blok etiketi ayarın kuşağına ulaşana ve
+ *     settling bayrağı düşene dek bloklar atılır (USB'de bekleyen eski
+ *     frekans verisi + PLL oturma süresi). Kaç blok atılacağını SDR katmanı
+ *     belirler; sabit bir sayaç tahmin edilmez.
+ *   - Ardından dwell_blocks blok doğrusal güçte ortalanır.
+ *   - Panoramik bin birçok FFT bin'ini kapsar (24-1700 MHz'de ~100): bin
+ *     başına en güçlü FFT bin'i tutulur, dar taşıyıcı ortalamayla
+ *     seyrelmez (ortalamada ~20 dB kaybolurdu). Ayrıca komşu adımların
+ *     örtüşen kenarları doğrusal ağırlıkla çapraz geçişle (crossfade)
+ *     ortalanır: gürültü tabanı kestirimi bu ortalamadan yapılır.
+ *   - Adım sırası her taramada yön değiştirir (yılan düzeni): tarama sonunda
+ *     başa uzun bir atlama yapılmaz, son adım bir sonraki taramanın ilk
+ *     adımı olur ve yeniden ayar gerekmez.
+ *
+ * Ayar işlevi (tune) bir işlev işaretçisidir; gerçek cihazda sdr_set_freq'e,
+ * testte ise benzetilmiş bir tuner'a bağlanabilir. Yeni ayarın kuşağını
+ * döndürür; 0 dönerse (kuşak bilinmiyor) settle_blocks kadar blok atılır.
+ */
+
+#include <stdint.h>
+#include "fft.h"         /* FFT_SIZE için */
+#include "thread.h"
+#include "blockmeta.h"   /* SdrBlockMeta */
+
+#define SWEEP_PANO_BINS      8192    /* panoramik tampon üst sınırı */
+#define SWEEP_MAX_HOPS       2048
+#define SWEEP_USABLE         0.75f   /* adım başına kullanılan bant oranı */
+#define SWEEP_OVERLAP        0.10f   /* komşu adımların en az örtüşmesi (sr oranı) */
+#define SWEEP_SETTLE_BLOCKS  72      /* dwell planı için tahmin: 2 x 64 KB aktarım + PLL */
+#define SWEEP_MIN_DWELL      16
+
+/*
+ * Yeni merkez frekansı uygula (Hz), ayar kuşağını döndür. sweep_feed /
+ * sweep_start içinden, yani DSP veya GUI thread'inden çağrılır. USB async
+ * callback'inden çağrılmamalıdır: sdr_set_freq eşzamanlı kontrol aktarımı
+ * yapar ve librtlsdr'nin olay döngüsü o callback'te beklerken kilitlenir.
+ */
+typedef uint32_t (*SweepTuneFn)(uint32_t hz, void *userdata);
+
+typedef struct {
+    /* ── Yapılandırma ─────────────────────────────────────────── */
+    uint32_t    f_start, f_stop;   /* Hz */
+    uint32_t    sample_rate;
+    int         settle_blocks;     /* oturma tahmini (dwell planı; kuşaksız tuner'da atılan blok) */
+    int         dwell_blocks;      /* adım başına ortalanan PSD sayısı */
+    SweepTuneFn tune;
+    void       *tune_ud;
+
+    /* ── Plan ─────────────────────────────────────────────────── */
+    uint32_t hops[SWEEP_MAX_HOPS];
+    int      n_hops;
+    int      n_bins;               /* panoramik çözünürlük (≤ SWEEP_PANO_BINS) */
+    float    weight[FFT_SIZE];     /* adım içi bin ağırlıkları (crossfade) */
+
+    /* ── Çalışma durumu (DSP thread'i) ────────────────────────── */
+    volatile int active;
+    int      hop_pos;              /* bu taramadaki adım sırası */
+    int      dir;                  /* +1 artan, -1 azalan */
+    uint32_t cur_freq;             /* en son ayarlanan frekans */
+    uint32_t want_gen;             /* bu kuşaktan eski bloklar atılır (0 = skip sayacı) */
+    int      skip;                 /* kuşaksız tuner: atılacak kalan blok */
+    int      acc_n;
+    float    acc[FFT_SIZE];        /* adım içi doğrusal güç toplamı */
+    float    pano_pwr[SWEEP_PANO_BINS];   /* ağırlıklı ortalama (taban) */
+    float    pano_w  [SWEEP_PANO_BINS];
+    float    pano_max[SWEEP_PANO_BINS];   /* bin içindeki en güçlü FFT bin'i */
+    uint64_t sweep_samples;        /* bu taramada tüketilen örnek sayısı */
+
+    /* ── Yayın (GUI thread okur) ──────────────────────────────── */
+    float    pano_db[SWEEP_PANO_BINS];     /* en büyük (gösterim, dedektör) */
+    float    pano_mean[SWEEP_PANO_BINS];   /* doğrusal ortalama (gürültü tabanı) */
+    volatile int fresh;
+    Mutex    cs;
+
+    /* ── Ölçümler ─────────────────────────────────────────────── */
+    uint32_t sweeps;               /* tamamlanan tarama sayısı */
+    double   sweep_s;              /* son taramanın süresi (örnek zamanı) */
+    double   rate_mhz_s;           /* son taramanın hızı */
+    uint32_t retunes;
+    uint32_t settle_skipped;       /* son taramada oturma için atılan blok */
+    uint32_t skipped_cur;
+} Sweep;
+
+/* sweep_init: yapıyı sıfırla, ayar işlevini bağla (program başında bir kez) */
+void sweep_init(Sweep *w, SweepTuneFn tune, void *userdata);
+void sweep_free(Sweep *w);
+
+/*
+ * sweep_start: [f_start, f_stop] için adım planını kur ve ilk adıma ayarla.
+ * Çalışan bir tarama varsa yeniden başlatılır. Başarılıysa 0, aralık
+ * geçersizse -1.
+ */
+int  sweep_start(Sweep *w, uint32_t f_start, uint32_t f_stop, uint32_t sample_rate);
+void sweep_stop (Sweep *w);
+
+/*
+ * sweep_feed: DSP thread'inden her ham blok + etiketiyle çağrılır (FFT_SIZE*2
+ * bayt). Adım bitince tune'u çağırdığından USB callback'inden çağrılmaz.
+ */
+void sweep_feed(Sweep *w, const uint8_t *raw, const SdrBlockMeta *meta);
+
+/*
+ * sweep_pop_row: yeni tamamlanmış bir tarama varsa panoramik spektrumu
+ * n_out sütuna (dB) indirger (sütun başına en büyük değer) ve 1 döner.
+ * mean NULL değilse aynı sütunların ortalama gücü (dB) de yazılır.
+ * Yeni tarama yoksa 0 döner.
+ */
+int  sweep_pop_row(Sweep *w, float *out, float *mean, int n_out);
+
+/* Geçerli taramanın ilerlemesi (0..1) */
+float sweep_progress(const Sweep *w);
@@ -0,0 +1,84 @@
+#pragma once
+/* thread.h — İnce taşınabilir thread / kilit / koşul değişkeni / atomik katmanı
+ *
+ * Windows'ta Win32 (CreateThread, CRITICAL_SECTION, CONDITION_VARIABLE),
+ * diğer sistemlerde POSIX (pthread) üzerine oturur. Türler yapıların içine
+ * gömülebilsin diye başlıkta tanımlıdır; platform başlıkları yalnızca
+ * burada eklenir.
+ *
+ * Gerçek zamanlı seçenekler (ThreadOpts):
+ *   cpu      — thread'i tek çekirdeğe sabitle (-1 = serbest)
+ *   rt_prio  — Linux: SCHED_FIFO önceliği (1..99, 0 = normal zamanlayıcı).
+ *              CAP_SYS_NICE / rtprio limiti yoksa uyarı basılır ve thread
+ *              normal öncelikte devam eder.
+ *              Windows: > 0 ise THREAD_PRIORITY_TIME_CRITICAL.
+ * Seçenekler thread'in kendi içinde, kullanıcı işlevinden önce uygulanır.
+ */
+
+#include <stdint.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#define PATH_SEP "\\"
+#else
+#include <pthread.h>
+#define PATH_SEP "/"
+#endif
+
+/* ── Türler ───────────────────────────────────────────────────── */
+typedef void (*ThreadFn)(void *arg);
+
+typedef struct {
+    int cpu;        /* -1 = serbest */
+    int rt_prio;    /* 0 = normal */
+} ThreadOpts;
+
+#ifdef _WIN32
+typedef struct { HANDLE h; }              Thread;
+typedef struct { CRITICAL_SECTION cs; }   Mutex;
+typedef struct { CONDITION_VARIABLE cv; } Cond;
+#else
+typedef struct { pthread_t t; int live; } Thread;
+typedef struct { pthread_mutex_t m; }     Mutex;
+typedef struct { pthread_cond_t c; }      Cond;
+#endif
+
+/* ── Thread ───────────────────────────────────────────────────── */
+/* fn(arg)'ı yeni thread'de başlat; opts NULL olabilir. Başarılıysa 0. */
+int  thread_start(Thread *t, ThreadFn fn, void *arg, const ThreadOpts *opts);
+
+/* Thread bitene dek bekle ve kaynaklarını bırak. Başlatılmamışsa bir şey yapmaz. */
+void thread_join(Thread *t);
+
+/* Çağıran thread'e seçenekleri uygula (ör. kütüphane thread'leri için) */
+void thread_apply_opts(const ThreadOpts *opts);
+
+void sleep_ms(uint32_t ms);
+
+/* Duvar saati, epoch ms */
+uint64_t wall_ms(void);
+
+/* Çevrimiçi mantıksal çekirdek sayısı (en az 1) */
+int cpu_count(void);
+
+/* ── Kilit (özyinelemeli; CRITICAL_SECTION ile aynı anlam) ───── */
+void mutex_init  (Mutex *m);
+void mutex_free  (Mutex *m);
+void mutex_lock  (Mutex *m);
+void mutex_unlock(Mutex *m);
+
+/* ── Koşul değişkeni ──────────────────────────────────────────── */
+void cond_init     (Cond *c);
+void cond_free     (Cond *c);
+void cond_signal   (Cond *c);
+void cond_broadcast(Cond *c);
+
+/* m kilitliyken çağrılır; sinyal gelirse 1, ms dolarsa 0 döner */
+int  cond_wait_ms(Cond *c, Mutex *m, uint32_t ms);
+
+/* ── Atomikler (GCC / Clang yerleşikleri, iki platformda aynı) ── */
+#define ATOMIC_LOAD(p)       __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define ATOMIC_STORE(p, v)   __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define ATOMIC_ADD(p, v)     __atomic_add_fetch((p), (v), __ATOMIC_ACQ_REL)
+#define ATOMIC_LOAD_RLX(p)   __atomic_load_n((p), __ATOMIC_RELAXED)
+#define ATOMIC_ADD_RLX(p, v) __atomic_add_fetch((p), (v), __ATOMIC_RELAXED)
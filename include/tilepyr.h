@@ -0,0 +1,104 @@
+#pragma once
+/* tilepyr.h — Kayıt spektrogramı için çok çözünürlüklü döşeme piramidi
+ *
+ * Saatlerce süren bir iq_*.bin kaydının genel görünümü tools/spec_tiles ile
+ * çevrimdışı üretilir; GUI dosyayı belleğe eşler ve kaydırma / yakınlaştırma
+ * sırasında yalnızca ekrandaki hücreleri okur (hesap yok, anında).
+ *
+ * Düzeyler:
+ *   0      tam çözünürlük: satır = avg_blocks bloğun ortalama gücü, FFT_SIZE bin
+ *   L > 0  L-1'in 2×2 (zaman × frekans) en büyüğü; bin sayısı PYR_MIN_BINS'e
+ *          inince yalnız zaman yarılanır. Tepe indirgemesi kısa / dar
+ *          sinyallerin uzak görünümde kaybolmasını önler.
+ *
+ * Hücre: uint8, dB = PYR_DB_MIN + v * PYR_DB_STEP (0.5 dB; en büyük ile
+ * karşılaştırma nicemlenmiş değerde de aynı sonucu verir).
+ *
+ * Dosya düzeni (yerel bayt sırası, x86 / ARM küçük sonlu):
+ *   PyrHeader (PYR_DATA_OFF baytına kadar) | düzey 0 döşemeleri | düzey 1 | ...
+ * Her düzey, satır-öncelikli döşeme ızgarasıdır; döşeme PYR_TILE_ROWS satır ×
+ * tile_w bin (tile_w = min(PYR_TILE_BINS, bins)) ve kendi içinde satır
+ * önceliklidir. Son döşeme satırı tam boyda tutulur (artık satırlar 0).
+ */
+
+#include <stdint.h>
+
+#define PYR_MAGIC       0x31525950u   /* "PYR1" */
+#define PYR_VERSION     1
+#define PYR_MAX_LEVELS  32
+#define PYR_TILE_ROWS   256
+#define PYR_TILE_BINS   256
+#define PYR_MIN_BINS    16
+#define PYR_DB_MIN      (-40.0f)
+#define PYR_DB_STEP     0.5f
+#define PYR_DATA_OFF    4096u
+
+typedef struct {
+    uint64_t rows;           /* düzeydeki satır */
+    uint64_t off;            /* dosya başından bayt ofseti */
+    uint32_t bins;
+    uint32_t tile_w;         /* döşeme genişliği (bin) */
+} PyrLevel;
+
+typedef struct {
+    uint32_t magic, version;
+    uint32_t fft_size;
+    uint32_t avg_blocks;     /* düzey 0 satırı başına blok */
+    uint32_t sample_rate;
+    uint32_t center_hz;      /* 0 = bilinmiyor */
+    uint32_t n_levels;
+    uint32_t _pad;
+    uint64_t total_bytes;
+    PyrLevel level[PYR_MAX_LEVELS];
+} PyrHeader;
+
+/* ── Dosya eşleme (Windows: CreateFileMapping, diğerleri: mmap) ─── */
+typedef struct {
+    uint8_t *base;
+    uint64_t size;
+    void    *h_file, *h_map;  /* yalnız Windows */
+} FileMap;
+
+/* create_size 0: salt okunur aç; aksi halde o boyda oluştur, yazılabilir */
+int  filemap_open (FileMap *m, const char *path, uint64_t create_size);
+void filemap_close(FileMap *m);
+
+/* ── Düzen ───────────────────────────────────────────────────── */
+/* rows0 satırlık düzey 0'dan başlayarak düzeyleri ve ofsetleri doldur */
+void pyr_layout(PyrHeader *h, uint64_t rows0, uint32_t fft_size);
+
+static inline uint8_t *pyr_cell_ptr(uint8_t *base, const PyrHeader *h,
+                                    int lv, uint64_t row, uint32_t bin) {
+    const PyrLevel *L = &h->level[lv];
+    uint64_t tiles_x = L->bins / L->tile_w;
+    uint64_t tile    = (row / PYR_TILE_ROWS) * tiles_x + bin / L->tile_w;
+    return base + L->off + tile * PYR_TILE_ROWS * L->tile_w +
+           (row % PYR_TILE_ROWS) * L->tile_w + bin % L->tile_w;
+}
+
+static inline uint8_t pyr_quant(float db) {
+    float v = (db - PYR_DB_MIN) / PYR_DB_STEP + 0.5f;
+    if (v < 0.0f)   v = 0.0f;
+    if (v > 255.0f) v = 255.0f;
+    return (uint8_t)v;
+}
+
+static inline float pyr_db(uint8_t v) { return PYR_DB_MIN + v * PYR_DB_STEP; }
+
+/* ── Okuyucu (GUI) ───────────────────────────────────────────── */
+typedef struct {
+    FileMap          map;
+    const PyrHeader *hdr;
+} TilePyr;
+
+int  pyr_open (TilePyr *p, const char *path);   /* başarılıysa 0 */
+void pyr_close(TilePyr *p);
+
+/*
+ * Görüntü penceresi: düzey 0 satır [t0, t1) × bin [b0, b1). Genişliği w,
+ * yüksekliği h piksel olan alana, piksel başına en çok ~32 hücre
+ * okunacak en ince düzeyi seçip her pikselin tepe değerini out'a
+ * (w*h, satır öncelikli, üst satır = t0) yazar.
+ */
+void pyr_render(const TilePyr *p, double t0, double t1, double b0, double b1,
+                int w, int h, uint8_t *out);
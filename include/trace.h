@@ -0,0 +1,43 @@
+#pragma once
+/* trace.h — Kalıcı spektrum izleri: max-hold, min-hold, EMA ortalama, tepe-düşüş
+ *
+ * Her yeni PSD satırında tek bir geçişle dört iz birlikte güncellenir
+ * (dal içermeyen döngü, derleyici SIMD'e çevirir). Sıfırlama O(1)'dir:
+ * yalnızca bir bayrak temizlenir, sonraki satır tüm izleri yeniden tohumlar.
+ * Ortalama dB alanında alınır (analizörlerdeki "video averaging").
+ */
+
+#include <stdint.h>
+#include "fft.h"   /* FFT_SIZE için */
+
+typedef enum {
+    TRACE_MAX = 0,
+    TRACE_MIN,
+    TRACE_AVG,
+    TRACE_PEAK,
+    TRACE_COUNT
+} TraceKind;
+
+typedef struct {
+    float    max_db [FFT_SIZE];
+    float    min_db [FFT_SIZE];
+    float    avg_db [FFT_SIZE];
+    float    peak_db[FFT_SIZE];
+
+    float    tau_s;        /* EMA zaman sabiti (s) */
+    float    decay_db_s;   /* tepe izinin düşüş hızı (dB/s) */
+    uint32_t shown;        /* (1 << TraceKind) bitleri: çizilecek izler */
+    int      seeded;       /* 0 → sonraki satır izleri başlatır */
+    uint32_t rows;         /* son sıfırlamadan beri satır sayısı */
+} TraceSet;
+
+void trace_init (TraceSet *t);
+
+/* Anında sıfırlama: geçmişten yeniden hesap yok */
+void trace_reset(TraceSet *t);
+
+/* Yeni satırla güncelle; dt_s önceki satırdan geçen süre */
+void trace_update(TraceSet *t, const float *psd, float dt_s);
+
+const float *trace_get(const TraceSet *t, TraceKind k);
+const char  *trace_name(TraceKind k);
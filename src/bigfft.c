@@ -0,0 +1,296 @@
+/* bigfft.c — Çok thread'li büyük FFT (four-step), ince çözünürlük modu */
+#include "bigfft.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define TW_LO_BITS 10   /* W_n^m = tw_hi[m >> 10] · tw_lo[m & 1023] */
+#define TW_LO      (1 << TW_LO_BITS)
+
+enum { PH_COLS, PH_ROWS, PH_OUT };
+
+typedef struct {
+    BigFft *b;
+    int     idx;      /* 0 = çağıran thread */
+} Worker;
+
+struct BigFft {
+    int       log2n, n, n1, n2;
+    int       n_thr;
+    float     scale;          /* güç: FFT_SIZE yoluna göre */
+    FftCpx   *x;              /* çalışma tamponu, n (A/B sonrası k1·n2 + k2) */
+    float    *win;            /* Hann, n */
+    FftCpx   *tw_lo, *tw_hi;
+    FftCpx   *scratch;        /* thread başına BIGFFT_COLS × n1 */
+
+    /* ── Geçerli iş (run_phase ile) ───────────────────────────── */
+    int             phase;
+    const FftCpx   *src_c;
+    const uint8_t  *src_u8;
+    FftCpx         *dst_c;
+    float          *dst_p;
+    uint32_t        n_items;
+    volatile uint32_t next;
+
+    /* ── Havuz ────────────────────────────────────────────────── */
+    Thread    th[BIGFFT_MAX_THREADS];
+    Worker    w[BIGFFT_MAX_THREADS];
+    Mutex     cs;
+    Cond      go, done;
+    uint32_t  epoch;
+    int       active;         /* adımı bitirmemiş havuz thread'i */
+    int       alive;
+};
+
+static inline FftCpx cmul(FftCpx a, FftCpx b) {
+    return (FftCpx){ a.r * b.r - a.i * b.i, a.r * b.i + a.i * b.r };
+}
+
+static inline FftCpx twiddle(const BigFft *b, uint32_t m) {
+    return cmul(b->tw_hi[m >> TW_LO_BITS], b->tw_lo[m & (TW_LO - 1)]);
+}
+
+/* ── Adımlar ──────────────────────────────────────────────────── */
+
+/* A: BIGFFT_COLS sütunu topla (pencere burada), n1 FFT, düzeltme, yerine yaz */
+static void do_cols(BigFft *b, uint32_t u, int t) {
+    const int n1 = b->n1, n2 = b->n2, j0 = (int)u * BIGFFT_COLS;
+    FftCpx *s = b->scratch + (size_t)t * BIGFFT_COLS * n1;
+
+    for (int j1 = 0; j1 < n1; j1++) {
+        size_t base = (size_t)j1 * n2 + j0;
+        if (b->src_u8) {
+            const uint8_t *raw = b->src_u8 + 2 * base;
+            const float   *w   = b->win + base;
+            for (int c = 0; c < BIGFFT_COLS; c++) {
+                s[c * n1 + j1].r = ((float)raw[2*c]     - 127.5f) / 128.0f * w[c];
+                s[c * n1 + j1].i = ((float)raw[2*c + 1] - 127.5f) / 128.0f * w[c];
+            }
+        } else {
+            for (int c = 0; c < BIGFFT_COLS; c++)
+                s[c * n1 + j1] = b->src_c[base + c];
+        }
+    }
+    for (int c = 0; c < BIGFFT_COLS; c++) {
+        FftCpx  *col = s + c * n1;
+        uint32_t j2  = (uint32_t)(j0 + c);
+        fft_cpx(col, n1, 0);
+        for (int k1 = 1; k1 < n1; k1++)
+            col[k1] = cmul(col[k1], twiddle(b, j2 * (uint32_t)k1));
+    }
+    for (int k1 = 0; k1 < n1; k1++) {
+        FftCpx *row = b->x + (size_t)k1 * n2 + j0;
+        for (int c = 0; c < BIGFFT_COLS; c++)
+            row[c] = s[c * n1 + k1];
+    }
+}
+
+/* C: x[k1·n2 + k2] = X[k1 + n1·k2]; BIGFFT_COLS k2 birlikte, çıkışta sıralı akışlar */
+static void do_out(BigFft *b, uint32_t u) {
+    const int n1 = b->n1, n2 = b->n2, k0 = (int)u * BIGFFT_COLS;
+    const uint32_t mask = (uint32_t)b->n - 1, half = (uint32_t)b->n / 2;
+    for (int k1 = 0; k1 < n1; k1++) {
+        const FftCpx *row = b->x + (size_t)k1 * n2 + k0;
+        for (int c = 0; c < BIGFFT_COLS; c++) {
+            uint32_t k = (uint32_t)k1 + (uint32_t)n1 * (uint32_t)(k0 + c);
+            if (b->dst_p)
+                b->dst_p[(k + half) & mask] =
+                    (row[c].r * row[c].r + row[c].i * row[c].i) * b->scale;
+            else
+                b->dst_c[k] = row[c];
+        }
+    }
+}
+
+static void run_units(BigFft *b, int t) {
+    for (;;) {
+        uint32_t u = __atomic_fetch_add(&b->next, 1, __ATOMIC_RELAXED);
+        if (u >= b->n_items) break;
+        switch (b->phase) {
+        case PH_COLS: do_cols(b, u, t); break;
+        case PH_ROWS: fft_cpx(b->x + (size_t)u * b->n2, b->n2, 0); break;
+        default:      do_out(b, u); break;
+        }
+    }
+}
+
+static void worker_fn(void *arg) {
+    Worker  *w = (Worker *)arg;
+    BigFft  *b = w->b;
+    uint32_t seen = 0;
+    for (;;) {
+        mutex_lock(&b->cs);
+        while (b->alive && b->epoch == seen)
+            cond_wait_ms(&b->go, &b->cs, 200);
+        if (!b->alive) {
+            mutex_unlock(&b->cs);
+            break;
+        }
+        seen = b->epoch;
+        mutex_unlock(&b->cs);
+
+        run_units(b, w->idx);
+
+        mutex_lock(&b->cs);
+        if (--b->active == 0) cond_signal(&b->done);
+        mutex_unlock(&b->cs);
+    }
+}
+
+/* Adımı havuza dağıt; çağıran da katılır, hepsi bitince döner */
+static void run_phase(BigFft *b, int phase, uint32_t items) {
+    mutex_lock(&b->cs);
+    b->phase   = phase;
+    b->n_items = items;
+    b->next    = 0;
+    b->active  = b->n_thr - 1;
+    b->epoch++;
+    cond_broadcast(&b->go);
+    mutex_unlock(&b->cs);
+
+    run_units(b, 0);
+
+    mutex_lock(&b->cs);
+    while (b->active)
+        cond_wait_ms(&b->done, &b->cs, 100);
+    mutex_unlock(&b->cs);
+}
+
+static void transform(BigFft *b) {
+    run_phase(b, PH_COLS, (uint32_t)(b->n2 / BIGFFT_COLS));
+    run_phase(b, PH_ROWS, (uint32_t)b->n1);
+    run_phase(b, PH_OUT,  (uint32_t)(b->n2 / BIGFFT_COLS));
+}
+
+/* ── Genel API ────────────────────────────────────────────────── */
+
+BigFft *bigfft_create(int log2n, int threads) {
+    if (log2n < BIGFFT_MIN_LOG2 || log2n > BIGFFT_MAX_LOG2) {
+        fprintf(stderr, "[BIGFFT] Boy 2^%d..2^%d olmali (2^%d verildi)\n",
+                BIGFFT_MIN_LOG2, BIGFFT_MAX_LOG2, log2n);
+        return NULL;
+    }
+    if (threads <= 0) threads = cpu_count();
+    if (threads > BIGFFT_MAX_THREADS) threads = BIGFFT_MAX_THREADS;
+
+    BigFft *b = calloc(1, sizeof(*b));
+    if (!b) return NULL;
+    b->log2n = log2n;
+    b->n     = 1 << log2n;
+    b->n1    = 1 << (log2n / 2);        /* n1 <= n2: sütun FFT'si kısa olan */
+    b->n2    = b->n / b->n1;
+    b->n_thr = threads;
+    b->scale = (float)FFT_SIZE / (float)b->n;
+
+    int n_hi   = b->n >> TW_LO_BITS;
+    b->x       = malloc(sizeof(FftCpx) * (size_t)b->n);
+    b->win     = malloc(sizeof(float) * (size_t)b->n);
+    b->tw_lo   = malloc(sizeof(FftCpx) * TW_LO);
+    b->tw_hi   = malloc(sizeof(FftCpx) * (size_t)n_hi);
+    b->scratch = malloc(sizeof(FftCpx) * (size_t)threads * BIGFFT_COLS * b->n1);
+    if (!b->x || !b->win || !b->tw_lo || !b->tw_hi || !b->scratch) {
+        fprintf(stderr, "[BIGFFT] Bellek hatasi (2^%d)\n", log2n);
+        bigfft_free(b);
+        return NULL;
+    }
+
+    /* double ile: 2^20 noktada float açı hatası birkaç bin kayar */
+    for (int i = 0; i < b->n; i++)
+        b->win[i] = (float)(0.5 * (1.0 - cos(2.0 * M_PI * i / (b->n - 1))));
+    for (int m = 0; m < TW_LO; m++) {
+        double a = -2.0 * M_PI * m / b->n;
+        b->tw_lo[m] = (FftCpx){ (float)cos(a), (float)sin(a) };
+    }
+    for (int h = 0; h < n_hi; h++) {
+        double a = -2.0 * M_PI * ((double)h * TW_LO) / b->n;
+        b->tw_hi[h] = (FftCpx){ (float)cos(a), (float)sin(a) };
+    }
+
+    mutex_init(&b->cs);
+    cond_init(&b->go);
+    cond_init(&b->done);
+    b->alive = 1;
+    for (int t = 1; t < threads; t++) {
+        b->w[t] = (Worker){ b, t };
+        thread_start(&b->th[t], worker_fn, &b->w[t], NULL);
+    }
+    printf("[BIGFFT] 2^%d nokta (%d x %d), %d thread, %.1f MB\n", log2n, b->n1, b->n2,
+           threads, (b->n * (sizeof(FftCpx) + sizeof(float)) +
+                     (size_t)threads * BIGFFT_COLS * b->n1 * sizeof(FftCpx)) / 1048576.0);
+    return b;
+}
+
+void bigfft_free(BigFft *b) {
+    if (!b) return;
+    if (b->alive) {
+        mutex_lock(&b->cs);
+        b->alive = 0;
+        cond_broadcast(&b->go);
+        mutex_unlock(&b->cs);
+        for (int t = 1; t < b->n_thr; t++) thread_join(&b->th[t]);
+        cond_free(&b->done);
+        cond_free(&b->go);
+        mutex_free(&b->cs);
+    }
+    free(b->x);
+    free(b->win);
+    free(b->tw_lo);
+    free(b->tw_hi);
+    free(b->scratch);
+    free(b);
+}
+
+int bigfft_size(const BigFft *b)    { return b->n; }
+int bigfft_threads(const BigFft *b) { return b->n_thr; }
+
+void bigfft_forward(BigFft *b, const FftCpx *in, FftCpx *out) {
+    b->src_c  = in;
+    b->src_u8 = NULL;
+    b->dst_c  = out;
+    b->dst_p  = NULL;
+    transform(b);
+}
+
+void bigfft_power_u8(BigFft *b, const uint8_t *raw, float *pwr_out) {
+    b->src_c  = NULL;
+    b->src_u8 = raw;
+    b->dst_c  = NULL;
+    b->dst_p  = pwr_out;
+    transform(b);
+}
+
+void bigfft_decimate(const float *pwr, int lo, int hi, float *out, int cols, int peak) {
+    int64_t span = hi - lo;
+    for (int c = 0; c < cols; c++) {
+        int a = lo + (int)(span * c / cols);
+        int e = lo + (int)(span * (c + 1) / cols);
+        if (e <= a) e = a + 1;   /* sütun bin'den dar: en yakın bin */
+        float v = pwr[a];
+        if (peak) {
+            for (int k = a + 1; k < e; k++) if (pwr[k] > v) v = pwr[k];
+        } else {
+            for (int k = a + 1; k < e; k++) v += pwr[k];
+            v /= (float)(e - a);
+        }
+        out[c] = v;
+    }
+}
+
+int bigfft_parse_size(const char *s) {
+    char  *end;
+    double v = strtod(s, &end);
+    if (end == s || v <= 0.0) return -1;
+    if      (*end == 'k' || *end == 'K') v *= 1024.0;
+    else if (*end == 'm' || *end == 'M') v *= 1048576.0;
+    else if (*end != '\0') return -1;
+    else if (v <= 30.0) return ((int)v >= BIGFFT_MIN_LOG2 && (int)v <= BIGFFT_MAX_LOG2 &&
+                                v == (int)v) ? (int)v : -1;
+    for (int l = BIGFFT_MIN_LOG2; l <= BIGFFT_MAX_LOG2; l++)
+        if (v == (double)(1 << l)) return l;
+    return -1;
+}
@@ -0,0 +1,291 @@
+/* chan.c — Çok kanallı hızlı evrişim (overlap-save) kanal ayırıcı */
+#include "chan.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/* ── Filtre tasarımı ──────────────────────────────────────────── */
+
+/* Sıfırıncı dereceden değiştirilmiş Bessel (Kaiser penceresi için) */
+static double bessel_i0(double x) {
+    double s = 1.0, t = 1.0;
+    for (int k = 1; k < 32; k++) {
+        t *= (x / (2.0 * k)) * (x / (2.0 * k));
+        s += t;
+        if (t < 1e-12 * s) break;
+    }
+    return s;
+}
+
+/* CHAN_OVERLAP+1 katsayılı Kaiser penceresinin geçiş bandı genişliği (Hz) */
+static double kaiser_transition(uint32_t sr) {
+    return (CHAN_ATTEN_DB - 8.0) / (2.285 * 2.0 * M_PI * CHAN_OVERLAP) * sr;
+}
+
+/*
+ * Alçak geçiren sinc × Kaiser, kesim fc (Hz); N noktalı FFT'si alınıp
+ * merkez etrafındaki M bin (doğal FFT sırası, 1/N ölçekli) H'ye yazılır.
+ * scratch: CHAN_FFT karmaşık.
+ */
+static void design_lowpass(FftCpx *H, int M, double fc, uint32_t sr, FftCpx *scratch) {
+    const int    P    = CHAN_OVERLAP + 1;
+    const double beta = 0.1102 * (CHAN_ATTEN_DB - 8.7);
+    const double nu   = fc / sr;
+    const double mid  = (P - 1) / 2.0;
+
+    memset(scratch, 0, sizeof(*scratch) * CHAN_FFT);
+    double sum = 0.0;
+    double *h  = malloc(sizeof(double) * P);
+    if (!h) return;
+    for (int n = 0; n < P; n++) {
+        double x = n - mid;
+        double s = (x == 0.0) ? 2.0 * nu : sin(2.0 * M_PI * nu * x) / (M_PI * x);
+        double r = x / mid;
+        h[n] = s * bessel_i0(beta * sqrt(1.0 - r * r));
+        sum += h[n];
+    }
+    for (int n = 0; n < P; n++)   /* DC kazancı 1 */
+        scratch[n].r = (float)(h[n] / sum);
+    free(h);
+
+    fft_cpx(scratch, CHAN_FFT, 0);
+    const float inv = 1.0f / CHAN_FFT;
+    for (int m = 0; m < M; m++) {
+        int o = (m < M / 2) ? m : m - M;
+        FftCpx v = scratch[o & (CHAN_FFT - 1)];
+        H[m] = (FftCpx){ v.r * inv, v.i * inv };
+    }
+}
+
+/* ── Plan ─────────────────────────────────────────────────────── */
+
+/* Geçiş bandı çıkış Nyquist'ine sığdığı sürece desimasyonu ikiye katla */
+int chan_decimation(uint32_t sr, uint32_t bw_hz) {
+    const double tw = kaiser_transition(sr);
+    int dec = 1;
+    while (dec * 2 <= CHAN_FFT / CHAN_MIN_BINS &&
+           (double)sr / (dec * 2) >= bw_hz + 2.0 * tw)
+        dec *= 2;
+    return dec;
+}
+
+/* Desimasyon, merkez bini ve filtre; c->X kazıma alanı olarak kullanılır */
+static void plan_channel(Channelizer *c, Chan *ch) {
+    const double fs  = c->sr;
+    const double off = (double)ch->freq_hz - (double)c->center_hz;
+
+    int dec  = chan_decimation(c->sr, ch->bw_hz);
+    int bins = CHAN_FFT / dec;
+
+    ch->planned = 1;
+    ch->plan_id++;
+    ch->out_count = 0;
+    ch->nco_ph    = 0.0;
+    ch->dec       = dec;
+    ch->out_sr    = (uint32_t)(fs / dec);
+    ch->live      = fabs(off) + ch->out_sr / 2.0 <= fs / 2.0;
+    if (!ch->live) {
+        printf("[CHAN] Kanal %d (%.4f MHz) bant disinda, beklemede\n",
+               ch->id, ch->freq_hz / 1e6);
+        return;
+    }
+
+    long ks = lround(off * CHAN_FFT / fs);
+    ch->k_c       = (int)(((ks % CHAN_FFT) + CHAN_FFT) % CHAN_FFT);
+    ch->fine_step = -2.0 * M_PI * (off - ks * fs / CHAN_FFT) / ch->out_sr;
+
+    if (ch->bins != bins) {
+        free(ch->H);
+        free(ch->work);
+        ch->H    = malloc(sizeof(FftCpx) * bins);
+        ch->work = malloc(sizeof(FftCpx) * bins);
+        ch->bins = bins;
+        if (!ch->H || !ch->work) {
+            fprintf(stderr, "[CHAN] Bellek hatasi: kanal %d\n", ch->id);
+            ch->live = 0;
+            ch->bins = 0;
+            return;
+        }
+    }
+
+    /* Aynı genişlik + desimasyondaki kanal varsa yanıtı kopyala */
+    const Chan *same = NULL;
+    for (int i = 0; i < CHAN_MAX && !same; i++) {
+        const Chan *o = &c->ch[i];
+        if (o != ch && o->used && o->planned && o->live &&
+            o->bw_hz == ch->bw_hz && o->dec == dec)
+            same = o;
+    }
+    if (same)
+        memcpy(ch->H, same->H, sizeof(FftCpx) * bins);
+    else
+        design_lowpass(ch->H, bins, (ch->bw_hz / 2.0 + ch->out_sr / 2.0) / 2.0,
+                       c->sr, c->X);
+    printf("[CHAN] Kanal %d: %.4f MHz  %.1f kHz  D=%d  %u S/s  (bin %d, M=%d)\n",
+           ch->id, ch->freq_hz / 1e6, ch->bw_hz / 1e3, dec, ch->out_sr,
+           ch->k_c, bins);
+}
+
+/* ── Blok işleme ──────────────────────────────────────────────── */
+static void run_channel(Channelizer *c, Chan *ch) {
+    const int M = ch->bins, N = CHAN_FFT;
+    FftCpx *w = ch->work;
+
+    /* Merkez bini etrafındaki M bin × H → M noktalı ters FFT = karıştır + desime et */
+    for (int m = 0; m < M; m++) {
+        int o = (m < M / 2) ? m : m - M;
+        FftCpx x = c->X[(ch->k_c + o) & (N - 1)], h = ch->H[m];
+        w[m] = (FftCpx){ x.r * h.r - x.i * h.i, x.r * h.i + x.i * h.r };
+    }
+    fft_cpx(w, M, 1);
+
+    /*
+     * Bin kaydırma karıştırmayı bloğun kendi başlangıcına göre yapar; mutlak
+     * zamana göre sürekli faz için e^{-j2π k_c b L / N} ile döndür. İnce
+     * kayma NCO'su aynı fazöre katlanır.
+     */
+    uint64_t r   = (uint64_t)ch->k_c * ((c->blocks * CHAN_HOP) % N) % N;
+    double   ang = -2.0 * M_PI * (double)r / N + ch->nco_ph;
+    double   pr  = cos(ang), pi = sin(ang);
+    double   sr  = cos(ch->fine_step), si = sin(ch->fine_step);
+
+    FftCpx *y = w + M / 4;   /* ilk P-1 giriş örneği dairesel evrişimle bozuk */
+    int     n = M - M / 4;
+    for (int t = 0; t < n; t++) {
+        FftCpx v = y[t];
+        y[t] = (FftCpx){ (float)(v.r * pr - v.i * pi), (float)(v.r * pi + v.i * pr) };
+        double nr = pr * sr - pi * si;
+        pi = pr * si + pi * sr;
+        pr = nr;
+    }
+    ch->nco_ph = fmod(ch->nco_ph + n * ch->fine_step, 2.0 * M_PI);
+
+    c->out(ch, y, n, c->ud);
+    ch->out_count += (uint64_t)n;
+}
+
+static void run_block(Channelizer *c) {
+    memcpy(c->X, c->in, sizeof(FftCpx) * CHAN_FFT);
+    fft_cpx(c->X, CHAN_FFT, 0);
+    for (int i = 0; i < CHAN_MAX; i++) {
+        Chan *ch = &c->ch[i];
+        if (ch->used && ch->live) run_channel(c, ch);
+    }
+    c->blocks++;
+}
+
+/* ── Genel API ────────────────────────────────────────────────── */
+int chan_init(Channelizer *c, ChanOutFn out, void *ud) {
+    memset(c, 0, sizeof(*c));
+    c->in = malloc(sizeof(FftCpx) * CHAN_FFT);
+    c->X  = malloc(sizeof(FftCpx) * CHAN_FFT);
+    if (!c->in || !c->X) {
+        fprintf(stderr, "[CHAN] Bellek hatasi\n");
+        free(c->in);
+        free(c->X);
+        c->in = c->X = NULL;
+        return -1;
+    }
+    for (int i = 0; i < CHAN_MAX; i++) c->ch[i].id = i;
+    c->out = out;
+    c->ud  = ud;
+    mutex_init(&c->cs);
+    return 0;
+}
+
+void chan_free(Channelizer *c) {
+    if (!c->in) return;
+    for (int i = 0; i < CHAN_MAX; i++) {
+        free(c->ch[i].H);
+        free(c->ch[i].work);
+    }
+    free(c->in);
+    free(c->X);
+    c->in = c->X = NULL;
+    mutex_free(&c->cs);
+}
+
+int chan_add(Channelizer *c, uint32_t freq_hz, uint32_t bw_hz) {
+    if (!c->in || bw_hz == 0) return -1;
+    int id = -1;
+    mutex_lock(&c->cs);
+    for (int i = 0; i < CHAN_MAX; i++) {
+        if (c->ch[i].used) continue;
+        Chan *ch    = &c->ch[i];
+        ch->used    = 1;
+        ch->planned = 0;   /* ilk blokta, geçerli ayarla planlanır */
+        ch->live    = 0;
+        ch->freq_hz = freq_hz;
+        ch->bw_hz   = bw_hz;
+        c->n_used++;
+        id = i;
+        break;
+    }
+    mutex_unlock(&c->cs);
+    if (id < 0)
+        fprintf(stderr, "[CHAN] Kanal eklenemedi: en cok %d\n", CHAN_MAX);
+    return id;
+}
+
+void chan_remove(Channelizer *c, int id) {
+    if (id < 0 || id >= CHAN_MAX) return;
+    mutex_lock(&c->cs);
+    if (c->ch[id].used) {
+        c->ch[id].used = 0;
+        c->ch[id].live = 0;
+        c->n_used--;
+    }
+    mutex_unlock(&c->cs);
+}
+
+void chan_feed(Channelizer *c, const uint8_t *raw, const SdrBlockMeta *m) {
+    if (!c->in) return;
+    mutex_lock(&c->cs);
+    if (c->n_used == 0) {
+        mutex_unlock(&c->cs);
+        return;
+    }
+
+    /* Yeni ayar: merkez / hız değişmiş olabilir, tüm kanallar yeniden planlanır */
+    if (m->gen != c->gen || m->freq != c->center_hz || m->sr != c->sr) {
+        c->gen       = m->gen;
+        c->center_hz = m->freq;
+        c->sr        = m->sr;
+        c->fill      = 0;
+        c->blocks    = 0;
+        for (int i = 0; i < CHAN_MAX; i++) c->ch[i].planned = 0;
+    }
+    if (m->sample != c->next_sample) {   /* kayıp blok: pencere süreksiz */
+        c->fill   = 0;
+        c->blocks = 0;
+    }
+    c->next_sample = m->sample + FFT_SIZE;
+
+    for (int i = 0; i < CHAN_MAX; i++)
+        if (c->ch[i].used && !c->ch[i].planned) plan_channel(c, &c->ch[i]);
+
+    for (int n = 0; n < FFT_SIZE; n++) {
+        c->in[c->fill].r = ((float)raw[2*n]     - 127.5f) / 128.0f;
+        c->in[c->fill].i = ((float)raw[2*n + 1] - 127.5f) / 128.0f;
+        if (++c->fill == CHAN_FFT) {
+            run_block(c);
+            memmove(c->in, c->in + CHAN_HOP, sizeof(FftCpx) * CHAN_OVERLAP);
+            c->fill = CHAN_OVERLAP;
+        }
+    }
+    mutex_unlock(&c->cs);
+}
+
+int chan_parse(const char *spec, uint32_t *freq_hz, uint32_t *bw_hz) {
+    double mhz = 0.0, khz = 0.0;
+    if (sscanf(spec, "%lf:%lf", &mhz, &khz) != 2 || mhz <= 0.0 || khz <= 0.0)
+        return -1;
+    *freq_hz = (uint32_t)(mhz * 1e6 + 0.5);
+    *bw_hz   = (uint32_t)(khz * 1e3 + 0.5);
+    return 0;
+}
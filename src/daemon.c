@@ -0,0 +1,498 @@
+/*
+ * daemon.c — RTL-SDR Radar başsız (SDL'siz) servis
+ *
+ * Pencere açmadan kaynak → DSP → kayıt / dedektör / yayın hattını çalıştırır.
+ * render, widgets ve panel modüllerine bağlanmaz; raf sunucularında GUI
+ * maliyeti olmadan makine başına çok daha fazla alıcı koşturulabilir.
+ *
+ * Derleme:
+ *   make daemon                    → radar_d.exe (MinGW)
+ *   make linux                     → radar_d     (Linux, pthread)
+ *
+ * Kullanım:
+ *   radar_d.exe -d 0 -d 1@2,3,4 -S 5555      iki cihaz, spektrum yayını
+ *   radar_d.exe -r 10.0.0.5:1234 -m -R       uzak dongle, shm + IQ kaydı
+ *   radar_d.exe -c C:\RtlSdr\radar.conf      ayarları dosyadan oku
+ *
+ * Seçenekler (yapılandırma dosyasında "anahtar = değer" karşılıkları):
+ *   -d idx[@cpu]      device = ...        USB cihaz (indeks)
+ *   -s seri[@cpu]     serial = ...        USB cihaz (seri no)
+ *   -r host:port      tcp    = ...        rtl_tcp sunucusu
+ *   -f MHz            freq   = 100.0      merkez frekans
+ *   -w MHz            rate   = 2.048      örnekleme hızı
+ *   -g dB|auto        gain   = auto       tuner kazancı
+ *   -W f0:f1          sweep  = 88:108     geniş bant tarama (MHz)
+ *   -S port           stream = 5555       spektrum yayın sunucusu
+ *   -m                shm    = 1          paylaşılan bellek yayını
+ *   -R                record = 1          açılışta IQ kaydını başlat
+ *   -i s              status = 10         durum satırı aralığı (0 = kapalı)
+ *   -x KBxN           xfer   = 128x16     USB aktarım boyutu x sayısı
+ *   -j s              stats  = 5          ölçüm dökümü aralığı (<outdir>/stats.json)
+ *   -o dizin          outdir = /srv/iq    kayıt / olay günlüğü / ölçüm dizini
+ *   -P öncelik        rtprio = 50         USB + kayıt thread'leri SCHED_FIFO (Linux)
+ *   -q                fixed  = 1          sabit noktalı (int16) FFT yolu
+ *   -C MHz:kHz        chan   = 145.5:12.5 dar kanal (tekrarlanabilir): kayıtta
+ *                                         cf32 dosyası, shm'de radar_<etiket>_ch<N>
+ *   -B ön[:son]       snap   = 10:5       ön tetik halkası (s): anlık kayıt tetikten
+ *                                         önceki ve sonraki IQ'yu içerir
+ *   -E                snapdet = 1         her yeni dedektör olayı anlık kaydı tetikler
+ *   -b MHz:kHz[:biçim] subband = 433.92:25:ci16  kayıt yalnız bu pencere: süzülmüş,
+ *                                         desimasyonlu ci8 / ci16 / cf32 (recorder.h)
+ *   -F boy            fine   = 1M        ince çözünürlük FFT'si (4k..1M, çok thread'li)
+ *   -K                reccorr = 1         kayıt / anlık kayıt DC + IQ düzeltilmiş blokları
+ *                                         yazar (varsayılan ham; düzeltme hep açık)
+ *   -G s|boy          segment = 60       kaydı bölütlere böl: süre (s) ya da boyut
+ *                                         (512M, 2G); her bölüte .sigmf-meta
+ *   -A boy            keep   = 500G      saklama bütçesi (dizin başına, bütün
+ *                                         cihazlar toplam): kayıt dizinindeki
+ *                                         bölütler aşınca en eskiden silinir
+ *   -a kip[:kHz]      demod  = fm        demodülatör: fm / am / usb / lsb, isteğe bağlı
+ *                                         kanal genişliği (demod.h); 48 kHz s16 ses
+ *   -D MHz            demodfreq = 100.1  dinlenen frekans (-a yoksa fm)
+ *   -O çıkış          audio  = |aplay -r 48000 -f S16_LE  ses çıkışı: .wav dosyası,
+ *                                         FIFO / ham dosya, "|komut" ya da "null"
+ *                                         (varsayılan <outdir>/audio_*.wav)
+ *   -M boy[:çerçeve]  mres   = 16k:8     ek çözünürlük (tekrarlanabilir, 64..16k):
+ *                                         düzey başına dedektör günlüğü, shm'de
+ *                                         radar_<etiket>_r<boy>
+ *   -L yol[,arg]      stage  = ./nf.so,x DSP aşama eklentisi (tekrarlanabilir,
+ *                                         stage_api.h); her cihaza bir örnek
+ *
+ * Linux'ta SIGUSR1 tüm hatlarda anlık kaydı tetikler (kill -USR1 <pid>).
+ *
+ * SIGINT / SIGTERM (Windows'ta Ctrl+C, konsol kapatma, oturum kapanışı)
+ * hatları düzgün durdurur: kayıtlar ve olay günlükleri kapanır.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+
+#include "fft.h"
+#include "pipeline.h"
+
+/* ── Ayarlar ──────────────────────────────────────────────────── */
+typedef struct {
+    PipeConfig dev[PIPE_MAX];
+    int        n_dev;
+    uint32_t   freq, rate;        /* 0 = varsayılan */
+    float      gain_db;
+    int        manual_gain;
+    uint32_t   sweep_f0, sweep_f1;
+    int        stream_port;
+    int        shm;
+    unsigned   xfer_kb, xfer_num;  /* 0 = varsayılan */
+    int        record;
+    int        status_s;
+    int        stats_s;
+    int        rt_prio;           /* 0 = normal zamanlayıcı */
+    int        fixed;             /* 1 = int16 FFT (fftq) */
+    char       out_dir[192];      /* boş = REC_DEFAULT_DIR */
+    uint32_t   chan_freq[CHAN_MAX], chan_bw[CHAN_MAX];
+    int        n_chan;
+    uint32_t   snap_pre_ms, snap_post_ms;   /* 0 + 0 = ön tetik halkası kapalı */
+    int        snap_det;
+    uint32_t   sub_freq, sub_bw;            /* 0 = tam bant kayıt */
+    int        sub_fmt;
+    int        fine_log2;                   /* 0 = normal FFT_SIZE yolu */
+    int        mres_size[MRES_MAX], mres_avg[MRES_MAX];
+    int        n_mres;
+    int        rec_corr;                    /* 1 = kayda düzeltilmiş bloklar */
+    uint32_t   seg_s;                       /* 0 + 0 = bölütleme kapalı */
+    uint64_t   seg_bytes;
+    uint64_t   keep_bytes;                  /* 0 = saklama bütçesi yok */
+    int        demod_mode;                  /* DEMOD_*, OFF = kapalı */
+    uint32_t   demod_freq, demod_bw;        /* 0 = bekle / kipin varsayılanı */
+    char       audio_out[256];              /* boş = <outdir>/audio_*.wav */
+} DaemonCfg;
+
+/* Yapılandırma dosyasından gelen cihaz tanımları PipeConfig içinden
+   gösterildiği için süreç boyunca yaşar */
+static char s_specs[PIPE_MAX][128];
+
+static volatile sig_atomic_t s_stop = 0;
+static volatile sig_atomic_t s_snap = 0;
+
+static void on_signal(int sig) {
+    (void)sig;
+    s_stop = 1;
+}
+
+#ifdef SIGUSR1
+static void on_snap_signal(int sig) {
+    (void)sig;
+    s_snap = 1;
+}
+#endif
+
+#ifdef _WIN32
+/* Konsol kapatma / oturum kapanışı SIGTERM üretmez */
+static BOOL WINAPI on_console_event(DWORD ev) {
+    (void)ev;
+    s_stop = 1;
+    return TRUE;
+}
+#endif
+
+/* ── Ayar çözümleme ───────────────────────────────────────────── */
+static int add_device(DaemonCfg *c, const char *spec, char kind) {
+    if (c->n_dev >= PIPE_MAX) {
+        fprintf(stderr, "En fazla %d cihaz desteklenir\n", PIPE_MAX);
+        return -1;
+    }
+    snprintf(s_specs[c->n_dev], sizeof(s_specs[0]), "%s", spec);
+    pipeline_parse_spec(s_specs[c->n_dev], kind, &c->dev[c->n_dev]);
+    c->n_dev++;
+    return 0;
+}
+
+/* Tek bir ayarı uygula; anahtar CLI bayrağı ya da dosya anahtarıdır */
+static int apply_opt(DaemonCfg *c, const char *key, const char *val) {
+    if (!strcmp(key, "device")) return add_device(c, val, 'd');
+    if (!strcmp(key, "serial")) return add_device(c, val, 's');
+    if (!strcmp(key, "tcp"))    return add_device(c, val, 'r');
+    if (!strcmp(key, "freq"))   { c->freq = (uint32_t)(atof(val) * 1e6); return 0; }
+    if (!strcmp(key, "rate"))   { c->rate = (uint32_t)(atof(val) * 1e6); return 0; }
+    if (!strcmp(key, "gain")) {
+        c->manual_gain = strcmp(val, "auto") != 0;
+        c->gain_db     = (float)atof(val);
+        return 0;
+    }
+    if (!strcmp(key, "sweep")) {
+        double f0, f1;
+        if (sscanf(val, "%lf:%lf", &f0, &f1) != 2) {
+            fprintf(stderr, "Gecersiz tarama araligi: %s\n", val);
+            return -1;
+        }
+        c->sweep_f0 = (uint32_t)(f0 * 1e6);
+        c->sweep_f1 = (uint32_t)(f1 * 1e6);
+        return 0;
+    }
+    if (!strcmp(key, "xfer")) {
+        if (sscanf(val, "%ux%u", &c->xfer_kb, &c->xfer_num) < 1) {
+            fprintf(stderr, "Gecersiz aktarim boyutu: %s\n", val);
+            return -1;
+        }
+        return 0;
+    }
+    if (!strcmp(key, "stream")) { c->stream_port = atoi(val); return 0; }
+    if (!strcmp(key, "shm"))    { c->shm         = atoi(val); return 0; }
+    if (!strcmp(key, "record")) { c->record      = atoi(val); return 0; }
+    if (!strcmp(key, "status")) { c->status_s    = atoi(val); return 0; }
+    if (!strcmp(key, "stats"))  { c->stats_s     = atoi(val); return 0; }
+    if (!strcmp(key, "rtprio")) { c->rt_prio     = atoi(val); return 0; }
+    if (!strcmp(key, "fixed"))  { c->fixed       = atoi(val); return 0; }
+    if (!strcmp(key, "snapdet")) { c->snap_det   = atoi(val); return 0; }
+    if (!strcmp(key, "reccorr")) { c->rec_corr   = atoi(val); return 0; }
+    if (!strcmp(key, "snap"))
+        return snap_parse(val, &c->snap_pre_ms, &c->snap_post_ms);
+    if (!strcmp(key, "subband")) {
+        if (recorder_parse_subband(val, &c->sub_freq, &c->sub_bw, &c->sub_fmt) != 0) {
+            fprintf(stderr, "Gecersiz alt bant: %s\n", val);
+            return -1;
+        }
+        return 0;
+    }
+    if (!strcmp(key, "segment")) {
+        if (recorder_parse_segment(val, &c->seg_s, &c->seg_bytes) != 0) {
+            fprintf(stderr, "Gecersiz bolut: %s\n", val);
+            return -1;
+        }
+        return 0;
+    }
+    if (!strcmp(key, "keep")) {
+        if ((c->keep_bytes = ret_parse_size(val)) == 0) {
+            fprintf(stderr, "Gecersiz saklama butcesi: %s\n", val);
+            return -1;
+        }
+        return 0;
+    }
+    if (!strcmp(key, "demod")) {
+        if (demod_parse(val, &c->demod_mode, &c->demod_bw) != 0) {
+            fprintf(stderr, "Gecersiz demod: %s (fm|am|usb|lsb[:kHz])\n", val);
+            return -1;
+        }
+        return 0;
+    }
+    if (!strcmp(key, "demodfreq")) {
+        double mhz = atof(val);
+        if (mhz <= 0.0) {
+            fprintf(stderr, "Gecersiz demod frekansi: %s\n", val);
+            return -1;
+        }
+        c->demod_freq = (uint32_t)(mhz * 1e6 + 0.5);
+        return 0;
+    }
+    if (!strcmp(key, "audio")) {
+        snprintf(c->audio_out, sizeof(c->audio_out), "%s", val);
+        return 0;
+    }
+    if (!strcmp(key, "chan")) {
+        if (c->n_chan >= CHAN_MAX ||
+            chan_parse(val, &c->chan_freq[c->n_chan], &c->chan_bw[c->n_chan]) != 0) {
+            fprintf(stderr, "Gecersiz kanal: %s\n", val);
+            return -1;
+        }
+        c->n_chan++;
+        return 0;
+    }
+    if (!strcmp(key, "stage"))  return stage_load(val);
+    if (!strcmp(key, "mres")) {
+        if (c->n_mres >= MRES_MAX ||
+            mres_parse(val, &c->mres_size[c->n_mres], &c->mres_avg[c->n_mres]) != 0) {
+            fprintf(stderr, "Gecersiz cozunurluk: %s\n", val);
+            return -1;
+        }
+        c->n_mres++;
+        return 0;
+    }
+    if (!strcmp(key, "fine")) {
+        if ((c->fine_log2 = bigfft_parse_size(val)) < 0) {
+            fprintf(stderr, "Gecersiz ince FFT boyu: %s\n", val);
+            return -1;
+        }
+        return 0;
+    }
+    if (!strcmp(key, "outdir")) {
+        snprintf(c->out_dir, sizeof(c->out_dir), "%s", val);
+        return 0;
+    }
+    fprintf(stderr, "Bilinmeyen ayar: %s\n", key);
+    return -1;
+}
+
+static char *trim(char *s) {
+    while (*s == ' ' || *s == '\t') s++;
+    char *e = s + strlen(s);
+    while (e > s && (e[-1] == ' ' || e[-1] == '\t' ||
+                     e[-1] == '\r' || e[-1] == '\n')) *--e = '\0';
+    return s;
+}
+
+/* "anahtar = değer" satırları; '#' sonrası yorum */
+static int load_config(DaemonCfg *c, const char *path) {
+    FILE *fp = fopen(path, "r");
+    if (!fp) {
+        fprintf(stderr, "Yapilandirma acilamadi: %s\n", path);
+        return -1;
+    }
+    char line[256];
+    int  ln = 0, rc = 0;
+    while (fgets(line, sizeof(line), fp)) {
+        ln++;
+        char *hash = strchr(line, '#');
+        if (hash) *hash = '\0';
+        char *eq = strchr(line, '=');
+        if (!eq) {
+            if (*trim(line)) {
+                fprintf(stderr, "%s:%d: '=' bekleniyordu\n", path, ln);
+                rc = -1;
+            }
+            continue;
+        }
+        *eq = '\0';
+        if (apply_opt(c, trim(line), trim(eq + 1)) != 0) {
+            fprintf(stderr, "%s:%d: gecersiz satir\n", path, ln);
+            rc = -1;
+        }
+    }
+    fclose(fp);
+    return rc;
+}
+
+static int parse_args(DaemonCfg *c, int argc, char *argv[]) {
+    static const struct { const char *flag, *key; } map[] = {
+        {"-d", "device"}, {"-s", "serial"}, {"-r", "tcp"},
+        {"-f", "freq"},   {"-w", "rate"},   {"-g", "gain"},
+        {"-W", "sweep"},  {"-S", "stream"}, {"-i", "status"},
+        {"-j", "stats"},  {"-x", "xfer"},   {"-o", "outdir"},
+        {"-P", "rtprio"}, {"-C", "chan"},   {"-B", "snap"},
+        {"-b", "subband"}, {"-L", "stage"},  {"-F", "fine"},
+        {"-M", "mres"},   {"-G", "segment"}, {"-A", "keep"},
+        {"-a", "demod"},  {"-D", "demodfreq"}, {"-O", "audio"},
+    };
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-l")) { sdr_list_devices(); exit(0); }
+        if (!strcmp(argv[i], "-m")) { c->shm    = 1; continue; }
+        if (!strcmp(argv[i], "-R")) { c->record = 1; continue; }
+        if (!strcmp(argv[i], "-q")) { c->fixed  = 1; continue; }
+        if (!strcmp(argv[i], "-E")) { c->snap_det = 1; continue; }
+        if (!strcmp(argv[i], "-K")) { c->rec_corr = 1; continue; }
+        if (!strcmp(argv[i], "-c") && i + 1 < argc) {
+            if (load_config(c, argv[++i]) != 0) return -1;
+            continue;
+        }
+        int hit = 0;
+        for (size_t k = 0; k < sizeof(map) / sizeof(map[0]); k++) {
+            if (!strcmp(argv[i], map[k].flag) && i + 1 < argc) {
+                if (apply_opt(c, map[k].key, argv[++i]) != 0) return -1;
+                hit = 1;
+                break;
+            }
+        }
+        if (!hit) {
+            fprintf(stderr, "Bilinmeyen arguman: %s\n", argv[i]);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* ── Durum satırı ─────────────────────────────────────────────── */
+static void print_status(Pipeline **pipes, int n, SpecServer *srv) {
+    for (int i = 0; i < n; i++) {
+        const Pipeline *pl = pipes[i];
+        printf("[DMN] %s  %.3f MHz  satir %u  olay %u  taban %.1f dB  kuyruk kaybi %llu  "
+               "kayit kaybi %llu  gecikme p99 %.1f ms%s\n",
+               pl->name, pl->sdr.center_freq / 1e6, pl->det.row, pl->det.n_logged,
+               pl->nf.floor_db,
+               (unsigned long long)stats_get(&pl->stats, STAT_C_Q_DROPS),
+               (unsigned long long)stats_get(&pl->stats, STAT_C_REC_DROPS),
+               stats_percentile(&pl->stats.h[STAT_H_DSP_LAT], 0.99) / 1000.0,
+               pl->rec.active ? "  [KAYIT]" : pl->snap.busy ? "  [ANLIK]" : "");
+        for (int k = 0; k < pl->mres.n; k++) {
+            const MresLevel *l = &pl->mres.lv[k];
+            printf("[DMN]   cozunurluk %d bin  %d cerceve/satir  satir %u  olay %u\n",
+                   l->size, l->avg, l->rows, pl->mres_det[k]->n_logged);
+        }
+        if (pl->demod.on)
+            printf("[DMN]   demod %s %.4f MHz  %.1f kHz  ses %.1f s  kayip %llu  "
+                   "gecikme p99 %.1f ms\n", demod_mode_name(pl->demod.mode),
+                   pl->demod.freq_hz / 1e6, pl->demod.bw_hz / 1e3,
+                   (double)pl->demod.samples / DEMOD_AUDIO_SR,
+                   (unsigned long long)stats_get(&pl->stats, STAT_C_DEMOD_DROPS),
+                   stats_percentile(&pl->stats.h[STAT_H_DEMOD_LAT], 0.99) / 1000.0);
+        for (int k = 0; k < pl->stages.n; k++) {
+            const StageInst *st = &pl->stages.st[k];
+            printf("[DMN]   asama %s  blok %llu  satir %llu  atlanan %llu  "
+                   "gecikme p99 %.1f ms\n", st->d->name,
+                   (unsigned long long)stats_get(&st->stats, STAT_C_STAGE_BLOCKS),
+                   (unsigned long long)stats_get(&st->stats, STAT_C_STAGE_ROWS),
+                   (unsigned long long)stats_get(&st->stats, STAT_C_STAGE_SKIP),
+                   stats_percentile(&st->stats.h[STAT_H_STAGE_LAG], 0.99) / 1000.0);
+        }
+    }
+    if (srv)
+        printf("[DMN] Yayin: %d izleyici, %.1f MB gonderildi\n",
+               specsrv_clients(srv), specsrv_bytes_sent(srv) / 1048576.0);
+    fflush(stdout);
+}
+
+/* ── main ─────────────────────────────────────────────────────── */
+int main(int argc, char *argv[]) {
+    DaemonCfg cfg;
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.status_s = 10;
+    if (parse_args(&cfg, argc, argv) != 0) return 1;
+    if (cfg.n_dev == 0) add_device(&cfg, "0", 'd');
+    for (int i = 0; i < cfg.n_dev; i++) {
+        cfg.dev[i].shm      = cfg.shm;
+        cfg.dev[i].xfer_len = cfg.xfer_kb * 1024u;
+        cfg.dev[i].xfer_num = cfg.xfer_num;
+        cfg.dev[i].rt_prio  = cfg.rt_prio;
+        cfg.dev[i].out_dir  = cfg.out_dir[0] ? cfg.out_dir : NULL;
+        cfg.dev[i].snap_pre_ms  = cfg.snap_pre_ms;
+        cfg.dev[i].snap_post_ms = cfg.snap_post_ms;
+        cfg.dev[i].snap_det     = cfg.snap_det;
+        cfg.dev[i].fine_log2    = cfg.fine_log2;
+        cfg.dev[i].rec_corr     = cfg.rec_corr;
+        cfg.dev[i].mres_n       = cfg.n_mres;
+        memcpy(cfg.dev[i].mres_size, cfg.mres_size, sizeof(cfg.mres_size));
+        memcpy(cfg.dev[i].mres_avg,  cfg.mres_avg,  sizeof(cfg.mres_avg));
+        cfg.dev[i].demod_mode   = cfg.demod_freq && cfg.demod_mode == DEMOD_OFF
+                                ? DEMOD_FM : cfg.demod_mode;
+        cfg.dev[i].demod_freq   = cfg.demod_freq;
+        cfg.dev[i].demod_bw     = cfg.demod_bw;
+        cfg.dev[i].audio_out    = cfg.audio_out[0] ? cfg.audio_out : NULL;
+    }
+    char stats_path[256];
+    snprintf(stats_path, sizeof(stats_path), "%s" PATH_SEP "stats.json",
+             cfg.out_dir[0] ? cfg.out_dir : REC_DEFAULT_DIR);
+
+    signal(SIGINT,  on_signal);
+    signal(SIGTERM, on_signal);
+#ifdef SIGUSR1
+    signal(SIGUSR1, on_snap_signal);
+#endif
+#ifdef _WIN32
+    SetConsoleCtrlHandler(on_console_event, TRUE);
+#endif
+
+    fft_init();
+    fft_set_fixed(cfg.fixed);
+    if (cfg.fixed) printf("[DMN] FFT: sabit noktali (int16) yol\n");
+
+    /* ── Hatları aç ve ayarla ──────────────────────────────── */
+    /* Saklama bütçesi dizin başına: bütün cihazların bölütleri tek bütçede */
+    Retention ret;
+    ret_init(&ret, cfg.out_dir[0] ? cfg.out_dir : REC_DEFAULT_DIR, cfg.keep_bytes);
+    Pipeline *pipes[PIPE_MAX];
+    int n_pipes = 0;
+    for (int i = 0; i < cfg.n_dev; i++) {
+        Pipeline *pl = calloc(1, sizeof(Pipeline));
+        if (!pl || pipeline_open(pl, n_pipes, &cfg.dev[i]) != 0) {
+            free(pl);
+            continue;
+        }
+        if (cfg.rate) sdr_set_sr  (&pl->sdr, cfg.rate);
+        if (cfg.freq) sdr_set_freq(&pl->sdr, cfg.freq);
+        if (cfg.manual_gain) {
+            sdr_set_gain(&pl->sdr, cfg.gain_db);
+            sdr_set_agc (&pl->sdr, 0);
+        }
+        for (int k = 0; k < cfg.n_chan; k++)
+            pipeline_add_channel(pl, cfg.chan_freq[k], cfg.chan_bw[k]);
+        if (cfg.sub_freq)
+            recorder_set_subband(&pl->rec, cfg.sub_freq, cfg.sub_bw, cfg.sub_fmt);
+        recorder_set_segments(&pl->rec, cfg.seg_s, cfg.seg_bytes,
+                              cfg.keep_bytes ? &ret : NULL);
+        pipes[n_pipes++] = pl;
+    }
+    if (n_pipes == 0) return 1;
+
+    SpecServer *srv = cfg.stream_port ? specsrv_start((uint16_t)cfg.stream_port)
+                                      : NULL;
+
+    for (int i = 0; i < n_pipes; i++) {
+        Pipeline *pl = pipes[i];
+        pl->srv = srv;
+        pipeline_start(pl);
+        if (cfg.record) recorder_start(&pl->rec);
+        if (cfg.sweep_f1 > cfg.sweep_f0 &&
+            sweep_start(&pl->sweep, cfg.sweep_f0, cfg.sweep_f1,
+                        pl->sdr.sample_rate) != 0)
+            fprintf(stderr, "[DMN] %s: tarama baslatilamadi\n", pl->name);
+    }
+    printf("[DMN] %d hat calisiyor (cikis: Ctrl+C / SIGTERM)\n", n_pipes);
+
+    /* ── Bekle ─────────────────────────────────────────────── */
+    int ticks = 0, stat_ticks = 0;
+    while (!s_stop) {
+        sleep_ms(200);
+        if (s_snap) {
+            s_snap = 0;
+            for (int i = 0; i < n_pipes; i++) pipeline_snapshot(pipes[i], "SIGUSR1");
+        }
+        if (cfg.status_s > 0 && ++ticks >= cfg.status_s * 5) {
+            print_status(pipes, n_pipes, srv);
+            ticks = 0;
+        }
+        if (cfg.stats_s > 0 && ++stat_ticks >= cfg.stats_s * 5) {
+            pipeline_dump_stats(stats_path, pipes, n_pipes, NULL);
+            stat_ticks = 0;
+        }
+    }
+
+    /* ── Kapanış (GUI ile aynı sıra: önce kaynak, sonra tüketiciler) ── */
+    printf("[DMN] Durduruluyor...\n");
+    for (int i = 0; i < n_pipes; i++) pipeline_stop(pipes[i]);
+    specsrv_stop(srv);
+    for (int i = 0; i < n_pipes; i++) {
+        pipeline_close(pipes[i]);
+        free(pipes[i]);
+    }
+    ret_free(&ret);
+    printf("[DMN] Kapatildi.\n");
+    return 0;
+}
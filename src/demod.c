@@ -0,0 +1,563 @@
+/* demod.c — Tıklanan frekansta düşük gecikmeli FM / AM / USB / LSB demodülatör */
+#include "demod.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <signal.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#ifdef _WIN32
+#define popen  _popen
+#define pclose _pclose
+#define POPEN_MODE "wb"
+#else
+#define POPEN_MODE "w"
+#endif
+
+enum { DEMOD_SINK_NONE, DEMOD_SINK_NULL, DEMOD_SINK_WAV, DEMOD_SINK_RAW, DEMOD_SINK_PIPE };
+
+static const char *const MODE_NAME[DEMOD_COUNT] = { "off", "fm", "am", "usb", "lsb" };
+static const uint32_t    MODE_BW[DEMOD_COUNT]   = { 0, 12500, 10000, 2800, 2800 };
+
+#define DEMOD_FM_DC_S   0.2    /* FM çıkışındaki ayar kayması DC'sinin zaman sabiti */
+#define DEMOD_AM_S      0.1    /* AM taşıyıcı düzeyi */
+#define DEMOD_AGC_S     0.5    /* SSB AGC bırakma */
+#define DEMOD_AGC_MAX   1000.0f
+
+/* Blok başına tek kutuplu süzgeç katsayısı (n örnek, fs hızı, tau s) */
+static float blk_alpha(int n, double fs, double tau) {
+    return (float)(1.0 - exp(-(double)n / (fs * tau)));
+}
+
+/*
+ * Dallanmasız atan2 (en çok ~1e-5 rad hata): seçimler karşılaştırma +
+ * harmanlama olur, döngü -O2'de vektörleşir.
+ */
+static inline float fast_atan2f(float y, float x) {
+    float ax = fabsf(x), ay = fabsf(y);
+    float mx = ax > ay ? ax : ay, mn = ax > ay ? ay : ax;
+    float a  = mn / (mx + 1e-30f);
+    float s  = a * a;
+    float r  = ((-0.0464964749f * s + 0.15931422f) * s - 0.327622764f) * s * a + a;
+    r = ay > ax ? 1.57079637f - r : r;
+    r = x < 0.0f ? 3.14159274f - r : r;
+    return y < 0.0f ? -r : r;
+}
+
+/* ── Çıkış ────────────────────────────────────────────────────── */
+static void put_le(uint8_t *p, uint32_t v, int n) {
+    for (int i = 0; i < n; i++) p[i] = (uint8_t)(v >> (8 * i));
+}
+
+/* 44 baytlık PCM başlığı; dosya sonunda kalır (ftell korunur) */
+static void wav_header(FILE *fp, uint64_t samples) {
+    uint8_t  h[44];
+    uint32_t data = (uint32_t)(samples * 2u);
+    memcpy(h, "RIFF", 4);      put_le(h + 4, 36u + data, 4);
+    memcpy(h + 8, "WAVEfmt ", 8);
+    put_le(h + 16, 16, 4);     put_le(h + 20, 1, 2);   /* PCM */
+    put_le(h + 22, 1, 2);      put_le(h + 24, DEMOD_AUDIO_SR, 4);
+    put_le(h + 28, DEMOD_AUDIO_SR * 2, 4);
+    put_le(h + 32, 2, 2);      put_le(h + 34, 16, 2);
+    memcpy(h + 36, "data", 4); put_le(h + 40, data, 4);
+
+    long pos = ftell(fp);
+    if (pos > 0) fseek(fp, 0, SEEK_SET);
+    fwrite(h, 1, sizeof(h), fp);
+    if (pos > 0) fseek(fp, pos, SEEK_SET);
+}
+
+static void sink_open(Demod *d) {
+    const char *o = d->out;
+    d->sink = DEMOD_SINK_NULL;
+    if (!strcmp(o, "null")) {
+        snprintf(d->path, sizeof(d->path), "null");
+    } else if (o[0] == '|') {
+        snprintf(d->path, sizeof(d->path), "%s", o);
+#ifdef SIGPIPE
+        signal(SIGPIPE, SIG_IGN);   /* oynatıcı kapanırsa süreç değil yazma hata alır */
+#endif
+        d->fp   = popen(o + 1, POPEN_MODE);
+        d->sink = DEMOD_SINK_PIPE;
+    } else {
+        if (!o[0]) {
+            time_t t = time(NULL);
+            struct tm *tm = localtime(&t);
+            snprintf(d->path, sizeof(d->path),
+                "%s" PATH_SEP "audio_%s%s%04d%02d%02d_%02d%02d%02d.wav", d->dir,
+                d->tag, d->tag[0] ? "_" : "",
+                tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday,
+                tm->tm_hour, tm->tm_min, tm->tm_sec);
+        } else {
+            snprintf(d->path, sizeof(d->path), "%s", o);
+        }
+        size_t n = strlen(d->path);
+        d->sink = n > 4 && !strcmp(d->path + n - 4, ".wav") ? DEMOD_SINK_WAV
+                                                           : DEMOD_SINK_RAW;
+        d->fp = fopen(d->path, "wb");
+        if (d->fp && d->sink == DEMOD_SINK_WAV) wav_header(d->fp, 0);
+    }
+    if (d->sink != DEMOD_SINK_NULL && !d->fp) {
+        fprintf(stderr, "[DEM] Ses cikisi acilamadi: %s (ses atiliyor)\n", d->path);
+        d->sink = DEMOD_SINK_NULL;
+    }
+    d->samples = d->hdr_at = 0;
+    printf("[DEM] Ses cikisi: %s (48 kHz, s16 mono)\n", d->path);
+}
+
+static void sink_close(Demod *d) {
+    if (d->sink == DEMOD_SINK_NONE) return;
+    if (d->sink == DEMOD_SINK_NULL) {   /* "null" ya da yazma hatasıyla kapanmış */
+        d->sink = DEMOD_SINK_NONE;
+        return;
+    }
+    if (d->fp) {
+        if (d->sink == DEMOD_SINK_WAV) wav_header(d->fp, d->samples);
+        if (d->sink == DEMOD_SINK_PIPE) pclose(d->fp);
+        else                            fclose(d->fp);
+        d->fp = NULL;
+    }
+    printf("[DEM] Ses cikisi kapandi: %s, %.1f s\n", d->path,
+           (double)d->samples / DEMOD_AUDIO_SR);
+    d->sink = DEMOD_SINK_NONE;
+}
+
+static void sink_write(Demod *d, const int16_t *pcm, int n) {
+    if (d->sink == DEMOD_SINK_NONE) sink_open(d);
+    if (d->fp) {
+        int ok = fwrite(pcm, sizeof(int16_t), (size_t)n, d->fp) == (size_t)n;
+        if (ok && d->sink == DEMOD_SINK_WAV) {
+            if (d->samples + (uint64_t)n - d->hdr_at >= DEMOD_AUDIO_SR) {
+                wav_header(d->fp, d->samples + (uint64_t)n);
+                d->hdr_at = d->samples + (uint64_t)n;
+            }
+        } else if (ok) {
+            ok = fflush(d->fp) == 0;   /* boru / FIFO: tampon gecikme eklemesin */
+        }
+        if (!ok) {
+            fprintf(stderr, "[DEM] Ses cikisina yazilamadi: %s (ses atiliyor)\n", d->path);
+            sink_close(d);
+            d->sink = DEMOD_SINK_NULL;   /* demod_stop'a dek yeniden açılmaz */
+            return;
+        }
+    }
+    d->samples += (uint64_t)n;
+}
+
+/* ── Plan ─────────────────────────────────────────────────────── */
+
+/* Kanal hızı fs_c için yeniden örnekleyici + kip durumu. Başarılıysa 0. */
+static int demod_plan(Demod *d, uint32_t fs_c) {
+    const double step = (double)fs_c / DEMOD_AUDIO_SR;
+    const double fc   = 0.45 * (step > 1.0 ? 1.0 / step : 1.0);   /* döngü / giriş örneği */
+    int half = (int)ceil(DEMOD_RS_ZEROS / (2.0 * fc));
+    half = (half + 1) & ~1;   /* taps 4'ün katı: dört toplayıcılı iç döngü */
+    const int taps = 2 * half;
+
+    int n_hop = d->in_sr ? (int)((uint64_t)CHAN_HOP * fs_c / d->in_sr) : CHAN_HOP;
+    int rs_cap  = n_hop + taps + (int)step + 8;   /* artan: en çok taps + adım */
+    int pcm_cap = (int)((n_hop + taps) / step) + 8;
+
+    float   *h   = realloc(d->rs_h,  sizeof(float) * (size_t)DEMOD_RS_PHASES * (size_t)taps);
+    float   *re  = realloc(d->rs_re, sizeof(float) * (size_t)rs_cap);
+    float   *im  = realloc(d->rs_im, sizeof(float) * (size_t)rs_cap);
+    float   *ore = realloc(d->o_re,  sizeof(float) * (size_t)pcm_cap);
+    float   *oim = realloc(d->o_im,  sizeof(float) * (size_t)pcm_cap);
+    FftCpx  *rot = realloc(d->rot,   sizeof(FftCpx) * (size_t)pcm_cap);
+    int16_t *pcm = realloc(d->pcm,   sizeof(int16_t) * (size_t)pcm_cap);
+    if (h)   d->rs_h  = h;
+    if (re)  d->rs_re = re;
+    if (im)  d->rs_im = im;
+    if (ore) d->o_re  = ore;
+    if (oim) d->o_im  = oim;
+    if (rot) d->rot   = rot;
+    if (pcm) d->pcm   = pcm;
+    if (!h || !re || !im || !ore || !oim || !rot || !pcm) {
+        fprintf(stderr, "[DEM] Bellek hatasi: plan kurulamadi\n");
+        d->fs_c = 0;
+        return -1;
+    }
+
+    /* Blackman pencereli sinc, her kesir fazı birim DC kazançlı */
+    for (int p = 0; p < DEMOD_RS_PHASES; p++) {
+        float *hp  = h + (size_t)p * (size_t)taps;
+        double frac = (double)p / DEMOD_RS_PHASES, sum = 0.0;
+        for (int j = 0; j < taps; j++) {
+            double t = (double)(j - (half - 1)) - frac;
+            double x = 2.0 * fc * t;
+            double s = fabs(x) < 1e-12 ? 1.0 : sin(M_PI * x) / (M_PI * x);
+            double w = fabs(t) >= half ? 0.0
+                     : 0.42 + 0.5 * cos(M_PI * t / half) + 0.08 * cos(2.0 * M_PI * t / half);
+            hp[j] = (float)(s * w);
+            sum  += hp[j];
+        }
+        for (int j = 0; j < taps; j++) hp[j] = (float)(hp[j] / sum);
+    }
+    d->rs_taps = taps;
+    d->rs_half = half;
+    d->rs_step = step;
+    d->rs_cap  = rs_cap;
+    d->pcm_cap = pcm_cap;
+    d->rs_fill = half - 1;   /* başta sıfırlar: ilk çıkış ilk girişe hizalı */
+    d->rs_pos  = half - 1;
+    memset(d->rs_re, 0, sizeof(float) * (size_t)rs_cap);
+    memset(d->rs_im, 0, sizeof(float) * (size_t)rs_cap);
+
+    /* SSB: yan bant ortasından taşıyıcıya, 48 kHz'de */
+    double w = M_PI * d->cur_bw / DEMOD_AUDIO_SR;
+    d->rot_w     = d->cur_mode == DEMOD_USB ? w : -w;
+    d->rot_phase = 0.0;
+    for (int k = 0; k < pcm_cap; k++) {
+        d->rot[k].r = (float)cos(d->rot_w * k);
+        d->rot[k].i = (float)sin(d->rot_w * k);
+    }
+
+    d->fs_c    = fs_c;
+    d->prev    = (FftCpx){ 0.0f, 0.0f };
+    d->fm_gain = (float)(0.5 * fs_c / (2.0 * M_PI * DEMOD_FM_DEV * d->cur_bw));
+    d->de_a    = (float)(1.0 - exp(-1e6 / (fs_c * (double)DEMOD_DEEMPH_US)));
+    d->de_y    = 0.0f;
+    d->level   = 0.0f;
+    d->dc      = 0.0f;
+
+    double sr = d->in_sr ? d->in_sr : fs_c;
+    /* varış zamanı aktarımın sonudur: ilk örneği bir aktarım süresi eskidir */
+    d->lat_fixed_us = (d->xfer_len / 2 + CHAN_HOP + CHAN_OVERLAP / 2) * 1e6 / sr
+                    + half * 1e6 / fs_c;
+    printf("[DEM] Plan: %s %.4f MHz, kanal %u S/s, 48 kHz'e %d dokulu, gecikme siniri %.1f ms\n",
+           MODE_NAME[d->cur_mode], d->cur_freq / 1e6, fs_c, taps, d->lat_fixed_us / 1000.0);
+    if (d->lat_fixed_us > DEMOD_LAT_BUDGET_MS * 1000.0)
+        printf("[DEM] UYARI: %u S/s'de aktarim (%u KB) + kanal adimi %d ms butceyi asiyor\n",
+               (unsigned)sr, d->xfer_len / 1024, DEMOD_LAT_BUDGET_MS);
+    return 0;
+}
+
+/* ── Dedektörler (fs_c hızında, d->aud'a) ───────────────────────── */
+static void detect_fm(Demod *d, const FftCpx *iq, int n) {
+    FftCpx *z = d->zbuf;
+    float  *y = d->aud;
+    const float g = d->fm_gain;
+    z[0] = d->prev;
+    memcpy(z + 1, iq, sizeof(FftCpx) * (size_t)n);
+    d->prev = iq[n - 1];
+
+    /* z[k]·z*[k-1] açısı: anlık frekans */
+    for (int k = 0; k < n; k++) {
+        float re = z[k + 1].r * z[k].r + z[k + 1].i * z[k].i;
+        float im = z[k + 1].i * z[k].r - z[k + 1].r * z[k].i;
+        y[k] = fast_atan2f(im, re) * g;
+    }
+    float sum = 0.0f;
+    for (int k = 0; k < n; k++) sum += y[k];
+    d->dc += blk_alpha(n, d->fs_c, DEMOD_FM_DC_S) * (sum / n - d->dc);
+
+    /* De-emfazi: tek kutuplu alçak geçiren, tek özyinelemeli döngü */
+    const float a = d->de_a, dc = d->dc;
+    float s = d->de_y;
+    for (int k = 0; k < n; k++) {
+        s += a * (y[k] - dc - s);
+        y[k] = s;
+    }
+    d->de_y = s;
+}
+
+static void detect_am(Demod *d, const FftCpx *iq, int n) {
+    float *y = d->aud;
+    for (int k = 0; k < n; k++)
+        y[k] = sqrtf(iq[k].r * iq[k].r + iq[k].i * iq[k].i);
+    float sum = 0.0f;
+    for (int k = 0; k < n; k++) sum += y[k];
+    float mean = sum / n;
+    if (d->level <= 0.0f) d->level = mean;
+    else                  d->level += blk_alpha(n, d->fs_c, DEMOD_AM_S) * (mean - d->level);
+
+    /* Taşıyıcıya göre modülasyon: %100'de ±0.5 */
+    const float lv = d->level, inv = 0.5f / (d->level + 1e-9f);
+    for (int k = 0; k < n; k++) y[k] = (y[k] - lv) * inv;
+}
+
+/* ── Yeniden örnekleme ────────────────────────────────────────── */
+static void rs_push(Demod *d, const float *re, const FftCpx *iq, int n) {
+    if (d->rs_fill + n > d->rs_cap) n = d->rs_cap - d->rs_fill;   /* planla sınırlı */
+    float *xr = d->rs_re + d->rs_fill, *xi = d->rs_im + d->rs_fill;
+    if (re) {
+        memcpy(xr, re, sizeof(float) * (size_t)n);
+    } else {
+        for (int k = 0; k < n; k++) {
+            xr[k] = iq[k].r;
+            xi[k] = iq[k].i;
+        }
+    }
+    d->rs_fill += n;
+}
+
+/* Dört toplayıcı: kayan nokta indirgemesi -ffast-math olmadan da SIMD'e gider */
+static inline float dot(const float *restrict h, const float *restrict x, int taps) {
+    float a0 = 0.0f, a1 = 0.0f, a2 = 0.0f, a3 = 0.0f;
+    for (int j = 0; j < taps; j += 4) {
+        a0 += h[j]     * x[j];
+        a1 += h[j + 1] * x[j + 1];
+        a2 += h[j + 2] * x[j + 2];
+        a3 += h[j + 3] * x[j + 3];
+    }
+    return (a0 + a1) + (a2 + a3);
+}
+
+/* Hazır 48 kHz örneklerini üret (cpx: sanal kol da); üretilen sayı */
+static int rs_run(Demod *d, int cpx) {
+    const int taps = d->rs_taps, half = d->rs_half;
+    int m = 0;
+    while ((int)d->rs_pos + half < d->rs_fill && m < d->pcm_cap) {
+        int i0 = (int)d->rs_pos;
+        int p  = (int)((d->rs_pos - i0) * DEMOD_RS_PHASES);
+        const float *h = d->rs_h + (size_t)p * (size_t)taps;
+        int base = i0 - half + 1;
+        d->o_re[m] = dot(h, d->rs_re + base, taps);
+        if (cpx) d->o_im[m] = dot(h, d->rs_im + base, taps);
+        m++;
+        d->rs_pos += d->rs_step;
+    }
+    int drop = (int)d->rs_pos - half + 1;
+    if (drop > 0) {
+        int keep = d->rs_fill - drop;
+        memmove(d->rs_re, d->rs_re + drop, sizeof(float) * (size_t)keep);
+        if (cpx) memmove(d->rs_im, d->rs_im + drop, sizeof(float) * (size_t)keep);
+        d->rs_fill = keep;
+        d->rs_pos -= drop;
+    }
+    return m;
+}
+
+/* SSB: taşıyıcıyı sıfıra kaydır, reel kısım, blok hızında AGC */
+static void ssb_out(Demod *d, int m) {
+    const float cr = (float)cos(d->rot_phase), ci = (float)sin(d->rot_phase);
+    float *y = d->o_re;
+    for (int k = 0; k < m; k++) {
+        float rr = d->rot[k].r * cr - d->rot[k].i * ci;
+        float ri = d->rot[k].r * ci + d->rot[k].i * cr;
+        y[k] = d->o_re[k] * rr - d->o_im[k] * ri;
+    }
+    d->rot_phase = fmod(d->rot_phase + d->rot_w * m, 2.0 * M_PI);
+
+    float pw = 0.0f;
+    for (int k = 0; k < m; k++) pw += y[k] * y[k];
+    float rms = sqrtf(pw / m);
+    if (rms > d->level) d->level += 0.5f * (rms - d->level);   /* hızlı saldırı */
+    else d->level += blk_alpha(m, DEMOD_AUDIO_SR, DEMOD_AGC_S) * (rms - d->level);
+    float g = 0.25f / (d->level + 1e-9f);
+    if (g > DEMOD_AGC_MAX) g = DEMOD_AGC_MAX;
+    for (int k = 0; k < m; k++) y[k] *= g;
+}
+
+/* Kanal ayırıcı callback'i (demod thread'i, kanal kilidi tutulurken) */
+static void on_demod_chan(const Chan *ch, const FftCpx *iq, int n, void *ud) {
+    Demod *d = (Demod *)ud;
+    if (ch->id != d->ch_id || n <= 0) return;
+    if (ch->plan_id != d->plan_id || ch->out_sr != d->fs_c) {
+        d->plan_id = ch->plan_id;
+        if (demod_plan(d, ch->out_sr) != 0) return;
+    }
+    if (!d->fs_c) return;
+
+    int cpx = 0;
+    switch (d->cur_mode) {
+    case DEMOD_FM: detect_fm(d, iq, n); rs_push(d, d->aud, NULL, n); break;
+    case DEMOD_AM: detect_am(d, iq, n); rs_push(d, d->aud, NULL, n); break;
+    default:       cpx = 1;             rs_push(d, NULL, iq, n);     break;
+    }
+    int m = rs_run(d, cpx);
+    if (m <= 0) return;
+    if (cpx) ssb_out(d, m);
+
+    for (int k = 0; k < m; k++) {
+        float v = d->o_re[k] * 32767.0f;
+        v = v > 32767.0f ? 32767.0f : v < -32768.0f ? -32768.0f : v;
+        d->pcm[k] = (int16_t)lrintf(v);
+    }
+    sink_write(d, d->pcm, m);
+    if (d->stats)
+        stats_record(d->stats, STAT_H_DEMOD_LAT,
+                     stats_now_us() - d->t_newest_us + (uint64_t)d->lat_fixed_us);
+}
+
+/* ── Thread ───────────────────────────────────────────────────── */
+
+/* Bekleyen isteği uygula: eski kanalı kaldır, yenisini ekle */
+static void apply_request(Demod *d) {
+    mutex_lock(&d->cs);
+    int      mode = d->mode;
+    uint32_t f    = d->freq_hz, bw = d->bw_hz;
+    d->seq = d->req_seq;
+    mutex_unlock(&d->cs);
+
+    if (d->ch_id >= 0) chan_remove(d->ch, d->ch_id);
+    d->ch_id    = -1;
+    d->fs_c     = 0;   /* yeni kanal ilk çıkışında planlanır */
+    d->plan_id  = 0;
+    d->cur_mode = mode;
+    d->cur_freq = f;
+    d->cur_bw   = bw;
+    if (mode == DEMOD_OFF || !f) return;
+
+    uint32_t cf = mode == DEMOD_USB ? f + bw / 2 : mode == DEMOD_LSB ? f - bw / 2 : f;
+    d->ch_id = chan_add(d->ch, cf, bw);
+}
+
+static void demod_thread(void *arg) {
+    Demod *d = (Demod *)arg;
+    while (d->alive || d->ri != d->wi) {
+        mutex_lock(&d->cs);
+        if (d->ri == d->wi && d->alive && d->seq == d->req_seq)
+            cond_wait_ms(&d->cv, &d->cs, 50);
+        int has_data = (d->ri != d->wi);
+        int req      = (d->seq != d->req_seq);
+        mutex_unlock(&d->cs);
+
+        if (req) apply_request(d);
+        if (!has_data) continue;
+
+        const SdrBlockMeta *m = &d->meta[d->ri % DEMOD_RING];
+        if (d->ch_id >= 0 && !m->settling) {   /* oturmamış blok kanala girmez */
+            uint64_t t0 = stats_now_us();
+            d->t_newest_us = m->t_us;
+            d->in_sr       = m->sr;
+            chan_feed(d->ch, d->ring[d->ri % DEMOD_RING], m);
+            if (d->stats) stats_since(d->stats, STAT_H_DEMOD, t0);
+        }
+        mutex_lock(&d->cs);
+        d->ri++;
+        mutex_unlock(&d->cs);
+    }
+    sink_close(d);
+}
+
+/* ── Genel API ────────────────────────────────────────────────── */
+static void release(Demod *d) {
+    free(d->ring); free(d->meta); free(d->ch);   free(d->zbuf); free(d->aud);
+    free(d->rs_h); free(d->rs_re); free(d->rs_im);
+    free(d->o_re); free(d->o_im);  free(d->rot);  free(d->pcm);
+    cond_free(&d->cv);
+    mutex_free(&d->cs);
+    memset(d, 0, sizeof(*d));
+    d->ch_id = -1;
+}
+
+int demod_init(Demod *d) {
+    memset(d, 0, sizeof(*d));
+    d->cpu      = -1;
+    d->ch_id    = -1;
+    d->xfer_len = SDR_XFER_LEN_DEF;
+    snprintf(d->dir, sizeof(d->dir), "%s", REC_DEFAULT_DIR);
+    mutex_init(&d->cs);
+    cond_init(&d->cv);
+    d->ring = malloc(sizeof(*d->ring) * DEMOD_RING);
+    d->meta = malloc(sizeof(*d->meta) * DEMOD_RING);
+    d->ch   = malloc(sizeof(*d->ch));
+    d->zbuf = malloc(sizeof(FftCpx) * (CHAN_HOP + 1));
+    d->aud  = malloc(sizeof(float) * CHAN_HOP);
+    if (!d->ring || !d->meta || !d->ch || !d->zbuf || !d->aud ||
+        chan_init(d->ch, on_demod_chan, d) != 0) {
+        fprintf(stderr, "[DEM] Bellek hatasi: demod kapali\n");
+        release(d);
+        return -1;
+    }
+    return 0;
+}
+
+void demod_free(Demod *d) {
+    if (!d->ring) return;   /* demod_init başarısızdı */
+    chan_free(d->ch);
+    release(d);
+}
+
+void demod_start(Demod *d) {
+    if (!d->ring || d->alive) return;
+    d->ri = d->wi = 0;
+    d->alive = 1;
+    ThreadOpts o = { d->cpu, 0 };
+    thread_start(&d->thread, demod_thread, d, &o);
+}
+
+void demod_stop(Demod *d) {
+    if (!d->alive) return;
+    mutex_lock(&d->cs);
+    d->alive = 0;
+    cond_signal(&d->cv);
+    mutex_unlock(&d->cs);
+    thread_join(&d->thread);
+    if (d->ch_id >= 0) chan_remove(d->ch, d->ch_id);
+    d->ch_id = -1;
+    if (d->drops)
+        printf("[DEM] UYARI: halka doluyken %u blok atildi\n", d->drops);
+}
+
+int demod_push(Demod *d, const uint8_t *blk, const SdrBlockMeta *meta) {
+    if (!d->on || !d->alive) return 0;
+    int dropped = 0;
+    mutex_lock(&d->cs);
+    if (d->wi - d->ri < DEMOD_RING) {
+        memcpy(d->ring[d->wi % DEMOD_RING], blk, REC_BLOCK);
+        d->meta[d->wi % DEMOD_RING] = *meta;
+        d->wi++;
+        cond_signal(&d->cv);
+    } else {
+        d->drops++;
+        dropped = 1;
+    }
+    mutex_unlock(&d->cs);
+    return dropped ? -1 : 0;
+}
+
+void demod_set(Demod *d, int mode, uint32_t freq_hz, uint32_t bw_hz) {
+    if (mode < 0 || mode >= DEMOD_COUNT) return;
+    if (!bw_hz) bw_hz = MODE_BW[mode];
+    if (bw_hz > DEMOD_MAX_BW) bw_hz = DEMOD_MAX_BW;
+    mutex_lock(&d->cs);
+    d->mode    = mode;
+    d->freq_hz = freq_hz;
+    d->bw_hz   = bw_hz;
+    d->req_seq++;
+    d->on = (mode != DEMOD_OFF && freq_hz != 0);
+    cond_signal(&d->cv);
+    mutex_unlock(&d->cs);
+    if (d->on)
+        printf("[DEM] %s %.4f MHz, %.1f kHz\n", MODE_NAME[mode], freq_hz / 1e6, bw_hz / 1e3);
+    else if (mode != DEMOD_OFF)
+        printf("[DEM] %s hazir, %.1f kHz: frekans bekleniyor\n", MODE_NAME[mode], bw_hz / 1e3);
+    else
+        printf("[DEM] Kapali\n");
+}
+
+int demod_parse(const char *spec, int *mode, uint32_t *bw_hz) {
+    char name[8];
+    size_t n = strcspn(spec, ":");
+    if (n == 0 || n >= sizeof(name)) return -1;
+    memcpy(name, spec, n);
+    name[n] = '\0';
+    *mode = -1;
+    for (int i = DEMOD_FM; i < DEMOD_COUNT; i++)
+        if (!strcmp(name, MODE_NAME[i])) *mode = i;
+    if (*mode < 0) return -1;
+    *bw_hz = 0;
+    if (spec[n] == ':') {
+        char  *end;
+        double khz = strtod(spec + n + 1, &end);
+        if (end == spec + n + 1 || *end != '\0' || khz <= 0.0 ||
+            khz * 1e3 > DEMOD_MAX_BW)
+            return -1;
+        *bw_hz = (uint32_t)lround(khz * 1e3);
+    }
+    return 0;
+}
+
+const char *demod_mode_name(int mode) {
+    return mode >= 0 && mode < DEMOD_COUNT ? MODE_NAME[mode] : "?";
+}
+
+uint32_t demod_default_bw(int mode) {
+    return mode >= 0 && mode < DEMOD_COUNT ? MODE_BW[mode] : 0;
+}
@@ -0,0 +1,149 @@
+/* detector.c — Artımlı CFAR sinyal dedektörü + olay kaydı */
+#include "detector.h"
+#include <string.h>
+
+/* ── Yardımcı: olayı kapat ────────────────────────────────────── */
+static void event_close(Detector *d, const DetEvent *e) {
+    if ((int)(e->row_stop - e->row_start + 1) < d->min_rows) return;
+
+    d->recent[d->recent_head] = *e;
+    d->recent_head = (d->recent_head + 1) % DET_RECENT;
+    if (d->n_recent < DET_RECENT) d->n_recent++;
+
+    if (d->log) {
+        fprintf(d->log, "%llu,%llu,%.0f,%.0f,%.1f\n",
+                (unsigned long long)e->t_start_ms,
+                (unsigned long long)e->t_stop_ms,
+                (e->f_lo_hz + e->f_hi_hz) / 2.0,
+                e->f_hi_hz - e->f_lo_hz,
+                e->peak_db);
+        d->n_logged++;
+    }
+}
+
+static void close_all(Detector *d) {
+    for (int i = 0; i < d->n_open; i++) event_close(d, &d->open[i]);
+    d->n_open = 0;
+    if (d->log) fflush(d->log);
+}
+
+/* Parçayı (bin_lo..bin_hi) açık bir olaya bağla ya da yeni olay aç */
+static void attach_segment(Detector *d, int lo, int hi, float peak,
+                           uint64_t t_ms) {
+    double bin_hz = d->span_hz / d->bins;
+    double f0     = d->center_hz - d->span_hz / 2.0;
+
+    for (int i = 0; i < d->n_open; i++) {
+        DetEvent *e = &d->open[i];
+        if (hi + d->merge_gap < e->bin_lo || lo - d->merge_gap > e->bin_hi)
+            continue;
+        if (lo < e->bin_lo) e->bin_lo = lo;
+        if (hi > e->bin_hi) e->bin_hi = hi;
+        if (peak > e->peak_db) e->peak_db = peak;
+        e->row_stop  = d->row;
+        e->t_stop_ms = t_ms;
+        e->f_lo_hz   = f0 + e->bin_lo * bin_hz;
+        e->f_hi_hz   = f0 + (e->bin_hi + 1) * bin_hz;
+        return;
+    }
+    if (d->n_open >= DET_MAX_OPEN) return;   /* tablo dolu: parça yok sayılır */
+
+    DetEvent *e = &d->open[d->n_open++];
+    d->n_started++;
+    e->t_start_ms = e->t_stop_ms = t_ms;
+    e->row_start  = e->row_stop  = d->row;
+    e->bin_lo     = lo;
+    e->bin_hi     = hi;
+    e->peak_db    = peak;
+    e->f_lo_hz    = f0 + lo * bin_hz;
+    e->f_hi_hz    = f0 + (hi + 1) * bin_hz;
+}
+
+/* ── Genel API ────────────────────────────────────────────────── */
+void detector_init(Detector *d) {
+    memset(d, 0, sizeof(*d));
+    d->guard     = 4;
+    d->window    = 16;
+    d->thresh_db = 10.0f;
+    d->merge_gap = 2;
+    d->hang_rows = 3;
+    d->min_rows  = 2;
+}
+
+int detector_open_log(Detector *d, const char *path) {
+    d->log = fopen(path, "a");
+    if (!d->log) {
+        fprintf(stderr, "[DET] Gunluk acilamadi: %s\n", path);
+        return -1;
+    }
+    fseek(d->log, 0, SEEK_END);
+    if (ftell(d->log) == 0)
+        fprintf(d->log, "t_start_ms,t_stop_ms,freq_hz,bw_hz,peak_db\n");
+    printf("[DET] Gunluk: %s\n", path);
+    return 0;
+}
+
+void detector_free(Detector *d) {
+    close_all(d);
+    if (d->log) { fclose(d->log); d->log = NULL; }
+}
+
+void detector_process(Detector *d, const float *psd, int bins, uint64_t t_ms,
+                      double center_hz, double span_hz) {
+    if (bins > DET_MAX_BINS) bins = DET_MAX_BINS;
+
+    /* Yeniden ayar: eski bin'ler artık başka frekanslar */
+    if (center_hz != d->center_hz || span_hz != d->span_hz || bins != d->bins) {
+        close_all(d);
+        d->center_hz = center_hz;
+        d->span_hz   = span_hz;
+        d->bins      = bins;
+    }
+    d->row++;
+
+    /* 1. Önek toplamı */
+    const int N = bins;
+    d->prefix[0] = 0.0f;
+    for (int k = 0; k < N; k++) d->prefix[k + 1] = d->prefix[k] + psd[k];
+
+    /* 2. CA-CFAR: her yanda [G+1, G+W] uzaklıktaki hücreler */
+    const int G = d->guard, W = d->window;
+    for (int k = 0; k < N; k++) {
+        int l0 = k - G - W, l1 = k - G;          /* [l0, l1) */
+        int r0 = k + G + 1, r1 = k + G + W + 1;  /* [r0, r1) */
+        if (l0 < 0) l0 = 0;
+        if (l1 < 0) l1 = 0;
+        if (r0 > N) r0 = N;
+        if (r1 > N) r1 = N;
+        int   cnt = (l1 - l0) + (r1 - r0);
+        float sum = (d->prefix[l1] - d->prefix[l0]) + (d->prefix[r1] - d->prefix[r0]);
+        d->hit[k] = cnt > 0 && psd[k] > sum / (float)cnt + d->thresh_db;
+    }
+
+    /* 3. Bitişik tespitleri parçalara ayır, olaylara bağla */
+    int k = 0;
+    while (k < N) {
+        if (!d->hit[k]) { k++; continue; }
+        int   lo = k, hi = k, gap = 0;
+        float peak = psd[k];
+        for (k++; k < N; k++) {
+            if (d->hit[k]) {
+                hi = k; gap = 0;
+                if (psd[k] > peak) peak = psd[k];
+            } else if (++gap > d->merge_gap) {
+                break;
+            }
+        }
+        attach_segment(d, lo, hi, peak, t_ms);
+    }
+
+    /* 4. Uzun süre güncellenmeyen olayları kapat */
+    for (int i = 0; i < d->n_open; ) {
+        if (d->row - d->open[i].row_stop > (uint32_t)d->hang_rows) {
+            event_close(d, &d->open[i]);
+            d->open[i] = d->open[--d->n_open];
+        } else {
+            i++;
+        }
+    }
+}
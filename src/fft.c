@@ -1,5 +1,6 @@
 /* fft.c — Hann penceresi + Cooley-Tukey FFT + PSD hesabı */
 #include "fft.h"
+#include "fftq.h"
 #include <math.h>
 #include <string.h>
 
@@ -7,18 +8,28 @@
 #define M_PI 3.14159265358979323846
 #endif
 
-typedef struct { float r, i; } Cf;  
+typedef FftCpx Cf;
 
 static float s_hann[FFT_SIZE];
-static Cf    s_buf [FFT_SIZE];
+static Cf    s_tw[FFT_CPX_MAX / 2];   /* e^{-j2πk/FFT_CPX_MAX} */
+static int   s_fixed = 0;
 
 void fft_init(void) {
     for (int n = 0; n < FFT_SIZE; n++)
         s_hann[n] = 0.5f * (1.0f - cosf(2.0f * (float)M_PI * n / (FFT_SIZE - 1)));
+    /* double ile: büyük boylarda özyinelemeli twiddle hatası birikmesin */
+    for (int k = 0; k < FFT_CPX_MAX / 2; k++) {
+        double a = -2.0 * M_PI * k / FFT_CPX_MAX;
+        s_tw[k] = (Cf){ (float)cos(a), (float)sin(a) };
+    }
+    fftq_init();
 }
 
-/* Yerinde Cooley-Tukey (radix-2, DIT) */
-static void fft_inplace(Cf *x, int N) {
+void fft_set_fixed(int on) { s_fixed = on ? 1 : 0; }
+int  fft_is_fixed(void)    { return s_fixed; }
+
+/* Yerinde Cooley-Tukey (radix-2, DIT); twiddle tablodan, adım FFT_CPX_MAX/len */
+static void fft_inplace(Cf *x, int N, int inverse) {
     /* Bit-reversal permutation */
     for (int i = 1, j = 0; i < N; i++) {
         int bit = N >> 1;
@@ -27,12 +38,12 @@ static void fft_inplace(Cf *x, int N) {
         if (i < j) { Cf t = x[i]; x[i] = x[j]; x[j] = t; }
     }
     /* Butterfly */
+    float sgn = inverse ? -1.0f : 1.0f;
     for (int len = 2; len <= N; len <<= 1) {
-        float ang = -2.0f * (float)M_PI / len;
-        Cf wl = { cosf(ang), sinf(ang) };
+        int step = FFT_CPX_MAX / len;
         for (int i = 0; i < N; i += len) {
-            Cf w = { 1.0f, 0.0f };
             for (int j = 0; j < len / 2; j++) {
+                Cf w = { s_tw[j * step].r, sgn * s_tw[j * step].i };
                 Cf u = x[i + j];
                 Cf v = {
                     x[i+j+len/2].r * w.r - x[i+j+len/2].i * w.i,
@@ -40,28 +51,50 @@ static void fft_inplace(Cf *x, int N) {
                 };
                 x[i + j]         = (Cf){ u.r + v.r, u.i + v.i };
                 x[i + j + len/2] = (Cf){ u.r - v.r, u.i - v.i };
-                float nr = w.r * wl.r - w.i * wl.i;
-                float ni = w.r * wl.i + w.i * wl.r;
-                w.r = nr; w.i = ni;
             }
         }
     }
 }
 
-void fft_compute_psd(const uint8_t *raw, float *psd_out) {
+void fft_cpx(FftCpx *x, int n, int inverse) {
+    fft_inplace(x, n, inverse);
+}
+
+void fft_compute_power(const uint8_t *raw, float *pwr_out) {
+    if (s_fixed) { fftq_compute_power(raw, pwr_out); return; }
+
+    Cf buf[FFT_SIZE];   /* yığında: DSP thread'leri aynı anda çağırabilir */
+
     /* Ham uint8 IQ → pencereli kompleks */
     for (int n = 0; n < FFT_SIZE; n++) {
-        s_buf[n].r = ((float)raw[2*n]   - 127.5f) / 128.0f * s_hann[n];
-        s_buf[n].i = ((float)raw[2*n+1] - 127.5f) / 128.0f * s_hann[n];
+        buf[n].r = ((float)raw[2*n]   - 127.5f) / 128.0f * s_hann[n];
+        buf[n].i = ((float)raw[2*n+1] - 127.5f) / 128.0f * s_hann[n];
     }
 
-    fft_inplace(s_buf, FFT_SIZE);
+    fft_inplace(buf, FFT_SIZE, 0);
 
-    /* fftshift + dB dönüşümü */
+    /* fftshift + |X|^2 */
     int half = FFT_SIZE / 2;
     for (int k = 0; k < FFT_SIZE; k++) {
         int sk = (k + half) % FFT_SIZE;
-        float m2 = s_buf[sk].r * s_buf[sk].r + s_buf[sk].i * s_buf[sk].i;
-        psd_out[k] = 10.0f * log10f(m2 + 1e-10f);
+        pwr_out[k] = buf[sk].r * buf[sk].r + buf[sk].i * buf[sk].i;
     }
+}
+
+void fft_power_db(const float *pwr, float scale, float *db_out, int n) {
+    if (s_fixed) {
+        for (int k = 0; k < n; k++) db_out[k] = fftq_db_pow(pwr[k] * scale);
+        return;
+    }
+    for (int k = 0; k < n; k++)
+        db_out[k] = 10.0f * log10f(pwr[k] * scale + 1e-10f);
+}
+
+void fft_compute_psd(const uint8_t *raw, float *psd_out) {
+    if (s_fixed) { fftq_compute_psd(raw, psd_out); return; }
+    fft_compute_power(raw, psd_out);
+
+    /* dB dönüşümü */
+    for (int k = 0; k < FFT_SIZE; k++)
+        psd_out[k] = 10.0f * log10f(psd_out[k] + 1e-10f);
 }
\ No newline at end of file
@@ -0,0 +1,382 @@
+/* fftq.c — Sabit noktalı (int16, blok kayan noktalı) FFT + güç / dB yolu */
+#include "fftq.h"
+#include <math.h>
+#include <string.h>
+
+/*
+ * Vektör katmanı: x86'da SSE2 tamsayı komutları; diğer mimarilerde (ARM
+ * NEON vb.) GCC / Clang vektör uzantıları. İkisi de yoksa düz C. Üç yol da
+ * aynı yuvarlamayı ve SSE2'nin doyuran (saturating) int16 aritmetiğini
+ * yapar; sınırda bir toplam taştığında da çıktılar bit düzeyinde aynıdır.
+ */
+#if defined(__SSE2__)
+#define FQ_SSE2 1
+#include <emmintrin.h>
+#elif defined(__GNUC__) && defined(__has_builtin)
+#if __has_builtin(__builtin_shufflevector) && __has_builtin(__builtin_convertvector)
+#define FQ_VEC 1
+typedef int16_t v8s __attribute__((vector_size(16)));
+typedef int16_t v4s __attribute__((vector_size(8)));
+typedef int32_t v4i __attribute__((vector_size(16)));
+#endif
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/*
+ * Kelebek çıkışı bileşen başına en çok (1 + √2) kat büyür; aşama girişi
+ * bu sınırın altındaysa int16 taşmaz. Üstündeyse blok kaydırılır.
+ */
+#define FQ_LIMIT   13572            /* 32767 / (1 + √2) */
+#define FQ_IN_MAX  8191             /* giriş: ilk radix-4 geçişi 4 kat büyütür */
+
+static int16_t  s_hq[FFT_SIZE];         /* Hann, Q15 */
+static uint16_t s_rev[FFT_SIZE];        /* bit-ters indeks */
+static int16_t  s_wa[2 * FFT_SIZE];     /* aşama başına {wr, -wi} (madd: gerçek kısım) */
+static int16_t  s_wb[2 * FFT_SIZE];     /* aşama başına {wi,  wr} (madd: sanal kısım) */
+static float    s_log2[256];            /* log2(1 + (i + 0.5) / 256) */
+
+static int16_t q15(double v) {
+    long q = lround(v * 32768.0);
+    if (q >  32767) q =  32767;
+    if (q < -32767) q = -32767;
+    return (int16_t)q;
+}
+
+void fftq_init(void) {
+    int bits = 0;
+    while ((1 << bits) < FFT_SIZE) bits++;
+
+    for (int n = 0; n < FFT_SIZE; n++) {
+        s_hq[n] = q15(0.5 * (1.0 - cos(2.0 * M_PI * n / (FFT_SIZE - 1))));
+        unsigned r = 0;
+        for (int b = 0; b < bits; b++)
+            if (n & (1 << b)) r |= 1u << (bits - 1 - b);
+        s_rev[n] = (uint16_t)r;
+    }
+
+    /* Yarı uzunluğu h olan aşamanın twiddle'ları (h - 1). girdiden başlar */
+    for (int h = 1; h < FFT_SIZE; h <<= 1) {
+        for (int j = 0; j < h; j++) {
+            double  ang = -M_PI * j / h;
+            int16_t wr  = q15(cos(ang));
+            int16_t wi  = q15(sin(ang));
+            int     o   = 2 * (h - 1 + j);
+            s_wa[o] = wr;  s_wa[o + 1] = (int16_t)-wi;
+            s_wb[o] = wi;  s_wb[o + 1] = wr;
+        }
+    }
+
+    for (int i = 0; i < 256; i++)
+        s_log2[i] = (float)(log2(1.0 + (i + 0.5) / 256.0));
+}
+
+/* ── Blok ölçeği ──────────────────────────────────────────────── */
+/* Aşama girişindeki en büyük bileşen m iken gereken yuvarlamalı sağa kaydırma */
+static int stage_shift(int m, int limit) {
+    int s = 0;
+    while (((m + (s ? 1 << (s - 1) : 0)) >> s) > limit) s++;
+    return s;
+}
+
+/* ── Kelebekler ───────────────────────────────────────────────── */
+static inline int imax(int a, int b) { return a > b ? a : b; }
+static inline int iabs(int a)        { return a < 0 ? -a : a; }
+
+/* SSE2 _mm_adds_epi16 / _mm_packs_epi32 ile aynı doyma; |x| de 32767'de kesilir */
+static inline int32_t sat16(int32_t v) { return v > 32767 ? 32767 : v < -32768 ? -32768 : v; }
+static inline int     sabs (int32_t v) { return v < -32767 ? 32767 : iabs(v); }
+
+#ifdef FQ_VEC
+static inline v8s  vload (const int16_t *p)  { v8s v; memcpy(&v, p, 16); return v; }
+static inline void vstore(int16_t *p, v8s v) { memcpy(p, &v, 16); }
+static inline v8s  vmax  (v8s a, v8s b)      { v8s k = a > b; return (a & k) | (b & ~k); }
+/* Doyuran toplama / çıkarma: taşan şeritte işarete göre 32767 / -32768 */
+static inline v8s  vadds (v8s a, v8s b) {
+    v8s r = a + b, o = ((a ^ r) & (b ^ r)) >> 15;
+    return (r & ~o) | (((a >> 15) ^ 0x7FFF) & o);
+}
+static inline v8s  vsubs (v8s a, v8s b) {
+    v8s r = a - b, o = ((a ^ b) & (a ^ r)) >> 15;
+    return (r & ~o) | (((a >> 15) ^ 0x7FFF) & o);
+}
+static inline v8s  vabs  (v8s v)             { v8s z = { 0 }; return vmax(v, vsubs(z, v)); }
+static inline v4i  vsat  (v4i v) {
+    v4i hi = v > 32767, lo = v < -32768;
+    v = (v & ~hi) | (32767 & hi);
+    return (v & ~lo) | (-32768 & lo);
+}
+static inline int  vhmax (v8s v, int m) {
+    for (int k = 0; k < 8; k++) m = imax(m, v[k]);
+    return m;
+}
+#endif
+
+/*
+ * İlk iki aşama (h = 1, 2) birlikte: twiddle'lar 1 ve -i, çarpma yok.
+ * Giriş FQ_IN_MAX ile sınırlı olduğundan 4 katına büyüyen çıkış int16'ya
+ * sığar, kaydırma gerekmez. Dönüş: çıkıştaki en büyük bileşen.
+ */
+static int radix4_first(int16_t *x) {
+    int i = 0, m = 0;
+#ifdef FQ_SSE2
+    /* Vektör = bir radix-4 grubu [c0 c1 c2 c3]; kompleks sayı 32 bit şerit */
+    const __m128i n1 = _mm_setr_epi16(0, 0, -1, -1, 0, 0, -1, -1);   /* c0±c1, c2±c3 */
+    const __m128i n2 = _mm_setr_epi16(0, 0, 0, -1, -1, -1, -1, 0);   /* ±b0, ±(-i)b1 */
+    const __m128i z  = _mm_setzero_si128();
+    __m128i vmax = z;
+    for (; i < FFT_SIZE; i += 4) {
+        __m128i v  = _mm_loadu_si128((const __m128i *)(x + 2 * i));
+        __m128i a  = _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 2, 0, 0));
+        __m128i b  = _mm_shuffle_epi32(v, _MM_SHUFFLE(3, 3, 1, 1));
+        __m128i s1 = _mm_add_epi16(a, _mm_sub_epi16(_mm_xor_si128(b, n1), n1));
+        a = _mm_shuffle_epi32(s1, _MM_SHUFFLE(1, 0, 1, 0));          /* a0 a1 a0 a1 */
+        b = _mm_shuffle_epi32(s1, _MM_SHUFFLE(3, 2, 3, 2));          /* b0 b1 b0 b1 */
+        b = _mm_shufflelo_epi16(b, _MM_SHUFFLE(2, 3, 1, 0));         /* b1 → (bi, br) */
+        b = _mm_shufflehi_epi16(b, _MM_SHUFFLE(2, 3, 1, 0));
+        __m128i o  = _mm_add_epi16(a, _mm_sub_epi16(_mm_xor_si128(b, n2), n2));
+        _mm_storeu_si128((__m128i *)(x + 2 * i), o);
+        vmax = _mm_max_epi16(vmax, _mm_max_epi16(o, _mm_sub_epi16(z, o)));
+    }
+    int16_t lane[8];
+    _mm_storeu_si128((__m128i *)lane, vmax);
+    for (int k = 0; k < 8; k++) m = imax(m, lane[k]);
+#elif defined(FQ_VEC)
+    const v8s n1 = { 0, 0, -1, -1, 0, 0, -1, -1 };
+    const v8s n2 = { 0, 0, 0, -1, -1, -1, -1, 0 };
+    v8s vm = { 0 };
+    for (; i < FFT_SIZE; i += 4) {
+        v8s v  = vload(x + 2 * i);
+        v8s a  = __builtin_shufflevector(v, v, 0, 1, 0, 1, 4, 5, 4, 5);
+        v8s b  = __builtin_shufflevector(v, v, 2, 3, 2, 3, 6, 7, 6, 7);
+        v8s s1 = a + ((b ^ n1) - n1);
+        a = __builtin_shufflevector(s1, s1, 0, 1, 2, 3, 0, 1, 2, 3);
+        b = __builtin_shufflevector(s1, s1, 4, 5, 7, 6, 4, 5, 7, 6);   /* b1 → (bi, br) */
+        v8s o  = a + ((b ^ n2) - n2);
+        vstore(x + 2 * i, o);
+        vm = vmax(vm, vabs(o));
+    }
+    m = vhmax(vm, m);
+#endif
+    for (; i < FFT_SIZE; i += 4) {
+        int16_t *p = x + 2 * i;
+        int a0r = p[0] + p[2], a0i = p[1] + p[3];   /* c0 + c1 */
+        int a1r = p[0] - p[2], a1i = p[1] - p[3];   /* c0 - c1 */
+        int b0r = p[4] + p[6], b0i = p[5] + p[7];   /* c2 + c3 */
+        int b1r = p[4] - p[6], b1i = p[5] - p[7];   /* c2 - c3, ardından ·(-i) */
+        int o[8] = {
+            a0r + b0r, a0i + b0i,  a1r + b1i, a1i - b1r,
+            a0r - b0r, a0i - b0i,  a1r - b1i, a1i + b1r,
+        };
+        for (int k = 0; k < 8; k++) {
+            p[k] = (int16_t)o[k];
+            m    = imax(m, iabs(o[k]));
+        }
+    }
+    return m;
+}
+
+/*
+ * a ± b·w; a, b: {re, im} çifti, girişler önce s bit yuvarlamalı kaydırılır
+ * (blok ölçeği ayrı bir geçiş yerine kelebeğe katlanır). Giriş FQ_LIMIT
+ * altında olduğundan çıkış pratikte taşmaz; yuvarlama payı sınırı aşarsa
+ * her ara toplam SSE2 gibi int16'ya doyurulur, iki yol bit düzeyinde aynı.
+ */
+static inline int bfly1(int16_t *a, int16_t *b, const int16_t *wa, const int16_t *wb,
+                        int s, int m) {
+    int32_t rs = s ? 1 << (s - 1) : 0;
+    int32_t ar = sat16(a[0] + rs) >> s, ai = sat16(a[1] + rs) >> s;
+    int32_t br = sat16(b[0] + rs) >> s, bi = sat16(b[1] + rs) >> s;
+    int32_t vr = sat16((br * wa[0] + bi * wa[1] + (1 << 14)) >> 15);
+    int32_t vi = sat16((br * wb[0] + bi * wb[1] + (1 << 14)) >> 15);
+    int32_t pr = sat16(ar + vr), pi = sat16(ai + vi);
+    int32_t qr = sat16(ar - vr), qi = sat16(ai - vi);
+    a[0] = (int16_t)pr;  a[1] = (int16_t)pi;
+    b[0] = (int16_t)qr;  b[1] = (int16_t)qi;
+    m = imax(m, imax(sabs(pr), sabs(pi)));
+    return imax(m, imax(sabs(qr), sabs(qi)));
+}
+
+#ifdef FQ_SSE2
+/* Dört kompleks kelebek: _mm_madd_epi16 çiftleri toplar → br*wr - bi*wi tek komut */
+static inline __m128i bfly4(int16_t *a, int16_t *b, const int16_t *wa, const int16_t *wb,
+                            __m128i sh, __m128i rs, __m128i vmax) {
+    const __m128i rnd = _mm_set1_epi32(1 << 14);
+    const __m128i z   = _mm_setzero_si128();
+    __m128i u  = _mm_sra_epi16(_mm_adds_epi16(_mm_loadu_si128((const __m128i *)a), rs), sh);
+    __m128i v  = _mm_sra_epi16(_mm_adds_epi16(_mm_loadu_si128((const __m128i *)b), rs), sh);
+    __m128i re = _mm_madd_epi16(v, _mm_loadu_si128((const __m128i *)wa));
+    __m128i im = _mm_madd_epi16(v, _mm_loadu_si128((const __m128i *)wb));
+    re = _mm_srai_epi32(_mm_add_epi32(re, rnd), 15);
+    im = _mm_srai_epi32(_mm_add_epi32(im, rnd), 15);
+    __m128i t  = _mm_packs_epi32(re, im);                        /* r0..r3 i0..i3 */
+    __m128i vt = _mm_unpacklo_epi16(t, _mm_unpackhi_epi64(t, t)); /* r0 i0 r1 i1 .. */
+    __m128i p  = _mm_adds_epi16(u, vt);
+    __m128i q  = _mm_subs_epi16(u, vt);
+    _mm_storeu_si128((__m128i *)a, p);
+    _mm_storeu_si128((__m128i *)b, q);
+    vmax = _mm_max_epi16(vmax, _mm_max_epi16(p, _mm_subs_epi16(z, p)));
+    return _mm_max_epi16(vmax, _mm_max_epi16(q, _mm_subs_epi16(z, q)));
+}
+#elif defined(FQ_VEC)
+/* Aynısı vektör uzantılarıyla: re / im şeritleri ayrılıp int32'de çarpılır, doyurulur */
+static inline v8s bfly4(int16_t *a, int16_t *b, const int16_t *wa, const int16_t *wb,
+                        int s, int16_t rs, v8s vm) {
+    v8s r  = { 0 };
+    v8s u  = vadds(vload(a), r + rs) >> s;
+    v8s v  = vadds(vload(b), r + rs) >> s;
+    v8s ta = vload(wa), tb = vload(wb);
+    v4i br = __builtin_convertvector(__builtin_shufflevector(v, v, 0, 2, 4, 6), v4i);
+    v4i bi = __builtin_convertvector(__builtin_shufflevector(v, v, 1, 3, 5, 7), v4i);
+    v4i wr = __builtin_convertvector(__builtin_shufflevector(ta, ta, 0, 2, 4, 6), v4i);
+    v4i wi = __builtin_convertvector(__builtin_shufflevector(tb, tb, 0, 2, 4, 6), v4i);
+    v4s vr = __builtin_convertvector(vsat((br * wr - bi * wi + (1 << 14)) >> 15), v4s);
+    v4s vi = __builtin_convertvector(vsat((br * wi + bi * wr + (1 << 14)) >> 15), v4s);
+    v8s vt = __builtin_shufflevector(vr, vi, 0, 4, 1, 5, 2, 6, 3, 7);
+    v8s p  = vadds(u, vt);
+    v8s q  = vsubs(u, vt);
+    vstore(a, p);
+    vstore(b, q);
+    return vmax(vm, vmax(vabs(p), vabs(q)));
+}
+#endif
+
+/* Yerinde radix-2 DIT, bit-ters sıralı girişle. Dönüş: toplam sağa kaydırma. */
+static int fftq_inplace(int16_t *x) {
+    int m = radix4_first(x);
+    int e = 0;
+
+    for (int h = 4; h < FFT_SIZE; h <<= 1) {
+        int s = stage_shift(m, FQ_LIMIT);
+        e += s;
+        m  = 0;
+
+        const int16_t *wa = s_wa + 2 * (h - 1);
+        const int16_t *wb = s_wb + 2 * (h - 1);
+#ifdef FQ_SSE2
+        __m128i sh   = _mm_cvtsi32_si128(s);
+        __m128i rs   = _mm_set1_epi16((int16_t)(s ? 1 << (s - 1) : 0));
+        __m128i vmax = _mm_setzero_si128();
+#elif defined(FQ_VEC)
+        int16_t rs   = (int16_t)(s ? 1 << (s - 1) : 0);
+        v8s     vm   = { 0 };
+#endif
+        for (int i = 0; i < FFT_SIZE; i += 2 * h) {
+            int j = 0;
+#ifdef FQ_SSE2
+            for (; j + 4 <= h; j += 4)
+                vmax = bfly4(x + 2 * (i + j), x + 2 * (i + j + h),
+                             wa + 2 * j, wb + 2 * j, sh, rs, vmax);
+#elif defined(FQ_VEC)
+            for (; j + 4 <= h; j += 4)
+                vm = bfly4(x + 2 * (i + j), x + 2 * (i + j + h),
+                           wa + 2 * j, wb + 2 * j, s, rs, vm);
+#endif
+            for (; j < h; j++)
+                m = bfly1(x + 2 * (i + j), x + 2 * (i + j + h),
+                          wa + 2 * j, wb + 2 * j, s, m);
+        }
+#ifdef FQ_SSE2
+        int16_t lane[8];
+        _mm_storeu_si128((__m128i *)lane, vmax);
+        for (int k = 0; k < 8; k++) m = imax(m, lane[k]);
+#elif defined(FQ_VEC)
+        m = vhmax(vm, m);
+#endif
+    }
+    return e;
+}
+
+/* fftshift'li |X|^2; iki yarı ayrı ayrı ardışık okunur */
+static void mag_half(const int16_t *x, uint32_t *out, unsigned n) {
+    unsigned k = 0;
+#ifdef FQ_SSE2
+    /* madd(v, v) = re² + im²; yalnızca iki bileşen -32768 iken int32 taşar,
+       o da uint32 olarak doğru değerdir */
+    for (; k + 4 <= n; k += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(x + 2 * k));
+        _mm_storeu_si128((__m128i *)(out + k), _mm_madd_epi16(v, v));
+    }
+#elif defined(FQ_VEC)
+    for (; k + 4 <= n; k += 4) {
+        v8s v  = vload(x + 2 * k);
+        v4i re = __builtin_convertvector(__builtin_shufflevector(v, v, 0, 2, 4, 6), v4i);
+        v4i im = __builtin_convertvector(__builtin_shufflevector(v, v, 1, 3, 5, 7), v4i);
+        v4i m2 = re * re + im * im;
+        memcpy(out + k, &m2, 16);
+    }
+#endif
+    for (; k < n; k++)
+        out[k] = (uint32_t)((int32_t)x[2*k] * x[2*k]) +
+                 (uint32_t)((int32_t)x[2*k+1] * x[2*k+1]);
+}
+
+/* ── Genel API ────────────────────────────────────────────────── */
+int fftq_compute_mag(const uint8_t *raw, uint32_t *mag_out) {
+    int16_t x[2 * FFT_SIZE];   /* yığında: farklı thread'lerden aynı anda çağrılabilir */
+
+    /*
+     * Giriş ölçeği: zayıf blok (ör. AGC kapalı, düşük kazanç) birkaç LSB
+     * genliğindedir; en büyük |2·raw - 255| FQ_IN_MAX'a yaklaşacak kadar sola
+     * kaydırılır ki kelebek yuvarlaması sinyale göre küçük kalsın.
+     */
+    uint8_t lo = 255, hi = 0;
+    for (int n = 0; n < FFT_SIZE * 2; n++) {
+        if (raw[n] < lo) lo = raw[n];
+        if (raw[n] > hi) hi = raw[n];
+    }
+    int amax = 2 * hi - 255;
+    if (255 - 2 * lo > amax) amax = 255 - 2 * lo;
+    int s_in = 0;
+    while ((amax << (s_in + 1)) <= FQ_IN_MAX) s_in++;
+
+    /* Ham uint8 IQ → (2·raw - 255)·2^s_in × Hann, bit-ters konuma */
+    for (int n = 0; n < FFT_SIZE; n++) {
+        int32_t h = s_hq[n];
+        int32_t i = ((int32_t)raw[2*n]   * 2 - 255) * (1 << s_in);
+        int32_t q = ((int32_t)raw[2*n+1] * 2 - 255) * (1 << s_in);
+        int r = s_rev[n];
+        x[2*r]     = (int16_t)((i * h + (1 << 14)) >> 15);
+        x[2*r + 1] = (int16_t)((q * h + (1 << 14)) >> 15);
+    }
+
+    int e = fftq_inplace(x);
+
+    int half = FFT_SIZE / 2;
+    mag_half(x + 2 * half, mag_out,        half);
+    mag_half(x,            mag_out + half, half);
+
+    /* X = x_int · 2^e / 2^(s_in + 8)  →  |X|^2 = mag · 2^(2e - 2·s_in - 16) */
+    return 2 * (e - s_in) - 16;
+}
+
+float fftq_db(uint32_t mag, int exp2) {
+    if (!mag) return -100.0f;
+    int      k   = 31 - __builtin_clz(mag);
+    uint32_t idx = (k >= 8) ? (mag >> (k - 8)) & 255u : (mag << (8 - k)) & 255u;
+    return 3.01029996f * ((float)(k + exp2) + s_log2[idx]);   /* 10·log10(2) */
+}
+
+float fftq_db_pow(float p) {
+    if (!(p > 1e-10f)) return -100.0f;
+    uint32_t b;
+    memcpy(&b, &p, sizeof(b));
+    int k = (int)(b >> 23) - 127;
+    return 3.01029996f * ((float)k + s_log2[(b >> 15) & 255u]);
+}
+
+void fftq_compute_power(const uint8_t *raw, float *pwr_out) {
+    uint32_t mag[FFT_SIZE];
+    float    sc = ldexpf(1.0f, fftq_compute_mag(raw, mag));
+    for (int k = 0; k < FFT_SIZE; k++)
+        pwr_out[k] = (float)mag[k] * sc;
+}
+
+void fftq_compute_psd(const uint8_t *raw, float *psd_out) {
+    uint32_t mag[FFT_SIZE];
+    int      e = fftq_compute_mag(raw, mag);
+    for (int k = 0; k < FFT_SIZE; k++)
+        psd_out[k] = fftq_db(mag[k], e);
+}
@@ -0,0 +1,124 @@
+/* iqcorr.c — Akan DC giderme + IQ dengesizliği düzeltmesi */
+#include "iqcorr.h"
+#include <math.h>
+#include <string.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define IQC_MID8   32640   /* 127.5 · 256 */
+
+typedef struct { uint32_t si, sq, sii, sqq, siq; } Moments;
+
+/*
+ * Tek geçişte blok momentleri. Hepsi tamsayı: toplama sırası sonucu
+ * değiştirmez, derleyici -ffast-math olmadan da vektörleştirir.
+ * FFT_SIZE · 255² < 2^32, taşma yok.
+ */
+static void moments(const uint8_t *restrict in, Moments *m) {
+    uint32_t si = 0, sq = 0, sii = 0, sqq = 0, siq = 0;
+    for (int n = 0; n < FFT_SIZE; n++) {
+        uint32_t i = in[2 * n], q = in[2 * n + 1];
+        si  += i;
+        sq  += q;
+        sii += i * i;
+        sqq += q * q;
+        siq += i * q;
+    }
+    m->si = si; m->sq = sq; m->sii = sii; m->sqq = sqq; m->siq = siq;
+}
+
+/*
+ * Düzeltmeyi uygula: Q8 ara değer, Q12 katsayı, hata geri beslemeli
+ * uint8 nicemleme. Kesilen alt 8 bit sonraki örneğe eklenir (ei / eq,
+ * bloklar arası taşınır): çıkışın uzun dönem ortalaması ve DC / kazanç /
+ * faz düzeltmesinin kesirli kısmı tam korunur.
+ */
+static void apply(const uint8_t *restrict in, uint8_t *restrict out,
+                  int32_t mi8, int32_t mq8, int32_t kqq, int32_t kqi,
+                  int32_t *ei, int32_t *eq) {
+    int32_t e_i = *ei, e_q = *eq;
+    for (int n = 0; n < FFT_SIZE; n++) {
+        int32_t ic = ((int32_t)in[2 * n]     << 8) - mi8;
+        int32_t qc = ((int32_t)in[2 * n + 1] << 8) - mq8;
+        int32_t ai = ic + IQC_MID8 + e_i;
+        int32_t aq = ((kqq * qc + kqi * ic + 2048) >> 12) + IQC_MID8 + e_q;
+        e_i = ai & 0xFF;   /* taban nicemleme artığı, [0, 255] */
+        e_q = aq & 0xFF;
+        int32_t yi = ai >> 8, yq = aq >> 8;
+        yi = yi < 0 ? 0 : yi > 255 ? 255 : yi;
+        yq = yq < 0 ? 0 : yq > 255 ? 255 : yq;
+        out[2 * n]     = (uint8_t)yi;
+        out[2 * n + 1] = (uint8_t)yq;
+    }
+    *ei = e_i;
+    *eq = e_q;
+}
+
+/* Süzülmüş momentlerden sabit noktalı katsayılar */
+static void update_coeffs(IqCorr *c) {
+    c->mi8 = (int32_t)lrintf((127.5f + c->dc_i) * 256.0f);
+    c->mq8 = (int32_t)lrintf((127.5f + c->dc_q) * 256.0f);
+
+    float kqq = 1.0f, kqi = 0.0f;
+    if (c->p_i > 1e-3f && c->p_q > 1e-3f) {
+        float alpha = sqrtf(c->p_i / c->p_q);
+        float rho   = c->c_iq / sqrtf(c->p_i * c->p_q);
+        if (rho >  IQC_RHO_MAX) rho =  IQC_RHO_MAX;
+        if (rho < -IQC_RHO_MAX) rho = -IQC_RHO_MAX;
+        float s = 1.0f / sqrtf(1.0f - rho * rho);
+        kqq = alpha * s;
+        kqi = -rho * s;
+        c->gain_db   = -20.0f * log10f(alpha);
+        c->phase_deg = asinf(rho) * (float)(180.0 / M_PI);
+    }
+    /* |k| < 2: Q8 · Q12 çarpımları int32'ye sığar */
+    if (kqq > 1.99f) kqq = 1.99f;
+    if (kqq < 0.50f) kqq = 0.50f;
+    c->k_qq = (int32_t)lrintf(kqq * 4096.0f);
+    c->k_qi = (int32_t)lrintf(kqi * 4096.0f);
+}
+
+/* ── Genel API ────────────────────────────────────────────────── */
+void iqcorr_init(IqCorr *c) {
+    memset(c, 0, sizeof(*c));
+    c->mi8  = c->mq8 = (int32_t)(127.5f * 256.0f);
+    c->k_qq = 4096;
+    c->err_i = c->err_q = 128;   /* ilk örnek en yakına yuvarlanır */
+}
+
+void iqcorr_process(IqCorr *c, const uint8_t *in, uint8_t *out,
+                    uint32_t sample_rate) {
+    if (sample_rate != c->sample_rate && sample_rate) {
+        double blk_ms = FFT_SIZE * 1000.0 / sample_rate;
+        c->a_dc = (float)(1.0 - exp(-blk_ms / IQC_DC_TAU_MS));
+        c->a_iq = (float)(1.0 - exp(-blk_ms / IQC_IQ_TAU_MS));
+        c->sample_rate = sample_rate;
+    }
+
+    Moments m;
+    moments(in, &m);
+    const float inv = 1.0f / FFT_SIZE;
+    float mi  = m.si * inv, mq = m.sq * inv;
+    float vi  = m.sii * inv - mi * mi;
+    float vq  = m.sqq * inv - mq * mq;
+    float cv  = m.siq * inv - mi * mq;
+    mi -= 127.5f;
+    mq -= 127.5f;
+
+    if (!c->seeded) {
+        c->dc_i = mi;  c->dc_q = mq;
+        c->p_i  = vi;  c->p_q  = vq;  c->c_iq = cv;
+        c->seeded = 1;
+    } else {
+        c->dc_i += c->a_dc * (mi - c->dc_i);
+        c->dc_q += c->a_dc * (mq - c->dc_q);
+        c->p_i  += c->a_iq * (vi - c->p_i);
+        c->p_q  += c->a_iq * (vq - c->p_q);
+        c->c_iq += c->a_iq * (cv - c->c_iq);
+    }
+    update_coeffs(c);
+    apply(in, out, c->mi8, c->mq8, c->k_qq, c->k_qi, &c->err_i, &c->err_q);
+    c->blocks++;
+}
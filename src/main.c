@@ -3,8 +3,27 @@
  *
  * Tüm modülleri bir araya getirir:
  *   fft       → Hann penceresi + Cooley-Tukey FFT + PSD
+ *   fftq      → Sabit noktalı (int16, blok kayan noktalı) FFT yolu
  *   sdr       → RTL-SDR cihaz soyutlama
- *   recorder  → Arka plan IQ kayıt (Windows thread)
+ *   rtltcp    → rtl_tcp ağ istemcisi (uzak IQ kaynağı)
+ *   recorder  → Arka plan IQ kayıt thread'i
+ *   thread    → Taşınabilir thread / kilit / atomik katmanı (Win32, pthread)
+ *   sweep     → Geniş bant tarama + panoramik spektrum
+ *   detector  → CFAR sinyal dedektörü + olay günlüğü
+ *   trace     → Max/min/ortalama/tepe izleri
+ *   pipeline  → Cihaz başına USB + DSP + kayıt thread'leri
+ *   stats     → Gecikme histogramları + kayıp sayaçları
+ *   specsrv   → Uzak izleyicilere ikili spektrum yayını
+ *   shmring   → Yerel süreçlere paylaşılan bellek IQ/PSD yayını
+ *   bigfft    → Çok thread'li büyük FFT (four-step, 2^20'ye dek), ince çözünürlük
+ *   multires  → Aynı akıştan eşzamanlı ek çözünürlükler (ör. 256 + 16k bin)
+ *   iqcorr    → Akan DC giderme + IQ kazanç / faz düzeltmesi (hep açık)
+ *   demod     → Tıklanan frekansta FM / AM / USB / LSB, 48 kHz ses çıkışı
+ *   chan      → Hızlı evrişimli çok kanallı dar bant ayırıcı
+ *   snapshot  → Ön tetik IQ halkası + tetiklemeli anlık kayıt
+ *   noisefloor→ Akan gürültü tabanı / yüzdelik kestirimi, otomatik ölçek
+ *   stage     → Eklenti DSP aşamaları (paylaşılan kütüphane, kopyasız halka)
+ *   tilepyr   → Kayıt spektrogramı döşeme piramidi (arşiv görünümü)
  *   render    → SDL2 çizim katmanı + SDL_ttf
  *   widgets   → Slider / Button / TextInput
  *   panel     → Kontrol paneli düzeni + olay işleme
@@ -12,59 +31,609 @@
  * Derleme (MSYS2 MinGW64 terminali):
  *   cd /c/RtlSdr/radar
  *   make
+ * Linux:
+ *   make linux
+ *
+ * Kullanım:
+ *   radar.exe                      cihaz #0
+ *   radar.exe -d 0 -d 1 -s 0042    indeks ve/veya seri no ile birden çok cihaz
+ *   radar.exe -d 1@2,3,4           USB thread'i çekirdek 2, DSP 3, kayıt 4
+ *   radar.exe -r 10.0.0.5:1234     uzak rtl_tcp sunucusu (port varsayılan 1234)
+ *   radar.exe -S 5555              spektrum satırlarını TCP 5555'ten yayınla
+ *   radar.exe -m -d 0              IQ + PSD'yi paylaşılan belleğe yayınla (radar_d0)
+ *   radar.exe -l                   bağlı cihazları listele
+ *   radar.exe -t ...               döşeli görünümle başla
+ *   radar.exe -x 128x16 ...        USB aktarımı 128 KB, 16 tampon (varsayılan 64x16)
+ *   radar.exe -j 5 ...             5 s'de bir <outdir>/stats.json ölçüm dökümü
+ *   radar.exe -o D:\iq ...         kayıt, olay günlüğü ve ölçüm dizini
+ *   radar.exe -P 50 ...            USB + kayıt thread'leri SCHED_FIFO 50 (Linux)
+ *   radar.exe -q ...               sabit noktalı (int16) FFT yolu
+ *   radar.exe -C 145.5:12.5 ...    dar kanal (MHz:kHz), tekrarlanabilir; kayıtta
+ *                                  cf32 dosyası, -m ile radar_<etiket>_ch<N>
+ *   radar.exe -T kayit.pyr ...     tools/spec_tiles çıktısını arşiv görünümünde aç
+ *   radar.exe -B 10:5 ...          son 10 s bellekte; F4 tetikten 10 s önce + 5 s sonra
+ *   radar.exe -B 10:5 -E ...       her yeni dedektör olayı da anlık kaydı tetikler
+ *   radar.exe -b 433.92:25:ci8 ... kayıt yalnız bu pencere (MHz:kHz[:ci8|ci16|cf32]),
+ *                                  desimasyonlu; panelde sağ sürükle ile de seçilir
+ *   radar.exe -F 1M ...            ince çözünürlük: 2^20 noktalı FFT (~2 Hz/bin), F5 açar/kapatır
+ *   radar.exe -K ...               kayıt / anlık kayıt DC + IQ düzeltilmiş blokları yazar
+ *   radar.exe -G 60 -A 500G ...    kaydı 60 s'lik bölütlere böl (ya da -G 2G boyutla),
+ *                                  her bölüte SigMF; dizindeki bütün cihazların
+ *                                  bölütleri toplam 500 GB'ı aşınca en eskiyi sil
+ *   radar.exe -a fm -D 100.1 ...   100.1 MHz'i FM dinle (sol tık frekansı, F7 kipi değiştirir);
+ *                                  ses <outdir>/audio_*.wav, -a usb:2.4 kanal genişliği
+ *   radar.exe -a am -O "|aplay -r 48000 -f S16_LE" ...  sesi bir oynatıcıya boru ile ver
+ *   radar.exe -M 256 -M 16k:8 ...  ek çözünürlükler (boy[:çerçeve/satır]), tekrarlanabilir;
+ *                                  spektrum üstünde iz (F6), düzey başına dedektör
+ *                                  günlüğü, -m ile radar_<etiket>_r<boy>
+ *   radar.exe -L my_stage.dll,x=1 ...  DSP aşama eklentisi yükle (stage_api.h),
+ *                                  tekrarlanabilir; her cihaza bir örnek
  *
  * Klavye kısayolları:
  *   ← →   ±1 MHz     ↑ ↓   ±100 kHz     ESC  Çıkış
+ *   Tab   sonraki cihaz                 F1   döşeli / tekli görünüm
+ *   F2    ölçüm katmanı (sayaçlar, p50/p99 gecikmeler)
+ *   F3    arşiv görünümü (-T): tekerlek zaman, Ctrl+tekerlek frekans
+ *         yakınlaştırır; oklar kaydırır, Home tümünü gösterir
+ *   F4    seçili cihazda anlık kayıt (-B)
+ *   F5    seçili cihazda ince çözünürlük (-F boyu, verilmezse 2^20);
+ *         açıkken tekerlek imleç çevresinde yakınlaştırır, Home tüm bant
+ *   F6    ek çözünürlük izlerini göster / gizle (-M)
+ *   F7    demod kipi: FM → AM → USB → LSB → kapalı
+ *
+ * Fare:
+ *   Sağ sürükle (spektrum / şelale)  alt bant kayıt penceresi; sağ tık tam bant
+ *   Sol tık (spektrum / şelale)      demodülatörü o frekansa kur (tekli görünüm)
  */
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
 
 #include "fft.h"
-#include "sdr.h"
-#include "recorder.h"
+#include "pipeline.h"
 #include "render.h"
 #include "widgets.h"
 #include "panel.h"
 
-/* Şelale tamponu: [satır][fft_bin] */
-static float s_waterfall[WATERFALL_ROWS][FFT_SIZE];
-static float s_psd[FFT_SIZE];
+_Static_assert(PIPE_WF_ROWS == WATERFALL_ROWS,
+               "pipeline ve render sele satir sayisi ayni olmali");
+
+/* İz renkleri (TraceKind sırasıyla) */
+static const SDL_Color TRACE_COLORS[TRACE_COUNT] = {
+    {255,  80,  80, 255},   /* Max  */
+    { 80, 220, 220, 255},   /* Min  */
+    {255, 220,  90, 255},   /* Ort  */
+    {220, 110, 255, 255},   /* Tepe */
+};
+
+/* Ek çözünürlük izlerinin renkleri (düzey sırasıyla) */
+static const SDL_Color MRES_COLORS[MRES_MAX] = {
+    {120, 255, 120, 255},
+    {255, 150, 200, 255},
+    {140, 170, 255, 255},
+    {255, 255, 255, 255},
+};
+
+/* Açık ve son kapanan olayları şelale üstüne çiz */
+static void draw_detections(RenderCtx *ctx, const PipeView *v) {
+    SDL_Color open_c   = {255,  90,  60, 255};
+    SDL_Color closed_c = {255, 200,  80, 255};
+    for (int i = 0; i < v->n_open; i++) {
+        const DetEvent *e = &v->open[i];
+        render_waterfall_mark(ctx, e->bin_lo, e->bin_hi,
+            (int)(v->row - e->row_stop), (int)(v->row - e->row_start), open_c);
+    }
+    for (int i = 0; i < v->n_recent; i++) {
+        const DetEvent *e = &v->recent[i];
+        if (v->row - e->row_stop >= WATERFALL_ROWS) continue;
+        render_waterfall_mark(ctx, e->bin_lo, e->bin_hi,
+            (int)(v->row - e->row_stop), (int)(v->row - e->row_start), closed_c);
+    }
+}
+
+/* Tek hattın spektrum + izler + şelale + olay çizimi (geçerli yerleşimde) */
+static void draw_pipe(RenderCtx *ctx, const Pipeline *pl, const PipeView *v,
+                      int show_mres, Stats *ui) {
+    float fc_mhz = (float)(v->center_hz / 1e6);
+    float bw_mhz = (float)(v->span_hz   / 1e6);
+    if (v->span_hz <= 0.0) {   /* henüz satır yok */
+        fc_mhz = pl->sdr.center_freq / 1e6f;
+        bw_mhz = pl->sdr.sample_rate  / 1e6f;
+    }
+    render_grid    (ctx, fc_mhz, bw_mhz);
+    render_spectrum(ctx, v->psd);
+    for (int i = 0; i < TRACE_COUNT; i++)
+        if ((pl->traces.shown & (1u << i)) && v->trace_seeded)
+            render_trace(ctx, v->trace[i], TRACE_COLORS[i]);
+    for (int i = 0; show_mres && i < v->mres_n; i++) {
+        char buf[24];
+        snprintf(buf, sizeof(buf), "%d bin", v->mres_size[i]);
+        render_trace(ctx, v->mres[i], MRES_COLORS[i]);
+        render_text(ctx, ctx->font_sm, buf, GRAPH_L + GRAPH_W - 70,
+                    ctx->spec_top + 2 + 15 * i, MRES_COLORS[i]);
+    }
+    uint64_t t0 = stats_now_us();
+    render_waterfall(ctx, (const float (*)[FFT_SIZE])v->waterfall);
+    stats_since(ui, STAT_H_RENDER_WF, t0);
+    draw_detections (ctx, v);
+}
+
+/* ── Alt bant seçimi (sağ sürükle) ───────────────────────────── */
+typedef struct {
+    int drag;
+    int x0, x1;
+} BandSel;
+
+/* Görünümün merkez / açıklığı (henüz satır yoksa cihaz ayarı) */
+static void view_span(const Pipeline *pl, const PipeView *v, double *fc, double *span) {
+    *fc   = v->span_hz > 0.0 ? v->center_hz : (double)pl->sdr.center_freq;
+    *span = v->span_hz > 0.0 ? v->span_hz   : (double)pl->sdr.sample_rate;
+}
+
+static double x_to_hz(const Pipeline *pl, const PipeView *v, int x) {
+    double fc, span;
+    view_span(pl, v, &fc, &span);
+    return fc + ((double)(x - GRAPH_L) / GRAPH_W - 0.5) * span;
+}
+
+static int hz_to_x(const Pipeline *pl, const PipeView *v, double hz) {
+    double fc, span;
+    view_span(pl, v, &fc, &span);
+    return GRAPH_L + (int)lround(((hz - fc) / span + 0.5) * GRAPH_W);
+}
 
 /*
- * Async SDR callback'inden kaydediciye köprü.
- * rtlsdr_read_async thread'inden çağrılır; her I/Q bloğunu recorder'a
- * yollar. GUI thread'i bu yolda değildir — veri kaybı yaşanmaz.
+ * Grafik alanında sağ tuşla sürüklenen aralık bir sonraki kaydın alt bant
+ * penceresi olur; sürüklemeden bırakılan sağ tık tam banda döner.
+ * Olay tüketildiyse 1.
  */
-static void on_sdr_data(const uint8_t *buf, uint32_t len, void *ud) {
-    (void)len;
-    recorder_push((RecorderState *)ud, buf);
+static int band_handle_event(BandSel *b, Pipeline *pl, const PipeView *v,
+                             const SDL_Event *ev, const RenderCtx *ctx) {
+    int mx, my;
+    SDL_GetMouseState(&mx, &my);
+    if (ev->type == SDL_MOUSEBUTTONDOWN && ev->button.button == SDL_BUTTON_RIGHT) {
+        if (mx < GRAPH_L || mx >= GRAPH_L + GRAPH_W || my < ctx->spec_top ||
+            my >= ctx->wfall_top + ctx->wfall_h)
+            return 0;
+        b->drag = 1;
+        b->x0   = b->x1 = mx;
+        return 1;
+    }
+    if (!b->drag) return 0;
+    if (ev->type == SDL_MOUSEMOTION) {
+        b->x1 = SDL_max(GRAPH_L, SDL_min(mx, GRAPH_L + GRAPH_W));
+        return 1;
+    }
+    if (ev->type == SDL_MOUSEBUTTONUP && ev->button.button == SDL_BUTTON_RIGHT) {
+        b->drag = 0;
+        RecorderState *rec = &pl->rec;
+        if (abs(b->x1 - b->x0) < 3) {
+            recorder_set_subband(rec, 0, 0, rec->sub_fmt);
+            return 1;
+        }
+        double f0 = x_to_hz(pl, v, b->x0), f1 = x_to_hz(pl, v, b->x1);
+        double fc = round((f0 + f1) / 2.0 / 100.0) * 100.0;   /* 100 Hz adım */
+        recorder_set_subband(rec, (uint32_t)fc, (uint32_t)fabs(f1 - f0), rec->sub_fmt);
+        return 1;
+    }
+    return 0;
+}
+
+/* Sürüklenen ya da seçili alt bant penceresini grafik üstüne çiz */
+static void draw_band(RenderCtx *ctx, const Pipeline *pl, const PipeView *v,
+                      const BandSel *b) {
+    if (b->drag) {
+        render_band(ctx, b->x0, b->x1, (SDL_Color){255, 200, 60, 50});
+    } else if (pl->rec.sub_freq) {
+        double half = pl->rec.sub_bw / 2.0;
+        render_band(ctx, hz_to_x(pl, v, pl->rec.sub_freq - half),
+                    hz_to_x(pl, v, pl->rec.sub_freq + half),
+                    (SDL_Color){60, 210, 130, 40});
+    }
+}
+
+/* ── Demodülatör (sol tık / F7) ──────────────────────────────── */
+
+/*
+ * Grafik alanında sol tık demodülatörü tıklanan frekansa (100 Hz adım)
+ * kurar; kip kapalıysa FM ile açılır, aynı kipte kanal genişliği korunur.
+ * Olay tüketildiyse 1.
+ */
+static int demod_handle_event(Pipeline *pl, const PipeView *v, const SDL_Event *ev,
+                              const RenderCtx *ctx) {
+    if (ev->type != SDL_MOUSEBUTTONDOWN || ev->button.button != SDL_BUTTON_LEFT)
+        return 0;
+    int mx, my;
+    SDL_GetMouseState(&mx, &my);
+    if (mx < GRAPH_L || mx >= GRAPH_L + GRAPH_W || my < ctx->spec_top ||
+        my >= ctx->wfall_top + ctx->wfall_h)
+        return 0;
+    Demod *d    = &pl->demod;
+    int    mode = d->mode != DEMOD_OFF ? d->mode : DEMOD_FM;
+    double f    = round(x_to_hz(pl, v, mx) / 100.0) * 100.0;
+    if (f <= 0.0) return 1;
+    demod_set(d, mode, (uint32_t)f, mode == d->mode ? d->bw_hz : 0);
+    return 1;
+}
+
+/*
+ * İnce mod yakınlaştırması: tekerlek imlecin frekansı sabit kalacak biçimde
+ * açıklığı 0.8 / 1.25 kat değiştirir, Home tüm banda döner. Pencere
+ * DSP thread'inde büyük FFT'nin bin'lerinden seçilir. Olay tüketildiyse 1.
+ */
+static int fine_handle_event(Pipeline *pl, const PipeView *v, const SDL_Event *ev,
+                             const RenderCtx *ctx) {
+    if (!pl->fine_req || !v->fine_log2) return 0;
+    double fc = (double)pl->sdr.center_freq, sr = (double)pl->sdr.sample_rate;
+    if (ev->type == SDL_KEYDOWN && ev->key.keysym.sym == SDLK_HOME) {
+        pipeline_set_fine_zoom(pl, 0.0, 0.0);
+        return 1;
+    }
+    if (ev->type != SDL_MOUSEWHEEL) return 0;
+    int mx, my;
+    SDL_GetMouseState(&mx, &my);
+    if (mx < GRAPH_L || mx >= GRAPH_L + GRAPH_W || my < ctx->spec_top ||
+        my >= ctx->wfall_top + ctx->wfall_h)
+        return 0;
+    double c, span;
+    view_span(pl, v, &c, &span);
+    double f     = ev->wheel.y > 0 ? 0.8 : 1.25;
+    double at    = x_to_hz(pl, v, mx);
+    double min_w = sr / (double)(1 << v->fine_log2) * FFT_SIZE;
+    span *= f;
+    if (span < min_w) span = min_w;
+    if (span >= sr) { pipeline_set_fine_zoom(pl, 0.0, 0.0); return 1; }
+    c = at - (at - c) * f;
+    if (c - span / 2.0 < fc - sr / 2.0) c = fc - sr / 2.0 + span / 2.0;
+    if (c + span / 2.0 > fc + sr / 2.0) c = fc + sr / 2.0 - span / 2.0;
+    pipeline_set_fine_zoom(pl, c - fc, span);
+    return 1;
+}
+
+/* F7: FM → AM → USB → LSB → kapalı → FM, frekans korunur */
+static void demod_cycle(Pipeline *pl) {
+    Demod *d = &pl->demod;
+    demod_set(d, (d->mode + 1) % DEMOD_COUNT, d->freq_hz, 0);
+}
+
+/* Dinlenen kanal şeridi + taşıyıcı çizgisi, üstte kip / gecikme etiketi */
+static void draw_demod(RenderCtx *ctx, const Pipeline *pl, const PipeView *v) {
+    const Demod *d = &pl->demod;
+    if (!d->on) return;
+    double lo = d->freq_hz - d->bw_hz / 2.0, hi = d->freq_hz + d->bw_hz / 2.0;
+    if (d->mode == DEMOD_USB) { lo = d->freq_hz; hi = d->freq_hz + (double)d->bw_hz; }
+    if (d->mode == DEMOD_LSB) { lo = d->freq_hz - (double)d->bw_hz; hi = d->freq_hz; }
+    int x  = hz_to_x(pl, v, d->freq_hz);
+    int x0 = hz_to_x(pl, v, lo), x1 = hz_to_x(pl, v, hi);
+    render_band(ctx, x0, x1 > x0 ? x1 : x0 + 1, (SDL_Color){90, 170, 255, 50});
+    render_line(ctx, x, ctx->spec_top, x, ctx->wfall_top + ctx->wfall_h,
+                (SDL_Color){90, 170, 255, 160});
+
+    char buf[96];
+    snprintf(buf, sizeof(buf), "%s %.4f MHz  %.1f kHz  gecikme p99 %.0f ms",
+             demod_mode_name(d->mode), d->freq_hz / 1e6, d->bw_hz / 1e3,
+             stats_percentile(&pl->stats.h[STAT_H_DEMOD_LAT], 0.99) / 1000.0);
+    render_text(ctx, ctx->font_sm, buf, GRAPH_L + 4, ctx->spec_top + 2,
+                (SDL_Color){90, 170, 255, 255});
+}
+
+/* ── Arşiv görünümü (döşeme piramidi) ───────────────────────── */
+static void pyr_view_reset(PyrView *v, const TilePyr *p) {
+    v->t0 = 0.0;
+    v->t1 = (double)p->hdr->level[0].rows;
+    v->b0 = 0.0;
+    v->b1 = (double)p->hdr->fft_size;
+}
+
+/* [lo, hi) aralığını sınırlar içinde tut, en az min_span genişlikte */
+static void clamp_span(double *lo, double *hi, double lim, double min_span) {
+    double span = *hi - *lo;
+    if (span < min_span) span = min_span;
+    if (span > lim)      span = lim;
+    if (*lo < 0.0)        *lo = 0.0;
+    if (*lo + span > lim) *lo = lim - span;
+    *hi = *lo + span;
+}
+
+/* Eksende (0 = zaman, 1 = frekans) at noktası sabit kalacak biçimde f kat ölçekle */
+static void pyr_view_zoom(PyrView *v, const TilePyr *p, int axis, double at, double f) {
+    double *lo = axis ? &v->b0 : &v->t0, *hi = axis ? &v->b1 : &v->t1;
+    *lo = at - (at - *lo) * f;
+    *hi = at + (*hi - at) * f;
+    if (axis) clamp_span(lo, hi, p->hdr->fft_size, 8.0);
+    else      clamp_span(lo, hi, (double)p->hdr->level[0].rows, 16.0);
 }
 
-static void waterfall_push(const float *psd) {
-    memmove(s_waterfall[0], s_waterfall[1],
-            sizeof(float) * FFT_SIZE * (WATERFALL_ROWS - 1));
-    memcpy(s_waterfall[WATERFALL_ROWS - 1], psd, sizeof(float) * FFT_SIZE);
+/* Görünümü kendi genişliğinin frac katı kadar kaydır */
+static void pyr_view_pan(PyrView *v, const TilePyr *p, int axis, double frac) {
+    double *lo = axis ? &v->b0 : &v->t0, *hi = axis ? &v->b1 : &v->t1;
+    double d = (*hi - *lo) * frac;
+    *lo += d;
+    *hi += d;
+    if (axis) clamp_span(lo, hi, p->hdr->fft_size, 8.0);
+    else      clamp_span(lo, hi, (double)p->hdr->level[0].rows, 16.0);
+}
+
+/* Arşiv görünümü olayları; olay tüketildiyse 1 */
+static int pyr_handle_event(PyrView *v, const TilePyr *p, const SDL_Event *ev,
+                            const RenderCtx *ctx) {
+    int top = ctx->spec_top, ht = ctx->wfall_top + ctx->wfall_h - ctx->spec_top;
+    if (ev->type == SDL_MOUSEWHEEL) {
+        int mx, my;
+        SDL_GetMouseState(&mx, &my);
+        if (mx < GRAPH_L || mx >= GRAPH_L + GRAPH_W || my < top || my >= top + ht)
+            return 0;
+        double f = ev->wheel.y > 0 ? 0.8 : 1.25;
+        if (SDL_GetModState() & KMOD_CTRL)
+            pyr_view_zoom(v, p, 1, v->b0 + (v->b1 - v->b0) * (mx - GRAPH_L) / GRAPH_W, f);
+        else
+            pyr_view_zoom(v, p, 0, v->t0 + (v->t1 - v->t0) * (my - top) / ht, f);
+        return 1;
+    }
+    if (ev->type != SDL_KEYDOWN) return 0;
+    switch (ev->key.keysym.sym) {
+    case SDLK_UP:       pyr_view_pan(v, p, 0, -0.25); return 1;
+    case SDLK_DOWN:     pyr_view_pan(v, p, 0,  0.25); return 1;
+    case SDLK_LEFT:     pyr_view_pan(v, p, 1, -0.25); return 1;
+    case SDLK_RIGHT:    pyr_view_pan(v, p, 1,  0.25); return 1;
+    case SDLK_PAGEUP:   pyr_view_zoom(v, p, 0, (v->t0 + v->t1) / 2.0, 0.5); return 1;
+    case SDLK_PAGEDOWN: pyr_view_zoom(v, p, 0, (v->t0 + v->t1) / 2.0, 2.0); return 1;
+    case SDLK_HOME:     pyr_view_reset(v, p); return 1;
+    default:            return 0;
+    }
+}
+
+/* Ölçüm katmanı: seçili hattın sayaçları + GUI gecikmeleri (F2) */
+static void draw_stats(RenderCtx *ctx, const Pipeline *pl, const Stats *ui) {
+    static const StatHistId PIPE_H[] = {
+        STAT_H_CB_GAP, STAT_H_QUEUE, STAT_H_FFT, STAT_H_DSP_LAT,
+    };
+    static const StatHistId UI_H[] = {
+        STAT_H_RENDER_WF, STAT_H_FRAME, STAT_H_PRESENT, STAT_H_E2E,
+    };
+    SDL_Color c = {170, 240, 170, 255};
+    char buf[96];
+    int  y = ctx->spec_top + 18;
+
+    snprintf(buf, sizeof(buf), "blok %llu  satir %llu  kuyruk kaybi %llu  kayit kaybi %llu",
+             (unsigned long long)stats_get(&pl->stats, STAT_C_BLOCKS),
+             (unsigned long long)stats_get(&pl->stats, STAT_C_ROWS),
+             (unsigned long long)stats_get(&pl->stats, STAT_C_Q_DROPS),
+             (unsigned long long)stats_get(&pl->stats, STAT_C_REC_DROPS));
+    render_text(ctx, ctx->font_sm, buf, GRAPH_L + 4, y, c);
+    y += 15;
+    snprintf(buf, sizeof(buf), "kare %llu  bayat gorunum %llu",
+             (unsigned long long)stats_get(ui, STAT_C_FRAMES),
+             (unsigned long long)stats_get(ui, STAT_C_VIEW_STALE));
+    render_text(ctx, ctx->font_sm, buf, GRAPH_L + 4, y, c);
+    y += 15;
+
+    for (int k = 0; k < 8; k++) {
+        const Stats *s  = k < 4 ? &pl->stats : ui;
+        StatHistId   id = k < 4 ? PIPE_H[k] : UI_H[k - 4];
+        const StatHist *h = &s->h[id];
+        snprintf(buf, sizeof(buf), "%-16s p50 %7.0f  p99 %7.0f  max %7llu us",
+                 stats_hist_name(id), stats_percentile(h, 0.50),
+                 stats_percentile(h, 0.99), (unsigned long long)h->max_us);
+        render_text(ctx, ctx->font_sm, buf, GRAPH_L + 4, y, c);
+        y += 15;
+    }
 }
 
 /* ── main ─────────────────────────────────────────────────── */
 int main(int argc, char *argv[]) {
-    (void)argc; (void)argv;
+
+    /* ── 0. Komut satırı ───────────────────────────────────── */
+    PipeConfig cfgs[PIPE_MAX];
+    int n_cfg = 0, tiled = 0, srv_port = 0, shm = 0, stats_s = 0, rt_prio = 0;
+    int fixed = 0, n_chan = 0, snap_det = 0, sub_fmt = REC_FMT_CI16, fine = 0;
+    int rec_corr = 0, n_mres = 0, mres_size[MRES_MAX] = {0}, mres_avg[MRES_MAX] = {0};
+    uint32_t sub_freq = 0, sub_bw = 0, seg_s = 0;
+    uint64_t seg_bytes = 0, keep_bytes = 0;
+    int demod_mode = DEMOD_OFF;
+    uint32_t demod_freq = 0, demod_bw = 0;
+    const char *audio_out = NULL;
+    uint32_t snap_pre = 0, snap_post = 0;
+    const char *pyr_path = NULL;
+    uint32_t chan_freq[CHAN_MAX], chan_bw[CHAN_MAX];
+    unsigned xfer_kb = 0, xfer_num = 0;
+    const char *out_dir = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-l")) { sdr_list_devices(); return 0; }
+        if (!strcmp(argv[i], "-t")) { tiled = 1; continue; }
+        if (!strcmp(argv[i], "-m")) { shm   = 1; continue; }
+        if (!strcmp(argv[i], "-q")) { fixed = 1; continue; }
+        if (!strcmp(argv[i], "-E")) { snap_det = 1; continue; }
+        if (!strcmp(argv[i], "-K")) { rec_corr = 1; continue; }
+        if (!strcmp(argv[i], "-B") && i + 1 < argc) {
+            if (snap_parse(argv[++i], &snap_pre, &snap_post) != 0) {
+                fprintf(stderr, "Gecersiz on tetik: %s (saniye on[:son])\n", argv[i]);
+                return 1;
+            }
+            continue;
+        }
+        if (!strcmp(argv[i], "-b") && i + 1 < argc) {
+            if (recorder_parse_subband(argv[++i], &sub_freq, &sub_bw, &sub_fmt) != 0) {
+                fprintf(stderr, "Gecersiz alt bant: %s (MHz:kHz[:ci8|ci16|cf32])\n",
+                        argv[i]);
+                return 1;
+            }
+            continue;
+        }
+        if (!strcmp(argv[i], "-G") && i + 1 < argc) {
+            if (recorder_parse_segment(argv[++i], &seg_s, &seg_bytes) != 0) {
+                fprintf(stderr, "Gecersiz bolut: %s (saniye ya da boyut: 60, 2G)\n", argv[i]);
+                return 1;
+            }
+            continue;
+        }
+        if (!strcmp(argv[i], "-A") && i + 1 < argc) {
+            if ((keep_bytes = ret_parse_size(argv[++i])) == 0) {
+                fprintf(stderr, "Gecersiz saklama butcesi: %s (500G, 2T)\n", argv[i]);
+                return 1;
+            }
+            continue;
+        }
+        if (!strcmp(argv[i], "-a") && i + 1 < argc) {
+            if (demod_parse(argv[++i], &demod_mode, &demod_bw) != 0) {
+                fprintf(stderr, "Gecersiz demod: %s (fm|am|usb|lsb[:kHz])\n", argv[i]);
+                return 1;
+            }
+            continue;
+        }
+        if (!strcmp(argv[i], "-D") && i + 1 < argc) {
+            double mhz = atof(argv[++i]);
+            if (mhz <= 0.0) {
+                fprintf(stderr, "Gecersiz demod frekansi: %s (MHz)\n", argv[i]);
+                return 1;
+            }
+            demod_freq = (uint32_t)(mhz * 1e6 + 0.5);
+            continue;
+        }
+        if (!strcmp(argv[i], "-O") && i + 1 < argc) {
+            audio_out = argv[++i];
+            continue;
+        }
+        if (!strcmp(argv[i], "-F") && i + 1 < argc) {
+            if ((fine = bigfft_parse_size(argv[++i])) < 0) {
+                fprintf(stderr, "Gecersiz ince FFT boyu: %s (4k..1M ya da 12..20)\n",
+                        argv[i]);
+                return 1;
+            }
+            continue;
+        }
+        if (!strcmp(argv[i], "-M") && i + 1 < argc) {
+            if (n_mres >= MRES_MAX ||
+                mres_parse(argv[++i], &mres_size[n_mres], &mres_avg[n_mres]) != 0) {
+                fprintf(stderr, "Gecersiz cozunurluk: %s (64..16k[:cerceve], en cok %d)\n",
+                        argv[i], MRES_MAX);
+                return 1;
+            }
+            n_mres++;
+            continue;
+        }
+        if (!strcmp(argv[i], "-L") && i + 1 < argc) {
+            if (stage_load(argv[++i]) != 0) return 1;
+            continue;
+        }
+        if (!strcmp(argv[i], "-S") && i + 1 < argc) {
+            srv_port = atoi(argv[++i]);
+            continue;
+        }
+        if (!strcmp(argv[i], "-x") && i + 1 < argc) {
+            sscanf(argv[++i], "%ux%u", &xfer_kb, &xfer_num);
+            continue;
+        }
+        if (!strcmp(argv[i], "-j") && i + 1 < argc) {
+            stats_s = atoi(argv[++i]);
+            continue;
+        }
+        if (!strcmp(argv[i], "-o") && i + 1 < argc) {
+            out_dir = argv[++i];
+            continue;
+        }
+        if (!strcmp(argv[i], "-P") && i + 1 < argc) {
+            rt_prio = atoi(argv[++i]);
+            continue;
+        }
+        if (!strcmp(argv[i], "-T") && i + 1 < argc) {
+            pyr_path = argv[++i];
+            continue;
+        }
+        if (!strcmp(argv[i], "-C") && i + 1 < argc) {
+            if (n_chan >= CHAN_MAX ||
+                chan_parse(argv[++i], &chan_freq[n_chan], &chan_bw[n_chan]) != 0) {
+                fprintf(stderr, "Gecersiz kanal: %s\n", argv[i]);
+                return 1;
+            }
+            n_chan++;
+            continue;
+        }
+        if ((!strcmp(argv[i], "-d") || !strcmp(argv[i], "-s") ||
+             !strcmp(argv[i], "-r")) && i + 1 < argc) {
+            if (n_cfg >= PIPE_MAX) {
+                fprintf(stderr, "En fazla %d cihaz desteklenir\n", PIPE_MAX);
+                return 1;
+            }
+            pipeline_parse_spec(argv[i + 1], argv[i][1], &cfgs[n_cfg++]);
+            i++;
+            continue;
+        }
+        fprintf(stderr, "Bilinmeyen arguman: %s\n", argv[i]);
+        return 1;
+    }
+    if (n_cfg == 0) {
+        char def[] = "0";   /* varsayılan: cihaz #0 */
+        pipeline_parse_spec(def, 'd', &cfgs[n_cfg++]);
+    }
+    for (int i = 0; i < n_cfg; i++) {
+        cfgs[i].shm      = shm;
+        cfgs[i].xfer_len = xfer_kb * 1024u;
+        cfgs[i].xfer_num = xfer_num;
+        cfgs[i].rt_prio  = rt_prio;
+        cfgs[i].out_dir  = out_dir;
+        cfgs[i].snap_pre_ms  = snap_pre;
+        cfgs[i].snap_post_ms = snap_post;
+        cfgs[i].snap_det     = snap_det;
+        cfgs[i].fine_log2    = fine;
+        cfgs[i].rec_corr     = rec_corr;
+        cfgs[i].mres_n       = n_mres;
+        memcpy(cfgs[i].mres_size, mres_size, sizeof(mres_size));
+        memcpy(cfgs[i].mres_avg,  mres_avg,  sizeof(mres_avg));
+        cfgs[i].demod_mode   = demod_freq && demod_mode == DEMOD_OFF ? DEMOD_FM : demod_mode;
+        cfgs[i].demod_freq   = demod_freq;
+        cfgs[i].demod_bw     = demod_bw;
+        cfgs[i].audio_out    = audio_out;
+    }
+    if (snap_det && !snap_pre && !snap_post)
+        fprintf(stderr, "UYARI: -E icin on tetik halkasi gerekli (-B)\n");
+    char stats_path[256];
+    snprintf(stats_path, sizeof(stats_path), "%s" PATH_SEP "stats.json",
+             out_dir ? out_dir : REC_DEFAULT_DIR);
 
     /* ── 1. FFT başlat ─────────────────────────────────────── */
     fft_init();
-    memset(s_waterfall, 0, sizeof(s_waterfall));
+    fft_set_fixed(fixed);
 
-    /* ── 2. SDR aç ─────────────────────────────────────────── */
-    SdrDevice sdr;
-    if (sdr_open(&sdr) != 0) return 1;
+    /* ── 2. Cihaz hatlarını aç (SDR + kayıt + dedektör + izler) ── */
+    /* Saklama bütçesi dizin başına: bütün cihazların bölütleri tek bütçede */
+    Retention ret;
+    ret_init(&ret, out_dir ? out_dir : REC_DEFAULT_DIR, keep_bytes);
+    Pipeline *pipes[PIPE_MAX];
+    PipeView *views = calloc((size_t)n_cfg, sizeof(PipeView));
+    if (!views) {
+        fprintf(stderr, "Bellek hatasi\n");
+        return 1;
+    }
+    int n_pipes = 0;
+    for (int i = 0; i < n_cfg; i++) {
+        Pipeline *pl = calloc(1, sizeof(Pipeline));
+        if (!pl || pipeline_open(pl, n_pipes, &cfgs[i]) != 0) {
+            free(pl);
+            continue;
+        }
+        for (int k = 0; k < n_chan; k++)
+            pipeline_add_channel(pl, chan_freq[k], chan_bw[k]);
+        if (sub_freq) recorder_set_subband(&pl->rec, sub_freq, sub_bw, sub_fmt);
+        recorder_set_segments(&pl->rec, seg_s, seg_bytes, keep_bytes ? &ret : NULL);
+        pipes[n_pipes++] = pl;
+    }
+    if (n_pipes == 0) return 1;
 
-    /* ── 3. Kaydedici başlat ───────────────────────────────── */
-    RecorderState rec;
-    recorder_init(&rec);
+    /* Çevrimdışı üretilmiş spektrogram piramidi (isteğe bağlı, F3) */
+    TilePyr pyr;
+    PyrView pyr_view;
+    int     have_pyr = pyr_path && pyr_open(&pyr, pyr_path) == 0;
+    int     show_pyr = have_pyr;
+    if (have_pyr) pyr_view_reset(&pyr_view, &pyr);
 
-    /* ── 4. SDL2 başlat ────────────────────────────────────── */
+    /* Uzak izleyiciler için spektrum yayını (isteğe bağlı) */
+    SpecServer *srv = srv_port ? specsrv_start((uint16_t)srv_port) : NULL;
+    for (int i = 0; i < n_pipes; i++) pipes[i]->srv = srv;
+
+    /* ── 3. SDL2 başlat ────────────────────────────────────── */
     SDL_Init(SDL_INIT_VIDEO);
 
     SDL_Window *win = SDL_CreateWindow(
@@ -75,7 +644,8 @@ int main(int argc, char *argv[]) {
 
     if (!win) {
         fprintf(stderr, "Pencere olusturulamadi: %s\n", SDL_GetError());
-        sdr_close(&sdr);
+        for (int i = 0; i < n_pipes; i++) pipeline_close(pipes[i]);
+        ret_free(&ret);
         SDL_Quit();
         return 1;
     }
@@ -87,7 +657,8 @@ int main(int argc, char *argv[]) {
     if (!sdl_ren) {
         fprintf(stderr, "Renderer olusturulamadi: %s\n", SDL_GetError());
         SDL_DestroyWindow(win);
-        sdr_close(&sdr);
+        for (int i = 0; i < n_pipes; i++) pipeline_close(pipes[i]);
+        ret_free(&ret);
         SDL_Quit();
         return 1;
     }
@@ -96,36 +667,41 @@ int main(int argc, char *argv[]) {
        tampon her zaman WIN_W x WIN_H piksel gibi çalgışır. */
     SDL_RenderSetLogicalSize(sdl_ren, WIN_W, WIN_H);
 
-    /* ── 5. Render bağlamı ─────────────────────────────────── */
+    /* ── 4. Render bağlamı ─────────────────────────────────── */
     RenderCtx ctx;
     render_init(&ctx, sdl_ren);
 
-    /* ── 6. Kontrol paneli ─────────────────────────────────── */
+    /* ── 5. Kontrol paneli ─────────────────────────────────── */
     Panel panel;
     panel_init(&panel);
+    int sel = 0;   /* panelin kontrol ettiği hat */
 
     /* db_min / db_max başlangıç değerlerini slider'larla senkronize et */
     ctx.db_min = panel.sl_dbmin.val;
     ctx.db_max = panel.sl_dbmax.val;
+    for (int i = 0; i < n_pipes; i++) pipes[i]->traces.tau_s = panel.sl_tau.val;
+    panel_sync(&panel, pipes[sel]);
 
-    /* ── 7. Asenkron SDR okumayı başlat ───────────────────── */
+    /* ── 6. Hatları başlat ─────────────────────────────────── */
     /*
-     * sdr_start_async, rtlsdr_read_async'i ayrı bir thread'de başlatır.
-     * Bu thread GPU/VSYNC'e bağlı değildir; cihazın tam bant genişliğinde
-     * (2.048 MS/s → ~4 MB/s) kesintisiz veri akar.
-     *   - on_sdr_data callback'i: kaydedici aktifse her bloğu diske atar.
-     *   - GUI: sdr_pop_block() ile en güncel bloğu 60 FPS hızında okur.
+     * Her hat kendi rtlsdr_read_async thread'ini ve DSP thread'ini başlatır.
+     * Bu thread'ler GPU/VSYNC'e bağlı değildir; her cihaz tam bant
+     * genişliğinde (2.048 MS/s → ~4 MB/s) kesintisiz veri akıtır.
+     *   - Kaydedici aktifse her blok diske gider.
+     *   - DSP thread'i blokları ortalar, dedektörü/izleri günceller.
+     *   - GUI yalnızca pipeline_view() ile son durumu kopyalar.
      */
-    sdr_start_async(&sdr, on_sdr_data, &rec);
+    for (int i = 0; i < n_pipes; i++) pipeline_start(pipes[i]);
 
-    /* ── 8. Ham veri tamponu (GUI görüntüleme için) ────────── */
-    uint8_t *raw = (uint8_t *)malloc(FFT_SIZE * 2);
-    if (!raw) {
-        fprintf(stderr, "Bellek hatasi\n");
-        return 1;
-    }
+    /* ── 7. Ana döngü ──────────────────────────────────────── */
+    Stats    ui_stats;
+    BandSel  band = {0};
+    int      show_stats = 0;
+    int      show_mres  = 1;
+    uint64_t t_dump     = stats_now_us();
+    int      fresh[PIPE_MAX];
+    stats_reset(&ui_stats);
 
-    /* ── 9. Ana döngü ──────────────────────────────────────── */
     int running = 1;
     while (running) {
 
@@ -136,51 +712,132 @@ int main(int argc, char *argv[]) {
             if (ev.type == SDL_KEYDOWN &&
                 ev.key.keysym.sym == SDLK_ESCAPE) { running = 0; break; }
 
-            panel_handle_event(&panel, &ev, &sdr, &rec, &ctx);
+            /* Cihaz seçimi / görünüm (metin kutusu odakta değilken) */
+            int typing = panel.ti_freq.active || panel.ti_sw_start.active ||
+                         panel.ti_sw_stop.active;
+            if (ev.type == SDL_KEYDOWN && !typing &&
+                ev.key.keysym.sym == SDLK_F2) { show_stats = !show_stats; continue; }
+            if (ev.type == SDL_KEYDOWN && !typing && have_pyr &&
+                ev.key.keysym.sym == SDLK_F3) { show_pyr = !show_pyr; continue; }
+            if (ev.type == SDL_KEYDOWN && !typing &&
+                ev.key.keysym.sym == SDLK_F4) { pipeline_snapshot(pipes[sel], "F4"); continue; }
+            if (ev.type == SDL_KEYDOWN && !typing && ev.key.keysym.sym == SDLK_F5) {
+                pipeline_set_fine(pipes[sel], pipes[sel]->fine_req ? 0
+                                              : fine ? fine : BIGFFT_MAX_LOG2);
+                continue;
+            }
+            if (ev.type == SDL_KEYDOWN && !typing &&
+                ev.key.keysym.sym == SDLK_F6) { show_mres = !show_mres; continue; }
+            if (ev.type == SDL_KEYDOWN && !typing &&
+                ev.key.keysym.sym == SDLK_F7) { demod_cycle(pipes[sel]); continue; }
+            if (show_pyr && !typing && pyr_handle_event(&pyr_view, &pyr, &ev, &ctx))
+                continue;
+            if (!show_pyr && !typing && !(tiled && n_pipes > 1) &&
+                fine_handle_event(pipes[sel], &views[sel], &ev, &ctx))
+                continue;
+            if (ev.type == SDL_KEYDOWN && !typing && n_pipes > 1) {
+                if (ev.key.keysym.sym == SDLK_TAB) {
+                    sel = (sel + 1) % n_pipes;
+                    panel_sync(&panel, pipes[sel]);
+                    continue;
+                }
+                if (ev.key.keysym.sym == SDLK_F1) { tiled = !tiled; continue; }
+            }
+            if (ev.type == SDL_MOUSEBUTTONDOWN && tiled && n_pipes > 1) {
+                int mx, my;
+                SDL_GetMouseState(&mx, &my);
+                if (mx < PANEL_X) {
+                    sel = render_tile_at(my, n_pipes);
+                    panel_sync(&panel, pipes[sel]);
+                }
+            }
+            if (!show_pyr && band_handle_event(&band, pipes[sel], &views[sel], &ev, &ctx))
+                continue;
+            if (!show_pyr && !(tiled && n_pipes > 1) &&
+                demod_handle_event(pipes[sel], &views[sel], &ev, &ctx))
+                continue;
+
+            panel_handle_event(&panel, &ev, pipes[sel], &ctx);
         }
         if (!running) break;
 
-        /*
-         * Async thread'den en güncel bloğu al.
-         * - Yeni blok varsa FFT hesapla ve şelaleyi güncelle.
-         * - Yoksa (GUI, async'ten daha hızlı döndüyse) mevcut s_psd ile
-         *   tekrar çiz; grafik donar değil, sadece güncellenmez.
-         * Kayıt (recorder_push) artık on_sdr_data callback'inde yapılıyor;
-         * veri kaybı yaşanmaz.
-         */
-        if (sdr_pop_block(&sdr, raw)) {
-            fft_compute_psd(raw, s_psd);
-            waterfall_push(s_psd);
+        /* DSP thread'lerinin son durumunu al (yeni satır yoksa eski kopya) */
+        for (int i = 0; i < n_pipes; i++) {
+            fresh[i] = pipeline_view(pipes[i], &views[i]);
+            if (!fresh[i]) stats_inc(&ui_stats, STAT_C_VIEW_STALE);
         }
 
         /* Çiz */
+        uint64_t t_frame = stats_now_us();
         render_clear(&ctx);
 
-        float fc_mhz = sdr.center_freq / 1e6f;
-        float bw_mhz = sdr.sample_rate  / 1e6f;
-        render_grid     (&ctx, fc_mhz, bw_mhz);
-        render_spectrum (&ctx, s_psd);
-        render_waterfall(&ctx, (const float (*)[FFT_SIZE])s_waterfall);
-        panel_draw      (&ctx, &panel, &sdr, &rec);
+        if (show_pyr) {
+            render_pyramid(&ctx, &pyr, &pyr_view);
+        } else if (tiled && n_pipes > 1) {
+            for (int i = 0; i < n_pipes; i++) {
+                render_set_layout(&ctx, i, n_pipes);
+                panel_auto_scale(&panel, &ctx, &views[i], i == sel);
+                draw_pipe(&ctx, pipes[i], &views[i], show_mres, &ui_stats);
+                if (i == sel) draw_band(&ctx, pipes[i], &views[i], &band);
+
+                char buf[64];
+                snprintf(buf, sizeof(buf), "%s  %.3f MHz", pipes[i]->name,
+                         pipes[i]->sdr.center_freq / 1e6);
+                render_text(&ctx, ctx.font_sm, buf, GRAPH_L + 4,
+                            ctx.spec_top + 2, (SDL_Color){200, 210, 230, 255});
+                if (i == sel)
+                    render_outline_rect(&ctx, GRAPH_L - 2, ctx.spec_top - 2,
+                        GRAPH_W + 4, ctx.wfall_top + ctx.wfall_h - ctx.spec_top + 4,
+                        (SDL_Color){100, 145, 225, 255});
+            }
+            render_set_layout(&ctx, 0, 1);
+            panel_auto_scale(&panel, &ctx, &views[sel], 1);
+        } else {
+            panel_auto_scale(&panel, &ctx, &views[sel], 1);
+            draw_pipe(&ctx, pipes[sel], &views[sel], show_mres, &ui_stats);
+            draw_band(&ctx, pipes[sel], &views[sel], &band);
+            draw_demod(&ctx, pipes[sel], &views[sel]);
+        }
+        panel_draw(&ctx, &panel, pipes[sel], n_pipes);
+        if (show_stats) draw_stats(&ctx, pipes[sel], &ui_stats);
 
+        uint64_t t_present = stats_since(&ui_stats, STAT_H_FRAME, t_frame);
         render_present(&ctx);
+        uint64_t t_shown = stats_since(&ui_stats, STAT_H_PRESENT, t_present);
+        stats_inc(&ui_stats, STAT_C_FRAMES);
+
+        /* Örnekten fotona: bu karede yeni satırı gösterilen hatlar */
+        for (int i = 0; i < n_pipes; i++)
+            if (fresh[i] && views[i].t_arrival_us &&
+                (i == sel || (tiled && n_pipes > 1)))
+                stats_record(&ui_stats, STAT_H_E2E, t_shown - views[i].t_arrival_us);
+
+        if (stats_s > 0 && t_shown - t_dump >= (uint64_t)stats_s * 1000000u) {
+            pipeline_dump_stats(stats_path, pipes, n_pipes, &ui_stats);
+            t_dump = t_shown;
+        }
     }
 
-    /* ── 10. Temizlik ──────────────────────────────────────── */
+    /* ── 8. Temizlik ──────────────────────────────────────── */
     /*
-     * Önce async SDR thread durdurulur (rtlsdr_cancel_async),
-     * ardından recorder durdurulur — sıra önemli: SDR thread durmazsa
+     * pipeline_stop önce async SDR thread'ini durdurur (rtlsdr_cancel_async),
+     * ardından DSP ve kaydediciyi — sıra önemli: SDR thread durmazsa
      * recorder_push çağrılmaya devam edebilir.
      */
-    sdr_stop_async(&sdr);
-    if (rec.active) recorder_stop(&rec);
-    free(raw);
+    for (int i = 0; i < n_pipes; i++) pipeline_stop(pipes[i]);
+    specsrv_stop(srv);
     render_free(&ctx);
     SDL_DestroyRenderer(sdl_ren);
     SDL_DestroyWindow(win);
     SDL_Quit();
-    sdr_close(&sdr);
+    for (int i = 0; i < n_pipes; i++) {
+        pipeline_close(pipes[i]);
+        free(pipes[i]);
+    }
+    ret_free(&ret);
+    free(views);
+    if (have_pyr) pyr_close(&pyr);
 
     printf("Program kapatildi.\n");
     return 0;
-}
\ No newline at end of file
+}
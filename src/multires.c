@@ -0,0 +1,158 @@
+/* multires.c — Aynı örnek akışından eşzamanlı çoklu çözünürlüklü spektrum */
+#include "multires.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/* uint8 → tam ölçekli float; fft.c ile aynı ölçek (127.5 merkez, /128) */
+static float s_u8[256];
+static int   s_u8_ready = 0;
+
+static void level_free(MresLevel *l) {
+    free(l->win);
+    free(l->buf);
+    free(l->acc);
+    free(l->row);
+    memset(l, 0, sizeof(*l));
+}
+
+/* Blok başına en çok bir satır: ortalama bloktaki çerçeve sayısından az olmaz */
+static int min_avg(const MresLevel *l) {
+    return l->size < FFT_SIZE ? FFT_SIZE / l->size : 1;
+}
+
+/* Çerçeve hazır: pencere, FFT, fftshift'li |X|² birikime */
+static void level_frame(MresLevel *l) {
+    const int N = l->size, half = N / 2;
+    for (int n = 0; n < N; n++) {
+        l->buf[n].r *= l->win[n];
+        l->buf[n].i *= l->win[n];
+    }
+    fft_cpx(l->buf, N, 0);
+    for (int k = 0; k < N; k++) {
+        const FftCpx *b = &l->buf[(k + half) & (N - 1)];
+        l->acc[k] += b->r * b->r + b->i * b->i;
+    }
+    l->acc_n++;
+}
+
+/* Ortalama doldu: dB satır, birikim sıfırlanır. Yeni satır varsa 1. */
+static int level_emit(MresLevel *l) {
+    if (l->acc_n < l->avg) return 0;
+    float scale = (float)FFT_SIZE / (float)l->size / (float)l->acc_n;
+    for (int k = 0; k < l->size; k++)
+        l->row[k] = 10.0f * log10f(l->acc[k] * scale + 1e-10f);
+    memset(l->acc, 0, sizeof(float) * (size_t)l->size);
+    l->acc_n = 0;
+    l->rows++;
+    return 1;
+}
+
+/* ── Genel API ────────────────────────────────────────────────── */
+void mres_init(MultiRes *m) {
+    memset(m, 0, sizeof(*m));
+    if (!s_u8_ready) {
+        for (int v = 0; v < 256; v++) s_u8[v] = ((float)v - 127.5f) / 128.0f;
+        s_u8_ready = 1;
+    }
+}
+
+void mres_free(MultiRes *m) {
+    for (int i = 0; i < m->n; i++) level_free(&m->lv[i]);
+    m->n = 0;
+}
+
+int mres_add(MultiRes *m, int size, int avg) {
+    if (m->n >= MRES_MAX || size < MRES_MIN_SIZE || size > MRES_MAX_SIZE ||
+        (size & (size - 1)) || avg < 0)
+        return -1;
+
+    MresLevel *l = &m->lv[m->n];
+    memset(l, 0, sizeof(*l));
+    l->size    = size;
+    l->avg_req = avg;
+    l->avg     = avg > min_avg(l) ? avg : min_avg(l);
+    l->win = malloc(sizeof(float)  * (size_t)size);
+    l->buf = malloc(sizeof(FftCpx) * (size_t)size);
+    l->acc = calloc((size_t)size, sizeof(float));
+    l->row = malloc(sizeof(float)  * (size_t)size);
+    if (!l->win || !l->buf || !l->acc || !l->row) {
+        level_free(l);
+        return -1;
+    }
+    for (int n = 0; n < size; n++)
+        l->win[n] = 0.5f * (1.0f - cosf(2.0f * (float)M_PI * n / (size - 1)));
+    return m->n++;
+}
+
+void mres_reset(MultiRes *m, uint32_t sample_rate, int row_rate) {
+    for (int i = 0; i < m->n; i++) {
+        MresLevel *l = &m->lv[i];
+        l->fill  = 0;
+        l->acc_n = 0;
+        memset(l->acc, 0, sizeof(float) * (size_t)l->size);
+        int a = l->avg_req;
+        if (!a && row_rate > 0)
+            a = (int)(sample_rate / (uint32_t)l->size / (uint32_t)row_rate);
+        l->avg = a < min_avg(l) ? min_avg(l) : a;
+    }
+}
+
+unsigned mres_feed(MultiRes *m, const uint8_t *raw, uint64_t sample) {
+    if (!m->n) return 0;
+    int gap = sample != m->next_sample;   /* kayıp blok: biriktirme süreksiz */
+    m->next_sample = sample + FFT_SIZE;
+
+    /* Paylaşılan dönüşüm: tüm düzeyler bu tek kopyayı okur */
+    for (int n = 0; n < FFT_SIZE; n++) {
+        m->x[n].r = s_u8[raw[2 * n]];
+        m->x[n].i = s_u8[raw[2 * n + 1]];
+    }
+
+    unsigned ready = 0;
+    for (int i = 0; i < m->n; i++) {
+        MresLevel *l = &m->lv[i];
+        if (l->size <= FFT_SIZE) {
+            /* Bloğa birden çok çerçeve sığar; satır bloğun herhangi bir çerçevesinde dolabilir */
+            for (int off = 0; off < FFT_SIZE; off += l->size) {
+                memcpy(l->buf, m->x + off, sizeof(FftCpx) * (size_t)l->size);
+                level_frame(l);
+                if (level_emit(l)) ready |= 1u << i;
+            }
+        } else {
+            if (gap) l->fill = 0;
+            memcpy(l->buf + l->fill, m->x, sizeof(m->x));
+            l->fill += FFT_SIZE;
+            if (l->fill < l->size) continue;
+            l->fill = 0;
+            level_frame(l);
+            if (level_emit(l)) ready |= 1u << i;
+        }
+    }
+    return ready;
+}
+
+int mres_parse(const char *s, int *size, int *avg) {
+    char  *end;
+    double v = strtod(s, &end);
+    if (end == s || v <= 0.0) return -1;
+    if (*end == 'k' || *end == 'K') { v *= 1024.0; end++; }
+    *avg = 0;
+    if (*end == ':') {
+        char *e2;
+        long a = strtol(end + 1, &e2, 10);
+        if (e2 == end + 1 || *e2 != '\0' || a < 1 || a > 100000) return -1;
+        *avg = (int)a;
+    } else if (*end != '\0') {
+        return -1;
+    }
+    int n = (int)v;
+    if ((double)n != v || n < MRES_MIN_SIZE || n > MRES_MAX_SIZE || (n & (n - 1)))
+        return -1;
+    *size = n;
+    return 0;
+}
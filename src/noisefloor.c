@@ -0,0 +1,107 @@
+/* noisefloor.c — Akan gürültü tabanı + yüzdelik kestirimi, otomatik ölçek */
+#include "noisefloor.h"
+#include <math.h>
+#include <string.h>
+
+#define NF_RESCALE  1e12f   /* w bunu aşınca kovalar yeniden ölçeklenir */
+
+static inline int bucket_of(float db) {
+    int b = (int)((db - NF_DB_LO) * (1.0f / NF_DB_STEP));
+    b = b < 0 ? 0 : b;
+    return b >= NF_BUCKETS ? NF_BUCKETS - 1 : b;
+}
+
+/* Histogramda q yüzdeliği, kova içinde doğrusal ara değer */
+static float hist_quantile(const float *h, float tot, float q) {
+    float target = q * tot, acc = 0.0f;
+    for (int b = 0; b < NF_BUCKETS; b++) {
+        if (h[b] > 0.0f && acc + h[b] >= target)
+            return NF_DB_LO + ((float)b + (target - acc) / h[b]) * NF_DB_STEP;
+        acc += h[b];
+    }
+    return NF_DB_LO + NF_BUCKETS * NF_DB_STEP;
+}
+
+void nf_init(NoiseFloor *n) {
+    memset(n, 0, sizeof(*n));
+    n->tau_s   = 5.0f;
+    n->hyst_db = 4.0f;
+    nf_reset(n);
+}
+
+void nf_reset(NoiseFloor *n) {
+    memset(n->long_h, 0, sizeof(n->long_h));
+    memset(n->seg_h,  0, sizeof(n->seg_h));
+    n->w          = 1.0f;
+    n->tot        = 0.0f;
+    n->rows       = 0;
+    n->seg_next   = 0;
+    n->auto_valid = 0;
+}
+
+/* w sınırı aştı: tüm uzun dönem kovalarını 1/w ile çarp (seyrek, O(kova × bölüt)) */
+static void rescale(NoiseFloor *n) {
+    float s = 1.0f / n->w;
+    for (int b = 0; b < NF_BUCKETS; b++) n->long_h[b] *= s;
+    for (int g = 0; g < NF_SEGS; g++)
+        for (int b = 0; b < NF_BUCKETS; b++) n->seg_h[g][b] *= s;
+    n->tot *= s;
+    n->w    = 1.0f;
+}
+
+/* Hedef geçerli değerden hyst kadar uzaklaşınca bir adımda geçilir */
+static void hysteresis(float *cur, float target, float hyst, int valid) {
+    if (!valid || fabsf(target - *cur) > hyst) *cur = roundf(target);
+}
+
+void nf_update(NoiseFloor *n, const float *psd, float dt_s) {
+    /* İlk satır geçmişsiz başlar; sonrakiler eski satırlara göre e^(dt/tau) ağır */
+    if (n->rows && n->tau_s > 0.0f) n->w *= expf(dt_s / n->tau_s);
+    if (n->w > NF_RESCALE) rescale(n);
+    const float w = n->w;
+
+    memset(n->row_h, 0, sizeof(n->row_h));
+    for (int g = 0; g < NF_SEGS; g++) {
+        float *sh = n->seg_h[g];
+        const float *x = psd + g * NF_SEG_BINS;
+        for (int k = 0; k < NF_SEG_BINS; k++) {
+            int b = bucket_of(x[k]);
+            n->row_h[b]  += 1.0f;
+            n->long_h[b] += w;
+            sh[b]        += w;
+        }
+    }
+    n->tot += w * FFT_SIZE;
+    n->rows++;
+
+    n->row_floor  = hist_quantile(n->row_h, FFT_SIZE, NF_Q_FLOOR);
+    n->row_median = hist_quantile(n->row_h, FFT_SIZE, 0.5f);
+    n->row_top    = hist_quantile(n->row_h, FFT_SIZE, NF_Q_TOP);
+    n->floor_db   = hist_quantile(n->long_h, n->tot, NF_Q_FLOOR);
+    n->top_db     = hist_quantile(n->long_h, n->tot, NF_Q_TOP);
+
+    /* İlk satırda tüm bölütler, sonra sırayla */
+    int n_seg = n->rows == 1 ? NF_SEGS : NF_SEG_PER_ROW;
+    for (int i = 0; i < n_seg; i++) {
+        int g = n->seg_next;
+        n->seg_floor[g] = hist_quantile(n->seg_h[g], n->tot / NF_SEGS, NF_Q_FLOOR);
+        n->seg_next = (g + 1) % NF_SEGS;
+    }
+
+    float lo = n->floor_db - NF_MARGIN_LO;
+    float hi = n->top_db   + NF_MARGIN_HI;
+    if (hi - lo < NF_MIN_SPAN) hi = lo + NF_MIN_SPAN;
+    hysteresis(&n->auto_min, lo, n->hyst_db, n->auto_valid);
+    hysteresis(&n->auto_max, hi, n->hyst_db, n->auto_valid);
+    n->auto_valid = 1;
+}
+
+float nf_quantile(const NoiseFloor *n, float q) {
+    return hist_quantile(n->long_h, n->tot, q);
+}
+
+float nf_bin_floor(const NoiseFloor *n, int bin) {
+    if (bin < 0) bin = 0;
+    if (bin >= FFT_SIZE) bin = FFT_SIZE - 1;
+    return n->seg_floor[bin / NF_SEG_BINS];
+}
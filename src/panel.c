@@ -23,6 +23,15 @@ static void update_sr_buttons(Panel *p) {
     }
 }
 
+/* ── Yardımcı: iz butonlarını güncelle ──────────────────────── */
+static void update_trace_buttons(Panel *p, const TraceSet *tr) {
+    for (int i = 0; i < TRACE_COUNT; i++) {
+        p->btn_trace[i].bg = (tr->shown & (1u << i))
+            ? (SDL_Color){55, 120, 55, 255}
+            : (SDL_Color){40, 40,  70, 255};
+    }
+}
+
 /* ── Panel ilklendirme ──────────────────────────────────────── */
 void panel_init(Panel *p) {
     memset(p, 0, sizeof(*p));
@@ -66,18 +75,54 @@ void panel_init(Panel *p) {
     /* Max dB slider'ı */
     p->sl_dbmax = (Slider){ PX, y+14, PW, 10, -60.0f, 60.0f, 0.0f, 0,
                              "Max Güç (dB)" };
-    y += 52;
+    y += 40;
+
+    /* Otomatik ölçek */
+    p->btn_autoscale = (Button){ PX, y, PW, 22, "Oto Ölçek: Kapalı",
+                                 {40,40,70,255}, 0 };
+    y += 34;
 
     /* Kayıt butonları */
     p->btn_rec  = (Button){ PX,          y, PW/2-3, 26, "Kayıt Başla",
                              {145,28,28,255}, 0 };
     p->btn_stop = (Button){ PX+PW/2+3,   y, PW/2-3, 26, "Durdur",
                              {55,55,70,255},  0 };
+    y += 108;  /* kayıt durum satırları için boşluk */
+
+    /* Tarama aralığı (başlangıç / bitiş MHz) + başlat/durdur */
+    p->ti_sw_start = (TextInput){ PX,          y+14, PW/2-3, 22, "88.000",  6, 0 };
+    p->ti_sw_stop  = (TextInput){ PX+PW/2+3,   y+14, PW/2-3, 22, "108.000", 7, 0 };
+    y += 44;
+    p->btn_sweep   = (Button){ PX, y, PW, 22, "Tarama Başlat",
+                               {40,80,160,255}, 0 };
+    y += 66;   /* tarama durum satırları için boşluk */
+
+    /* İz seçimi (Max / Min / Ort / Tepe) + sıfırla */
+    int tw = (PW - TRACE_COUNT * 2) / (TRACE_COUNT + 1);
+    for (int i = 0; i < TRACE_COUNT; i++) {
+        p->btn_trace[i] = (Button){ PX + i*(tw+2), y+14, tw, 20, "",
+                                    {40,40,70,255}, 0 };
+        strncpy(p->btn_trace[i].text, trace_name((TraceKind)i),
+                sizeof(p->btn_trace[i].text) - 1);
+    }
+    p->btn_trace_reset = (Button){ PX + TRACE_COUNT*(tw+2), y+14,
+                                   PW - TRACE_COUNT*(tw+2), 20, "Sıfırla",
+                                   {55,55,70,255}, 0 };
+    y += 48;
+
+    /* EMA zaman sabiti */
+    p->sl_tau = (Slider){ PX, y+14, PW, 10, 0.1f, 10.0f, 1.0f, 0,
+                          "Ortalama τ (s)" };
 }
 
 /* ── Panel çizimi ───────────────────────────────────────────── */
-void panel_draw(RenderCtx *ctx, const Panel *p,
-                const SdrDevice *sdr, const RecorderState *rec) {
+void panel_draw(RenderCtx *ctx, const Panel *p, const Pipeline *pl,
+                int n_pipes) {
+    const SdrDevice     *sdr = &pl->sdr;
+    const RecorderState *rec = &pl->rec;
+    const Sweep         *sw  = &pl->sweep;
+    const TraceSet      *tr  = &pl->traces;
+
     /* Arka plan */
     render_fill_rect(ctx, PANEL_X, 0, PANEL_W, WIN_H,
                      (SDL_Color){14, 14, 28, 255});
@@ -102,10 +147,22 @@ void panel_draw(RenderCtx *ctx, const Panel *p,
     slider_draw(ctx, &p->sl_gain,  !sdr->agc_on);
     slider_draw(ctx, &p->sl_dbmin, 1);
     slider_draw(ctx, &p->sl_dbmax, 1);
+    button_draw(ctx, &p->btn_autoscale);
 
     button_draw(ctx, &p->btn_rec);
     button_draw(ctx, &p->btn_stop);
 
+    render_text(ctx, ctx->font_sm, "Tarama Aralığı (MHz)", PX,
+                p->ti_sw_start.y - 14, lbl);
+    textinput_draw(ctx, &p->ti_sw_start);
+    textinput_draw(ctx, &p->ti_sw_stop);
+    button_draw(ctx, &p->btn_sweep);
+
+    render_text(ctx, ctx->font_sm, "İzler", PX, p->btn_trace[0].y - 14, lbl);
+    for (int i = 0; i < TRACE_COUNT; i++) button_draw(ctx, &p->btn_trace[i]);
+    button_draw(ctx, &p->btn_trace_reset);
+    slider_draw(ctx, &p->sl_tau, (tr->shown & (1u << TRACE_AVG)) != 0);
+
     /* Kayıt durumu */
     int sy = p->btn_rec.y + 38;
     if (rec->active) {
@@ -119,8 +176,84 @@ void panel_draw(RenderCtx *ctx, const Panel *p,
                     (SDL_Color){80, 210, 95, 255});
     }
 
-    /* Alt durum */
+    /* Ön tetik halkası (-B): F4 anlık kayıt */
+    const SnapRing *sn = &pl->snap;
+    if (sn->ring) {
+        char sb[96];
+        if (sn->busy)
+            snprintf(sb, sizeof(sb), "Anlık kayıt yazılıyor...");
+        else if (sn->n_snaps)
+            snprintf(sb, sizeof(sb), "Anlık kayıt: %u dosya  (F4)", sn->n_snaps);
+        else
+            snprintf(sb, sizeof(sb), "Ön kayıt %.0f s + %.0f s  (F4)",
+                     sn->pre_ms / 1000.0, sn->post_ms / 1000.0);
+        render_text(ctx, ctx->font_sm, sb, PX, sy + 34,
+                    sn->busy ? (SDL_Color){255, 170, 60, 255}
+                             : (SDL_Color){155, 155, 165, 255});
+    }
+
+    /* Alt bant penceresi (sağ sürükle / -b) */
     char buf[64];
+    if (rec->sub_freq)
+        snprintf(buf, sizeof(buf), "Alt bant: %.3f MHz / %.1f kHz  %s",
+                 rec->sub_freq / 1e6, rec->sub_bw / 1e3,
+                 recorder_fmt_name(rec->sub_fmt));
+    else
+        snprintf(buf, sizeof(buf), "Tam bant  (sağ sürükle: alt bant)");
+    render_text(ctx, ctx->font_sm, buf, PX, sy + 52,
+                rec->sub_freq ? (SDL_Color){60, 210, 130, 255}
+                              : (SDL_Color){105, 115, 130, 255});
+
+    /* Tarama durumu */
+    int ty = p->btn_sweep.y + 30;
+    if (sw->active) {
+        snprintf(buf, sizeof(buf), "Adım %d/%d  (%.0f%%)",
+                 sw->hop_pos + 1, sw->n_hops, sweep_progress(sw) * 100.0f);
+        render_text(ctx, ctx->font_sm, buf, PX, ty,
+                    (SDL_Color){155, 155, 165, 255});
+    }
+    if (sw->sweeps > 0) {
+        snprintf(buf, sizeof(buf), "Tarama hızı: %.1f MHz/s  (%.2f s)",
+                 sw->rate_mhz_s, sw->sweep_s);
+        render_text(ctx, ctx->font_sm, buf, PX, ty + 16,
+                    (SDL_Color){80, 210, 95, 255});
+    }
+
+    /* Alt durum */
+    if (sdr->tcp) {
+        const RtlTcpStats *ts = rtltcp_stats(sdr->tcp);
+        snprintf(buf, sizeof(buf), "TCP: %.2f MB/s  bosluk %.1f ms",
+                 ts->rate_mbs, ts->gap_max_us / 1000.0);
+        render_text(ctx, ctx->font_sm, buf, PX, WIN_H-76,
+                    (SDL_Color){105,115,130,255});
+    }
+    if (n_pipes > 1) {
+        snprintf(buf, sizeof(buf), "Cihaz %d/%d: %s  (Tab / F1)",
+                 pl->id + 1, n_pipes, pl->name);
+        render_text(ctx, ctx->font_sm, buf, PX, WIN_H-60,
+                    (SDL_Color){150,180,215,255});
+    }
+    if (pl->fine_log2) {
+        snprintf(buf, sizeof(buf), "İnce FFT 2^%d: %.2f Hz/bin  (F5)", pl->fine_log2,
+                 sdr->sample_rate / (double)(1u << pl->fine_log2));
+        render_text(ctx, ctx->font_sm, buf, PX, WIN_H-108,
+                    (SDL_Color){60,210,130,255});
+    }
+    if (pl->mres.n) {
+        int n = snprintf(buf, sizeof(buf), "Ek çözünürlük:");
+        for (int i = 0; i < pl->mres.n && n < (int)sizeof(buf); i++)
+            n += snprintf(buf + n, sizeof(buf) - (size_t)n, " %d", pl->mres.lv[i].size);
+        if (n < (int)sizeof(buf))
+            snprintf(buf + n, sizeof(buf) - (size_t)n, " bin  (F6)");
+        render_text(ctx, ctx->font_sm, buf, PX, WIN_H-124,
+                    (SDL_Color){105,115,130,255});
+    }
+    if (pl->nf.rows) {
+        snprintf(buf, sizeof(buf), "Taban: %.1f dB  Tepe: %.1f dB",
+                 pl->nf.floor_db, pl->nf.top_db);
+        render_text(ctx, ctx->font_sm, buf, PX, WIN_H-92,
+                    (SDL_Color){105,115,130,255});
+    }
     snprintf(buf, sizeof(buf), "FC : %.3f MHz", sdr->center_freq / 1e6);
     render_text(ctx, ctx->font_sm, buf, PX, WIN_H-44,
                 (SDL_Color){105,115,130,255});
@@ -150,11 +283,78 @@ static void refresh_agc_btn(Panel *p, const SdrDevice *sdr) {
     }
 }
 
+/* ── Yardımcı: otomatik ölçek butonu ───────────────────────── */
+static void refresh_autoscale_btn(Panel *p) {
+    if (p->auto_scale) {
+        strncpy(p->btn_autoscale.text, "Oto Ölçek: Açık", sizeof(p->btn_autoscale.text)-1);
+        p->btn_autoscale.bg = (SDL_Color){55,115,55,255};
+    } else {
+        strncpy(p->btn_autoscale.text, "Oto Ölçek: Kapalı", sizeof(p->btn_autoscale.text)-1);
+        p->btn_autoscale.bg = (SDL_Color){40,40,70,255};
+    }
+}
+
+/* ── Yardımcı: tarama butonu metni ─────────────────────────── */
+static void refresh_sweep_btn(Panel *p, const Sweep *sw) {
+    if (sw->active) {
+        strncpy(p->btn_sweep.text, "Tarama Durdur", sizeof(p->btn_sweep.text)-1);
+        p->btn_sweep.bg = (SDL_Color){118,72,20,255};
+    } else {
+        strncpy(p->btn_sweep.text, "Tarama Başlat", sizeof(p->btn_sweep.text)-1);
+        p->btn_sweep.bg = (SDL_Color){40,80,160,255};
+    }
+}
+
+/* ── Yardımcı: taramayı başlat / durdur ────────────────────── */
+static void toggle_sweep(Panel *p, SdrDevice *sdr, Sweep *sw) {
+    if (sw->active) {
+        sweep_stop(sw);
+        apply_freq(p, sdr);   /* taramadan önceki merkez frekansa dön */
+    } else {
+        uint32_t f0 = (uint32_t)(atof(p->ti_sw_start.buf) * 1e6);
+        uint32_t f1 = (uint32_t)(atof(p->ti_sw_stop.buf)  * 1e6);
+        if (sweep_start(sw, f0, f1, sdr->sample_rate) != 0) {
+            fprintf(stderr, "[SWEEP] Gecersiz aralik: %s - %s\n",
+                    p->ti_sw_start.buf, p->ti_sw_stop.buf);
+            return;
+        }
+    }
+    refresh_sweep_btn(p, sw);
+}
+
+/* ── Yardımcı: odaktaki metin kutusu ───────────────────────── */
+static TextInput *focused_input(Panel *p) {
+    if (p->ti_freq.active)     return &p->ti_freq;
+    if (p->ti_sw_start.active) return &p->ti_sw_start;
+    if (p->ti_sw_stop.active)  return &p->ti_sw_stop;
+    return NULL;
+}
+
+/* ── Seçili hatta eşitle ───────────────────────────────────── */
+void panel_sync(Panel *p, const Pipeline *pl) {
+    const SdrDevice *sdr = &pl->sdr;
+    snprintf(p->ti_freq.buf, sizeof(p->ti_freq.buf),
+             "%.3f", sdr->center_freq / 1e6);
+    p->ti_freq.len = (int)strlen(p->ti_freq.buf);
+    for (int i = 0; i < SR_COUNT; i++)
+        if (SR_OPTS[i].sr == sdr->sample_rate) p->sr_sel = i;
+    update_sr_buttons(p);
+    p->sl_gain.val = sdr->gain_db;
+    p->sl_tau.val  = pl->traces.tau_s;
+    refresh_agc_btn(p, sdr);
+    refresh_sweep_btn(p, &pl->sweep);
+    update_trace_buttons(p, &pl->traces);
+}
+
 /* ── Olay işleyicisi ────────────────────────────────────────── */
-void panel_handle_event(Panel *p, SDL_Event *ev,
-                        SdrDevice *sdr, RecorderState *rec,
+void panel_handle_event(Panel *p, SDL_Event *ev, Pipeline *pl,
                         RenderCtx *ctx) {
+    SdrDevice     *sdr = &pl->sdr;
+    RecorderState *rec = &pl->rec;
+    Sweep         *sw  = &pl->sweep;
+    TraceSet      *tr  = &pl->traces;
     int mx, my;
+    TextInput *ti;
     SDL_GetMouseState(&mx, &my);
 
     switch (ev->type) {
@@ -164,26 +364,45 @@ void panel_handle_event(Panel *p, SDL_Event *ev,
         if (ev->button.button != SDL_BUTTON_LEFT) break;
 
         /* TextInput odak */
-        if (textinput_hit(&p->ti_freq, mx, my)) {
-            p->ti_freq.active = 1;
-            SDL_StartTextInput();
-        } else {
-            p->ti_freq.active = 0;
-            SDL_StopTextInput();
-        }
+        p->ti_freq.active     = textinput_hit(&p->ti_freq,     mx, my);
+        p->ti_sw_start.active = textinput_hit(&p->ti_sw_start, mx, my);
+        p->ti_sw_stop.active  = textinput_hit(&p->ti_sw_stop,  mx, my);
+        if (focused_input(p)) SDL_StartTextInput();
+        else                  SDL_StopTextInput();
 
         /* Butonlar */
-        if (button_hit(&p->btn_setfreq, mx, my)) apply_freq(p, sdr);
+        if (button_hit(&p->btn_setfreq, mx, my)) {
+            if (sw->active) toggle_sweep(p, sdr, sw);   /* durdurur + frekansı uygular */
+            else            apply_freq(p, sdr);
+        }
 
         for (int i = 0; i < SR_COUNT; i++) {
             if (button_hit(&p->btn_sr[i], mx, my)) {
                 p->sr_sel = i;
                 sdr_set_sr(sdr, SR_OPTS[i].sr);
                 update_sr_buttons(p);
+                /* Adım planı sample rate'e bağlı: taramayı yeni SR ile yeniden kur */
+                if (sw->active)
+                    sweep_start(sw, sw->f_start, sw->f_stop, sdr->sample_rate);
                 break;
             }
         }
 
+        if (button_hit(&p->btn_sweep, mx, my)) toggle_sweep(p, sdr, sw);
+
+        for (int i = 0; i < TRACE_COUNT; i++) {
+            if (button_hit(&p->btn_trace[i], mx, my)) {
+                tr->shown ^= 1u << i;
+                update_trace_buttons(p, tr);
+            }
+        }
+        if (button_hit(&p->btn_trace_reset, mx, my)) trace_reset(tr);
+
+        if (button_hit(&p->btn_autoscale, mx, my)) {
+            p->auto_scale = !p->auto_scale;
+            refresh_autoscale_btn(p);
+        }
+
         if (button_hit(&p->btn_agc, mx, my)) {
             sdr_set_agc(sdr, !sdr->agc_on);
             refresh_agc_btn(p, sdr);
@@ -198,6 +417,12 @@ void panel_handle_event(Panel *p, SDL_Event *ev,
             sdr_set_gain(sdr, p->sl_gain.val);
             refresh_agc_btn(p, sdr);
         }
+        /* Elle ayar otomatik ölçeği kapatır */
+        if ((slider_hit(&p->sl_dbmin, mx, my) || slider_hit(&p->sl_dbmax, mx, my)) &&
+            p->auto_scale) {
+            p->auto_scale = 0;
+            refresh_autoscale_btn(p);
+        }
         if (slider_hit(&p->sl_dbmin, mx, my)) {
             p->drag = &p->sl_dbmin;
             slider_set_from_x(&p->sl_dbmin, mx);
@@ -208,6 +433,11 @@ void panel_handle_event(Panel *p, SDL_Event *ev,
             slider_set_from_x(&p->sl_dbmax, mx);
             ctx->db_max = p->sl_dbmax.val;
         }
+        if (slider_hit(&p->sl_tau, mx, my)) {
+            p->drag = &p->sl_tau;
+            slider_set_from_x(&p->sl_tau, mx);
+            tr->tau_s = p->sl_tau.val;
+        }
         break;
 
     /* ─── Fare bırak ─── */
@@ -225,38 +455,47 @@ void panel_handle_event(Panel *p, SDL_Event *ev,
             }
             if (p->drag == &p->sl_dbmin) ctx->db_min = p->sl_dbmin.val;
             if (p->drag == &p->sl_dbmax) ctx->db_max = p->sl_dbmax.val;
+            if (p->drag == &p->sl_tau)   tr->tau_s  = p->sl_tau.val;
         }
         /* Hover güncelle */
         p->btn_setfreq.hover = button_hit(&p->btn_setfreq, mx, my);
         p->btn_agc.hover     = button_hit(&p->btn_agc,     mx, my);
+        p->btn_autoscale.hover = button_hit(&p->btn_autoscale, mx, my);
         p->btn_rec.hover     = button_hit(&p->btn_rec,     mx, my);
         p->btn_stop.hover    = button_hit(&p->btn_stop,    mx, my);
+        p->btn_sweep.hover   = button_hit(&p->btn_sweep,   mx, my);
+        p->btn_trace_reset.hover = button_hit(&p->btn_trace_reset, mx, my);
+        for (int i = 0; i < TRACE_COUNT; i++)
+            p->btn_trace[i].hover = button_hit(&p->btn_trace[i], mx, my);
         for (int i = 0; i < SR_COUNT; i++)
             p->btn_sr[i].hover = button_hit(&p->btn_sr[i], mx, my);
         break;
 
     /* ─── Metin girişi ─── */
     case SDL_TEXTINPUT:
-        if (p->ti_freq.active) {
+        if ((ti = focused_input(p)) != NULL) {
             for (const char *c = ev->text.text; *c; c++)
                 if ((*c >= '0' && *c <= '9') || *c == '.')
-                    textinput_append_char(&p->ti_freq, *c);
+                    textinput_append_char(ti, *c);
         }
         break;
 
     /* ─── Tuş ─── */
     case SDL_KEYDOWN:
-        if (p->ti_freq.active) {
+        if ((ti = focused_input(p)) != NULL) {
             if (ev->key.keysym.sym == SDLK_BACKSPACE)
-                textinput_backspace(&p->ti_freq);
+                textinput_backspace(ti);
             if (ev->key.keysym.sym == SDLK_RETURN ||
-                ev->key.keysym.sym == SDLK_KP_ENTER)
-                apply_freq(p, sdr);
+                ev->key.keysym.sym == SDLK_KP_ENTER) {
+                if (ti == &p->ti_freq)  apply_freq(p, sdr);
+                else if (!sw->active)   toggle_sweep(p, sdr, sw);
+            }
             if (ev->key.keysym.sym == SDLK_ESCAPE) {
-                p->ti_freq.active = 0;
+                ti->active = 0;
                 SDL_StopTextInput();
             }
-        } else {
+        } else if (!sw->active) {
+            /* Tarama sırasında frekansı tarama zamanlayıcısı yönetir */
             /* Frekans kaydırma klavye kısayolları */
             if (ev->key.keysym.sym == SDLK_RIGHT)  sdr_shift_freq(sdr, +1000000);
             if (ev->key.keysym.sym == SDLK_LEFT)   sdr_shift_freq(sdr, -1000000);
@@ -269,4 +508,19 @@ void panel_handle_event(Panel *p, SDL_Event *ev,
         }
         break;
     }
-}
\ No newline at end of file
+}
+
+/* ── Otomatik ölçek ─────────────────────────────────────────── */
+static float clamp_to(const Slider *s, float v) {
+    return v < s->min ? s->min : (v > s->max ? s->max : v);
+}
+
+void panel_auto_scale(Panel *p, RenderCtx *ctx, const PipeView *v, int follow) {
+    if (!p->auto_scale || !v->auto_valid) return;
+    ctx->db_min = clamp_to(&p->sl_dbmin, v->auto_min);
+    ctx->db_max = clamp_to(&p->sl_dbmax, v->auto_max);
+    if (follow) {
+        p->sl_dbmin.val = ctx->db_min;
+        p->sl_dbmax.val = ctx->db_max;
+    }
+}
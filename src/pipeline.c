@@ -0,0 +1,756 @@
+/* pipeline.c — Cihaz başına bağımsız işleme hattı */
+#include "pipeline.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+/* ── Yardımcılar ──────────────────────────────────────────────── */
+
+int pipeline_avg_blocks(uint32_t sample_rate) {
+    int n = (int)(sample_rate / FFT_SIZE / PIPE_ROW_RATE);
+    return n < 1 ? 1 : n;
+}
+
+/*
+ * Tarama zamanlayıcısının ayar isteği → bu hattın SDR'ı. sweep_feed
+ * dsp_thread_fn'de çalıştığından DSP thread'inde çağrılır; on_pipe_data
+ * (USB callback) taramaya dokunmaz, sdr_set_freq'in kontrol aktarımı olay
+ * döngüsünü bekletmez.
+ */
+static uint32_t on_sweep_tune(uint32_t hz, void *ud) {
+    sdr_set_freq((SdrDevice *)ud, hz);
+    return sdr_generation((SdrDevice *)ud);
+}
+
+/*
+ * USB (veya rtl_tcp) async thread'inden her blokta çağrılır. Kaydedici ve DSP kuyruğu
+ * ayrı tamponlardır: DSP geride kalsa bile kayıt blok kaybetmez. DC + IQ
+ * düzeltmesi burada, tüm tüketicilerden önce yapılır; kayıt istenirse ham kalır.
+ */
+static void on_pipe_data(const uint8_t *raw, uint32_t len,
+                         const SdrBlockMeta *meta, void *ud) {
+    Pipeline *pl = (Pipeline *)ud;
+    uint64_t  t  = stats_now_us();
+    if (pl->last_cb_us) stats_record(&pl->stats, STAT_H_CB_GAP, t - pl->last_cb_us);
+    pl->last_cb_us = t;
+    stats_inc(&pl->stats, STAT_C_BLOCKS);
+
+    uint8_t buf[FFT_SIZE * 2];
+    iqcorr_process(&pl->iqc, raw, buf, meta->sr);
+    stats_since(&pl->stats, STAT_H_IQCORR, t);
+
+    const uint8_t *rec_buf = pl->rec_corr ? buf : raw;
+    if (recorder_push(&pl->rec, rec_buf, meta) != 0)
+        stats_inc(&pl->stats, STAT_C_REC_DROPS);
+    snap_push(&pl->snap, rec_buf, meta);
+    stage_push_block(&pl->stages, buf, meta);
+    if (demod_push(&pl->demod, buf, meta) != 0)
+        stats_inc(&pl->stats, STAT_C_DEMOD_DROPS);
+    if (pl->shm)
+        shmring_publish_iq(pl->shm, buf, len, meta->freq, meta->sr);
+
+    mutex_lock(&pl->q_cs);
+    if (pl->q_wi - pl->q_ri < PIPE_QUEUE) {
+        memcpy(pl->queue[pl->q_wi % PIPE_QUEUE], buf, FFT_SIZE * 2);
+        pl->q_meta[pl->q_wi % PIPE_QUEUE] = *meta;
+        if (pl->q_wi++ == pl->q_ri)   /* boştan dolmaya geçiş: DSP bekliyor olabilir */
+            cond_signal(&pl->q_cv);
+    } else {
+        stats_inc(&pl->stats, STAT_C_Q_DROPS);
+    }
+    mutex_unlock(&pl->q_cs);
+    stats_since(&pl->stats, STAT_H_CB_TIME, t);
+}
+
+/* Kuyruk boşsa en çok 10 ms blok bekler; dsp_running düşünce döngü çıkabilsin */
+static int queue_pop(Pipeline *pl, uint8_t *out, SdrBlockMeta *meta) {
+    mutex_lock(&pl->q_cs);
+    if (pl->q_ri == pl->q_wi)
+        cond_wait_ms(&pl->q_cv, &pl->q_cs, 10);
+    int has_data = (pl->q_ri != pl->q_wi);
+    mutex_unlock(&pl->q_cs);
+    if (!has_data) return 0;
+
+    memcpy(out, pl->queue[pl->q_ri % PIPE_QUEUE], FFT_SIZE * 2);
+    *meta = pl->q_meta[pl->q_ri % PIPE_QUEUE];
+    mutex_lock(&pl->q_cs);
+    pl->q_ri++;
+    mutex_unlock(&pl->q_cs);
+    return 1;
+}
+
+/*
+ * Yeni PSD satırı: dedektör, izler ve şelale (view_cs altında), yayın.
+ * det_row / floor_row verilmişse dedektör / gürültü tabanı kestirimi satır
+ * yerine onu görür: en büyükle indirilmiş satırın tabanı ortalamadan
+ * yüksek durur, gösterim en büyüğü, kestirim ortalamayı kullanır.
+ */
+static void emit_row(Pipeline *pl, const float *row, const float *det_row,
+                     const float *floor_row,
+                     double center_hz, double span_hz, uint64_t t_arrival) {
+    uint64_t t0 = stats_now_us();
+    uint64_t t  = wall_ms();
+    float    dt = pl->last_row_ms ? (float)(t - pl->last_row_ms) / 1000.0f : 0.0f;
+    pl->last_row_ms = t;
+
+    mutex_lock(&pl->view_cs);
+    detector_process(&pl->det, det_row ? det_row : row, FFT_SIZE, t, center_hz, span_hz);
+
+    /* Frekans ekseni değiştiyse izlerin geçmişi anlamsız: sıfırla */
+    if (center_hz != pl->row_center_hz || span_hz != pl->row_span_hz) {
+        trace_reset(&pl->traces);
+        nf_reset(&pl->nf);
+    }
+    pl->row_center_hz = center_hz;
+    pl->row_span_hz   = span_hz;
+    trace_update(&pl->traces, row, dt);
+    nf_update(&pl->nf, floor_row ? floor_row : row, dt);
+
+    memcpy(pl->psd, row, sizeof(pl->psd));
+    memcpy(pl->wf[pl->wf_head], row, sizeof(pl->wf[0]));
+    pl->wf_head  = (pl->wf_head + 1) % PIPE_WF_ROWS;
+    pl->row_t_us = t_arrival;
+    uint32_t seq = pl->det.row;
+    uint32_t started = pl->det.n_started;
+    mutex_unlock(&pl->view_cs);
+
+    /* Yeni olay: ön pencere dedektör gecikmesini (kuyruk + ortalama) kapsar */
+    if (pl->snap_det && started != pl->snap_det_seen) {
+        pl->snap_det_seen = started;
+        snap_trigger(&pl->snap, "dedektor");
+    }
+
+    stats_inc(&pl->stats, STAT_C_ROWS);
+    uint64_t t_done = stats_since(&pl->stats, STAT_H_ROW, t0);
+    stats_record(&pl->stats, STAT_H_DSP_LAT, t_done - t_arrival);
+
+    StageRowMeta rm = { seq, FFT_SIZE, center_hz, span_hz, t_arrival };
+    stage_push_row(&pl->stages, row, &rm);
+    if (pl->srv)
+        specsrv_publish(pl->srv, pl->id, row, seq, t, center_hz, span_hz);
+    if (pl->shm)
+        shmring_publish_psd(pl->shm, row, FFT_SIZE, center_hz, span_hz);
+}
+
+/* ── Kanal çıkışları ──────────────────────────────────────────── */
+
+/* Kanal dosyası: ad frekansı ve çıkış hızını taşır, ham cf32 (I,Q float32) */
+static void chan_file_open(Pipeline *pl, const Chan *ch) {
+    char path[320];
+    time_t t = time(NULL);
+    struct tm *tm = localtime(&t);
+    snprintf(path, sizeof(path),
+        "%s" PATH_SEP "ch%d_%s_%.3fk_%usps_%04d%02d%02d_%02d%02d%02d.cf32",
+        pl->rec.dir, ch->id, pl->rec.tag, ch->freq_hz / 1e3, ch->out_sr,
+        tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday,
+        tm->tm_hour, tm->tm_min, tm->tm_sec);
+    pl->ch_fp[ch->id]   = fopen(path, "wb");
+    pl->ch_plan[ch->id] = ch->plan_id;
+    if (pl->ch_fp[ch->id]) {
+        setvbuf(pl->ch_fp[ch->id], NULL, _IOFBF, 1 << 16);
+        printf("[PIPE] Kanal kaydi: %s\n", path);
+    } else {
+        fprintf(stderr, "[PIPE] Kanal dosyasi acilamadi: %s\n", path);
+    }
+}
+
+static void chan_file_close(Pipeline *pl, int id) {
+    if (!pl->ch_fp[id]) return;
+    fclose(pl->ch_fp[id]);
+    pl->ch_fp[id] = NULL;
+}
+
+/*
+ * Kanal ayırıcı callback'i (DSP thread'i). Kanal akışları dar olduğundan
+ * (12.5 kHz kanal ≈ 150 KB/s) tamponlu fwrite kayıt thread'i gerektirmez.
+ * Plan değişince (yeniden ayar, hız) dosya kapanır; sonraki blok yeni hızla
+ * yeni dosya açar.
+ */
+static void on_chan_out(const Chan *ch, const FftCpx *iq, int n, void *ud) {
+    Pipeline *pl = (Pipeline *)ud;
+    int       id = ch->id;
+
+    if (pl->ch_fp[id] && (!pl->rec.active || pl->ch_plan[id] != ch->plan_id))
+        chan_file_close(pl, id);
+    if (pl->rec.active && !pl->ch_fp[id])
+        chan_file_open(pl, ch);
+    if (pl->ch_fp[id])
+        fwrite(iq, sizeof(*iq), (size_t)n, pl->ch_fp[id]);
+
+    if (pl->shm) {
+        uint32_t bytes = (uint32_t)n * sizeof(*iq);
+        if (pl->ch_shm[id] && pl->ch_shm_bytes[id] < bytes) {
+            shmring_destroy(pl->ch_shm[id]);   /* daha geniş plan: yuvalar büyümeli */
+            pl->ch_shm[id] = NULL;
+        }
+        if (!pl->ch_shm[id]) {
+            char name[64];
+            snprintf(name, sizeof(name), "radar_%s_ch%d", pl->rec.tag, id);
+            pl->ch_shm[id]       = shmring_create(name, bytes, 0);
+            pl->ch_shm_bytes[id] = bytes;
+        }
+        if (pl->ch_shm[id])
+            shmring_publish_iq(pl->ch_shm[id], (const uint8_t *)iq, bytes,
+                               ch->freq_hz, ch->out_sr);
+    }
+}
+
+/* ── DSP thread'i ─────────────────────────────────────────────── */
+
+/* Ayar kuşağından gelen satır: yayınla, yeniden ayar gecikmesini ölç */
+static void emit_tuned_row(Pipeline *pl, const float *row, const float *det_row,
+                           double center_hz, double span_hz, const SdrBlockMeta *m) {
+    emit_row(pl, row, det_row, det_row, center_hz, span_hz, m->t_us);
+    if (m->gen != pl->row_gen) {
+        if (pl->row_gen)
+            stats_since(&pl->stats, STAT_H_RETUNE, m->gen_t_us);
+        pl->row_gen = m->gen;
+    }
+}
+
+/* İnce çözünürlük planını kur / kaldır (DSP thread'i); kurulamazsa istek düşer */
+static void fine_apply(Pipeline *pl, int log2n) {
+    bigfft_free(pl->fine);
+    free(pl->fine_raw);
+    free(pl->fine_pwr);
+    pl->fine      = NULL;
+    pl->fine_raw  = NULL;
+    pl->fine_pwr  = NULL;
+    pl->fine_fill = 0;
+    pl->fine_log2 = 0;
+    memset(pl->acc, 0, sizeof(pl->acc));
+    pl->acc_n = 0;
+    if (!log2n) return;
+
+    size_t n = (size_t)1 << log2n;
+    pl->fine     = bigfft_create(log2n, 0);
+    pl->fine_raw = malloc(n * 2);
+    pl->fine_pwr = malloc(n * sizeof(float));
+    if (!pl->fine || !pl->fine_raw || !pl->fine_pwr) {
+        fine_apply(pl, 0);
+        __atomic_store_n(&pl->fine_req, 0, __ATOMIC_RELAXED);
+        fprintf(stderr, "[PIPE] %s: ince cozunurluk acilamadi\n", pl->name);
+        return;
+    }
+    pl->fine_log2 = log2n;
+    printf("[PIPE] %s: ince cozunurluk 2^%d, %.2f Hz/bin, satir %.2f s\n", pl->name,
+           log2n, pl->sdr.sample_rate / (double)n, n / (double)pl->sdr.sample_rate);
+}
+
+/*
+ * Oturmuş blokları büyük FFT boyuna dek biriktir; dolunca tek dönüşüm.
+ * Yakınlaştırma penceresinin bin'leri FFT_SIZE sütuna iki kez indirilir:
+ * gösterim en güçlü bin ile (dar taşıyıcı kaybolmaz), dedektör ve gürültü
+ * tabanı ortalamayla. k bin'in en büyüğü gürültüde ortalamanın ~H_k katıdır
+ * (1M tam bantta k = 1024, ~9 dB); kestirim bu kaymayı görmez.
+ */
+static void fine_feed(Pipeline *pl, const uint8_t *blk, const SdrBlockMeta *m,
+                      float *row, float *det) {
+    int      n     = bigfft_size(pl->fine);
+    uint32_t n_blk = (uint32_t)n / FFT_SIZE;
+    if (m->sample != pl->fine_next)   /* kayıp blok: büyük pencere süreksiz */
+        pl->fine_fill = 0;
+    pl->fine_next = m->sample + FFT_SIZE;
+    memcpy(pl->fine_raw + (size_t)pl->fine_fill * FFT_SIZE * 2, blk, FFT_SIZE * 2);
+    if (++pl->fine_fill < n_blk) return;
+    pl->fine_fill = 0;
+
+    /* Pencere: ayarlı merkeze göre ofset + açıklık, en az bir sütuna bir bin */
+    double bin = (double)m->sr / n;
+    mutex_lock(&pl->view_cs);
+    double off = pl->fine_zoom_off, span = pl->fine_zoom_span;
+    mutex_unlock(&pl->view_cs);
+    int w = (span > 0.0) ? (int)(span / bin) : n;
+    if (w < FFT_SIZE) w = FFT_SIZE;
+    if (w > n)        w = n;
+    int lo = n / 2 + (int)lround(off / bin) - w / 2;
+    if (lo < 0)     lo = 0;
+    if (lo > n - w) lo = n - w;
+
+    uint64_t t0 = stats_now_us();
+    bigfft_power_u8(pl->fine, pl->fine_raw, pl->fine_pwr);
+    bigfft_decimate(pl->fine_pwr, lo, lo + w, row, FFT_SIZE, 1);
+    bigfft_decimate(pl->fine_pwr, lo, lo + w, det, FFT_SIZE, 0);
+    fft_power_db(row, 1.0f, row, FFT_SIZE);
+    fft_power_db(det, 1.0f, det, FFT_SIZE);
+    stats_since(&pl->stats, STAT_H_FINE_FFT, t0);
+    emit_tuned_row(pl, row, det, (double)m->freq + (lo + w / 2 - n / 2) * bin,
+                   w * bin, m);
+}
+
+/*
+ * Ek çözünürlük düzeyinin yeni satırı: yerel bin'lerle dedektör ve shm,
+ * GUI için FFT_SIZE sütuna en güçlü bin ile indirilmiş kopya.
+ */
+static void mres_emit(Pipeline *pl, int i, const SdrBlockMeta *m) {
+    const MresLevel *l = &pl->mres.lv[i];
+    float col[FFT_SIZE];
+
+    detector_process(pl->mres_det[i], l->row, l->size, wall_ms(),
+                     (double)m->freq, (double)m->sr);
+    if (pl->mres_shm[i])
+        shmring_publish_psd(pl->mres_shm[i], l->row, (uint32_t)l->size,
+                            (double)m->freq, (double)m->sr);
+    bigfft_decimate(l->row, 0, l->size, col, FFT_SIZE, 1);
+    mutex_lock(&pl->view_cs);
+    memcpy(pl->mres_view[i], col, sizeof(col));
+    mutex_unlock(&pl->view_cs);
+    stats_inc(&pl->stats, STAT_C_MRES_ROWS);
+}
+
+static void dsp_thread_fn(void *arg) {
+    Pipeline *pl = (Pipeline *)arg;
+
+    uint8_t      blk[FFT_SIZE * 2];
+    float        pwr[FFT_SIZE];
+    float        row[FFT_SIZE];
+    float        mean[FFT_SIZE];
+    SdrBlockMeta m;
+
+    while (pl->dsp_running) {
+        if (pl->fine_req != pl->fine_log2) fine_apply(pl, pl->fine_req);
+        if (!queue_pop(pl, blk, &m)) continue;
+        stats_since(&pl->stats, STAT_H_QUEUE, m.t_us);
+
+        /* Tarama modu: satırlar tamamlanan panoramik taramalardır */
+        if (pl->sweep.active) {
+            pl->acc_n = 0;
+            sweep_feed(&pl->sweep, blk, &m);
+            if (sweep_pop_row(&pl->sweep, row, mean, FFT_SIZE))
+                emit_row(pl, row, NULL, mean,
+                         (pl->sweep.f_start + (double)pl->sweep.f_stop) / 2.0,
+                         (double)pl->sweep.f_stop - pl->sweep.f_start, m.t_us);
+            continue;
+        }
+
+        /*
+         * Eski ayarla yakalanmış ya da PLL'i oturmamış blok: şelaleye
+         * girmez. Kuşak değiştiyse yarım kalan ortalama da atılır; tampon
+         * boşaltmak gerekmez, frekans / hız satıra bloğun etiketinden gelir.
+         */
+        if (m.gen != pl->acc_gen) {
+            memset(pl->acc, 0, sizeof(pl->acc));
+            pl->acc_n      = 0;
+            pl->acc_gen    = m.gen;
+            pl->avg_blocks = pipeline_avg_blocks(m.sr);
+            pl->fine_fill  = 0;
+            mres_reset(&pl->mres, m.sr, PIPE_ROW_RATE);
+        }
+        if (m.settling) {
+            stats_inc(&pl->stats, STAT_C_SETTLE);
+            continue;
+        }
+
+        if (pl->chan.n_used) {
+            uint64_t t_ch = stats_now_us();
+            chan_feed(&pl->chan, blk, &m);
+            stats_since(&pl->stats, STAT_H_CHAN, t_ch);
+        }
+
+        if (pl->mres.n) {
+            uint64_t t_mr  = stats_now_us();
+            unsigned ready = mres_feed(&pl->mres, blk, m.sample);
+            for (int i = 0; i < pl->mres.n; i++)
+                if (ready & (1u << i)) mres_emit(pl, i, &m);
+            stats_since(&pl->stats, STAT_H_MRES, t_mr);
+        }
+
+        if (pl->fine) {
+            fine_feed(pl, blk, &m, row, mean);
+            continue;
+        }
+
+        uint64_t t_fft = stats_now_us();
+        fft_compute_power(blk, pwr);
+        stats_since(&pl->stats, STAT_H_FFT, t_fft);
+        for (int k = 0; k < FFT_SIZE; k++) pl->acc[k] += pwr[k];
+
+        if (++pl->acc_n >= pl->avg_blocks) {
+            fft_power_db(pl->acc, 1.0f / (float)pl->acc_n, row, FFT_SIZE);
+            memset(pl->acc, 0, sizeof(pl->acc));
+            pl->acc_n = 0;
+            emit_tuned_row(pl, row, NULL, (double)m.freq, (double)m.sr, &m);
+        }
+    }
+    fine_apply(pl, 0);
+}
+
+/* Dedektör günlüğü: "det_<etiket>[_<ek>]_<zaman>.csv" */
+static void det_log_open(Pipeline *pl, Detector *d, const char *suffix) {
+    char path[320];
+    time_t t = time(NULL);
+    struct tm *tm = localtime(&t);
+    snprintf(path, sizeof(path),
+        "%s" PATH_SEP "det_%s%s_%04d%02d%02d_%02d%02d%02d.csv", pl->rec.dir,
+        pl->rec.tag, suffix, tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday,
+        tm->tm_hour, tm->tm_min, tm->tm_sec);
+    detector_open_log(d, path);
+}
+
+/* Ek çözünürlük düzeyi: FFT planı, dedektör, isteğe bağlı shm halkası */
+static void mres_open_level(Pipeline *pl, int size, int avg, int shm) {
+    Detector *d = malloc(sizeof(Detector));
+    int       i = d ? mres_add(&pl->mres, size, avg) : -1;
+    if (i < 0) {
+        free(d);
+        fprintf(stderr, "[PIPE] %s: %d binlik cozunurluk eklenemedi\n", pl->name, size);
+        return;
+    }
+    char sfx[16];
+    snprintf(sfx, sizeof(sfx), "_r%d", size);
+    detector_init(d);
+    det_log_open(pl, d, sfx);
+    pl->mres_det[i] = d;
+
+    if (shm) {
+        char name[64];
+        snprintf(name, sizeof(name), "radar_%s%s", pl->rec.tag, sfx);
+        pl->mres_shm[i] = shmring_create(name, 0, (uint32_t)size);
+    }
+}
+
+/* ── Genel API ────────────────────────────────────────────────── */
+void pipeline_parse_spec(char *spec, char kind, PipeConfig *c) {
+    memset(c, 0, sizeof(*c));
+    c->tcp_port = RTLTCP_DEFAULT_PORT;
+    c->cpu_usb = c->cpu_dsp = c->cpu_rec = -1;
+
+    char *at = strchr(spec, '@');
+    if (at) {
+        *at = '\0';
+        sscanf(at + 1, "%d,%d,%d", &c->cpu_usb, &c->cpu_dsp, &c->cpu_rec);
+    }
+    if (kind == 's') {
+        c->serial = spec;
+    } else if (kind == 'r') {
+        char *colon = strrchr(spec, ':');
+        if (colon) {
+            *colon = '\0';
+            c->tcp_port = (uint16_t)atoi(colon + 1);
+        }
+        c->tcp_host = spec;
+    } else {
+        c->dev_index = atoi(spec);
+    }
+}
+
+int pipeline_open(Pipeline *pl, int id, const PipeConfig *cfg) {
+    memset(pl, 0, sizeof(*pl));
+    pl->id      = id;
+    pl->cpu_dsp = cfg->cpu_dsp;
+    pl->rec_corr = cfg->rec_corr;
+    iqcorr_init(&pl->iqc);
+
+    /* Dosya adlarında cihazı ayırt eden etiket: seri no, yoksa indeks */
+    char tag[32];
+    if (cfg->tcp_host) {
+        if (sdr_open_tcp(&pl->sdr, cfg->tcp_host, cfg->tcp_port) != 0) return -1;
+        snprintf(tag, sizeof(tag), "tcp_%.20s_%u", cfg->tcp_host, cfg->tcp_port);
+        for (char *c = tag; *c; c++)   /* IPv6 / alan adı → dosya adına uygun */
+            if (*c == ':' || *c == '.') *c = '-';
+        snprintf(pl->name, sizeof(pl->name), "TCP %.20s:%u",
+                 cfg->tcp_host, cfg->tcp_port);
+    } else {
+        int index = cfg->dev_index;
+        if (cfg->serial) {
+            index = sdr_find_serial(cfg->serial);
+            if (index < 0) {
+                fprintf(stderr, "[PIPE] Seri no bulunamadi: %s\n", cfg->serial);
+                return -1;
+            }
+        }
+        if (sdr_open(&pl->sdr, (uint32_t)index) != 0) return -1;
+
+        if (pl->sdr.serial[0]) snprintf(tag, sizeof(tag), "sn%.28s", pl->sdr.serial);
+        else                   snprintf(tag, sizeof(tag), "d%d", index);
+        if (pl->sdr.serial[0])
+            snprintf(pl->name, sizeof(pl->name), "#%d SN:%.20s", index, pl->sdr.serial);
+        else
+            snprintf(pl->name, sizeof(pl->name), "#%d", index);
+    }
+    pl->sdr.cpu     = cfg->cpu_usb;
+    pl->sdr.rt_prio = cfg->rt_prio;
+    pl->sdr.stats   = &pl->stats;
+    if (cfg->xfer_len || cfg->xfer_num)
+        sdr_set_xfer(&pl->sdr, cfg->xfer_len ? cfg->xfer_len : SDR_XFER_LEN_DEF,
+                     cfg->xfer_num ? cfg->xfer_num : SDR_XFER_NUM_DEF);
+
+    recorder_init(&pl->rec);
+    pl->rec.cpu     = cfg->cpu_rec;
+    pl->rec.rt_prio = cfg->rt_prio;
+    snprintf(pl->rec.tag, sizeof(pl->rec.tag), "%s", tag);
+    if (cfg->out_dir)
+        snprintf(pl->rec.dir, sizeof(pl->rec.dir), "%s", cfg->out_dir);
+
+    if (snap_init(&pl->snap, cfg->snap_pre_ms, cfg->snap_post_ms,
+                  pl->sdr.sample_rate) == 0 && pl->snap.ring) {
+        pl->snap.cpu     = cfg->cpu_rec;
+        pl->snap.rt_prio = cfg->rt_prio;
+        pl->snap_det     = cfg->snap_det;
+        snprintf(pl->snap.tag, sizeof(pl->snap.tag), "%s", tag);
+        snprintf(pl->snap.dir, sizeof(pl->snap.dir), "%s", pl->rec.dir);
+    }
+
+    if (demod_init(&pl->demod) == 0) {
+        pl->demod.cpu      = cfg->cpu_rec;
+        pl->demod.stats    = &pl->stats;
+        pl->demod.xfer_len = pl->sdr.xfer_len;
+        snprintf(pl->demod.tag, sizeof(pl->demod.tag), "%s", tag);
+        snprintf(pl->demod.dir, sizeof(pl->demod.dir), "%s", pl->rec.dir);
+        if (cfg->audio_out)
+            snprintf(pl->demod.out, sizeof(pl->demod.out), "%s", cfg->audio_out);
+        if (cfg->demod_mode != DEMOD_OFF)
+            demod_set(&pl->demod, cfg->demod_mode, cfg->demod_freq, cfg->demod_bw);
+    }
+
+    if (cfg->shm) {
+        char name[48];
+        snprintf(name, sizeof(name), "radar_%s", tag);
+        pl->shm = shmring_create(name, FFT_SIZE * 2, FFT_SIZE);
+    }
+
+    sweep_init(&pl->sweep, on_sweep_tune, &pl->sdr);
+    trace_init(&pl->traces);
+    nf_init(&pl->nf);
+    detector_init(&pl->det);
+    det_log_open(pl, &pl->det, "");
+
+    mres_init(&pl->mres);
+    for (int i = 0; i < cfg->mres_n; i++)
+        mres_open_level(pl, cfg->mres_size[i], cfg->mres_avg[i], cfg->shm);
+    mres_reset(&pl->mres, pl->sdr.sample_rate, PIPE_ROW_RATE);
+    for (int i = 0; i < pl->mres.n; i++) {
+        const MresLevel *l = &pl->mres.lv[i];
+        printf("[PIPE] %s: ek cozunurluk %d bin, %.1f Hz/bin, %d cerceve/satir\n",
+               pl->name, l->size, pl->sdr.sample_rate / (double)l->size, l->avg);
+    }
+
+    mutex_init(&pl->q_cs);
+    cond_init(&pl->q_cv);
+    mutex_init(&pl->view_cs);
+    chan_init(&pl->chan, on_chan_out, pl);
+
+    /*
+     * Başarısız olabilen adımlar sonda: buraya gelindiğinde pipeline_close'un
+     * dokunduğu her parça kurulmuştur, hata yolu hepsini (paylaşımlı bellek
+     * adları dahil) tek çağrıda geri alır.
+     */
+    int ok = stage_host_init(&pl->stages, pl->name, tag, pl->rec.dir, &pl->stats) == 0;
+    pl->queue = ok ? malloc(sizeof(*pl->queue) * PIPE_QUEUE) : NULL;
+    if (!pl->queue) {
+        if (ok) fprintf(stderr, "[PIPE] Bellek hatasi\n");
+        pipeline_close(pl);
+        return -1;
+    }
+    pl->avg_blocks = pipeline_avg_blocks(pl->sdr.sample_rate);
+    if (cfg->fine_log2) pipeline_set_fine(pl, cfg->fine_log2);
+    return 0;
+}
+
+void pipeline_start(Pipeline *pl) {
+    pl->q_wi = pl->q_ri = 0;
+    pl->last_cb_us  = 0;
+    pl->dsp_running = 1;
+    ThreadOpts o = { pl->cpu_dsp, 0 };
+    thread_start(&pl->dsp_thread, dsp_thread_fn, pl, &o);
+    snap_start(&pl->snap);
+    stage_host_start(&pl->stages);
+    demod_start(&pl->demod);
+    sdr_start_async(&pl->sdr, on_pipe_data, pl);
+}
+
+/*
+ * Sıra önemli: önce USB thread durur (artık blok gelmez), sonra DSP,
+ * en son kaydedici — aksi halde recorder_push çağrılmaya devam edebilir.
+ */
+void pipeline_stop(Pipeline *pl) {
+    sdr_stop_async(&pl->sdr);
+    mutex_lock(&pl->q_cs);
+    pl->dsp_running = 0;
+    cond_signal(&pl->q_cv);
+    mutex_unlock(&pl->q_cs);
+    thread_join(&pl->dsp_thread);
+    for (int i = 0; i < CHAN_MAX; i++) chan_file_close(pl, i);
+    if (pl->rec.active) recorder_stop(&pl->rec);
+    snap_stop(&pl->snap);
+    stage_host_stop(&pl->stages);
+    demod_stop(&pl->demod);
+    uint64_t qd = stats_get(&pl->stats, STAT_C_Q_DROPS);
+    uint64_t rd = stats_get(&pl->stats, STAT_C_REC_DROPS);
+    uint64_t sd = stats_get(&pl->stats, STAT_C_STAGE_DROPS);
+    if (qd || rd)
+        printf("[PIPE] %s: DSP kuyrugunda %llu, kayit halkasinda %llu blok atildi\n",
+               pl->name, (unsigned long long)qd, (unsigned long long)rd);
+    if (sd)
+        printf("[PIPE] %s: asama halkasi doluyken %llu giris atildi\n",
+               pl->name, (unsigned long long)sd);
+    if (pl->sdr.tcp) {
+        const RtlTcpStats *ts = rtltcp_stats(pl->sdr.tcp);
+        printf("[PIPE] %s: %llu bayt, %llu blok, en uzun bosluk %.1f ms, "
+               "en uzun teslim %.1f ms\n", pl->name,
+               (unsigned long long)ts->bytes, (unsigned long long)ts->blocks,
+               ts->gap_max_us / 1000.0, ts->dispatch_max_us / 1000.0);
+    }
+}
+
+void pipeline_close(Pipeline *pl) {
+    sweep_free(&pl->sweep);
+    detector_free(&pl->det);
+    for (int i = 0; i < pl->mres.n; i++) {
+        detector_free(pl->mres_det[i]);
+        free(pl->mres_det[i]);
+        pl->mres_det[i] = NULL;
+        shmring_destroy(pl->mres_shm[i]);
+        pl->mres_shm[i] = NULL;
+    }
+    mres_free(&pl->mres);
+    recorder_free(&pl->rec);
+    snap_free(&pl->snap);
+    stage_host_free(&pl->stages);
+    demod_free(&pl->demod);
+    sdr_close(&pl->sdr);
+    shmring_destroy(pl->shm);
+    pl->shm = NULL;
+    chan_free(&pl->chan);
+    for (int i = 0; i < CHAN_MAX; i++) {
+        shmring_destroy(pl->ch_shm[i]);
+        pl->ch_shm[i] = NULL;
+    }
+    free(pl->queue);
+    pl->queue = NULL;
+    cond_free(&pl->q_cv);
+    mutex_free(&pl->q_cs);
+    mutex_free(&pl->view_cs);
+}
+
+int pipeline_add_channel(Pipeline *pl, uint32_t freq_hz, uint32_t bw_hz) {
+    int id = chan_add(&pl->chan, freq_hz, bw_hz);
+    if (id >= 0)
+        printf("[PIPE] %s: kanal %d eklendi (%.4f MHz, %.1f kHz)\n",
+               pl->name, id, freq_hz / 1e6, bw_hz / 1e3);
+    return id;
+}
+
+void pipeline_set_fine(Pipeline *pl, int log2n) {
+    if (log2n && (log2n < BIGFFT_MIN_LOG2 || log2n > BIGFFT_MAX_LOG2)) {
+        fprintf(stderr, "[PIPE] %s: ince FFT boyu 2^%d..2^%d olmali\n",
+                pl->name, BIGFFT_MIN_LOG2, BIGFFT_MAX_LOG2);
+        return;
+    }
+    __atomic_store_n(&pl->fine_req, log2n, __ATOMIC_RELAXED);
+}
+
+void pipeline_set_fine_zoom(Pipeline *pl, double offset_hz, double span_hz) {
+    mutex_lock(&pl->view_cs);
+    pl->fine_zoom_off  = span_hz > 0.0 ? offset_hz : 0.0;
+    pl->fine_zoom_span = span_hz > 0.0 ? span_hz   : 0.0;
+    mutex_unlock(&pl->view_cs);
+}
+
+int pipeline_snapshot(Pipeline *pl, const char *reason) {
+    if (snap_trigger(&pl->snap, reason) != 0) {
+        fprintf(stderr, "[PIPE] %s: on tetik halkasi kapali (-B)\n", pl->name);
+        return -1;
+    }
+    return 0;
+}
+
+int pipeline_view(Pipeline *pl, PipeView *v) {
+    int got = 0;
+    mutex_lock(&pl->view_cs);
+    if (pl->det.row != v->row) {
+        memcpy(v->psd, pl->psd, sizeof(v->psd));
+
+        /* Halka → doğrusal: wf_head en eski satırı gösterir */
+        int h = pl->wf_head;
+        memcpy(v->waterfall[0], pl->wf[h],
+               sizeof(pl->wf[0]) * (PIPE_WF_ROWS - h));
+        memcpy(v->waterfall[PIPE_WF_ROWS - h], pl->wf[0],
+               sizeof(pl->wf[0]) * h);
+
+        for (int i = 0; i < TRACE_COUNT; i++)
+            memcpy(v->trace[i], trace_get(&pl->traces, (TraceKind)i),
+                   sizeof(v->trace[i]));
+        v->trace_seeded = pl->traces.seeded;
+
+        v->n_open   = pl->det.n_open;
+        v->n_recent = pl->det.n_recent;
+        memcpy(v->open,   pl->det.open,   sizeof(DetEvent) * v->n_open);
+        memcpy(v->recent, pl->det.recent, sizeof(DetEvent) * v->n_recent);
+
+        v->nf_floor   = pl->nf.floor_db;
+        v->nf_top     = pl->nf.top_db;
+        v->auto_min   = pl->nf.auto_min;
+        v->auto_max   = pl->nf.auto_max;
+        v->auto_valid = pl->nf.auto_valid;
+        v->fine_log2  = pl->fine_log2;
+        v->mres_n     = pl->mres.n;
+        for (int i = 0; i < pl->mres.n; i++) v->mres_size[i] = pl->mres.lv[i].size;
+        memcpy(v->mres, pl->mres_view, sizeof(pl->mres_view[0]) * pl->mres.n);
+        memcpy(v->nf_seg, pl->nf.seg_floor, sizeof(v->nf_seg));
+
+        v->row          = pl->det.row;
+        v->center_hz    = pl->row_center_hz;
+        v->span_hz      = pl->row_span_hz;
+        v->t_arrival_us = pl->row_t_us;
+        got = 1;
+    }
+    mutex_unlock(&pl->view_cs);
+    return got;
+}
+
+void pipeline_dump_stats(const char *path, Pipeline *const *pipes, int n,
+                         const Stats *ui) {
+    char tmp[272];
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    FILE *fp = fopen(tmp, "w");
+    if (!fp) {
+        fprintf(stderr, "[PIPE] Olcum dosyasi acilamadi: %s\n", tmp);
+        return;
+    }
+    fprintf(fp, "{\"t_ms\":%llu,\"pipes\":[", (unsigned long long)wall_ms());
+    for (int i = 0; i < n; i++) {
+        fprintf(fp, "%s{\"name\":\"%s\",\"stats\":", i ? "," : "", pipes[i]->name);
+        stats_write_json(fp, &pipes[i]->stats);
+        const NoiseFloor *nf = &pipes[i]->nf;   /* DSP yazarken okunur: yaklaşık */
+        fprintf(fp, ",\"noise_floor_db\":%.1f,\"top_db\":%.1f,\"seg_floor_db\":[",
+                nf->floor_db, nf->top_db);
+        for (int g = 0; g < NF_SEGS; g++)
+            fprintf(fp, "%s%.1f", g ? "," : "", nf->seg_floor[g]);
+        fprintf(fp, "]");
+        const IqCorr *qc = &pipes[i]->iqc;
+        fprintf(fp, ",\"iq_corr\":{\"dc_i\":%.2f,\"dc_q\":%.2f,\"gain_db\":%.3f,"
+                "\"phase_deg\":%.2f}", qc->dc_i, qc->dc_q, qc->gain_db, qc->phase_deg);
+        const MultiRes *mr = &pipes[i]->mres;
+        if (mr->n) {
+            fprintf(fp, ",\"multires\":[");
+            for (int k = 0; k < mr->n; k++)
+                fprintf(fp, "%s{\"bins\":%d,\"avg\":%d,\"rows\":%u,\"events\":%u}",
+                        k ? "," : "", mr->lv[k].size, mr->lv[k].avg, mr->lv[k].rows,
+                        pipes[i]->mres_det[k]->n_logged);
+            fprintf(fp, "]");
+        }
+        const Demod *dm = &pipes[i]->demod;
+        if (dm->on)
+            fprintf(fp, ",\"demod\":{\"mode\":\"%s\",\"freq_hz\":%u,\"bw_hz\":%u,"
+                    "\"channel_sr\":%u,\"latency_bound_ms\":%.2f,\"audio_s\":%.1f}",
+                    demod_mode_name(dm->mode), dm->freq_hz, dm->bw_hz, dm->fs_c,
+                    dm->lat_fixed_us / 1000.0, (double)dm->samples / DEMOD_AUDIO_SR);
+        if (pipes[i]->stages.n) {
+            fprintf(fp, ",\"stages\":");
+            stage_write_json(fp, &pipes[i]->stages);
+        }
+        fprintf(fp, "}");
+    }
+    fprintf(fp, "]");
+    if (ui) {
+        fprintf(fp, ",\"ui\":");
+        stats_write_json(fp, ui);
+    }
+    fprintf(fp, "}\n");
+    fclose(fp);
+    remove(path);   /* Windows rename hedefin üzerine yazmaz */
+    rename(tmp, path);
+}
@@ -1,90 +1,463 @@
-    /* recorder.c — Arka plan IQ kayıt sistemi */
+/* recorder.c — Arka plan IQ kayıt sistemi */
 #include "recorder.h"
-#include <stdio.h>
+#include "stats.h"   /* stats_now_us */
+#include <stdlib.h>
 #include <string.h>
 #include <time.h>
-#include <windows.h>
+#include <math.h>
 
-#define REC_RING_SIZE 64
-#define REC_BLOCK     (FFT_SIZE * 2)
+/* ── Ayar işaretleri ──────────────────────────────────────── */
+void recorder_write_mark(FILE *fp, uint64_t file_sample, const SdrBlockMeta *m,
+                         const char *ev) {
+    fprintf(fp, "%llu,%llu,%llu,%u,%u,%u,%.1f,%u,%s\n",
+            (unsigned long long)file_sample, (unsigned long long)m->sample,
+            (unsigned long long)m->t_us, m->gen, m->freq, m->sr,
+            m->gain_db, m->agc, ev);
+}
 
-/* ── Ring buffer ──────────────────────────────────────────── */
-static uint8_t  s_ring[REC_RING_SIZE][REC_BLOCK];
-static volatile int s_wi    = 0;   /* yazma indeksi */
-static volatile int s_ri    = 0;   /* okuma indeksi */
-static volatile int s_alive = 0;   /* thread çalışıyor mu */
-static FILE    *s_fp        = NULL;
-static HANDLE   s_thread    = NULL;
-static CRITICAL_SECTION s_cs;
+static void write_mark(RecorderState *r, const SdrBlockMeta *m, const char *ev) {
+    /* Alt bant: frekans / hız çıkış akışının, ayarlı merkez ek sütunlarda */
+    uint32_t freq = m->freq, sr = m->sr;
+    if (r->sub) {
+        const Chan *ch = &r->sub->ch[0];
+        freq = ch->freq_hz;
+        sr   = m->sr / (uint32_t)chan_decimation(m->sr, ch->bw_hz);
+    }
+    if (r->n_ev < REC_SEG_EVENTS) {
+        r->ev[r->n_ev++] = (RecEvent){ r->file_samples, m->sample, m->t_us,
+                                       freq, sr, m->freq, m->gain_db, m->agc, ev };
+    } else {
+        r->ev_lost++;
+    }
 
-/* ── Kayıt iş parçacığı ───────────────────────────────────── */
-static DWORD WINAPI rec_thread(LPVOID _arg) {
-    (void)_arg;
-    while (s_alive || s_ri != s_wi) {
-        EnterCriticalSection(&s_cs);
-        int has_data = (s_ri != s_wi);
-        LeaveCriticalSection(&s_cs);
-
-        if (has_data && s_fp) {
-            fwrite(s_ring[s_ri % REC_RING_SIZE], 1, REC_BLOCK, s_fp);
-            EnterCriticalSection(&s_cs);
-            s_ri++;
-            LeaveCriticalSection(&s_cs);
-        } else {
-            Sleep(1);
+    if (!r->mfp) return;
+    if (!r->sub) {
+        recorder_write_mark(r->mfp, r->file_samples, m, ev);
+        return;
+    }
+    fprintf(r->mfp, "%llu,%llu,%llu,%u,%u,%u,%.1f,%u,%s,%u,%lld\n",
+            (unsigned long long)r->file_samples, (unsigned long long)m->sample,
+            (unsigned long long)m->t_us, m->gen, freq, sr,
+            m->gain_db, m->agc, ev, m->freq, (long long)freq - (long long)m->freq);
+}
+
+/* Bloğu yazmadan önce: kuşak / oturma / süreklilik değiştiyse işaretle */
+static void mark_block(RecorderState *r, const SdrBlockMeta *m) {
+    int first = (r->next_sample == 0);   /* alt bantta ilk çıkış gecikir */
+    if (first) {
+        r->seg_stream0 = m->sample;
+        r->seg_sr      = m->sr;
+        r->seg_t0_us   = m->t_us;
+        r->seg_wall_ms = wall_ms() - (stats_now_us() - m->t_us) / 1000u;
+        write_mark(r, m, "start");
+    }
+    else if (m->sample != r->next_sample)
+        write_mark(r, m, "gap");
+    if (!first && m->gen != r->mark_gen)
+        write_mark(r, m, "retune");
+    else if (!first && r->mark_settling && !m->settling)
+        write_mark(r, m, "settled");
+    r->mark_gen      = m->gen;
+    r->mark_settling = m->settling;
+    r->next_sample   = m->sample + FFT_SIZE;
+}
+
+/* ── Alt bant çıkışı ──────────────────────────────────────── */
+static const char *const FMT_NAME[REC_FMT_COUNT] = { "ci8", "ci16", "cf32" };
+
+static inline float clampf(float v, float lim) {
+    return v > lim ? lim : (v < -lim ? -lim : v);
+}
+
+/* Kanal ayırıcı callback'i (yazıcı thread'i): seçilen biçimde dosyaya */
+static void on_sub_out(const Chan *ch, const FftCpx *iq, int n, void *ud) {
+    RecorderState *r = (RecorderState *)ud;
+    (void)ch;
+    switch (r->rec_fmt) {
+    case REC_FMT_CI8: {
+        int8_t *o = (int8_t *)r->sub_buf;
+        for (int k = 0; k < n; k++) {
+            o[2*k]     = (int8_t)lrintf(clampf(iq[k].r * 127.0f, 127.0f));
+            o[2*k + 1] = (int8_t)lrintf(clampf(iq[k].i * 127.0f, 127.0f));
+        }
+        fwrite(o, 2, (size_t)n, r->fp);
+        break;
+    }
+    case REC_FMT_CI16: {
+        int16_t *o = (int16_t *)r->sub_buf;
+        for (int k = 0; k < n; k++) {
+            o[2*k]     = (int16_t)lrintf(clampf(iq[k].r * 32767.0f, 32767.0f));
+            o[2*k + 1] = (int16_t)lrintf(clampf(iq[k].i * 32767.0f, 32767.0f));
         }
+        fwrite(o, 4, (size_t)n, r->fp);
+        break;
+    }
+    default:
+        fwrite(iq, sizeof(*iq), (size_t)n, r->fp);
+        break;
+    }
+    r->file_samples += (uint64_t)n;
+}
+
+/* Alt bant penceresi için tek kanallı ayırıcıyı kur; başarılıysa 0 */
+static int sub_open(RecorderState *r) {
+    r->sub     = malloc(sizeof(*r->sub));
+    r->sub_buf = malloc(sizeof(int16_t) * 2 * CHAN_HOP);
+    if (!r->sub || !r->sub_buf || chan_init(r->sub, on_sub_out, r) != 0) {
+        free(r->sub);
+        free(r->sub_buf);
+        r->sub     = NULL;
+        r->sub_buf = NULL;
+        return -1;
     }
-    if (s_fp) { fclose(s_fp); s_fp = NULL; }
+    chan_add(r->sub, r->sub_freq, r->sub_bw);
+    r->rec_fmt = r->sub_fmt;
     return 0;
 }
 
+static void sub_close(RecorderState *r) {
+    if (!r->sub) return;
+    chan_free(r->sub);
+    free(r->sub);
+    free(r->sub_buf);
+    r->sub     = NULL;
+    r->sub_buf = NULL;
+}
+
+/* ── Bölütler + SigMF ─────────────────────────────────────── */
+static const char *const SIGMF_TYPE[REC_FMT_COUNT] = { "ci8", "ci16_le", "cf32_le" };
+static const int         FMT_BYTES[REC_FMT_COUNT]  = { 2, 4, 8 };
+
+/* Dosyadaki örnek başına bayt */
+static int sample_bytes(const RecorderState *r) {
+    return r->sub ? FMT_BYTES[r->rec_fmt] : 2;
+}
+
+/* SigMF core:datetime: ISO-8601 UTC, milisaniyeli */
+static void iso_time(char *out, size_t cap, uint64_t ms) {
+    time_t t = (time_t)(ms / 1000u);
+    size_t n = strftime(out, cap, "%Y-%m-%dT%H:%M:%S", gmtime(&t));
+    snprintf(out + n, cap - n, ".%03uZ", (unsigned)(ms % 1000u));
+}
+
+static int is_capture(const RecEvent *e) {
+    return !strcmp(e->kind, "start") || !strcmp(e->kind, "retune");
+}
+
+/*
+ * "<kök>.sigmf-meta": global + captures (start / retune) + annotations.
+ * Alt bantta oturma blokları dosyaya girmediğinden iki retune aynı
+ * file_sample'a düşebilir; SigMF capture başlangıçları tekil olmalı, sonuncusu kalır.
+ */
+static void write_sigmf(const RecorderState *r) {
+    char path[336];
+    snprintf(path, sizeof(path), "%.*s.sigmf-meta",
+             (int)(strrchr(r->filepath, '.') - r->filepath), r->filepath);
+    FILE *fp = fopen(path, "w");
+    if (!fp) {
+        fprintf(stderr, "[REC] SigMF dosyasi acilamadi: %s\n", path);
+        return;
+    }
+    const char *name = strrchr(r->filepath, PATH_SEP[0]);
+    name = name ? name + 1 : r->filepath;
+
+    fprintf(fp, "{\n  \"global\": {\n"
+                "    \"core:datatype\": \"%s\",\n"
+                "    \"core:sample_rate\": %u,\n"
+                "    \"core:version\": \"1.0.0\",\n"
+                "    \"core:dataset\": \"%s\",\n"
+                "    \"core:recorder\": \"radar\",\n"
+                "    \"core:hw\": \"RTL-SDR %s\",\n"
+                "    \"radar:segment\": %u,\n"
+                "    \"radar:stream_sample\": %llu,\n"
+                "    \"radar:samples\": %llu,\n"
+                "    \"radar:events_lost\": %u\n  },\n",
+            r->sub ? SIGMF_TYPE[r->rec_fmt] : "cu8", r->n_ev ? r->ev[0].sr : 0u,
+            name, r->tag, r->seg_no, (unsigned long long)r->seg_stream0,
+            (unsigned long long)r->file_samples, r->ev_lost);
+
+    fprintf(fp, "  \"captures\": [");
+    int n = 0;
+    for (int i = 0; i < r->n_ev; i++) {
+        const RecEvent *e = &r->ev[i];
+        if (!is_capture(e)) continue;
+        int later = 0;
+        for (int k = i + 1; k < r->n_ev && !later; k++)
+            later = is_capture(&r->ev[k]) && r->ev[k].file_sample == e->file_sample;
+        if (later) continue;
+        char when[40];
+        iso_time(when, sizeof(when), r->seg_wall_ms + (e->t_us - r->seg_t0_us) / 1000u);
+        fprintf(fp, "%s\n    {\"core:sample_start\": %llu, \"core:frequency\": %u, "
+                    "\"core:datetime\": \"%s\", \"radar:sample_rate\": %u, "
+                    "\"radar:gain_db\": %.1f, \"radar:agc\": %u, "
+                    "\"radar:tuner_hz\": %u, \"radar:stream_sample\": %llu}",
+                n++ ? "," : "", (unsigned long long)e->file_sample, e->freq, when,
+                e->sr, e->gain_db, e->agc, e->tuner,
+                (unsigned long long)e->stream_sample);
+    }
+    fprintf(fp, "\n  ],\n  \"annotations\": [");
+    n = 0;
+    for (int i = 0; i < r->n_ev; i++) {
+        const RecEvent *e = &r->ev[i];
+        if (!strcmp(e->kind, "start")) continue;
+        fprintf(fp, "%s\n    {\"core:sample_start\": %llu, \"core:label\": \"%s\", "
+                    "\"core:comment\": \"%.6f MHz, %u S/s, %.1f dB\", "
+                    "\"radar:stream_sample\": %llu}",
+                n++ ? "," : "", (unsigned long long)e->file_sample, e->kind,
+                e->freq / 1e6, e->sr, e->gain_db, (unsigned long long)e->stream_sample);
+    }
+    fprintf(fp, "\n  ]\n}\n");
+    fclose(fp);
+}
+
+/*
+ * Bölüt dosyalarını aç (veri + işaret); işaret durumu sıfırlanır. Başarılıysa 0.
+ * Alt bant adı kayıttaki kanaldan alınır: sub_freq / sub_bw kayıt sürerken
+ * değişebilir ama yalnız sonraki kayda uygulanır.
+ */
+static int seg_open(RecorderState *r) {
+    char seg[16] = "";
+    if (r->seg_no) snprintf(seg, sizeof(seg), "_s%06u", r->seg_no);
+    if (r->sub)
+        snprintf(r->filepath, sizeof(r->filepath),
+            "%s" PATH_SEP "sub_%s%s%.3fk_%gkbw_%s%s.%s", r->dir,
+            r->tag, r->tag[0] ? "_" : "", r->sub->ch[0].freq_hz / 1e3,
+            r->sub->ch[0].bw_hz / 1e3, r->stamp, seg, FMT_NAME[r->rec_fmt]);
+    else
+        snprintf(r->filepath, sizeof(r->filepath),
+            "%s" PATH_SEP "iq_%s%s%s%s.bin", r->dir,
+            r->tag, r->tag[0] ? "_" : "", r->stamp, seg);
+
+    r->fp = fopen(r->filepath, "wb");
+    if (!r->fp) {
+        fprintf(stderr, "[REC] Dosya acilamadi: %s\n", r->filepath);
+        return -1;
+    }
+    if (r->sub) setvbuf(r->fp, NULL, _IOFBF, 1 << 16);
+    snprintf(r->markpath, sizeof(r->markpath), "%.*s_marks.csv",
+             (int)(strrchr(r->filepath, '.') - r->filepath), r->filepath);
+    r->mfp = fopen(r->markpath, "w");
+    if (r->mfp)
+        fputs(r->sub ? REC_SUB_MARKS_HEADER : REC_MARKS_HEADER, r->mfp);
+    else
+        fprintf(stderr, "[REC] Isaret dosyasi acilamadi: %s\n", r->markpath);
+    r->file_samples  = 0;
+    r->next_sample   = 0;
+    r->mark_gen      = 0;
+    r->mark_settling = 0;
+    r->n_ev          = 0;
+    r->ev_lost       = 0;
+    return 0;
+}
+
+/* Bölütü kapat: SigMF yan dosyası, saklama listesine ekle */
+static void seg_close(RecorderState *r) {
+    if (!r->fp) return;
+    fclose(r->fp);
+    r->fp = NULL;
+    if (r->mfp) { fclose(r->mfp); r->mfp = NULL; }
+    write_sigmf(r);
+    if (r->ret) ret_add(r->ret, r->filepath);
+}
+
+/* Bu bloktan önce yeni bölüt gerekiyor mu (süre / boyut / hız değişimi) */
+static int seg_due(const RecorderState *r, const SdrBlockMeta *m) {
+    if (!r->seg_no || r->next_sample == 0) return 0;
+    if (m->sr != r->seg_sr) return 1;
+    if (r->seg_s && m->sample - r->seg_stream0 >= (uint64_t)r->seg_s * r->seg_sr)
+        return 1;
+    return r->seg_bytes &&
+           r->file_samples * (uint64_t)sample_bytes(r) >= r->seg_bytes;
+}
+
+/* ── Kayıt iş parçacığı ───────────────────────────────────── */
+static void rec_thread(void *arg) {
+    RecorderState *r = (RecorderState *)arg;
+
+    while (r->alive || r->ri != r->wi) {
+        mutex_lock(&r->cs);
+        if (r->ri == r->wi && r->alive)
+            cond_wait_ms(&r->cv, &r->cs, 50);
+        int has_data = (r->ri != r->wi);
+        mutex_unlock(&r->cs);
+
+        if (!has_data) continue;
+
+        const SdrBlockMeta *m   = &r->meta[r->ri % REC_RING_SIZE];
+        const uint8_t      *blk = r->ring[r->ri % REC_RING_SIZE];
+        if (seg_due(r, m)) {
+            seg_close(r);
+            r->seg_no++;
+            if (seg_open(r) == 0)
+                printf("[REC] Yeni bolut: %s\n", r->filepath);
+        }
+        if (r->fp) {   /* bölüt açılamadıysa bloklar tüketilip atılır */
+            mark_block(r, m);
+            if (!r->sub) {
+                fwrite(blk, 1, REC_BLOCK, r->fp);
+                r->file_samples += FFT_SIZE;
+            } else if (!m->settling) {
+                chan_feed(r->sub, blk, m);   /* oturmamış blok pencereye girmez */
+            }
+        }
+        mutex_lock(&r->cs);
+        r->ri++;
+        mutex_unlock(&r->cs);
+    }
+    seg_close(r);
+    sub_close(r);
+}
+
 /* ── Genel API ────────────────────────────────────────────── */
 void recorder_init(RecorderState *r) {
     memset(r, 0, sizeof(*r));
-    InitializeCriticalSection(&s_cs);
+    r->cpu     = -1;
+    r->sub_fmt = REC_FMT_CI16;
+    snprintf(r->dir, sizeof(r->dir), "%s", REC_DEFAULT_DIR);
+    r->ring = malloc(sizeof(*r->ring) * REC_RING_SIZE);
+    r->meta = malloc(sizeof(*r->meta) * REC_RING_SIZE);
+    if (!r->ring || !r->meta) {
+        fprintf(stderr, "[REC] Bellek hatasi: ring ayrilamadi\n");
+        free(r->ring);
+        free(r->meta);
+        r->ring = NULL;
+        r->meta = NULL;
+    }
+    mutex_init(&r->cs);
+    cond_init(&r->cv);
+}
+
+void recorder_free(RecorderState *r) {
+    if (r->active) recorder_stop(r);
+    free(r->ring);
+    free(r->meta);
+    r->ring = NULL;
+    r->meta = NULL;
+    cond_free(&r->cv);
+    mutex_free(&r->cs);
 }
 
 void recorder_start(RecorderState *r) {
-    if (r->active) return;
+    if (r->active || !r->ring) return;
+
+    if (r->sub_freq && sub_open(r) != 0)
+        fprintf(stderr, "[REC] Alt bant kurulamadi, tam bant kaydediliyor\n");
 
     time_t t = time(NULL);
     struct tm *tm = localtime(&t);
-    snprintf(r->filepath, sizeof(r->filepath),
-        "C:\\RtlSdr\\iq_%04d%02d%02d_%02d%02d%02d.bin",
-        tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday,
-        tm->tm_hour, tm->tm_min, tm->tm_sec);
+    snprintf(r->stamp, sizeof(r->stamp), "%04d%02d%02d_%02d%02d%02d",
+             tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday,
+             tm->tm_hour, tm->tm_min, tm->tm_sec);
+    r->seg_no = (r->seg_s || r->seg_bytes) ? 1 : 0;
 
-    s_fp = fopen(r->filepath, "wb");
-    if (!s_fp) {
-        fprintf(stderr, "[REC] Dosya acilamadi: %s\n", r->filepath);
+    /* Dizin ilk kullanıcıda, bölüt açılmadan taranır: açık dosya listeye girmez */
+    if (r->ret) ret_start(r->ret);
+    if (seg_open(r) != 0) {
+        if (r->ret) ret_stop(r->ret);
+        sub_close(r);
         return;
     }
 
-    s_ri = s_wi = 0;
-    s_alive = 1;
+    r->ri = r->wi = 0;
+    r->drops  = 0;
+    r->alive  = 1;
     r->active = 1;
-    s_thread = CreateThread(NULL, 0, rec_thread, NULL, 0, NULL);
+    ThreadOpts o = { r->cpu, r->rt_prio };
+    thread_start(&r->thread, rec_thread, r, &o);
     printf("[REC] Kayit basladi: %s\n", r->filepath);
+    if (r->seg_s)
+        printf("[REC] Bolut suresi: %u s\n", r->seg_s);
+    else if (r->seg_bytes)
+        printf("[REC] Bolut boyu: %.0f MB\n", r->seg_bytes / 1048576.0);
+    if (r->sub)
+        printf("[REC] Alt bant: %.4f MHz, %.1f kHz, %s\n",
+               r->sub->ch[0].freq_hz / 1e6, r->sub->ch[0].bw_hz / 1e3,
+               FMT_NAME[r->rec_fmt]);
 }
 
 void recorder_stop(RecorderState *r) {
     if (!r->active) return;
-    s_alive   = 0;
+    mutex_lock(&r->cs);
+    r->alive  = 0;
     r->active = 0;
-    if (s_thread) {
-        WaitForSingleObject(s_thread, 8000);
-        CloseHandle(s_thread);
-        s_thread = NULL;
-    }
+    cond_signal(&r->cv);
+    mutex_unlock(&r->cs);
+    thread_join(&r->thread);
+    if (r->ret) ret_stop(r->ret);
     printf("[REC] Kayit durduruldu: %s\n", r->filepath);
+    if (r->drops)
+        printf("[REC] UYARI: halka doluyken %u blok atildi\n", r->drops);
 }
 
-void recorder_push(RecorderState *r, const uint8_t *raw) {
-    if (!r->active) return;
-    EnterCriticalSection(&s_cs);
-    if (s_wi - s_ri < REC_RING_SIZE) {
-        memcpy(s_ring[s_wi % REC_RING_SIZE], raw, REC_BLOCK);
-        s_wi++;
+int recorder_push(RecorderState *r, const uint8_t *raw, const SdrBlockMeta *meta) {
+    if (!r->active) return 0;
+    int dropped = 0;
+    mutex_lock(&r->cs);
+    if (r->wi - r->ri < REC_RING_SIZE) {
+        memcpy(r->ring[r->wi % REC_RING_SIZE], raw, REC_BLOCK);
+        r->meta[r->wi % REC_RING_SIZE] = *meta;
+        r->wi++;
+        cond_signal(&r->cv);
+    } else {
+        r->drops++;
+        dropped = 1;
     }
-    LeaveCriticalSection(&s_cs);
-}
\ No newline at end of file
+    mutex_unlock(&r->cs);
+    return dropped ? -1 : 0;
+}
+
+/* ── Alt bant ayarı ───────────────────────────────────────── */
+int recorder_set_subband(RecorderState *r, uint32_t freq_hz, uint32_t bw_hz, int fmt) {
+    if (fmt < 0 || fmt >= REC_FMT_COUNT || (freq_hz && bw_hz == 0)) return -1;
+    r->sub_freq = freq_hz;
+    r->sub_bw   = freq_hz ? bw_hz : 0;
+    r->sub_fmt  = fmt;
+    if (freq_hz)
+        printf("[REC] Alt bant secildi: %.4f MHz, %.1f kHz, %s%s\n",
+               freq_hz / 1e6, bw_hz / 1e3, FMT_NAME[fmt],
+               r->active ? " (sonraki kayitta)" : "");
+    else
+        printf("[REC] Tam bant kayit%s\n", r->active ? " (sonraki kayitta)" : "");
+    return 0;
+}
+
+int recorder_parse_subband(const char *spec, uint32_t *freq_hz, uint32_t *bw_hz,
+                           int *fmt) {
+    char name[8] = "";
+    if (chan_parse(spec, freq_hz, bw_hz) != 0) return -1;
+    *fmt = REC_FMT_CI16;
+    if (sscanf(spec, "%*[^:]:%*[^:]:%7s", name) != 1) return 0;
+    for (int i = 0; i < REC_FMT_COUNT; i++)
+        if (!strcmp(name, FMT_NAME[i])) {
+            *fmt = i;
+            return 0;
+        }
+    return -1;
+}
+
+/* ── Bölüt ayarı ──────────────────────────────────────────── */
+void recorder_set_segments(RecorderState *r, uint32_t seg_s, uint64_t seg_bytes,
+                           Retention *ret) {
+    r->seg_s     = seg_s;
+    r->seg_bytes = seg_bytes;
+    r->ret       = ret;
+}
+
+int recorder_parse_segment(const char *spec, uint32_t *seg_s, uint64_t *seg_bytes) {
+    char  *end;
+    double v = strtod(spec, &end);   /* "0.5G" de geçerli: boyutu ret_parse_size çözer */
+    if (end == spec || v <= 0.0) return -1;
+    if (*end == '\0' || !strcmp(end, "s")) {
+        if (v < 1.0 || v > 4294967295.0 || v != floor(v)) return -1;   /* tam saniye */
+        *seg_s     = (uint32_t)v;
+        *seg_bytes = 0;
+        return 0;
+    }
+    *seg_s     = 0;
+    *seg_bytes = ret_parse_size(spec);
+    return *seg_bytes ? 0 : -1;
+}
+
+const char *recorder_fmt_name(int fmt) {
+    return (fmt >= 0 && fmt < REC_FMT_COUNT) ? FMT_NAME[fmt] : "?";
+}
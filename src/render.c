@@ -1,6 +1,7 @@
 /* render.c — SDL2 çizim yardımcıları: ızgara, spektrum, şelale */
 #include "render.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <math.h>
 #include <string.h>
 
@@ -11,6 +12,8 @@ int render_init(RenderCtx *ctx, SDL_Renderer *renderer) {
     ctx->db_max   =   0.0f;
     ctx->font_sm  = NULL;
     ctx->font_md  = NULL;
+    ctx->pyr_tex  = NULL;
+    render_set_layout(ctx, 0, 1);
 
     if (TTF_Init() != 0) {
         fprintf(stderr, "[RENDER] TTF_Init hatasi: %s\n", TTF_GetError());
@@ -33,6 +36,7 @@ int render_init(RenderCtx *ctx, SDL_Renderer *renderer) {
 }
 
 void render_free(RenderCtx *ctx) {
+    if (ctx->pyr_tex) { SDL_DestroyTexture(ctx->pyr_tex); ctx->pyr_tex = NULL; }
     if (ctx->font_sm) { TTF_CloseFont(ctx->font_sm); ctx->font_sm = NULL; }
     if (ctx->font_md) { TTF_CloseFont(ctx->font_md); ctx->font_md = NULL; }
     TTF_Quit();
@@ -97,16 +101,17 @@ SDL_Color render_colormap(float v, float vmin, float vmax) {
     };
 }
 
-/* ── Grafik alanında dB → Y dönüşümü — [SPEC_TOP, SPEC_TOP+SPEC_H] arasına sıkıştırılır ─ */
+/* ── Grafik alanında dB → Y dönüşümü — [spec_top, spec_top+spec_h] arasına sıkıştırılır ─ */
 static int db_to_y(const RenderCtx *ctx, float db) {
     /* dışarı taşmayı önlemek için önce dB değerini sıkıştır */
     if (db > ctx->db_max) db = ctx->db_max;
     if (db < ctx->db_min) db = ctx->db_min;
     float r = (ctx->db_max - db) / (ctx->db_max - ctx->db_min);
-    int y = SPEC_TOP + (int)(r * SPEC_H);
+    int top = ctx->spec_top, bot = ctx->spec_top + ctx->spec_h;
+    int y = top + (int)(r * ctx->spec_h);
     /* ek güvenlik sınırı */
-    if (y < SPEC_TOP)          y = SPEC_TOP;
-    if (y > SPEC_TOP + SPEC_H) y = SPEC_TOP + SPEC_H;
+    if (y < top) y = top;
+    if (y > bot) y = bot;
     return y;
 }
 
@@ -122,13 +127,19 @@ void render_grid(RenderCtx *ctx, float fc_mhz, float bw_mhz) {
     SDL_Color axis = {95, 95, 110, 255};
     SDL_Color lc   = {140,140,150, 255};
 
-    /* Yatay dB ızgarası */
+    int st = ctx->spec_top,  sb = ctx->spec_top  + ctx->spec_h;
+    int wt = ctx->wfall_top, wb = ctx->wfall_top + ctx->wfall_h;
+    int gr = GRAPH_L + GRAPH_W;
+
+    /* Yatay dB ızgarası (döşeli görünümde alçak grafiklerde etiketsiz) */
+    int db_labels = !ctx->compact || ctx->spec_h >= 120;
     for (float db = ctx->db_min; db <= ctx->db_max + 0.5f; db += 10.0f) {
         int y = db_to_y(ctx, db);
-        if (y < SPEC_TOP || y > SPEC_TOP + SPEC_H) continue;
+        if (y < st || y > sb) continue;
         SDL_Color gc = (fabsf(db) < 0.5f)
             ? (SDL_Color){190, 50, 50, 255} : grid;
-        render_line(ctx, GRAPH_L, y, GRAPH_L + GRAPH_W, y, gc);
+        render_line(ctx, GRAPH_L, y, gr, y, gc);
+        if (!db_labels) continue;
         char buf[12]; snprintf(buf, sizeof(buf), "%.0f", db);
         render_text(ctx, ctx->font_sm, buf, 2, y - 6, lc);
     }
@@ -136,43 +147,45 @@ void render_grid(RenderCtx *ctx, float fc_mhz, float bw_mhz) {
     /* Dikey frekans ızgarası */
     for (int i = 0; i <= 8; i++) {
         int x = GRAPH_L + (int)((float)i / 8.0f * GRAPH_W);
-        render_line(ctx, x, SPEC_TOP,  x, SPEC_TOP  + SPEC_H,  grid);
-        render_line(ctx, x, WFALL_TOP, x, WFALL_TOP + WFALL_H, grid);
+        render_line(ctx, x, st, x, sb, grid);
+        render_line(ctx, x, wt, x, wb, grid);
 
         float f = fc_mhz - bw_mhz / 2.0f + ((float)i / 8.0f) * bw_mhz;
         char buf[16]; snprintf(buf, sizeof(buf), "%.2f", f);
-        render_text(ctx, ctx->font_sm, buf, x - 16, SPEC_TOP  + SPEC_H  + 4, lc);
-        render_text(ctx, ctx->font_sm, buf, x - 16, WFALL_TOP + WFALL_H + 4, lc);
+        if (!ctx->compact)
+            render_text(ctx, ctx->font_sm, buf, x - 16, sb + 4, lc);
+        render_text(ctx, ctx->font_sm, buf, x - 16, wb + 4, lc);
     }
 
     /* Eksen çerçeveleri */
-    render_line(ctx, GRAPH_L,         SPEC_TOP,          GRAPH_L+GRAPH_W, SPEC_TOP,          axis);
-    render_line(ctx, GRAPH_L,         SPEC_TOP+SPEC_H,   GRAPH_L+GRAPH_W, SPEC_TOP+SPEC_H,   axis);
-    render_line(ctx, GRAPH_L,         SPEC_TOP,          GRAPH_L,         SPEC_TOP+SPEC_H,   axis);
-    render_line(ctx, GRAPH_L+GRAPH_W, SPEC_TOP,          GRAPH_L+GRAPH_W, SPEC_TOP+SPEC_H,   axis);
+    render_line(ctx, GRAPH_L, st, gr,      st, axis);
+    render_line(ctx, GRAPH_L, sb, gr,      sb, axis);
+    render_line(ctx, GRAPH_L, st, GRAPH_L, sb, axis);
+    render_line(ctx, gr,      st, gr,      sb, axis);
 
-    render_line(ctx, GRAPH_L,         WFALL_TOP,         GRAPH_L+GRAPH_W, WFALL_TOP,         axis);
-    render_line(ctx, GRAPH_L,         WFALL_TOP+WFALL_H, GRAPH_L+GRAPH_W, WFALL_TOP+WFALL_H, axis);
-    render_line(ctx, GRAPH_L,         WFALL_TOP,         GRAPH_L,         WFALL_TOP+WFALL_H, axis);
-    render_line(ctx, GRAPH_L+GRAPH_W, WFALL_TOP,         GRAPH_L+GRAPH_W, WFALL_TOP+WFALL_H, axis);
+    render_line(ctx, GRAPH_L, wt, gr,      wt, axis);
+    render_line(ctx, GRAPH_L, wb, gr,      wb, axis);
+    render_line(ctx, GRAPH_L, wt, GRAPH_L, wb, axis);
+    render_line(ctx, gr,      wt, gr,      wb, axis);
 
     /* Başlıklar */
+    if (ctx->compact) return;
     render_text_center(ctx, ctx->font_md, "Anlık Frekans Spektrumu",
-        GRAPH_L + GRAPH_W / 2, SPEC_TOP  - 22, (SDL_Color){170, 200, 255, 255});
+        GRAPH_L + GRAPH_W / 2, st - 22, (SDL_Color){170, 200, 255, 255});
     render_text_center(ctx, ctx->font_md, "Canlı Şelale Grafiği",
-        GRAPH_L + GRAPH_W / 2, WFALL_TOP - 22, (SDL_Color){170, 200, 255, 255});
+        GRAPH_L + GRAPH_W / 2, wt - 22, (SDL_Color){170, 200, 255, 255});
 }
 
 /* ── Spektrum çizgisi ────────────────────────────────────────── */
 void render_spectrum(RenderCtx *ctx, const float *psd) {
     /* db_to_y artık clamp yapıyor; baseline da grafik altı */
-    int baseline = SPEC_TOP + SPEC_H;
-    int top_clip = SPEC_TOP;
+    int baseline = ctx->spec_top + ctx->spec_h;
+    int top_clip = ctx->spec_top;
 
     SDL_SetRenderDrawBlendMode(ctx->renderer, SDL_BLENDMODE_BLEND);
 
     /* SDL_RenderSetClipRect ile grafik alanını kilitleyerek taşmayı engelle */
-    SDL_Rect clip = { GRAPH_L, SPEC_TOP, GRAPH_W, SPEC_H };
+    SDL_Rect clip = { GRAPH_L, ctx->spec_top, GRAPH_W, ctx->spec_h };
     SDL_RenderSetClipRect(ctx->renderer, &clip);
 
     for (int k = 0; k < FFT_SIZE - 1; k++) {
@@ -196,23 +209,176 @@ void render_spectrum(RenderCtx *ctx, const float *psd) {
     (void)top_clip; /* kullanılmıyor, clamp db_to_y'de yapılıyor */
 }
 
+/* ── Ek iz (max-hold vb.) — yalnızca çizgi ───────────────────── */
+void render_trace(RenderCtx *ctx, const float *psd, SDL_Color c) {
+    SDL_Rect clip = { GRAPH_L, ctx->spec_top, GRAPH_W, ctx->spec_h };
+    SDL_RenderSetClipRect(ctx->renderer, &clip);
+    SDL_SetRenderDrawColor(ctx->renderer, c.r, c.g, c.b, c.a);
+
+    for (int k = 0; k < FFT_SIZE - 1; k++) {
+        int x1 = GRAPH_L + (int)((float)k       / FFT_SIZE * GRAPH_W);
+        int x2 = GRAPH_L + (int)((float)(k + 1) / FFT_SIZE * GRAPH_W);
+        SDL_RenderDrawLine(ctx->renderer, x1, db_to_y(ctx, psd[k]),
+                                          x2, db_to_y(ctx, psd[k + 1]));
+    }
+
+    SDL_RenderSetClipRect(ctx->renderer, NULL);
+}
+
 /* ── Şelale (waterfall) ──────────────────────────────────────── */
+/* Satır sınırları orantılı hesaplanır: döşeli görünümde şelale
+   WATERFALL_ROWS pikselden alçak olabilir (bazı satırlar 0 px kalır). */
+static int wf_row_y(const RenderCtx *ctx, int row) {
+    return ctx->wfall_top + row * ctx->wfall_h / WATERFALL_ROWS;
+}
+
 void render_waterfall(RenderCtx *ctx,
                       const float waterfall[WATERFALL_ROWS][FFT_SIZE]) {
-    int cell_h = WFALL_H / WATERFALL_ROWS;
-    if (cell_h < 1) cell_h = 1;
-
     for (int row = 0; row < WATERFALL_ROWS; row++) {
-        int y = WFALL_TOP + row * cell_h;
+        int y = wf_row_y(ctx, row);
+        int h = wf_row_y(ctx, row + 1) - y;
+        if (h < 1) continue;
         for (int k = 0; k < FFT_SIZE; k++) {
             int x = GRAPH_L + (int)((float)k       / FFT_SIZE * GRAPH_W);
             int w = (int)   ((float)(k + 1) / FFT_SIZE * GRAPH_W) - x;
             if (w < 1) w = 1;
             SDL_Color c = render_colormap(waterfall[row][k],
                                           ctx->db_min, ctx->db_max);
-            render_fill_rect(ctx, x, y, w, cell_h, c);
+            render_fill_rect(ctx, x, y, w, h, c);
+        }
+    }
+}
+
+void render_waterfall_mark(RenderCtx *ctx, int bin_lo, int bin_hi,
+                           int age_new, int age_old, SDL_Color c) {
+    if (age_new >= WATERFALL_ROWS) return;          /* tamamen kaymış */
+    if (age_old >= WATERFALL_ROWS) age_old = WATERFALL_ROWS - 1;
+
+    int x1 = GRAPH_L + (int)((float)bin_lo       / FFT_SIZE * GRAPH_W);
+    int x2 = GRAPH_L + (int)((float)(bin_hi + 1) / FFT_SIZE * GRAPH_W);
+    int y1 = wf_row_y(ctx, WATERFALL_ROWS - 1 - age_old);
+    int y2 = wf_row_y(ctx, WATERFALL_ROWS - age_new);
+    if (x2 - x1 < 3) { x1 -= 1; x2 += 2; }   /* dar sinyaller görünür kalsın */
+    if (y2 - y1 < 2) y2 = y1 + 2;
+    render_outline_rect(ctx, x1, y1, x2 - x1, y2 - y1, c);
+}
+
+void render_band(RenderCtx *ctx, int x1, int x2, SDL_Color c) {
+    if (x2 < x1) { int t = x1; x1 = x2; x2 = t; }
+    if (x1 < GRAPH_L)           x1 = GRAPH_L;
+    if (x2 > GRAPH_L + GRAPH_W) x2 = GRAPH_L + GRAPH_W;
+    if (x2 - x1 < 2) x2 = x1 + 2;
+    SDL_SetRenderDrawBlendMode(ctx->renderer, SDL_BLENDMODE_BLEND);
+    render_fill_rect(ctx, x1, ctx->spec_top, x2 - x1, ctx->spec_h, c);
+    render_fill_rect(ctx, x1, ctx->wfall_top, x2 - x1, ctx->wfall_h, c);
+    SDL_SetRenderDrawBlendMode(ctx->renderer, SDL_BLENDMODE_NONE);
+    c.a = 255;
+    render_outline_rect(ctx, x1, ctx->spec_top,  x2 - x1, ctx->spec_h,  c);
+    render_outline_rect(ctx, x1, ctx->wfall_top, x2 - x1, ctx->wfall_h, c);
+}
+
+/* ── Arşiv görünümü ──────────────────────────────────────────── */
+void render_pyramid(RenderCtx *ctx, const TilePyr *p, const PyrView *v) {
+    const PyrHeader *h = p->hdr;
+    int x0 = GRAPH_L, y0 = ctx->spec_top;
+    int w  = GRAPH_W, ht = ctx->wfall_top + ctx->wfall_h - ctx->spec_top;
+
+    if (ctx->pyr_tex && (ctx->pyr_w != w || ctx->pyr_h != ht)) {
+        SDL_DestroyTexture(ctx->pyr_tex);
+        ctx->pyr_tex = NULL;
+    }
+    int dirty = 0;
+    if (!ctx->pyr_tex) {
+        ctx->pyr_tex = SDL_CreateTexture(ctx->renderer, SDL_PIXELFORMAT_ARGB8888,
+                                         SDL_TEXTUREACCESS_STREAMING, w, ht);
+        if (!ctx->pyr_tex) return;
+        ctx->pyr_w = w;
+        ctx->pyr_h = ht;
+        dirty = 1;
+    }
+
+    /* Hücre okuma yalnız görünüm ya da renk aralığı değişince */
+    double key[6] = { v->t0, v->t1, v->b0, v->b1, ctx->db_min, ctx->db_max };
+    if (dirty || memcmp(key, ctx->pyr_key, sizeof(key)) != 0) {
+        memcpy(ctx->pyr_key, key, sizeof(key));
+        uint8_t *cells = malloc((size_t)w * ht);
+        void    *pix;
+        int      pitch;
+        if (cells && SDL_LockTexture(ctx->pyr_tex, NULL, &pix, &pitch) == 0) {
+            pyr_render(p, v->t0, v->t1, v->b0, v->b1, w, ht, cells);
+            Uint32 lut[256];
+            lut[0] = 0xFF0A0C12u;   /* veri yok / tabanın altı */
+            for (int i = 1; i < 256; i++) {
+                SDL_Color c = render_colormap(pyr_db((uint8_t)i), ctx->db_min, ctx->db_max);
+                lut[i] = 0xFF000000u | ((Uint32)c.r << 16) | ((Uint32)c.g << 8) | c.b;
+            }
+            for (int y = 0; y < ht; y++) {
+                Uint32        *row = (Uint32 *)((uint8_t *)pix + (size_t)y * pitch);
+                const uint8_t *c   = cells + (size_t)y * w;
+                for (int x = 0; x < w; x++) row[x] = lut[c[x]];
+            }
+            SDL_UnlockTexture(ctx->pyr_tex);
         }
+        free(cells);
+    }
+    SDL_Rect dst = { x0, y0, w, ht };
+    SDL_RenderCopy(ctx->renderer, ctx->pyr_tex, NULL, &dst);
+
+    /* Eksenler: üstte frekans, solda zaman (kayıt başından) */
+    SDL_Color lc = {200, 210, 230, 255};
+    char buf[96];
+    double bin_hz = (double)h->sample_rate / h->fft_size;
+    double row_s  = (double)h->avg_blocks * h->fft_size / h->sample_rate;
+    for (int i = 0; i <= 4; i++) {
+        double b  = v->b0 + (v->b1 - v->b0) * i / 4.0;
+        double hz = h->center_hz + (b - h->fft_size / 2.0) * bin_hz;
+        int    x  = x0 + w * i / 4;
+        render_line(ctx, x, y0 - 4, x, y0, lc);
+        if (h->center_hz) snprintf(buf, sizeof(buf), "%.4f MHz", hz / 1e6);
+        else              snprintf(buf, sizeof(buf), "%+.1f kHz", (hz - h->center_hz) / 1e3);
+        render_text_center(ctx, ctx->font_sm, buf, x, y0 - 18, lc);
     }
+    for (int i = 0; i <= 5; i++) {
+        double t = (v->t0 + (v->t1 - v->t0) * i / 5.0) * row_s;
+        int    y = y0 + (ht - 1) * i / 5;
+        snprintf(buf, sizeof(buf), "%02d:%02d:%02d", (int)(t / 3600),
+                 (int)fmod(t / 60.0, 60.0), (int)fmod(t, 60.0));
+        render_text(ctx, ctx->font_sm, buf, 2, y - 6, lc);
+    }
+    snprintf(buf, sizeof(buf), "ARSIV  %.1f s / %.1f kHz gorunum  (tekerlek: zaman, Ctrl: frekans, Home: tumu)",
+             (v->t1 - v->t0) * row_s, (v->b1 - v->b0) * bin_hz / 1e3);
+    render_text(ctx, ctx->font_sm, buf, x0 + 4, y0 + 2, lc);
+}
+
+/* ── Yerleşim ────────────────────────────────────────────────── */
+void render_set_layout(RenderCtx *ctx, int tile, int n_tiles) {
+    if (n_tiles <= 1) {
+        ctx->spec_top  = SPEC_TOP;
+        ctx->spec_h    = SPEC_H;
+        ctx->wfall_top = WFALL_TOP;
+        ctx->wfall_h   = WFALL_H;
+        ctx->compact   = 0;
+        return;
+    }
+    /* Döşeli: SPEC_TOP..WFALL_TOP+WFALL_H dikey olarak n_tiles'a bölünür;
+       her döşeme spektrum + şelale + 18 px frekans etiketi taşır. */
+    int area   = WFALL_TOP + WFALL_H - SPEC_TOP;
+    int tile_h = area / n_tiles;
+    int body   = tile_h - 20;
+    ctx->spec_top  = SPEC_TOP + tile * tile_h;
+    ctx->spec_h    = body * 9 / 20;
+    ctx->wfall_top = ctx->spec_top + ctx->spec_h + 2;
+    ctx->wfall_h   = body - ctx->spec_h - 2;
+    ctx->compact   = 1;
+}
+
+int render_tile_at(int y, int n_tiles) {
+    if (n_tiles <= 1) return 0;
+    int tile_h = (WFALL_TOP + WFALL_H - SPEC_TOP) / n_tiles;
+    int t = (y - SPEC_TOP) / tile_h;
+    if (t < 0) t = 0;
+    if (t >= n_tiles) t = n_tiles - 1;
+    return t;
 }
 
 void render_present(RenderCtx *ctx) {
@@ -0,0 +1,213 @@
+/* retention.c — Kayıt bölütleri için kayan disk bütçesi */
+#include "retention.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+static const char *const DATA_EXT[] = { ".bin", ".ci8", ".ci16", ".cf32" };
+
+/* Veri yolundan yan dosya yolu: uzantı atılır, ek eklenir */
+static void side_path(char *out, size_t cap, const char *data, const char *suffix) {
+    const char *dot = strrchr(data, '.');
+    int stem = dot ? (int)(dot - data) : (int)strlen(data);
+    snprintf(out, cap, "%.*s%s", stem, data, suffix);
+}
+
+static uint64_t file_size(const char *path, int64_t *mtime) {
+    struct stat st;
+    if (stat(path, &st) != 0) return 0;
+    if (mtime) *mtime = (int64_t)st.st_mtime;
+    return (uint64_t)st.st_size;
+}
+
+/* Veri + yan dosyaların toplam boyutu */
+static uint64_t seg_bytes(const char *data, int64_t *mtime) {
+    char side[336];
+    uint64_t n = file_size(data, mtime);
+    side_path(side, sizeof(side), data, "_marks.csv");
+    n += file_size(side, NULL);
+    side_path(side, sizeof(side), data, ".sigmf-meta");
+    n += file_size(side, NULL);
+    return n;
+}
+
+static void seg_delete(const char *data) {
+    char side[336];
+    remove(data);
+    side_path(side, sizeof(side), data, "_marks.csv");
+    remove(side);
+    side_path(side, sizeof(side), data, ".sigmf-meta");
+    remove(side);
+}
+
+/* Listeye ekle (cs tutulurken ya da thread başlamadan) */
+static int seg_push(Retention *rt, const char *path, uint64_t bytes, int64_t mtime) {
+    if (rt->n == rt->cap) {
+        int     cap = rt->cap ? rt->cap * 2 : 64;
+        RetSeg *s   = realloc(rt->seg, sizeof(*s) * (size_t)cap);
+        if (!s) return -1;
+        rt->seg = s;
+        rt->cap = cap;
+    }
+    RetSeg *s = &rt->seg[rt->n++];
+    snprintf(s->path, sizeof(s->path), "%s", path);
+    s->bytes = bytes;
+    s->mtime = mtime;
+    rt->total += bytes;
+    return 0;
+}
+
+static int by_mtime(const void *a, const void *b) {
+    const RetSeg *x = a, *y = b;
+    if (x->mtime != y->mtime) return x->mtime < y->mtime ? -1 : 1;
+    return strcmp(x->path, y->path);
+}
+
+/*
+ * Yalnızca bölüt dosyaları: "iq_..._sNNNNNN.<uzantı>" ya da "sub_...", her
+ * cihaz etiketi. Bölütlenmemiş eski kayıtların adında _sNNNNNN yoktur,
+ * bütçeye girmez ve silinmez.
+ */
+static int is_data_name(const char *name) {
+    if (!strncmp(name, "iq_", 3))       name += 3;
+    else if (!strncmp(name, "sub_", 4)) name += 4;
+    else return 0;
+    const char *dot = strrchr(name, '.');
+    if (!dot) return 0;
+    const char *p = dot;
+    while (p > name && isdigit((unsigned char)p[-1])) p--;
+    if (dot - p < 6 || p - name < 2 || p[-2] != '_' || p[-1] != 's') return 0;
+    for (size_t i = 0; i < sizeof(DATA_EXT) / sizeof(DATA_EXT[0]); i++)
+        if (!strcmp(dot, DATA_EXT[i])) return 1;
+    return 0;
+}
+
+/* Önceki çalıştırmalardan ve bu süreçteki önceki kayıtlardan kalan bölütler */
+static void scan_dir(Retention *rt) {
+    DIR *d = opendir(rt->dir);
+    if (!d) return;
+    struct dirent *e;
+    while ((e = readdir(d)) != NULL) {
+        if (!is_data_name(e->d_name)) continue;
+        char    path[320];
+        int64_t mtime = 0;
+        if (snprintf(path, sizeof(path), "%s" PATH_SEP "%s", rt->dir, e->d_name)
+            >= (int)sizeof(path)) continue;
+        seg_push(rt, path, seg_bytes(path, &mtime), mtime);
+    }
+    closedir(d);
+    qsort(rt->seg, (size_t)rt->n, sizeof(*rt->seg), by_mtime);
+}
+
+/* ── Silici thread'i ──────────────────────────────────────────── */
+static void ret_thread(void *arg) {
+    Retention *rt = (Retention *)arg;
+    mutex_lock(&rt->cs);
+    for (;;) {
+        /* Bütçe aşıldıysa en eskiyi listeden çıkar; silme kilitsiz yapılır */
+        if (rt->total > rt->budget && rt->n > 0) {
+            RetSeg s = rt->seg[0];
+            memmove(rt->seg, rt->seg + 1, sizeof(*rt->seg) * (size_t)--rt->n);
+            rt->total -= s.bytes;
+            mutex_unlock(&rt->cs);
+
+            seg_delete(s.path);
+            printf("[REC] Saklama: %s silindi (%.1f MB)\n", s.path, s.bytes / 1048576.0);
+
+            mutex_lock(&rt->cs);
+            rt->n_deleted++;
+            rt->bytes_deleted += s.bytes;
+            continue;
+        }
+        if (!rt->alive) break;
+        cond_wait_ms(&rt->cv, &rt->cs, 1000);
+    }
+    mutex_unlock(&rt->cs);
+}
+
+/* ── Genel API ────────────────────────────────────────────────── */
+void ret_init(Retention *rt, const char *dir, uint64_t budget) {
+    memset(rt, 0, sizeof(*rt));
+    snprintf(rt->dir, sizeof(rt->dir), "%s", dir);
+    rt->budget = budget;
+    mutex_init(&rt->cs);
+    cond_init(&rt->cv);
+}
+
+void ret_free(Retention *rt) {
+    cond_free(&rt->cv);
+    mutex_free(&rt->cs);
+}
+
+int ret_start(Retention *rt) {
+    if (!rt->budget) return 0;
+    mutex_lock(&rt->cs);
+    int first = rt->users++ == 0;
+    mutex_unlock(&rt->cs);
+    if (!first) return 0;
+
+    /* İlk kullanıcı: başka yazıcı yok, liste kilitsiz kurulur */
+    rt->total = 0;
+    rt->n     = 0;
+    scan_dir(rt);
+    rt->alive = 1;
+    if (thread_start(&rt->thread, ret_thread, rt, NULL) != 0) {
+        fprintf(stderr, "[REC] Saklama thread'i baslatilamadi\n");
+        rt->alive = 0;
+        return -1;
+    }
+    printf("[REC] Saklama butcesi %.0f MB (%s), mevcut %d bolut (%.0f MB)\n",
+           rt->budget / 1048576.0, rt->dir, rt->n, rt->total / 1048576.0);
+    return 0;
+}
+
+void ret_add(Retention *rt, const char *data_path) {
+    if (!rt->budget) return;
+    int64_t  mtime = 0;
+    uint64_t bytes = seg_bytes(data_path, &mtime);
+    mutex_lock(&rt->cs);
+    seg_push(rt, data_path, bytes, mtime);
+    if (rt->total > rt->budget) cond_signal(&rt->cv);
+    mutex_unlock(&rt->cs);
+}
+
+void ret_stop(Retention *rt) {
+    if (!rt->budget) return;
+    mutex_lock(&rt->cs);
+    int last = rt->users > 0 && --rt->users == 0;
+    int run  = last && rt->alive;
+    if (run) {
+        rt->alive = 0;
+        cond_signal(&rt->cv);
+    }
+    mutex_unlock(&rt->cs);
+    if (!last) return;
+
+    if (run) thread_join(&rt->thread);
+    if (rt->n_deleted)
+        printf("[REC] Saklama: %llu bolut, %.0f MB silindi\n",
+               (unsigned long long)rt->n_deleted, rt->bytes_deleted / 1048576.0);
+    free(rt->seg);
+    rt->seg   = NULL;
+    rt->n     = rt->cap = 0;
+    rt->total = 0;
+    rt->n_deleted = rt->bytes_deleted = 0;
+}
+
+uint64_t ret_parse_size(const char *s) {
+    char  *end;
+    double v = strtod(s, &end);
+    if (end == s || v <= 0.0) return 0;
+    switch (*end) {
+    case 'T': case 't': v *= 1099511627776.0; end++; break;
+    case 'G': case 'g': v *= 1073741824.0;    end++; break;
+    case 'M': case 'm': case '\0': v *= 1048576.0; if (*end) end++; break;
+    case 'k': case 'K': v *= 1024.0;          end++; break;
+    default: return 0;
+    }
+    if (*end == 'B' || *end == 'b') end++;
+    return *end ? 0 : (uint64_t)v;
+}
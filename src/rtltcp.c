@@ -0,0 +1,230 @@
+/* rtltcp.c — rtl_tcp protokol istemcisi */
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <windows.h>
+typedef SOCKET sock_t;
+#define SOCK_BAD     INVALID_SOCKET
+#define sock_close   closesocket
+#else
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <netdb.h>
+#include <unistd.h>
+#include <time.h>
+typedef int sock_t;
+#define SOCK_BAD     (-1)
+#define sock_close   close
+#endif
+
+#include "rtltcp.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct RtlTcp {
+    sock_t        sock;
+    uint32_t      tuner_type;
+    uint32_t      gain_count;
+    volatile int  cancel;
+    uint8_t      *rx;          /* RTLTCP_RXBUF baytlık alım tamponu */
+    RtlTcpStats   st;
+};
+
+/* ── Yardımcılar ──────────────────────────────────────────────── */
+static uint64_t mono_us(void) {
+#ifdef _WIN32
+    LARGE_INTEGER f, c;
+    QueryPerformanceFrequency(&f);
+    QueryPerformanceCounter(&c);
+    return (uint64_t)(c.QuadPart / (f.QuadPart / 1000000));
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+#endif
+}
+
+static uint32_t rd_be32(const uint8_t *p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+           ((uint32_t)p[2] <<  8) |  (uint32_t)p[3];
+}
+
+/* Tam olarak n bayt oku (yalnızca başlık için) */
+static int recv_all(sock_t s, uint8_t *buf, int n) {
+    int got = 0;
+    while (got < n) {
+        int r = recv(s, (char *)buf + got, n - got, 0);
+        if (r <= 0) return -1;
+        got += r;
+    }
+    return 0;
+}
+
+static int send_cmd(RtlTcp *c, uint8_t cmd, uint32_t param) {
+    uint8_t pkt[5] = {
+        cmd,
+        (uint8_t)(param >> 24), (uint8_t)(param >> 16),
+        (uint8_t)(param >>  8), (uint8_t)(param)
+    };
+    if (send(c->sock, (const char *)pkt, 5, 0) != 5) {
+        fprintf(stderr, "[TCP] Komut yollanamadi (0x%02x)\n", cmd);
+        return -1;
+    }
+    c->st.cmds++;
+    return 0;
+}
+
+/* ── Bağlantı ─────────────────────────────────────────────────── */
+RtlTcp *rtltcp_open(const char *host, uint16_t port) {
+#ifdef _WIN32
+    static int wsa_ready = 0;
+    if (!wsa_ready) {
+        WSADATA wd;
+        if (WSAStartup(MAKEWORD(2, 2), &wd) != 0) {
+            fprintf(stderr, "[TCP] WSAStartup hatasi\n");
+            return NULL;
+        }
+        wsa_ready = 1;
+    }
+#endif
+    char portstr[8];
+    snprintf(portstr, sizeof(portstr), "%u", port);
+
+    struct addrinfo hints, *res = NULL;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family   = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    if (getaddrinfo(host, portstr, &hints, &res) != 0 || !res) {
+        fprintf(stderr, "[TCP] Adres cozulemedi: %s\n", host);
+        return NULL;
+    }
+
+    sock_t s = SOCK_BAD;
+    for (struct addrinfo *a = res; a; a = a->ai_next) {
+        s = socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+        if (s == SOCK_BAD) continue;
+        /* Büyük çekirdek tamponu: GUI/DSP anlık takılsa bile akış durmasın */
+        int rb = (int)RTLTCP_SOCKBUF;
+        setsockopt(s, SOL_SOCKET, SO_RCVBUF, (const char *)&rb, sizeof(rb));
+        if (connect(s, a->ai_addr, (int)a->ai_addrlen) == 0) break;
+        sock_close(s);
+        s = SOCK_BAD;
+    }
+    freeaddrinfo(res);
+    if (s == SOCK_BAD) {
+        fprintf(stderr, "[TCP] Baglanilamadi: %s:%u\n", host, port);
+        return NULL;
+    }
+    int one = 1;   /* komutlar 5 bayt: Nagle beklemesin */
+    setsockopt(s, IPPROTO_TCP, TCP_NODELAY, (const char *)&one, sizeof(one));
+
+    uint8_t hdr[12];
+    if (recv_all(s, hdr, 12) != 0 || memcmp(hdr, "RTL0", 4) != 0) {
+        fprintf(stderr, "[TCP] Gecersiz rtl_tcp basligi: %s:%u\n", host, port);
+        sock_close(s);
+        return NULL;
+    }
+
+    RtlTcp *c = calloc(1, sizeof(*c));
+    if (c) c->rx = malloc(RTLTCP_RXBUF);
+    if (!c || !c->rx) {
+        fprintf(stderr, "[TCP] Bellek hatasi\n");
+        if (c) free(c);
+        sock_close(s);
+        return NULL;
+    }
+    c->sock       = s;
+    c->tuner_type = rd_be32(hdr + 4);
+    c->gain_count = rd_be32(hdr + 8);
+    printf("[TCP] Baglandi: %s:%u  tuner=%u  kazanc adimi=%u\n",
+           host, port, c->tuner_type, c->gain_count);
+    return c;
+}
+
+void rtltcp_close(RtlTcp *c) {
+    if (!c) return;
+    sock_close(c->sock);
+    free(c->rx);
+    free(c);
+}
+
+uint32_t rtltcp_tuner_type(const RtlTcp *c) { return c->tuner_type; }
+uint32_t rtltcp_gain_count(const RtlTcp *c) { return c->gain_count; }
+const RtlTcpStats *rtltcp_stats(const RtlTcp *c) { return &c->st; }
+
+/* ── Komutlar ─────────────────────────────────────────────────── */
+int rtltcp_set_center_freq(RtlTcp *c, uint32_t hz) {
+    return send_cmd(c, RTLTCP_CMD_FREQ, hz);
+}
+
+int rtltcp_set_sample_rate(RtlTcp *c, uint32_t sr) {
+    return send_cmd(c, RTLTCP_CMD_SAMPLE_RATE, sr);
+}
+
+int rtltcp_set_tuner_gain_mode(RtlTcp *c, int manual) {
+    return send_cmd(c, RTLTCP_CMD_GAIN_MODE, manual ? 1u : 0u);
+}
+
+int rtltcp_set_tuner_gain(RtlTcp *c, int tenth_db) {
+    return send_cmd(c, RTLTCP_CMD_GAIN, (uint32_t)tenth_db);
+}
+
+/* ── Akış ─────────────────────────────────────────────────────── */
+int rtltcp_read_async(RtlTcp *c, RtlTcpCb cb, void *ctx, uint32_t block_len) {
+    if (block_len == 0 || block_len > RTLTCP_RXBUF) return -1;
+    c->cancel = 0;
+
+    uint32_t fill      = 0;
+    uint64_t last_us   = mono_us();
+    uint64_t win_us    = last_us;
+    uint64_t win_bytes = 0;
+
+    while (!c->cancel) {
+        int r = recv(c->sock, (char *)c->rx + fill, (int)(RTLTCP_RXBUF - fill), 0);
+        if (r <= 0) {
+            if (!c->cancel) fprintf(stderr, "[TCP] Baglanti koptu\n");
+            return c->cancel ? 0 : -1;
+        }
+        uint64_t now = mono_us();
+        uint32_t gap = (uint32_t)(now - last_us);
+        if (gap > c->st.gap_max_us) c->st.gap_max_us = gap;
+        last_us = now;
+
+        fill         += (uint32_t)r;
+        c->st.bytes  += (uint64_t)r;
+        c->st.recv_calls++;
+        win_bytes    += (uint64_t)r;
+        if (now - win_us >= 1000000u) {
+            c->st.rate_mbs = (double)win_bytes / (double)(now - win_us);
+            win_us    = now;
+            win_bytes = 0;
+        }
+
+        /* Tampondaki tam blokları yerinde teslim et (kopya yok) */
+        uint32_t off = 0;
+        while (fill - off >= block_len && !c->cancel) {
+            cb(c->rx + off, block_len, ctx);
+            off += block_len;
+            c->st.blocks++;
+        }
+        uint32_t disp = (uint32_t)(mono_us() - now);
+        if (disp > c->st.dispatch_max_us) c->st.dispatch_max_us = disp;
+
+        /* Yarım kalan blok (< block_len bayt) başa taşınır */
+        if (off > 0 && fill > off) memmove(c->rx, c->rx + off, fill - off);
+        fill -= off;
+    }
+    return 0;
+}
+
+void rtltcp_cancel_async(RtlTcp *c) {
+    c->cancel = 1;
+#ifdef _WIN32
+    shutdown(c->sock, SD_RECEIVE);
+#else
+    shutdown(c->sock, SHUT_RD);
+#endif
+}
@@ -3,28 +3,92 @@
 #include <stdio.h>
 #include <string.h>
 
-int sdr_open(SdrDevice *s) {
+static void sdr_defaults(SdrDevice *s, uint32_t index) {
+    s->index         = index;
+    s->serial[0]     = '\0';
     s->center_freq   = SDR_DEFAULT_FREQ;
     s->sample_rate   = SDR_DEFAULT_SR;
     s->agc_on        = 1;
     s->gain_db       = 0.0f;
     s->dev           = NULL;
+    s->tcp           = NULL;
     /* Async alanlarını sıfırla */
-    s->async_thread  = NULL;
+    memset(&s->async_thread, 0, sizeof(s->async_thread));
     s->async_running = 0;
-    s->disp_fresh    = 0;
+    s->cpu           = -1;
+    s->rt_prio       = 0;
+    s->xfer_len      = SDR_XFER_LEN_DEF;
+    s->xfer_num      = SDR_XFER_NUM_DEF;
+    s->carry_len     = 0;
+    s->stats         = NULL;
     s->data_cb       = NULL;
     s->data_cb_ud    = NULL;
+    /* Blok etiketleri */
+    memset(&s->cfg, 0, sizeof(s->cfg));
+    s->cfg.gen       = 1;
+    s->cfg.freq      = s->center_freq;
+    s->cfg.sr        = s->sample_rate;
+    s->cfg.agc       = 1;
+    s->settle_to     = 0;
+    s->sample_count  = 0;
+    mutex_init(&s->cfg_cs);
+}
+
+/*
+ * Yeni ayar kuşağı aç: cfg'yi cihazdaki güncel değerlerle doldur ve
+ * henüz teslim edilmemiş, eski ayarla yakalanmış olabilecek örnekler +
+ * oturma süresi kadar ileriye settle_to koy. Async thread bir sonraki
+ * blokta bunu görür; tampon boşaltmaya gerek kalmaz.
+ */
+static void sdr_bump_gen(SdrDevice *s, uint32_t settle_ms) {
+    if (s->tcp) settle_ms += SDR_SETTLE_TCP_MS;
+    uint64_t inflight = (uint64_t)SDR_INFLIGHT_XFERS * s->xfer_len / 2;
+    uint64_t settle   = (uint64_t)s->sample_rate * settle_ms / 1000u;
+    uint64_t now      = ATOMIC_LOAD_RLX(&s->sample_count);
+
+    mutex_lock(&s->cfg_cs);
+    s->cfg.gen++;
+    s->cfg.gen_t_us = stats_now_us();
+    s->cfg.freq     = s->center_freq;
+    s->cfg.sr       = s->sample_rate;
+    s->cfg.gain_db  = s->gain_db;
+    s->cfg.agc      = (uint8_t)s->agc_on;
+    if (now + inflight + settle > s->settle_to)
+        s->settle_to = now + inflight + settle;
+    mutex_unlock(&s->cfg_cs);
+}
 
-    int count = rtlsdr_get_device_count();
+uint32_t sdr_generation(SdrDevice *s) {
+    mutex_lock(&s->cfg_cs);
+    uint32_t g = s->cfg.gen;
+    mutex_unlock(&s->cfg_cs);
+    return g;
+}
+
+int sdr_open(SdrDevice *s, uint32_t index) {
+    sdr_defaults(s, index);
+
+    uint32_t count = rtlsdr_get_device_count();
     if (count == 0) {
         fprintf(stderr, "[SDR] Hata: RTL-SDR cihazi bulunamadi!\n");
+        mutex_free(&s->cfg_cs);
         return -1;
     }
-    printf("[SDR] Cihaz: %s\n", rtlsdr_get_device_name(0));
+    if (index >= count) {
+        fprintf(stderr, "[SDR] Hata: #%u yok (%u cihaz bagli).\n", index, count);
+        mutex_free(&s->cfg_cs);
+        return -1;
+    }
+    char manuf[256], product[256];
+    if (rtlsdr_get_device_usb_strings(index, manuf, product, s->serial) != 0)
+        s->serial[0] = '\0';
+    printf("[SDR] Cihaz #%u: %s  SN=%s\n", index,
+           rtlsdr_get_device_name(index), s->serial);
 
-    if (rtlsdr_open(&s->dev, 0) < 0) {
-        fprintf(stderr, "[SDR] Hata: Cihaz acilamadi.\n");
+    if (rtlsdr_open(&s->dev, index) < 0) {
+        fprintf(stderr, "[SDR] Hata: Cihaz #%u acilamadi.\n", index);
+        mutex_free(&s->cfg_cs);
+        s->dev = NULL;
         return -1;
     }
 
@@ -38,44 +102,87 @@ int sdr_open(SdrDevice *s) {
     return 0;
 }
 
+int sdr_open_tcp(SdrDevice *s, const char *host, uint16_t port) {
+    sdr_defaults(s, 0);
+    s->tcp = rtltcp_open(host, port);
+    if (!s->tcp) {
+        mutex_free(&s->cfg_cs);
+        return -1;
+    }
+
+    rtltcp_set_sample_rate    (s->tcp, s->sample_rate);
+    rtltcp_set_center_freq    (s->tcp, s->center_freq);
+    rtltcp_set_tuner_gain_mode(s->tcp, 0);   /* AGC açık */
+
+    printf("[SDR] Baslangic frekans : %.3f MHz (rtl_tcp)\n", s->center_freq / 1e6);
+    printf("[SDR] Ornekleme hizi    : %.3f MHz\n", s->sample_rate / 1e6);
+    return 0;
+}
+
+int sdr_find_serial(const char *serial) {
+    int idx = rtlsdr_get_index_by_serial(serial);
+    return (idx < 0) ? -1 : idx;
+}
+
+void sdr_list_devices(void) {
+    uint32_t count = rtlsdr_get_device_count();
+    printf("[SDR] %u cihaz bulundu:\n", count);
+    for (uint32_t i = 0; i < count; i++) {
+        char manuf[256], product[256], serial[256];
+        if (rtlsdr_get_device_usb_strings(i, manuf, product, serial) != 0)
+            serial[0] = '\0';
+        printf("  #%u  %-24s SN=%s\n", i, rtlsdr_get_device_name(i), serial);
+    }
+}
+
 void sdr_close(SdrDevice *s) {
+    if (s->tcp) {
+        rtltcp_close(s->tcp);
+        s->tcp = NULL;
+    }
     if (s->dev) {
         rtlsdr_close(s->dev);
         s->dev = NULL;
     }
-}
-
-int sdr_read_block(SdrDevice *s, uint8_t *raw_out) {
-    int n_read = 0;
-    int ret = rtlsdr_read_sync(s->dev, raw_out, FFT_SIZE * 2, &n_read);
-    if (ret < 0 || n_read < FFT_SIZE * 2) return -1;
-    return 0;
+    mutex_free(&s->cfg_cs);
 }
 
 void sdr_set_freq(SdrDevice *s, uint32_t hz) {
     if (hz < 24000000u)    hz = 24000000u;
     if (hz > 1766000000u)  hz = 1766000000u;
     s->center_freq = hz;
-    rtlsdr_set_center_freq(s->dev, hz);
+    if (s->tcp) rtltcp_set_center_freq(s->tcp, hz);
+    else        rtlsdr_set_center_freq(s->dev, hz);
+    sdr_bump_gen(s, SDR_SETTLE_MS);
 }
 
+/* Eski hızdaki örnekler kuşak etiketiyle ayrıldığından tampon boşaltılmaz */
 void sdr_set_sr(SdrDevice *s, uint32_t sr) {
     s->sample_rate = sr;
-    rtlsdr_set_sample_rate(s->dev, sr);
-    rtlsdr_reset_buffer(s->dev);
+    if (s->tcp) rtltcp_set_sample_rate(s->tcp, sr);
+    else        rtlsdr_set_sample_rate(s->dev, sr);
+    sdr_bump_gen(s, SDR_SETTLE_SR_MS);
 }
 
 void sdr_set_agc(SdrDevice *s, int on) {
     s->agc_on = on;
-    rtlsdr_set_tuner_gain_mode(s->dev, on ? 0 : 1);
-    if (!on)
-        rtlsdr_set_tuner_gain(s->dev, (int)(s->gain_db * 10.0f));
+    if (s->tcp) {
+        rtltcp_set_tuner_gain_mode(s->tcp, !on);
+        if (!on) rtltcp_set_tuner_gain(s->tcp, (int)(s->gain_db * 10.0f));
+    } else {
+        rtlsdr_set_tuner_gain_mode(s->dev, on ? 0 : 1);
+        if (!on)
+            rtlsdr_set_tuner_gain(s->dev, (int)(s->gain_db * 10.0f));
+    }
+    sdr_bump_gen(s, SDR_SETTLE_MS);
 }
 
 void sdr_set_gain(SdrDevice *s, float db) {
     s->gain_db = db;
-    if (!s->agc_on)
-        rtlsdr_set_tuner_gain(s->dev, (int)(db * 10.0f));
+    if (s->agc_on) return;
+    if (s->tcp) rtltcp_set_tuner_gain(s->tcp, (int)(db * 10.0f));
+    else        rtlsdr_set_tuner_gain(s->dev, (int)(db * 10.0f));
+    sdr_bump_gen(s, SDR_SETTLE_MS);
 }
 
 void sdr_shift_freq(SdrDevice *s, int32_t delta_hz) {
@@ -85,82 +192,119 @@ void sdr_shift_freq(SdrDevice *s, int32_t delta_hz) {
     sdr_set_freq(s, (uint32_t)f);
 }
 
+void sdr_set_xfer(SdrDevice *s, uint32_t len, uint32_t num) {
+    const uint32_t block = FFT_SIZE * 2;
+    len = (len + block - 1) / block * block;
+    if (len < SDR_XFER_LEN_MIN) len = SDR_XFER_LEN_MIN;
+    if (len > SDR_XFER_LEN_MAX) len = SDR_XFER_LEN_MAX;
+    if (num < SDR_XFER_NUM_MIN) num = SDR_XFER_NUM_MIN;
+    if (num > SDR_XFER_NUM_MAX) num = SDR_XFER_NUM_MAX;
+    s->xfer_len = len;
+    s->xfer_num = num;
+}
+
 /* ── Asenkron okuma ─────────────────────────────────────────── */
 
+/* Tek bir tam bloğu etiketleyip tüketicilere ver */
+static void sdr_deliver(SdrDevice *s, const uint8_t *blk, uint64_t t_us) {
+    SdrBlockMeta m;
+    mutex_lock(&s->cfg_cs);
+    m = s->cfg;
+    m.settling = s->sample_count < s->settle_to;
+    mutex_unlock(&s->cfg_cs);
+    m.sample = s->sample_count;
+    m.t_us   = t_us;
+
+    if (s->data_cb)
+        s->data_cb(blk, FFT_SIZE * 2, &m, s->data_cb_ud);
+    ATOMIC_STORE(&s->sample_count, m.sample + FFT_SIZE);
+}
+
 /*
- * sdr_async_cb — librtlsdr'ın async thread'inden her blok geldiğinde
- * çağrılır. İki iş yapar:
- *   1. Kaydediciyi besler: data_cb her blok için çağrılır → veri KAYBI YOK.
- *   2. GUI görüntüleme tamponunu günceller: GUI kendi VSYNC hızında bu
- *      tamponu okur; aradaki blokları doğal olarak atlar (istenen davranış).
+ * sdr_async_cb — librtlsdr'ın (ya da rtl_tcp alım döngüsünün) async
+ * thread'inden her aktarım geldiğinde çağrılır. Aktarımı FFT_SIZE*2
+ * baytlık bloklara dilimler ve data_cb'yi HER blok için çağırır → veri
+ * KAYBI YOK. Aktarım blok katı değilse artan kısım carry'de bekler ve
+ * sonraki aktarımın başıyla tamamlanır.
+ * Her blok sdr_deliver'da örnek sırası, varış zamanı ve ayar kuşağıyla
+ * etiketlenir.
  */
 static void sdr_async_cb(unsigned char *buf, uint32_t len, void *ctx) {
     SdrDevice *s = (SdrDevice *)ctx;
+    const uint32_t block = FFT_SIZE * 2;
 
     if (!s->async_running) {
-        rtlsdr_cancel_async(s->dev);
+        if (s->tcp) rtltcp_cancel_async(s->tcp);
+        else        rtlsdr_cancel_async(s->dev);
         return;
     }
 
-    uint32_t block = FFT_SIZE * 2;
-    if (len < block) return;
+    uint64_t t = stats_now_us();
+    if (s->stats) {
+        if (s->last_xfer_us) stats_record(s->stats, STAT_H_XFER_GAP, t - s->last_xfer_us);
+        stats_inc(s->stats, STAT_C_XFERS);
+    }
+    s->last_xfer_us = t;
+
+    uint32_t off = 0;
 
-    /* 1. Kaydedici callback'i — her blok, veri kaybı olmadan */
-    if (s->data_cb)
-        s->data_cb(buf, block, s->data_cb_ud);
+    /* Önceki aktarımdan kalan yarım blok */
+    if (s->carry_len) {
+        uint32_t need = block - s->carry_len;
+        if (need > len) need = len;
+        memcpy(s->carry + s->carry_len, buf, need);
+        s->carry_len += need;
+        off = need;
+        if (s->carry_len < block) return;
+        sdr_deliver(s, s->carry, t);
+        s->carry_len = 0;
+    }
 
-    /* 2. GUI görüntüleme tamponu — en son bloğu sakla */
-    EnterCriticalSection(&s->disp_cs);
-    memcpy(s->disp_buf, buf, block);
-    s->disp_fresh = 1;
-    LeaveCriticalSection(&s->disp_cs);
+    /* Tam bloklar — doğrudan aktarım tamponundan, kopyasız */
+    for (; len - off >= block; off += block)
+        sdr_deliver(s, buf + off, t);
+    if (off < len) {
+        s->carry_len = len - off;
+        memcpy(s->carry, buf + off, s->carry_len);
+    }
 }
 
-/* rtlsdr_read_async bloklayıcı bir çağrıdır; kendi thread'inde çalışır. */
-static DWORD WINAPI sdr_async_thread_fn(LPVOID arg) {
+/* rtlsdr_read_async bloklayıcı bir çağrıdır; kendi thread'inde çalışır.
+   Çekirdek / SCHED_FIFO seçenekleri thread_start'ta, bu işlevden önce uygulanır. */
+static void sdr_async_thread_fn(void *arg) {
     SdrDevice *s = (SdrDevice *)arg;
     /*
-     * 3. ve 4. parametre (buf_num=0, buf_len=FFT_SIZE*2):
-     *   buf_num=0  → kütüphane varsayılan tampon sayısını kullanır (15).
-     *   buf_len    → her callback çağrısında gelecek bayt sayısı.
+     * 3. ve 4. parametre (buf_num=xfer_num, buf_len=xfer_len):
+     *   buf_num  → kütüphanenin USB'ye sıraya koyduğu aktarım sayısı.
+     *   buf_len  → her callback çağrısında gelecek bayt sayısı; callback
+     *              bunu FFT bloklarına dilimler.
      * rtlsdr_cancel_async() çağrılana veya async_running=0 olana dek
      * bu fonksiyon geri dönmez.
+     *
+     * rtl_tcp kaynağında alım döngüsü aynı callback'i aynı aktarım boyuyla
+     * çağırır; işaretçiler doğrudan soket alım tamponunu gösterir.
      */
-    rtlsdr_read_async(s->dev, sdr_async_cb, s, 0, FFT_SIZE * 2);
-    return 0;
+    if (s->tcp) rtltcp_read_async(s->tcp, sdr_async_cb, s, s->xfer_len);
+    else        rtlsdr_read_async(s->dev, sdr_async_cb, s, s->xfer_num, s->xfer_len);
 }
 
 void sdr_start_async(SdrDevice *s, SdrDataCb cb, void *userdata) {
     s->data_cb       = cb;
     s->data_cb_ud    = userdata;
     s->async_running = 1;
-    s->disp_fresh    = 0;
-    InitializeCriticalSection(&s->disp_cs);
-    s->async_thread  = CreateThread(NULL, 0, sdr_async_thread_fn, s, 0, NULL);
-    printf("[SDR] Asenkron okuma basladi.\n");
+    s->carry_len     = 0;
+    s->last_xfer_us  = 0;
+    ThreadOpts o = { s->cpu, s->rt_prio };
+    thread_start(&s->async_thread, sdr_async_thread_fn, s, &o);
+    printf("[SDR] Asenkron okuma basladi (%u KB x %u aktarim).\n",
+           s->xfer_len / 1024, s->xfer_num);
 }
 
 void sdr_stop_async(SdrDevice *s) {
     if (!s->async_running) return;
     s->async_running = 0;
-    rtlsdr_cancel_async(s->dev);
-    if (s->async_thread) {
-        WaitForSingleObject(s->async_thread, 5000);
-        CloseHandle(s->async_thread);
-        s->async_thread = NULL;
-    }
-    DeleteCriticalSection(&s->disp_cs);
+    if (s->tcp) rtltcp_cancel_async(s->tcp);
+    else        rtlsdr_cancel_async(s->dev);
+    thread_join(&s->async_thread);
     printf("[SDR] Asenkron okuma durduruldu.\n");
 }
-
-int sdr_pop_block(SdrDevice *s, uint8_t *out) {
-    int got = 0;
-    EnterCriticalSection(&s->disp_cs);
-    if (s->disp_fresh) {
-        memcpy(out, s->disp_buf, FFT_SIZE * 2);
-        s->disp_fresh = 0;
-        got = 1;
-    }
-    LeaveCriticalSection(&s->disp_cs);
-    return got;
-}
\ No newline at end of file
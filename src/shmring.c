@@ -0,0 +1,327 @@
+/* shmring.c — IQ bloklarının ve PSD satırlarının paylaşılan bellekten yayını */
+#include "shmring.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#endif
+
+_Static_assert(sizeof(ShmSlotMeta) == 64, "ShmSlotMeta 64 bayt olmali");
+_Static_assert(sizeof(ShmHeader)  == 128, "ShmHeader 128 bayt olmali");
+
+#define SHMRING_VERSION 1
+
+struct ShmRing {
+    ShmHeader *hdr;
+    uint8_t   *base;
+    uint64_t   size;
+    char       path[80];
+#ifdef _WIN32
+    HANDLE     handle;
+#endif
+};
+
+/* ── Yardımcılar ──────────────────────────────────────────────── */
+static uint64_t epoch_us(void) {
+#ifdef _WIN32
+    FILETIME ft;
+    GetSystemTimeAsFileTime(&ft);
+    uint64_t t = ((uint64_t)ft.dwHighDateTime << 32) | ft.dwLowDateTime;
+    return t / 10u - 11644473600000000ull;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+#endif
+}
+
+/* Platform adı: Windows oturum-yerel eşleme, POSIX "/ad" */
+static void shm_path(char *out, size_t n, const char *name) {
+#ifdef _WIN32
+    snprintf(out, n, "Local\\%s", name);
+#else
+    snprintf(out, n, "/%s", name);
+#endif
+}
+
+/* Yuva adımı: üstveri + veri, 64 bayta yuvarlanmış */
+static uint64_t slot_stride(uint32_t data_bytes) {
+    return (sizeof(ShmSlotMeta) + data_bytes + 63u) & ~(uint64_t)63u;
+}
+
+static ShmSlotMeta *slot_at(const ShmHeader *h, uint64_t off, uint32_t slots,
+                            uint32_t data_bytes, uint64_t index) {
+    return (ShmSlotMeta *)((uint8_t *)h + off +
+                           (index % slots) * slot_stride(data_bytes));
+}
+
+/* ── Üretici ──────────────────────────────────────────────────── */
+ShmRing *shmring_create(const char *name, uint32_t iq_bytes, uint32_t psd_bins) {
+    ShmRing *r = calloc(1, sizeof(*r));
+    if (!r) return NULL;
+    shm_path(r->path, sizeof(r->path), name);
+
+    uint64_t iq_off  = sizeof(ShmHeader);
+    uint64_t psd_off = iq_off + SHMRING_IQ_SLOTS * slot_stride(iq_bytes);
+    r->size = psd_off + SHMRING_PSD_SLOTS * slot_stride(psd_bins * 4u);
+
+#ifdef _WIN32
+    r->handle = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+                                   (DWORD)(r->size >> 32), (DWORD)r->size, r->path);
+    if (r->handle)
+        r->base = MapViewOfFile(r->handle, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+    if (!r->base) {
+        fprintf(stderr, "[SHM] Esleme olusturulamadi: %s\n", r->path);
+        if (r->handle) CloseHandle(r->handle);
+        free(r);
+        return NULL;
+    }
+#else
+    int fd = shm_open(r->path, O_CREAT | O_RDWR, 0644);
+    if (fd < 0 || ftruncate(fd, (off_t)r->size) != 0) {
+        fprintf(stderr, "[SHM] Bolut olusturulamadi: %s\n", r->path);
+        if (fd >= 0) close(fd);
+        free(r);
+        return NULL;
+    }
+    void *p = mmap(NULL, r->size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) {
+        fprintf(stderr, "[SHM] mmap hatasi: %s\n", r->path);
+        shm_unlink(r->path);
+        free(r);
+        return NULL;
+    }
+    r->base = p;
+#endif
+
+    /* Önceki bir oturumdan kalan içerik okuyucuları yanıltmasın */
+    memset(r->base, 0, r->size);
+    ShmHeader *h = r->hdr = (ShmHeader *)r->base;
+    h->version     = SHMRING_VERSION;
+    h->iq_slots    = SHMRING_IQ_SLOTS;
+    h->iq_bytes    = iq_bytes;
+    h->psd_slots   = SHMRING_PSD_SLOTS;
+    h->psd_bins    = psd_bins;
+    h->iq_off      = iq_off;
+    h->psd_off     = psd_off;
+    h->total_bytes = r->size;
+    h->instance    = epoch_us();
+    h->alive       = 1;
+    /* magic en son: okuyucu yarım ilklendirilmiş başlığa bağlanmasın */
+    __atomic_store_n(&h->magic, SHMRING_MAGIC, __ATOMIC_RELEASE);
+
+    printf("[SHM] Yayin: %s  (%.1f MB)\n", r->path, r->size / 1048576.0);
+    return r;
+}
+
+void shmring_destroy(ShmRing *r) {
+    if (!r) return;
+    __atomic_store_n(&r->hdr->alive, 0u, __ATOMIC_RELEASE);
+#ifdef _WIN32
+    UnmapViewOfFile(r->base);
+    CloseHandle(r->handle);
+#else
+    munmap(r->base, r->size);
+    shm_unlink(r->path);   /* bağlı okuyucuların eşlemesi geçerli kalır */
+#endif
+    free(r);
+}
+
+/* Seqlock yazımı: tek üretici olduğu için head düz okunur */
+static void publish(ShmHeader *h, volatile uint64_t *head, uint64_t off,
+                    uint32_t slots, uint32_t data_bytes, const void *data,
+                    uint32_t len, double center_hz, double rate_hz) {
+    uint64_t     i = *head;
+    ShmSlotMeta *m = slot_at(h, off, slots, data_bytes, i);
+    if (len > data_bytes) len = data_bytes;
+
+    __atomic_store_n(&m->seq, 2 * i + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    m->index     = i;
+    m->t_us      = epoch_us();
+    m->center_hz = center_hz;
+    m->rate_hz   = rate_hz;
+    m->len       = len;
+    m->flags     = 0;
+    memcpy(m + 1, data, len);
+    __atomic_store_n(&m->seq, 2 * i + 2, __ATOMIC_RELEASE);
+    __atomic_store_n(head, i + 1, __ATOMIC_RELEASE);
+}
+
+void shmring_publish_iq(ShmRing *r, const uint8_t *buf, uint32_t len,
+                        double center_hz, double sample_rate) {
+    ShmHeader *h = r->hdr;
+    publish(h, &h->iq_head, h->iq_off, h->iq_slots, h->iq_bytes,
+            buf, len, center_hz, sample_rate);
+}
+
+void shmring_publish_psd(ShmRing *r, const float *row, uint32_t bins,
+                         double center_hz, double span_hz) {
+    ShmHeader *h = r->hdr;
+    publish(h, &h->psd_head, h->psd_off, h->psd_slots, h->psd_bins * 4u,
+            row, bins * 4u, center_hz, span_hz);
+}
+
+/* ── Okuyucu ──────────────────────────────────────────────────── */
+int shmring_attach(ShmReader *rd, const char *name) {
+    char path[80];
+    memset(rd, 0, sizeof(*rd));
+    shm_path(path, sizeof(path), name);
+
+#ifdef _WIN32
+    HANDLE hm = OpenFileMappingA(FILE_MAP_READ, FALSE, path);
+    if (!hm) return -1;
+    void *p = MapViewOfFile(hm, FILE_MAP_READ, 0, 0, 0);
+    if (!p) { CloseHandle(hm); return -1; }
+    rd->handle = hm;
+#else
+    int fd = shm_open(path, O_RDONLY, 0);
+    if (fd < 0) return -1;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(ShmHeader)) {
+        close(fd);
+        return -1;
+    }
+    void *p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) return -1;
+    rd->size = (uint64_t)st.st_size;
+#endif
+    rd->map = p;
+    rd->hdr = (const ShmHeader *)p;
+
+    const ShmHeader *h = rd->hdr;
+    if (__atomic_load_n(&h->magic, __ATOMIC_ACQUIRE) != SHMRING_MAGIC ||
+        h->version != SHMRING_VERSION) {
+        shmring_detach(rd);
+        return -1;
+    }
+    rd->size     = h->total_bytes;
+    rd->instance = h->instance;
+    rd->iq_next  = __atomic_load_n(&h->iq_head,  __ATOMIC_ACQUIRE);
+    rd->psd_next = __atomic_load_n(&h->psd_head, __ATOMIC_ACQUIRE);
+    return 0;
+}
+
+void shmring_detach(ShmReader *rd) {
+    if (!rd->map) return;
+#ifdef _WIN32
+    UnmapViewOfFile(rd->map);
+    CloseHandle((HANDLE)rd->handle);
+#else
+    munmap(rd->map, rd->size);
+#endif
+    rd->map = NULL;
+    rd->hdr = NULL;
+}
+
+int shmring_alive(const ShmReader *rd) {
+    return rd->hdr && __atomic_load_n(&rd->hdr->alive, __ATOMIC_ACQUIRE) &&
+           rd->hdr->instance == rd->instance;
+}
+
+uint64_t shmring_iq_lag(const ShmReader *rd) {
+    return __atomic_load_n(&rd->hdr->iq_head, __ATOMIC_ACQUIRE) - rd->iq_next;
+}
+
+uint64_t shmring_psd_lag(const ShmReader *rd) {
+    return __atomic_load_n(&rd->hdr->psd_head, __ATOMIC_ACQUIRE) - rd->psd_next;
+}
+
+/*
+ * Sıradaki tamamlanmış yuvayı bul. Okuyucu bir turdan fazla gerideyse
+ * ezilen yayınları atlar. Yuva yoksa NULL, varsa seq'i *s1'e yazar.
+ */
+static const ShmSlotMeta *next_slot(const ShmHeader *h, const volatile uint64_t *head,
+                                    uint64_t off, uint32_t slots, uint32_t data_bytes,
+                                    uint64_t *next, uint64_t *lost, uint64_t *s1) {
+    for (;;) {
+        uint64_t hd = __atomic_load_n(head, __ATOMIC_ACQUIRE);
+        if (*next >= hd) return NULL;
+
+        /* hd % slots yuvası bir sonraki yazımda ezilecek: en eski güvenli hd-slots+1 */
+        if (hd - *next >= slots) {
+            uint64_t oldest = hd - slots + 1;
+            *lost += oldest - *next;
+            *next  = oldest;
+        }
+        const ShmSlotMeta *m = slot_at(h, off, slots, data_bytes, *next);
+        uint64_t s = __atomic_load_n(&m->seq, __ATOMIC_ACQUIRE);
+        if (s == 2 * *next + 2) { *s1 = s; return m; }
+        /* Aradan yeni bir tur geçmiş: bu yayın kayıp, bir sonrakine bak */
+        (*lost)++;
+        (*next)++;
+    }
+}
+
+static int read_slot(ShmReader *rd, int psd, void *out, ShmSlotMeta *meta) {
+    const ShmHeader *h = rd->hdr;
+    uint64_t *next = psd ? &rd->psd_next : &rd->iq_next;
+    uint64_t *lost = psd ? &rd->psd_lost : &rd->iq_lost;
+    uint64_t *torn = psd ? &rd->psd_torn : &rd->iq_torn;
+    uint32_t  db   = psd ? h->psd_bins * 4u : h->iq_bytes;
+
+    for (;;) {
+        uint64_t s1;
+        const ShmSlotMeta *m = psd
+            ? next_slot(h, &h->psd_head, h->psd_off, h->psd_slots, db, next, lost, &s1)
+            : next_slot(h, &h->iq_head,  h->iq_off,  h->iq_slots,  db, next, lost, &s1);
+        if (!m) return 0;
+
+        ShmSlotMeta tmp;
+        memcpy(&tmp, m, sizeof(tmp));
+        uint32_t len = tmp.len <= db ? tmp.len : db;
+        memcpy(out, m + 1, len);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+        (*next)++;
+        if (__atomic_load_n(&m->seq, __ATOMIC_RELAXED) != s1) {
+            (*torn)++;
+            (*lost)++;
+            continue;
+        }
+        if (meta) *meta = tmp;
+        return 1;
+    }
+}
+
+int shmring_read_iq(ShmReader *rd, uint8_t *out, ShmSlotMeta *meta) {
+    return read_slot(rd, 0, out, meta);
+}
+
+int shmring_read_psd(ShmReader *rd, float *out, ShmSlotMeta *meta) {
+    return read_slot(rd, 1, out, meta);
+}
+
+const uint8_t *shmring_iq_begin(ShmReader *rd, ShmSlotMeta *meta) {
+    const ShmHeader *h = rd->hdr;
+    const ShmSlotMeta *m = next_slot(h, &h->iq_head, h->iq_off, h->iq_slots,
+                                     h->iq_bytes, &rd->iq_next, &rd->iq_lost,
+                                     &rd->pend_seq);
+    rd->pend = m;
+    if (!m) return NULL;
+    if (meta) memcpy(meta, m, sizeof(*meta));
+    return (const uint8_t *)(m + 1);
+}
+
+int shmring_iq_end(ShmReader *rd) {
+    if (!rd->pend) return 0;
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    int ok = __atomic_load_n(&rd->pend->seq, __ATOMIC_RELAXED) == rd->pend_seq;
+    rd->iq_next++;
+    if (!ok) {
+        rd->iq_torn++;
+        rd->iq_lost++;
+    }
+    rd->pend = NULL;
+    return ok;
+}
@@ -0,0 +1,260 @@
+/* snapshot.c — Ön tetik IQ halkası + tetiklemeli anlık kayıt */
+#include "snapshot.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static uint64_t ms_to_blocks(uint32_t ms, uint32_t sr) {
+    return ((uint64_t)ms * sr / 1000 + FFT_SIZE - 1) / FFT_SIZE;
+}
+
+/* ── Yazıcı ───────────────────────────────────────────────────── */
+typedef struct {
+    FILE    *fp, *mfp;
+    uint64_t file_samples;
+    uint64_t next_sample;
+    uint32_t gen;
+    int      settling;
+} SnapFile;
+
+static int snap_open(SnapRing *s, SnapFile *f) {
+    memset(f, 0, sizeof(*f));
+    time_t t = time(NULL);
+    struct tm *tm = localtime(&t);
+    snprintf(s->last_path, sizeof(s->last_path),
+        "%s" PATH_SEP "snap_%s%s%04d%02d%02d_%02d%02d%02d.bin", s->dir,
+        s->tag, s->tag[0] ? "_" : "",
+        tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday,
+        tm->tm_hour, tm->tm_min, tm->tm_sec);
+    /* Kapanıştan hemen sonraki tetik aynı saniyeye düşebilir: üzerine yazma */
+    size_t base = strlen(s->last_path) - 4;
+    for (int n = 2; n < 100; n++) {
+        FILE *e = fopen(s->last_path, "rb");
+        if (!e) break;
+        fclose(e);
+        snprintf(s->last_path + base, sizeof(s->last_path) - base, "_%d.bin", n);
+    }
+    f->fp = fopen(s->last_path, "wb");
+    if (!f->fp) {
+        fprintf(stderr, "[SNAP] Dosya acilamadi: %s\n", s->last_path);
+        return -1;
+    }
+    setvbuf(f->fp, NULL, _IOFBF, SNAP_CHUNK * REC_BLOCK);
+    char mpath[320];
+    snprintf(mpath, sizeof(mpath), "%.*s_marks.csv",
+             (int)(strlen(s->last_path) - 4), s->last_path);
+    f->mfp = fopen(mpath, "w");
+    if (f->mfp) fputs(REC_MARKS_HEADER, f->mfp);
+    return 0;
+}
+
+/* recorder.c mark_block ile aynı kurallar + tetik bloğu */
+static void snap_write(SnapFile *f, const uint8_t *blk, const SdrBlockMeta *m,
+                       int is_trig) {
+    if (f->mfp) {
+        if (f->file_samples == 0)
+            recorder_write_mark(f->mfp, 0, m, "start");
+        else if (m->sample != f->next_sample)
+            recorder_write_mark(f->mfp, f->file_samples, m, "gap");
+        if (f->file_samples && m->gen != f->gen)
+            recorder_write_mark(f->mfp, f->file_samples, m, "retune");
+        else if (f->file_samples && f->settling && !m->settling)
+            recorder_write_mark(f->mfp, f->file_samples, m, "settled");
+        if (is_trig)
+            recorder_write_mark(f->mfp, f->file_samples, m, "trigger");
+    }
+    f->gen         = m->gen;
+    f->settling    = m->settling;
+    f->next_sample = m->sample + FFT_SIZE;
+    fwrite(blk, 1, REC_BLOCK, f->fp);
+    f->file_samples += FFT_SIZE;
+}
+
+/*
+ * Tek anlık kaydı yaz: [i, end) bloklarını üreticiye yetişerek kopyalar.
+ * end tetiklerle uzayabildiği için her parçada kilit altında okunur. Bitiş
+ * kararı ile busy=0 aynı kilit altında verilir: karardan önce gelen tetik
+ * end'i uzatır, sonra gelen pending kurar; arada tetik kaybolmaz.
+ */
+static void snap_run(SnapRing *s, uint64_t i, const char *reason) {
+    uint8_t      (*buf)[REC_BLOCK] = malloc(sizeof(*buf) * SNAP_CHUNK);
+    SdrBlockMeta *bm = malloc(sizeof(*bm) * SNAP_CHUNK);
+    SnapFile      f;
+    if (!buf || !bm || snap_open(s, &f) != 0) {
+        free(buf);
+        free(bm);
+        return;
+    }
+    printf("[SNAP] Tetik (%s): %s\n", reason, s->last_path);
+
+    uint64_t lost = 0;
+    for (;;) {
+        mutex_lock(&s->cs);
+        uint64_t end = s->end, trig = s->trig;
+        if (i >= end) s->busy = 0;
+        mutex_unlock(&s->cs);
+        if (i >= end) break;
+
+        uint64_t w = ATOMIC_LOAD(&s->wi);
+        if (i >= w) {
+            if (!s->alive) break;   /* akış durdu: eldekiyle kapat */
+            sleep_ms(5);
+            continue;
+        }
+        uint64_t n = w - i;
+        if (n > SNAP_CHUNK) n = SNAP_CHUNK;
+        if (n > end - i)    n = end - i;
+        for (uint64_t k = 0; k < n; k++) {
+            memcpy(buf[k], s->ring[(i + k) % s->cap], REC_BLOCK);
+            bm[k] = s->meta[(i + k) % s->cap];
+        }
+
+        /* Kopya sırasında üretici bu yuvalara başladıysa o bloklar bozuk */
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        uint64_t wr    = __atomic_load_n(&s->wr, __ATOMIC_RELAXED);
+        uint64_t first = wr > i + s->cap ? wr - s->cap : i;
+        for (uint64_t j = first; j < i + n; j++)
+            snap_write(&f, buf[j - i], &bm[j - i], j == trig);
+        lost += (first < i + n ? first : i + n) - i;
+        i += n;
+    }
+    fclose(f.fp);
+    if (f.mfp) fclose(f.mfp);
+    free(buf);
+    free(bm);
+    printf("[SNAP] Yazildi: %s (%.1f s%s)\n", s->last_path,
+           f.file_samples / (double)(s->last_sr ? s->last_sr : 1),
+           lost ? ", yazici geride kaldi: bloklar atlandi" : "");
+    mutex_lock(&s->cs);
+    s->lost += lost;
+    s->n_snaps++;
+    mutex_unlock(&s->cs);
+}
+
+static void snap_thread(void *arg) {
+    SnapRing *s = (SnapRing *)arg;
+    while (s->alive) {
+        mutex_lock(&s->cs);
+        if (!s->pending && s->alive)
+            cond_wait_ms(&s->cv, &s->cs, 100);
+        int      go = s->pending;
+        uint64_t i  = s->trig;
+        char     reason[32];
+        memcpy(reason, s->reason, sizeof(reason));
+        s->pending = 0;
+        s->busy    = go;
+        mutex_unlock(&s->cs);
+        if (!go) continue;
+
+        /* Ön pencere: tetikten geriye, halkada hâlâ sağlam olan kadar */
+        uint64_t pre   = ms_to_blocks(s->pre_ms, s->last_sr);
+        uint64_t slack = ms_to_blocks(SNAP_SLACK_MS, s->last_sr) / 2;
+        if (slack > s->cap / 2)   slack = s->cap / 2;
+        if (pre > s->cap - slack) pre = s->cap - slack;
+        if (pre > i)   pre = i;
+        snap_run(s, i - pre, reason);
+
+        /* Dosya açılamadıysa ya da akış durduysa snap_run busy'yi bırakmadı */
+        mutex_lock(&s->cs);
+        s->busy = 0;
+        mutex_unlock(&s->cs);
+    }
+}
+
+/* ── Genel API ────────────────────────────────────────────────── */
+int snap_init(SnapRing *s, uint32_t pre_ms, uint32_t post_ms, uint32_t sample_rate) {
+    memset(s, 0, sizeof(*s));
+    s->cpu     = -1;
+    s->pre_ms  = pre_ms;
+    s->post_ms = post_ms;
+    s->last_sr = sample_rate;
+    snprintf(s->dir, sizeof(s->dir), "%s", REC_DEFAULT_DIR);
+    mutex_init(&s->cs);
+    cond_init(&s->cv);
+    if (!pre_ms && !post_ms) return 0;
+
+    uint64_t cap = ms_to_blocks(pre_ms + SNAP_SLACK_MS, sample_rate);
+    if (cap < 2 * SNAP_CHUNK) cap = 2 * SNAP_CHUNK;
+    s->ring = malloc(sizeof(*s->ring) * cap);
+    s->meta = malloc(sizeof(*s->meta) * cap);
+    if (!s->ring || !s->meta) {
+        fprintf(stderr, "[SNAP] Bellek hatasi: %.1f MB ayrilamadi\n",
+                cap * (double)REC_BLOCK / 1048576.0);
+        free(s->ring);
+        free(s->meta);
+        s->ring = NULL;
+        s->meta = NULL;
+        return -1;
+    }
+    s->cap = (uint32_t)cap;
+    printf("[SNAP] On tetik halkasi: %.1f s + %.1f s, %.1f MB\n",
+           pre_ms / 1000.0, post_ms / 1000.0, cap * (double)REC_BLOCK / 1048576.0);
+    return 0;
+}
+
+void snap_free(SnapRing *s) {
+    free(s->ring);
+    free(s->meta);
+    s->ring = NULL;
+    s->meta = NULL;
+    cond_free(&s->cv);
+    mutex_free(&s->cs);
+}
+
+void snap_start(SnapRing *s) {
+    if (!s->ring || s->alive) return;
+    s->alive = 1;
+    ThreadOpts o = { s->cpu, s->rt_prio };
+    thread_start(&s->thread, snap_thread, s, &o);
+}
+
+void snap_stop(SnapRing *s) {
+    if (!s->alive) return;
+    mutex_lock(&s->cs);
+    s->alive = 0;
+    cond_signal(&s->cv);
+    mutex_unlock(&s->cs);
+    thread_join(&s->thread);
+}
+
+void snap_push(SnapRing *s, const uint8_t *raw, const SdrBlockMeta *meta) {
+    if (!s->ring) return;
+    uint64_t w = s->wi;
+    uint32_t k = (uint32_t)(w % s->cap);
+
+    /* Önce sınır: yazıcı bu yuvayı kopyalıyorsa bozulduğunu görebilsin */
+    __atomic_store_n(&s->wr, w + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    memcpy(s->ring[k], raw, REC_BLOCK);
+    s->meta[k] = *meta;
+    s->last_sr = meta->sr;
+    ATOMIC_STORE(&s->wi, w + 1);
+}
+
+int snap_trigger(SnapRing *s, const char *reason) {
+    if (!s->ring) return -1;
+    uint64_t now  = ATOMIC_LOAD(&s->wi);
+    uint64_t post = ms_to_blocks(s->post_ms, s->last_sr);
+    mutex_lock(&s->cs);
+    s->trig = now;
+    s->end  = now + post + 1;   /* tetik bloğu dahil */
+    if (!s->busy && !s->pending) {
+        s->pending = 1;
+        snprintf(s->reason, sizeof(s->reason), "%s", reason ? reason : "");
+        cond_signal(&s->cv);
+    }
+    mutex_unlock(&s->cs);
+    return 0;
+}
+
+int snap_parse(const char *spec, uint32_t *pre_ms, uint32_t *post_ms) {
+    double pre = 0.0, post = -1.0;
+    if (sscanf(spec, "%lf:%lf", &pre, &post) < 1 || pre < 0.0 || pre > 3600.0)
+        return -1;
+    if (post < 0.0) post = pre;
+    if (post > 3600.0 || pre + post <= 0.0) return -1;
+    *pre_ms  = (uint32_t)(pre  * 1000.0 + 0.5);
+    *post_ms = (uint32_t)(post * 1000.0 + 0.5);
+    return 0;
+}
@@ -0,0 +1,377 @@
+/* specsrv.c — Uzak izleyiciler için ikili spektrum yayın sunucusu */
+#ifdef _WIN32
+#include <winsock2.h>
+#include <windows.h>
+typedef SOCKET sock_t;
+#define SOCK_BAD       INVALID_SOCKET
+#define sock_close     closesocket
+#define SEND_FLAGS     0
+#else
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <unistd.h>
+typedef int sock_t;
+#define SOCK_BAD       (-1)
+#define sock_close     close
+#define SEND_FLAGS     MSG_NOSIGNAL   /* kopan istemci SIGPIPE üretmesin */
+#endif
+
+#include "specsrv.h"
+#include "thread.h"
+#include "fft.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define OUT_MAX  (SPECSRV_HDR_SIZE + FFT_SIZE * 3 / 2 + 1)   /* en kötü fark çerçevesi */
+
+/* Bir hattın son satırı */
+typedef struct {
+    float    row[FFT_SIZE];
+    uint32_t seq;
+    uint64_t t_ms;
+    double   center_hz, span_hz;
+    int      valid;
+} SrvRow;
+
+typedef struct {
+    sock_t   sock;
+    int      used;
+
+    /* Abonelik */
+    uint32_t decim;                        /* her N. satır */
+    uint32_t bins;                         /* istenen kutu sayısı */
+    uint32_t mask;                         /* hat maskesi */
+    uint8_t  cmd[5];
+    int      cmd_len;
+
+    /* Hat başına fark referansı: istemcinin elindeki son satır */
+    uint32_t seen[SPECSRV_MAX_PIPES];      /* seyreltme sayacı */
+    uint8_t  ref[SPECSRV_MAX_PIPES][FFT_SIZE];
+    uint32_t ref_bins[SPECSRV_MAX_PIPES];  /* 0 = referans yok */
+    double   ref_center[SPECSRV_MAX_PIPES], ref_span[SPECSRV_MAX_PIPES];
+    int      since_key[SPECSRV_MAX_PIPES];
+
+    /* Yolda olan tek çerçeve (boşalmadan yenisi kuyruğa alınmaz) */
+    uint8_t  out[OUT_MAX];
+    uint32_t out_len, out_off;
+
+    uint64_t frames, drops, bytes;
+} SrvClient;
+
+struct SpecServer {
+    sock_t           listen_sock;
+    Thread           thread;
+    volatile int     running;
+
+    Mutex            cs;                          /* slot'u korur */
+    SrvRow           slot[SPECSRV_MAX_PIPES];     /* publish yazar */
+    SrvRow           snap[SPECSRV_MAX_PIPES];     /* gönderici kopyası */
+
+    SrvClient        cl[SPECSRV_MAX_CLIENTS];
+    volatile int      n_clients;
+    volatile uint64_t bytes_sent;
+};
+
+/* ── Soket yardımcıları ───────────────────────────────────────── */
+static void set_nonblock(sock_t s) {
+#ifdef _WIN32
+    u_long on = 1;
+    ioctlsocket(s, FIONBIO, &on);
+#else
+    fcntl(s, F_SETFL, fcntl(s, F_GETFL, 0) | O_NONBLOCK);
+#endif
+}
+
+static int would_block(void) {
+#ifdef _WIN32
+    return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+    return errno == EAGAIN || errno == EWOULDBLOCK;
+#endif
+}
+
+/* ── Kodlama ──────────────────────────────────────────────────── */
+static void wr_le16(uint8_t *p, uint16_t v) { p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); }
+static void wr_le32(uint8_t *p, uint32_t v) {
+    for (int i = 0; i < 4; i++) p[i] = (uint8_t)(v >> (8 * i));
+}
+static void wr_le64(uint8_t *p, uint64_t v) {
+    for (int i = 0; i < 8; i++) p[i] = (uint8_t)(v >> (8 * i));
+}
+static void wr_f32(uint8_t *p, float v)  { uint32_t u; memcpy(&u, &v, 4); wr_le32(p, u); }
+static void wr_f64(uint8_t *p, double v) { uint64_t u; memcpy(&u, &v, 8); wr_le64(p, u); }
+
+/* FFT_SIZE float dB → bins adet uint8 (grup içi max, sonra nicemleme) */
+static void quantize(const float *row, uint32_t bins, uint8_t *q) {
+    uint32_t g = FFT_SIZE / bins;
+    for (uint32_t b = 0; b < bins; b++) {
+        float m = row[b * g];
+        for (uint32_t k = 1; k < g; k++)
+            if (row[b * g + k] > m) m = row[b * g + k];
+        float v = (m - SPECSRV_DB_BASE) / SPECSRV_DB_STEP + 0.5f;
+        q[b] = (v <= 0.0f) ? 0 : (v >= 255.0f) ? 255 : (uint8_t)v;
+    }
+}
+
+static void put_nib(uint8_t *out, uint32_t *nib, unsigned v) {
+    if (*nib & 1) out[*nib >> 1] |= (uint8_t)(v & 0xF);
+    else          out[*nib >> 1]  = (uint8_t)(v << 4);
+    (*nib)++;
+}
+
+/* Fark + 4 bit öbek kodlaması; yazılan bayt sayısını döndürür */
+static uint32_t pack_delta(const uint8_t *q, const uint8_t *ref, uint32_t n,
+                           uint8_t *out) {
+    uint32_t nib = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        int d = (int8_t)(uint8_t)(q[i] - ref[i]);
+        if (d >= -7 && d <= 7) {
+            put_nib(out, &nib, (unsigned)d);
+        } else {
+            put_nib(out, &nib, 0x8);
+            put_nib(out, &nib, (unsigned)(uint8_t)d >> 4);
+            put_nib(out, &nib, (unsigned)d);
+        }
+    }
+    return (nib + 1) / 2;
+}
+
+/* ── İstemciler ───────────────────────────────────────────────── */
+static void drop_client(SpecServer *sv, SrvClient *c) {
+    printf("[SPEC] Izleyici ayrildi: %llu cerceve, %llu atlanan, %.1f kB\n",
+           (unsigned long long)c->frames, (unsigned long long)c->drops,
+           c->bytes / 1024.0);
+    sock_close(c->sock);
+    c->used = 0;
+    sv->n_clients--;
+}
+
+static void accept_clients(SpecServer *sv) {
+    for (;;) {
+        sock_t s = accept(sv->listen_sock, NULL, NULL);
+        if (s == SOCK_BAD) return;
+
+        SrvClient *c = NULL;
+        for (int i = 0; i < SPECSRV_MAX_CLIENTS; i++)
+            if (!sv->cl[i].used) { c = &sv->cl[i]; break; }
+        if (!c) {
+            fprintf(stderr, "[SPEC] Izleyici siniri dolu, baglanti reddedildi\n");
+            sock_close(s);
+            continue;
+        }
+        set_nonblock(s);
+        int one = 1;
+        setsockopt(s, IPPROTO_TCP, TCP_NODELAY, (const char *)&one, sizeof(one));
+
+        memset(c, 0, sizeof(*c));
+        c->sock  = s;
+        c->used  = 1;
+        c->decim = 1;
+        c->bins  = FFT_SIZE;
+        c->mask  = 0xFFFFFFFFu;
+        sv->n_clients++;
+        printf("[SPEC] Izleyici baglandi (%d)\n", sv->n_clients);
+    }
+}
+
+/* Abonelik komutlarını oku. Bağlantı koptuysa -1. */
+static int read_cmds(SrvClient *c) {
+    for (;;) {
+        int r = recv(c->sock, (char *)c->cmd + c->cmd_len, 5 - c->cmd_len, 0);
+        if (r == 0) return -1;
+        if (r < 0) return would_block() ? 0 : -1;
+        c->cmd_len += r;
+        if (c->cmd_len < 5) continue;
+        c->cmd_len = 0;
+
+        uint32_t v = ((uint32_t)c->cmd[1] << 24) | ((uint32_t)c->cmd[2] << 16) |
+                     ((uint32_t)c->cmd[3] <<  8) |  (uint32_t)c->cmd[4];
+        switch (c->cmd[0]) {
+        case SPECSRV_CMD_DECIM:
+            if (v >= 1 && v <= SPECSRV_MAX_DECIM) c->decim = v;
+            break;
+        case SPECSRV_CMD_BINS:
+            /* 2'nin kuvveti ve FFT_SIZE'ı bölmeli */
+            if (v >= 64 && v <= FFT_SIZE && (v & (v - 1)) == 0) c->bins = v;
+            break;
+        case SPECSRV_CMD_PIPES:
+            c->mask = v;
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+/* Yoldaki çerçeveyi yazabildiği kadar yaz. Bağlantı koptuysa -1. */
+static int flush_client(SpecServer *sv, SrvClient *c) {
+    while (c->out_off < c->out_len) {
+        int r = send(c->sock, (const char *)c->out + c->out_off,
+                     (int)(c->out_len - c->out_off), SEND_FLAGS);
+        if (r < 0) return would_block() ? 0 : -1;
+        c->out_off     += (uint32_t)r;
+        c->bytes       += (uint64_t)r;
+        sv->bytes_sent += (uint64_t)r;
+    }
+    return 0;
+}
+
+/* Hattın yeni satırını bu istemcinin aboneliğine göre kuyruğa al */
+static void deliver(SpecServer *sv, SrvClient *c, int p) {
+    const SrvRow *r = &sv->snap[p];
+    if (!(c->mask & (1u << p))) return;
+    if (c->seen[p]++ % c->decim) return;
+    if (c->out_off < c->out_len) { c->drops++; return; }   /* önceki çerçeve yolda */
+
+    uint8_t  q[FFT_SIZE];
+    uint32_t n = c->bins;
+    quantize(r->row, n, q);
+
+    int key = c->ref_bins[p] != n ||
+              c->ref_center[p] != r->center_hz || c->ref_span[p] != r->span_hz ||
+              c->since_key[p] >= SPECSRV_KEY_EVERY;
+
+    uint8_t *pl = c->out + SPECSRV_HDR_SIZE;
+    uint32_t plen;
+    if (key) {
+        memcpy(pl, q, n);
+        plen = n;
+        c->since_key[p] = 0;
+    } else {
+        plen = pack_delta(q, c->ref[p], n, pl);
+        c->since_key[p]++;
+    }
+    memcpy(c->ref[p], q, n);
+    c->ref_bins[p]   = n;
+    c->ref_center[p] = r->center_hz;
+    c->ref_span[p]   = r->span_hz;
+
+    uint8_t *h = c->out;
+    memcpy(h, "SPF1", 4);
+    h[4] = key ? SPECSRV_F_KEY : 0;
+    h[5] = (uint8_t)p;
+    wr_le16(h +  6, (uint16_t)n);
+    wr_le32(h +  8, r->seq);
+    wr_le64(h + 12, r->t_ms);
+    wr_f64 (h + 20, r->center_hz);
+    wr_f64 (h + 28, r->span_hz);
+    wr_f32 (h + 36, SPECSRV_DB_BASE);
+    wr_f32 (h + 40, SPECSRV_DB_STEP);
+    wr_le32(h + 44, plen);
+
+    c->out_len = SPECSRV_HDR_SIZE + plen;
+    c->out_off = 0;
+    c->frames++;
+}
+
+/* ── Gönderici thread'i ───────────────────────────────────────── */
+static void srv_thread_fn(void *arg) {
+    SpecServer *sv = (SpecServer *)arg;
+    int fresh[SPECSRV_MAX_PIPES];
+
+    while (sv->running) {
+        accept_clients(sv);
+
+        /* Yeni satırların kopyası: kilit yalnızca memcpy boyunca tutulur */
+        int any = 0;
+        mutex_lock(&sv->cs);
+        for (int p = 0; p < SPECSRV_MAX_PIPES; p++) {
+            fresh[p] = sv->slot[p].valid && (!sv->snap[p].valid ||
+                       sv->slot[p].seq != sv->snap[p].seq);
+            if (fresh[p]) { sv->snap[p] = sv->slot[p]; any = 1; }
+        }
+        mutex_unlock(&sv->cs);
+
+        for (int i = 0; i < SPECSRV_MAX_CLIENTS; i++) {
+            SrvClient *c = &sv->cl[i];
+            if (!c->used) continue;
+            if (read_cmds(c) != 0 || flush_client(sv, c) != 0) {
+                drop_client(sv, c);
+                continue;
+            }
+            for (int p = 0; p < SPECSRV_MAX_PIPES; p++)
+                if (fresh[p]) deliver(sv, c, p);
+            if (flush_client(sv, c) != 0) drop_client(sv, c);
+        }
+        if (!any) sleep_ms(1);
+    }
+}
+
+/* ── Genel API ────────────────────────────────────────────────── */
+SpecServer *specsrv_start(uint16_t port) {
+#ifdef _WIN32
+    static int wsa_ready = 0;
+    if (!wsa_ready) {
+        WSADATA wd;
+        if (WSAStartup(MAKEWORD(2, 2), &wd) != 0) {
+            fprintf(stderr, "[SPEC] WSAStartup hatasi\n");
+            return NULL;
+        }
+        wsa_ready = 1;
+    }
+#endif
+    sock_t ls = socket(AF_INET, SOCK_STREAM, 0);
+    if (ls == SOCK_BAD) {
+        fprintf(stderr, "[SPEC] Soket acilamadi\n");
+        return NULL;
+    }
+    int one = 1;
+    setsockopt(ls, SOL_SOCKET, SO_REUSEADDR, (const char *)&one, sizeof(one));
+    struct sockaddr_in a;
+    memset(&a, 0, sizeof(a));
+    a.sin_family      = AF_INET;
+    a.sin_addr.s_addr = htonl(INADDR_ANY);
+    a.sin_port        = htons(port);
+    if (bind(ls, (struct sockaddr *)&a, sizeof(a)) != 0 ||
+        listen(ls, SPECSRV_MAX_CLIENTS) != 0) {
+        fprintf(stderr, "[SPEC] Port %u dinlenemiyor\n", port);
+        sock_close(ls);
+        return NULL;
+    }
+    set_nonblock(ls);
+
+    SpecServer *sv = calloc(1, sizeof(*sv));
+    if (!sv) {
+        fprintf(stderr, "[SPEC] Bellek hatasi\n");
+        sock_close(ls);
+        return NULL;
+    }
+    sv->listen_sock = ls;
+    sv->running     = 1;
+    mutex_init(&sv->cs);
+    thread_start(&sv->thread, srv_thread_fn, sv, NULL);
+    printf("[SPEC] Spektrum yayini port %u\n", port);
+    return sv;
+}
+
+void specsrv_stop(SpecServer *sv) {
+    if (!sv) return;
+    sv->running = 0;
+    thread_join(&sv->thread);
+    for (int i = 0; i < SPECSRV_MAX_CLIENTS; i++)
+        if (sv->cl[i].used) drop_client(sv, &sv->cl[i]);
+    sock_close(sv->listen_sock);
+    mutex_free(&sv->cs);
+    free(sv);
+}
+
+void specsrv_publish(SpecServer *sv, int pipe, const float *row, uint32_t seq,
+                     uint64_t t_ms, double center_hz, double span_hz) {
+    if (pipe < 0 || pipe >= SPECSRV_MAX_PIPES) return;
+    SrvRow *s = &sv->slot[pipe];
+    mutex_lock(&sv->cs);
+    memcpy(s->row, row, sizeof(s->row));
+    s->seq       = seq;
+    s->t_ms      = t_ms;
+    s->center_hz = center_hz;
+    s->span_hz   = span_hz;
+    s->valid     = 1;
+    mutex_unlock(&sv->cs);
+}
+
+int      specsrv_clients   (const SpecServer *sv) { return sv->n_clients; }
+uint64_t specsrv_bytes_sent(const SpecServer *sv) { return sv->bytes_sent; }
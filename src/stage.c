@@ -0,0 +1,315 @@
+/* stage.c — DSP aşamaları: kayıt defteri, paylaşılan kütüphane yükleme, hat başına barındırıcı */
+#include "stage.h"
+#include <stdlib.h>
+#include <string.h>
+#ifndef _WIN32
+#include <dlfcn.h>
+#endif
+
+#define STAGE_BATCH    64     /* halka başına tek turda işlenen en çok giriş */
+#define STAGE_WAIT_MS  20     /* kaçan uyandırma için üst sınır */
+
+/* ── Süreç kayıt defteri ──────────────────────────────────────── */
+static struct {
+    const StageDesc *d;
+    char             args[128];
+} g_reg[STAGE_MAX];
+static int g_n;
+
+int stage_registered(void) { return g_n; }
+
+int stage_register(const StageDesc *d, const char *args) {
+    if (!d || d->api_version != STAGE_API_VERSION) {
+        fprintf(stderr, "[STAGE] Arayuz surumu uyumsuz (%d, beklenen %d)\n",
+                d ? d->api_version : -1, STAGE_API_VERSION);
+        return -1;
+    }
+    const char *name = d->name ? d->name : "?";
+    if (!d->open || (d->mode != STAGE_LOSSLESS && d->mode != STAGE_BEST_EFFORT) ||
+        ((d->wants & STAGE_WANT_IQ)  && !d->on_block) ||
+        ((d->wants & STAGE_WANT_PSD) && !d->on_row) ||
+        !(d->wants & (STAGE_WANT_IQ | STAGE_WANT_PSD))) {
+        fprintf(stderr, "[STAGE] %s: gecersiz tanim (open / mode / wants)\n", name);
+        return -1;
+    }
+    if (g_n >= STAGE_MAX) {
+        fprintf(stderr, "[STAGE] En cok %d asama\n", STAGE_MAX);
+        return -1;
+    }
+    g_reg[g_n].d = d;
+    snprintf(g_reg[g_n].args, sizeof(g_reg[g_n].args), "%s", args ? args : "");
+    g_n++;
+    printf("[STAGE] Kaydedildi: %s (%s%s%s)\n", name,
+           d->mode == STAGE_LOSSLESS ? "kayipsiz" : "en iyi caba",
+           d->wants & STAGE_WANT_IQ  ? ", IQ"  : "",
+           d->wants & STAGE_WANT_PSD ? ", PSD" : "");
+    return 0;
+}
+
+/* Kütüphane süreç sonuna dek açık kalır: tanım ve işlevler onun içinde */
+int stage_load(const char *spec) {
+    char path[256];
+    snprintf(path, sizeof(path), "%s", spec);
+    char *comma = strchr(path, ',');
+    const char *args = "";
+    if (comma) {
+        *comma = '\0';
+        args = comma + 1;
+    }
+
+    StageEntryFn entry;
+#ifdef _WIN32
+    HMODULE lib = LoadLibraryA(path);
+    if (!lib) {
+        fprintf(stderr, "[STAGE] Kutuphane acilamadi: %s (hata %lu)\n",
+                path, (unsigned long)GetLastError());
+        return -1;
+    }
+    entry = (StageEntryFn)(void (*)(void))GetProcAddress(lib, STAGE_ENTRY_SYMBOL);
+#else
+    void *lib = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+    if (!lib) {
+        fprintf(stderr, "[STAGE] Kutuphane acilamadi: %s\n", dlerror());
+        return -1;
+    }
+    *(void **)&entry = dlsym(lib, STAGE_ENTRY_SYMBOL);
+#endif
+    if (!entry) {
+        fprintf(stderr, "[STAGE] %s: %s bulunamadi\n", path, STAGE_ENTRY_SYMBOL);
+        return -1;
+    }
+    return stage_register(entry(), args);
+}
+
+/* ── Halka ────────────────────────────────────────────────────── */
+
+static int ring_alloc(StageRing *r, uint32_t slot_size, uint32_t meta_size, uint32_t cap) {
+    r->slots     = malloc((size_t)slot_size * cap);
+    r->meta      = malloc((size_t)meta_size * cap);
+    r->slot_size = slot_size;
+    r->meta_size = meta_size;
+    r->cap       = cap;
+    r->wr = r->wi = 0;
+    if (r->slots && r->meta) return 0;
+    free(r->slots);
+    free(r->meta);
+    memset(r, 0, sizeof(*r));
+    return -1;
+}
+
+static void ring_free(StageRing *r) {
+    free(r->slots);
+    free(r->meta);
+    memset(r, 0, sizeof(*r));
+}
+
+static inline uint64_t *inst_rd(StageInst *s, int iq) {
+    return (uint64_t *)(iq ? &s->rd_iq : &s->rd_row);
+}
+
+/*
+ * Tek üretici: snap_push ile aynı sınır + sayaç düzeni. Kayıpsız bir
+ * okuyucunun henüz bırakmadığı yuvaya yazılmaz; giriş atılır.
+ */
+static void ring_push(StageHost *h, StageRing *r, int iq, uint32_t want,
+                      const void *data, const void *meta) {
+    uint64_t w = r->wi;
+    for (int i = 0; i < h->n; i++) {
+        StageInst *s = &h->st[i];
+        if (s->d->mode != STAGE_LOSSLESS || !(s->d->wants & want)) continue;
+        if (w - ATOMIC_LOAD(inst_rd(s, iq)) >= r->cap) {
+            stats_inc(h->pipe_stats, STAT_C_STAGE_DROPS);
+            return;
+        }
+    }
+
+    uint32_t k = (uint32_t)(w % r->cap);
+    __atomic_store_n(&r->wr, w + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    memcpy(r->slots + (size_t)k * r->slot_size, data, r->slot_size);
+    memcpy(r->meta  + (size_t)k * r->meta_size, meta, r->meta_size);
+    ATOMIC_STORE(&r->wi, w + 1);
+
+    /* Uyuyan yoksa kilit hiç alınmaz; sleepers ile wi Dekker düzeninde */
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (ATOMIC_LOAD_RLX(&h->sleepers)) {
+        mutex_lock(&h->cs);
+        cond_broadcast(&h->cv);
+        mutex_unlock(&h->cs);
+    }
+}
+
+/* ── Aşama thread'i ───────────────────────────────────────────── */
+
+/* Yuva çağrı öncesinde ya da sırasında üzerine yazıldı mı */
+static inline int slot_clobbered(const StageRing *r, uint64_t i) {
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return __atomic_load_n(&r->wr, __ATOMIC_RELAXED) > i + r->cap;
+}
+
+/* Halkadan en çok STAGE_BATCH giriş işle; işlenen sayısı */
+static int drain(StageInst *s, StageRing *r, int iq) {
+    uint64_t *rd = inst_rd(s, iq);
+    uint64_t  w  = ATOMIC_LOAD(&r->wi);
+    uint64_t  i  = *rd;
+    if (i >= w) return 0;
+
+    /* En iyi çaba: yarım halkadan fazla gerideyse en yeni girişe atla */
+    if (s->d->mode == STAGE_BEST_EFFORT && w - i > r->cap / 2) {
+        stats_add(&s->stats, STAT_C_STAGE_SKIP, w - 1 - i);
+        i = w - 1;
+    }
+
+    int n = 0;
+    for (; i < w && n < STAGE_BATCH; i++, n++) {
+        uint32_t k = (uint32_t)(i % r->cap);
+        const uint8_t *slot = r->slots + (size_t)k * r->slot_size;
+        union { SdrBlockMeta b; StageRowMeta p; } m;   /* etiket yereldedir */
+        memcpy(&m, r->meta + (size_t)k * r->meta_size, r->meta_size);
+        if (slot_clobbered(r, i)) {
+            stats_inc(&s->stats, STAT_C_STAGE_SKIP);
+            continue;
+        }
+
+        uint64_t t0 = stats_now_us();
+        if (iq) {
+            stats_record(&s->stats, STAT_H_STAGE_LAG, t0 - m.b.t_us);
+            s->d->on_block(s->ctx, slot, &m.b);
+            stats_since(&s->stats, STAT_H_STAGE_BLOCK, t0);
+            stats_inc(&s->stats, STAT_C_STAGE_BLOCKS);
+        } else {
+            s->d->on_row(s->ctx, (const float *)slot, &m.p);
+            stats_since(&s->stats, STAT_H_STAGE_ROW, t0);
+            stats_inc(&s->stats, STAT_C_STAGE_ROWS);
+        }
+        if (slot_clobbered(r, i))
+            stats_inc(&s->stats, STAT_C_STAGE_TORN);
+        ATOMIC_STORE(rd, i + 1);   /* kayıpsızda yuva ancak şimdi boşalır */
+    }
+    ATOMIC_STORE(rd, i);
+    return n;
+}
+
+static void stage_thread(void *arg) {
+    StageInst *s = (StageInst *)arg;
+    StageHost *h = s->host;
+    int want_iq  = (s->d->wants & STAGE_WANT_IQ)  != 0;
+    int want_psd = (s->d->wants & STAGE_WANT_PSD) != 0;
+
+    for (;;) {
+        int alive = ATOMIC_LOAD(&s->alive);
+        /* Durdurulunca kayıpsız aşama halkada kalanı bitirir */
+        if (!alive && s->d->mode == STAGE_BEST_EFFORT) break;
+        int n = 0;
+        if (want_iq)  n += drain(s, &h->iq,   1);
+        if (want_psd) n += drain(s, &h->rows, 0);
+        if (n) continue;
+        if (!alive) break;
+
+        mutex_lock(&h->cs);
+        ATOMIC_ADD(&h->sleepers, 1);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        int pending = (want_iq  && ATOMIC_LOAD(&h->iq.wi)   != s->rd_iq) ||
+                      (want_psd && ATOMIC_LOAD(&h->rows.wi) != s->rd_row);
+        if (!pending && ATOMIC_LOAD(&s->alive))
+            cond_wait_ms(&h->cv, &h->cs, STAGE_WAIT_MS);
+        ATOMIC_ADD(&h->sleepers, (uint32_t)-1);
+        mutex_unlock(&h->cs);
+    }
+}
+
+/* ── Barındırıcı ──────────────────────────────────────────────── */
+
+int stage_host_init(StageHost *h, const char *pipe_name, const char *tag,
+                    const char *out_dir, Stats *pipe_stats) {
+    memset(h, 0, sizeof(*h));
+    h->pipe_stats = pipe_stats;
+    mutex_init(&h->cs);
+    cond_init(&h->cv);
+
+    for (int i = 0; i < g_n; i++) {
+        const StageDesc *d = g_reg[i].d;
+        StageInfo info = {
+            STAGE_API_VERSION, pipe_name, tag, out_dir, g_reg[i].args,
+            FFT_SIZE, FFT_SIZE,
+        };
+        void *ctx = d->open(&info);
+        if (!ctx) {
+            fprintf(stderr, "[STAGE] %s: %s acilamadi, atlandi\n", pipe_name, d->name);
+            continue;
+        }
+        StageInst *s = &h->st[h->n++];
+        s->d    = d;
+        s->ctx  = ctx;
+        s->host = h;
+        h->wants |= d->wants;
+    }
+    if (!h->n) return 0;
+
+    if (((h->wants & STAGE_WANT_IQ) &&
+         ring_alloc(&h->iq, FFT_SIZE * 2, sizeof(SdrBlockMeta), STAGE_IQ_SLOTS) != 0) ||
+        ((h->wants & STAGE_WANT_PSD) &&
+         ring_alloc(&h->rows, FFT_SIZE * sizeof(float), sizeof(StageRowMeta),
+                    STAGE_ROW_SLOTS) != 0)) {
+        fprintf(stderr, "[STAGE] %s: bellek hatasi\n", pipe_name);
+        for (int i = 0; i < h->n; i++)
+            if (h->st[i].d->close) h->st[i].d->close(h->st[i].ctx);
+        h->n     = 0;
+        h->wants = 0;
+        ring_free(&h->iq);
+        ring_free(&h->rows);
+        return -1;   /* kilitler kalır: çağıran yine stage_host_free'yi çağırır */
+    }
+    printf("[STAGE] %s: %d asama acildi\n", pipe_name, h->n);
+    return 0;
+}
+
+void stage_host_start(StageHost *h) {
+    h->iq.wr = h->iq.wi = h->rows.wr = h->rows.wi = 0;
+    for (int i = 0; i < h->n; i++) {
+        StageInst *s = &h->st[i];
+        if (s->alive) continue;
+        s->rd_iq = s->rd_row = 0;
+        s->alive = 1;
+        thread_start(&s->thread, stage_thread, s, NULL);
+    }
+}
+
+/* Üreticiler durmuş olmalı (pipeline_stop USB ve DSP'den sonra çağırır) */
+void stage_host_stop(StageHost *h) {
+    for (int i = 0; i < h->n; i++) ATOMIC_STORE(&h->st[i].alive, 0);
+    mutex_lock(&h->cs);
+    cond_broadcast(&h->cv);
+    mutex_unlock(&h->cs);
+    for (int i = 0; i < h->n; i++) thread_join(&h->st[i].thread);
+}
+
+void stage_host_free(StageHost *h) {
+    for (int i = 0; i < h->n; i++)
+        if (h->st[i].d->close) h->st[i].d->close(h->st[i].ctx);
+    h->n = 0;
+    ring_free(&h->iq);
+    ring_free(&h->rows);
+    cond_free(&h->cv);
+    mutex_free(&h->cs);
+}
+
+void stage_push_block(StageHost *h, const uint8_t *raw, const SdrBlockMeta *m) {
+    if (h->iq.slots) ring_push(h, &h->iq, 1, STAGE_WANT_IQ, raw, m);
+}
+
+void stage_push_row(StageHost *h, const float *psd, const StageRowMeta *r) {
+    if (h->rows.slots) ring_push(h, &h->rows, 0, STAGE_WANT_PSD, psd, r);
+}
+
+void stage_write_json(FILE *fp, const StageHost *h) {
+    fputc('[', fp);
+    for (int i = 0; i < h->n; i++) {
+        const StageInst *s = &h->st[i];
+        fprintf(fp, "%s{\"name\":\"%s\",\"mode\":\"%s\",\"stats\":", i ? "," : "",
+                s->d->name, s->d->mode == STAGE_LOSSLESS ? "lossless" : "best_effort");
+        stats_write_json(fp, &s->stats);
+        fputc('}', fp);
+    }
+    fputc(']', fp);
+}
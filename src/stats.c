@@ -0,0 +1,150 @@
+/* stats.c — Düşük maliyetli hat ölçümleri */
+#include "stats.h"
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+/* Adlar kimliğe bağlı: stats.h'de sıra değişse de JSON anahtarı kaymaz */
+static const char *const HIST_NAMES[] = {
+    [STAT_H_XFER_GAP]    = "xfer_gap",
+    [STAT_H_CB_GAP]      = "cb_gap",
+    [STAT_H_CB_TIME]     = "cb_time",
+    [STAT_H_IQCORR]      = "iq_corr",
+    [STAT_H_QUEUE]       = "queue_wait",
+    [STAT_H_FFT]         = "fft",
+    [STAT_H_FINE_FFT]    = "fine_fft",
+    [STAT_H_MRES]        = "multires",
+    [STAT_H_CHAN]        = "channelize",
+    [STAT_H_DEMOD]       = "demod",
+    [STAT_H_DEMOD_LAT]   = "demod_latency",
+    [STAT_H_ROW]         = "row",
+    [STAT_H_DSP_LAT]     = "dsp_latency",
+    [STAT_H_RETUNE]      = "retune_to_row",
+    [STAT_H_E2E]         = "sample_to_photon",
+    [STAT_H_RENDER_WF]   = "render_waterfall",
+    [STAT_H_FRAME]       = "frame",
+    [STAT_H_PRESENT]     = "present",
+    [STAT_H_STAGE_BLOCK] = "stage_block",
+    [STAT_H_STAGE_ROW]   = "stage_row",
+    [STAT_H_STAGE_LAG]   = "stage_lag",
+};
+_Static_assert(sizeof(HIST_NAMES) / sizeof(HIST_NAMES[0]) == STAT_H_COUNT,
+               "HIST_NAMES her StatHistId icin bir ad icermeli");
+
+static const char *const COUNTER_NAMES[] = {
+    [STAT_C_XFERS]        = "xfers",
+    [STAT_C_BLOCKS]       = "blocks",
+    [STAT_C_REC_DROPS]    = "rec_drops",
+    [STAT_C_Q_DROPS]      = "queue_drops",
+    [STAT_C_DEMOD_DROPS]  = "demod_drops",
+    [STAT_C_ROWS]         = "rows",
+    [STAT_C_MRES_ROWS]    = "mres_rows",
+    [STAT_C_SETTLE]       = "settle_drops",
+    [STAT_C_VIEW_STALE]   = "view_stale",
+    [STAT_C_FRAMES]       = "frames",
+    [STAT_C_STAGE_DROPS]  = "stage_drops",
+    [STAT_C_STAGE_BLOCKS] = "stage_blocks",
+    [STAT_C_STAGE_ROWS]   = "stage_rows",
+    [STAT_C_STAGE_SKIP]   = "stage_skipped",
+    [STAT_C_STAGE_TORN]   = "stage_torn",
+};
+_Static_assert(sizeof(COUNTER_NAMES) / sizeof(COUNTER_NAMES[0]) == STAT_C_COUNT,
+               "COUNTER_NAMES her StatCounterId icin bir ad icermeli");
+
+uint64_t stats_now_us(void) {
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER c;
+    if (!freq.QuadPart) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&c);
+    return (uint64_t)((double)c.QuadPart * 1e6 / (double)freq.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+#endif
+}
+
+void stats_reset(Stats *s) {
+    memset(s, 0, sizeof(*s));
+}
+
+/*
+ * Kova: us < 4 için doğrudan us; aksi halde ikilik (msb) başına 4 kova,
+ * msb'nin altındaki iki bit alt kovayı seçer.
+ */
+static int bucket_of(uint64_t us) {
+    if (us < 4) return (int)us;
+    int msb = 63 - __builtin_clzll(us);
+    int idx = 4 * (msb - 1) + (int)((us >> (msb - 2)) & 3);
+    return idx < STATS_BUCKETS ? idx : STATS_BUCKETS - 1;
+}
+
+static double bucket_lo(int idx) {
+    if (idx < 4) return idx;
+    int msb = idx / 4 + 1;
+    return (double)((uint64_t)(4 + idx % 4) << (msb - 2));
+}
+
+void stats_record(Stats *s, StatHistId id, uint64_t us) {
+    StatHist *h = &s->h[id];
+    __atomic_fetch_add(&h->count,  1,  __ATOMIC_RELAXED);
+    __atomic_fetch_add(&h->sum_us, us, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&h->bucket[bucket_of(us)], 1, __ATOMIC_RELAXED);
+
+    uint64_t m = __atomic_load_n(&h->max_us, __ATOMIC_RELAXED);
+    while (us > m &&
+           !__atomic_compare_exchange_n(&h->max_us, &m, us, 1,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        ;
+}
+
+uint64_t stats_since(Stats *s, StatHistId id, uint64_t t0) {
+    uint64_t now = stats_now_us();
+    stats_record(s, id, now > t0 ? now - t0 : 0);
+    return now;
+}
+
+double stats_percentile(const StatHist *h, double p) {
+    uint64_t n = __atomic_load_n(&h->count, __ATOMIC_RELAXED);
+    if (n == 0) return 0.0;
+    uint64_t want = (uint64_t)(p * (double)n + 0.5);
+    if (want < 1) want = 1;
+    uint64_t acc = 0;
+    for (int i = 0; i < STATS_BUCKETS; i++) {
+        acc += __atomic_load_n(&h->bucket[i], __ATOMIC_RELAXED);
+        if (acc >= want)
+            return i + 1 < STATS_BUCKETS ? bucket_lo(i + 1) : bucket_lo(i);
+    }
+    return (double)h->max_us;
+}
+
+const char *stats_hist_name   (StatHistId id)    { return HIST_NAMES[id]; }
+const char *stats_counter_name(StatCounterId id) { return COUNTER_NAMES[id]; }
+
+void stats_write_json(FILE *fp, const Stats *s) {
+    fprintf(fp, "{\"counters\":{");
+    for (int i = 0; i < STAT_C_COUNT; i++)
+        fprintf(fp, "%s\"%s\":%llu", i ? "," : "", COUNTER_NAMES[i],
+                (unsigned long long)stats_get(s, (StatCounterId)i));
+    fprintf(fp, "},\"latency_us\":{");
+    int first = 1;
+    for (int i = 0; i < STAT_H_COUNT; i++) {
+        const StatHist *h = &s->h[i];
+        uint64_t n = h->count;
+        if (n == 0) continue;
+        fprintf(fp, "%s\"%s\":{\"n\":%llu,\"mean\":%.1f,\"p50\":%.0f,"
+                    "\"p90\":%.0f,\"p99\":%.0f,\"p999\":%.0f,\"max\":%llu}",
+                first ? "" : ",", HIST_NAMES[i], (unsigned long long)n,
+                (double)h->sum_us / (double)n,
+                stats_percentile(h, 0.50), stats_percentile(h, 0.90),
+                stats_percentile(h, 0.99), stats_percentile(h, 0.999),
+                (unsigned long long)h->max_us);
+        first = 0;
+    }
+    fprintf(fp, "}}");
+}
@@ -0,0 +1,250 @@
+/* sweep.c — Geniş bant tarama zamanlayıcısı + panoramik birleştirme */
+#include "sweep.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#define SWEEP_F_MIN   24000000u
+#define SWEEP_F_MAX 1766000000u
+
+/* ── Yardımcı: adım planı + bin ağırlıkları ───────────────────── */
+static void sweep_plan(Sweep *w) {
+    double sr     = (double)w->sample_rate;
+    double usable = sr * SWEEP_USABLE;
+    double step   = usable - sr * SWEEP_OVERLAP;
+    double lo     = w->f_start + usable / 2.0;
+    double hi     = w->f_stop  - usable / 2.0;
+
+    if (hi <= lo) {
+        /* Aralık tek adıma sığıyor */
+        w->n_hops  = 1;
+        w->hops[0] = (uint32_t)((w->f_start + (double)w->f_stop) / 2.0);
+        step = usable;
+    } else {
+        int n = (int)ceil((hi - lo) / step) + 1;
+        if (n > SWEEP_MAX_HOPS) {
+            /* Çok geniş aralık: üst sınırı kırp */
+            n  = SWEEP_MAX_HOPS;
+            hi = lo + step * (n - 1);
+            w->f_stop = (uint32_t)(hi + usable / 2.0);
+        }
+        /* Adımları eşit aralıkla dağıt; gerçek adım ≤ step → örtüşme ≥ SWEEP_OVERLAP */
+        step = (hi - lo) / (n - 1);
+        w->n_hops = n;
+        for (int i = 0; i < n; i++)
+            w->hops[i] = (uint32_t)(lo + step * i + 0.5);
+    }
+
+    /*
+     * Ağırlık: kullanılabilir bandın ortası 1, örtüşme bölgesinde kenara
+     * doğru doğrusal olarak 0'a iner. Komşu adımların rampaları tam
+     * üst üste bindiği için ağırlık toplamı her yerde ~1 olur.
+     */
+    double edge = usable / 2.0;
+    double ramp = usable - step;
+    if (ramp < 1.0) ramp = 1.0;
+    double bin_hz = sr / FFT_SIZE;
+    for (int k = 0; k < FFT_SIZE; k++) {
+        double a = fabs((k + 0.5 - FFT_SIZE / 2) * bin_hz);
+        if (a >= edge)             w->weight[k] = 0.0f;
+        else if (a <= edge - ramp) w->weight[k] = 1.0f;
+        else                       w->weight[k] = (float)((edge - a) / ramp);
+    }
+    /* DC sivri ucu her adımın merkezinde çıkar: panoramaya taşınmasın */
+    for (int k = FFT_SIZE / 2 - 1; k <= FFT_SIZE / 2 + 1; k++)
+        w->weight[k] = 0.0f;
+
+    /* Panoramik çözünürlük FFT bin genişliğinden ince olmasın (boşluk kalmasın) */
+    int nb = (int)((w->f_stop - (double)w->f_start) / bin_hz);
+    if (nb > SWEEP_PANO_BINS) nb = SWEEP_PANO_BINS;
+    if (nb < 1) nb = 1;
+    w->n_bins = nb;
+
+    /*
+     * Bekleme süresi: yeniden ayar kaybı (settle) toplam adım süresinin
+     * %25'ini geçmesin → dwell ≥ 3 × settle.
+     */
+    if (w->dwell_blocks < 3 * w->settle_blocks) w->dwell_blocks = 3 * w->settle_blocks;
+    if (w->dwell_blocks < SWEEP_MIN_DWELL)      w->dwell_blocks = SWEEP_MIN_DWELL;
+}
+
+static int hop_index(const Sweep *w) {
+    return (w->dir > 0) ? w->hop_pos : w->n_hops - 1 - w->hop_pos;
+}
+
+/* Geçerli adıma ayarla; frekans değişmediyse settle atlanır */
+static void tune_current(Sweep *w) {
+    uint32_t f = w->hops[hop_index(w)];
+    w->acc_n = 0;
+    memset(w->acc, 0, sizeof(w->acc));
+    if (f == w->cur_freq) { w->skip = 0; return; }
+    w->cur_freq = f;
+    w->retunes++;
+    w->want_gen = w->tune ? w->tune(f, w->tune_ud) : 0;
+    w->skip     = w->want_gen ? 0 : w->settle_blocks;
+}
+
+static void pano_reset(Sweep *w) {
+    memset(w->pano_pwr, 0, sizeof(float) * w->n_bins);
+    memset(w->pano_w,   0, sizeof(float) * w->n_bins);
+    memset(w->pano_max, 0, sizeof(float) * w->n_bins);
+    w->sweep_samples = 0;
+    w->skipped_cur   = 0;
+}
+
+/*
+ * Ortalanmış adım spektrumunu panoramik tampona ekle: ağırlıklı ortalama
+ * (taban) ve ağırlığı sıfır olmayan binlerin en büyüğü (taşıyıcılar)
+ */
+static void commit_hop(Sweep *w) {
+    double sr     = (double)w->sample_rate;
+    double bin_hz = sr / FFT_SIZE;
+    double f0     = (double)w->cur_freq - sr / 2.0 + bin_hz / 2.0 - w->f_start;
+    double scale  = w->n_bins / ((double)w->f_stop - w->f_start);
+    float  inv    = 1.0f / (float)w->acc_n;
+
+    for (int k = 0; k < FFT_SIZE; k++) {
+        float wt = w->weight[k];
+        if (wt <= 0.0f) continue;
+        int j = (int)floor((f0 + k * bin_hz) * scale);
+        if (j < 0 || j >= w->n_bins) continue;
+        float p = w->acc[k] * inv;
+        w->pano_pwr[j] += wt * p;
+        w->pano_w[j]   += wt;
+        if (p > w->pano_max[j]) w->pano_max[j] = p;
+    }
+}
+
+/* Tamamlanan taramayı dB'ye çevirip yayınla (cs tutulurken çağrılır) */
+static void publish_sweep(Sweep *w) {
+    float last = -100.0f, last_mean = 1e-10f;
+    for (int j = 0; j < w->n_bins; j++) {
+        if (w->pano_w[j] > 0.0f) {
+            last      = 10.0f * log10f(w->pano_max[j] + 1e-10f);
+            last_mean = w->pano_pwr[j] / w->pano_w[j];
+        }
+        w->pano_db[j]   = last;   /* kapsanmayan bin: soldaki değeri tekrarla */
+        w->pano_mean[j] = last_mean;
+    }
+    w->settle_skipped = w->skipped_cur;
+    w->sweep_s    = (double)w->sweep_samples / w->sample_rate;
+    w->rate_mhz_s = (w->sweep_s > 0.0)
+        ? ((double)w->f_stop - w->f_start) / 1e6 / w->sweep_s : 0.0;
+    w->sweeps++;
+    w->fresh = 1;
+}
+
+/* ── Genel API ────────────────────────────────────────────────── */
+void sweep_init(Sweep *w, SweepTuneFn tune, void *userdata) {
+    memset(w, 0, sizeof(*w));
+    w->tune          = tune;
+    w->tune_ud       = userdata;
+    w->settle_blocks = SWEEP_SETTLE_BLOCKS;
+    w->dwell_blocks  = SWEEP_MIN_DWELL;
+    w->dir           = 1;
+    mutex_init(&w->cs);
+}
+
+void sweep_free(Sweep *w) {
+    w->active = 0;
+    mutex_free(&w->cs);
+}
+
+int sweep_start(Sweep *w, uint32_t f_start, uint32_t f_stop, uint32_t sample_rate) {
+    if (f_start > f_stop) { uint32_t t = f_start; f_start = f_stop; f_stop = t; }
+    if (f_start < SWEEP_F_MIN) f_start = SWEEP_F_MIN;
+    if (f_stop  > SWEEP_F_MAX) f_stop  = SWEEP_F_MAX;
+    if (f_stop <= f_start || sample_rate == 0) return -1;
+
+    mutex_lock(&w->cs);
+    w->f_start     = f_start;
+    w->f_stop      = f_stop;
+    w->sample_rate = sample_rate;
+    sweep_plan(w);
+    pano_reset(w);
+    w->hop_pos  = 0;
+    w->dir      = 1;
+    w->cur_freq = 0;
+    w->sweeps   = 0;
+    w->retunes  = 0;
+    w->want_gen = 0;
+    w->fresh    = 0;
+    w->active   = 1;
+    tune_current(w);
+    mutex_unlock(&w->cs);
+
+    printf("[SWEEP] %.3f - %.3f MHz, %d adim, dwell=%d settle=%d blok\n",
+           w->f_start / 1e6, w->f_stop / 1e6, w->n_hops,
+           w->dwell_blocks, w->settle_blocks);
+    return 0;
+}
+
+void sweep_stop(Sweep *w) {
+    mutex_lock(&w->cs);
+    w->active = 0;
+    mutex_unlock(&w->cs);
+    printf("[SWEEP] Tarama durduruldu (%u tarama, %u yeniden ayar)\n",
+           w->sweeps, w->retunes);
+}
+
+void sweep_feed(Sweep *w, const uint8_t *raw, const SdrBlockMeta *meta) {
+    if (!w->active) return;
+
+    mutex_lock(&w->cs);
+    if (!w->active) { mutex_unlock(&w->cs); return; }
+
+    w->sweep_samples += FFT_SIZE;
+    int stale = w->want_gen ? (meta->gen < w->want_gen || meta->settling)
+                            : (w->skip > 0);
+    if (stale) {
+        if (w->skip > 0) w->skip--;
+        w->skipped_cur++;
+        mutex_unlock(&w->cs);
+        return;
+    }
+
+    float pwr[FFT_SIZE];
+    fft_compute_power(raw, pwr);
+    for (int k = 0; k < FFT_SIZE; k++) w->acc[k] += pwr[k];
+
+    if (++w->acc_n >= w->dwell_blocks) {
+        commit_hop(w);
+        if (++w->hop_pos >= w->n_hops) {
+            publish_sweep(w);
+            pano_reset(w);
+            w->hop_pos = 0;
+            w->dir     = -w->dir;   /* yılan düzeni: geri dönüş atlaması yok */
+        }
+        tune_current(w);
+    }
+    mutex_unlock(&w->cs);
+}
+
+int sweep_pop_row(Sweep *w, float *out, float *mean, int n_out) {
+    int got = 0;
+    mutex_lock(&w->cs);
+    if (w->fresh) {
+        int nb = w->n_bins;
+        for (int c = 0; c < n_out; c++) {
+            int j0 = (int)((int64_t)c       * nb / n_out);
+            int j1 = (int)((int64_t)(c + 1) * nb / n_out);
+            if (j1 <= j0) j1 = j0 + 1;
+            float m = w->pano_db[j0], sum = 0.0f;
+            for (int j = j0 + 1; j < j1; j++)
+                if (w->pano_db[j] > m) m = w->pano_db[j];
+            out[c] = m;
+            if (!mean) continue;
+            for (int j = j0; j < j1; j++) sum += w->pano_mean[j];
+            mean[c] = 10.0f * log10f(sum / (j1 - j0) + 1e-10f);
+        }
+        w->fresh = 0;
+        got = 1;
+    }
+    mutex_unlock(&w->cs);
+    return got;
+}
+
+float sweep_progress(const Sweep *w) {
+    if (!w->active || w->n_hops == 0) return 0.0f;
+    return (float)w->hop_pos / (float)w->n_hops;
+}
@@ -0,0 +1,186 @@
+/* thread.c — Taşınabilir thread katmanı (Win32 / pthread) */
+#ifndef _WIN32
+#define _GNU_SOURCE            /* pthread_setaffinity_np, CPU_SET */
+#endif
+#include "thread.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <sched.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+/* Thread'e seçenekleri taşıyan başlangıç paketi (thread içinde serbest bırakılır) */
+typedef struct {
+    ThreadFn   fn;
+    void      *arg;
+    ThreadOpts opts;
+} ThreadBoot;
+
+/* ── Seçenekler ───────────────────────────────────────────────── */
+void thread_apply_opts(const ThreadOpts *o) {
+    if (!o) return;
+#ifdef _WIN32
+    if (o->cpu >= 0)
+        SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << o->cpu);
+    if (o->rt_prio > 0)
+        SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL);
+#else
+    if (o->cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(o->cpu, &set);
+        int rc = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        if (rc != 0)
+            fprintf(stderr, "[THR] Cekirdek %d'e sabitlenemedi: %s\n",
+                    o->cpu, strerror(rc));
+    }
+    if (o->rt_prio > 0) {
+        struct sched_param sp;
+        memset(&sp, 0, sizeof(sp));
+        sp.sched_priority = o->rt_prio;
+        int rc = pthread_setschedparam(pthread_self(), SCHED_FIFO, &sp);
+        if (rc != 0)
+            fprintf(stderr, "[THR] SCHED_FIFO %d reddedildi (%s); "
+                    "CAP_SYS_NICE ya da rtprio limiti gerekli\n",
+                    o->rt_prio, strerror(rc));
+    }
+#endif
+}
+
+/* ── Thread ───────────────────────────────────────────────────── */
+#ifdef _WIN32
+static DWORD WINAPI thread_boot(LPVOID p) {
+#else
+static void *thread_boot(void *p) {
+#endif
+    ThreadBoot b = *(ThreadBoot *)p;
+    free(p);
+    thread_apply_opts(&b.opts);
+    b.fn(b.arg);
+    return 0;
+}
+
+int thread_start(Thread *t, ThreadFn fn, void *arg, const ThreadOpts *opts) {
+    ThreadBoot *b = malloc(sizeof(*b));
+    if (!b) return -1;
+    b->fn  = fn;
+    b->arg = arg;
+    b->opts.cpu     = opts ? opts->cpu     : -1;
+    b->opts.rt_prio = opts ? opts->rt_prio : 0;
+#ifdef _WIN32
+    t->h = CreateThread(NULL, 0, thread_boot, b, 0, NULL);
+    if (!t->h) { free(b); return -1; }
+#else
+    if (pthread_create(&t->t, NULL, thread_boot, b) != 0) {
+        t->live = 0;
+        free(b);
+        return -1;
+    }
+    t->live = 1;
+#endif
+    return 0;
+}
+
+void thread_join(Thread *t) {
+#ifdef _WIN32
+    if (!t->h) return;
+    WaitForSingleObject(t->h, INFINITE);
+    CloseHandle(t->h);
+    t->h = NULL;
+#else
+    if (!t->live) return;
+    pthread_join(t->t, NULL);
+    t->live = 0;
+#endif
+}
+
+void sleep_ms(uint32_t ms) {
+#ifdef _WIN32
+    Sleep(ms);
+#else
+    struct timespec ts = { ms / 1000u, (long)(ms % 1000u) * 1000000L };
+    while (nanosleep(&ts, &ts) != 0 && errno == EINTR)
+        ;
+#endif
+}
+
+int cpu_count(void) {
+#ifdef _WIN32
+    SYSTEM_INFO si;
+    GetSystemInfo(&si);
+    return si.dwNumberOfProcessors > 0 ? (int)si.dwNumberOfProcessors : 1;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+#endif
+}
+
+uint64_t wall_ms(void) {
+#ifdef _WIN32
+    /* FILETIME: 1601'den beri 100 ns */
+    FILETIME ft;
+    GetSystemTimeAsFileTime(&ft);
+    uint64_t t = ((uint64_t)ft.dwHighDateTime << 32) | ft.dwLowDateTime;
+    return t / 10000u - 11644473600000ull;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (uint64_t)ts.tv_sec * 1000u + (uint64_t)ts.tv_nsec / 1000000u;
+#endif
+}
+
+/* ── Kilit ────────────────────────────────────────────────────── */
+#ifdef _WIN32
+void mutex_init  (Mutex *m) { InitializeCriticalSection(&m->cs); }
+void mutex_free  (Mutex *m) { DeleteCriticalSection(&m->cs); }
+void mutex_lock  (Mutex *m) { EnterCriticalSection(&m->cs); }
+void mutex_unlock(Mutex *m) { LeaveCriticalSection(&m->cs); }
+#else
+void mutex_init(Mutex *m) {
+    pthread_mutexattr_t a;
+    pthread_mutexattr_init(&a);
+    pthread_mutexattr_settype(&a, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&m->m, &a);
+    pthread_mutexattr_destroy(&a);
+}
+void mutex_free  (Mutex *m) { pthread_mutex_destroy(&m->m); }
+void mutex_lock  (Mutex *m) { pthread_mutex_lock(&m->m); }
+void mutex_unlock(Mutex *m) { pthread_mutex_unlock(&m->m); }
+#endif
+
+/* ── Koşul değişkeni ──────────────────────────────────────────── */
+#ifdef _WIN32
+void cond_init     (Cond *c) { InitializeConditionVariable(&c->cv); }
+void cond_free     (Cond *c) { (void)c; }
+void cond_signal   (Cond *c) { WakeConditionVariable(&c->cv); }
+void cond_broadcast(Cond *c) { WakeAllConditionVariable(&c->cv); }
+
+int cond_wait_ms(Cond *c, Mutex *m, uint32_t ms) {
+    return SleepConditionVariableCS(&c->cv, &m->cs, ms) ? 1 : 0;
+}
+#else
+void cond_init(Cond *c) {
+    pthread_condattr_t a;
+    pthread_condattr_init(&a);
+    pthread_condattr_setclock(&a, CLOCK_MONOTONIC);
+    pthread_cond_init(&c->c, &a);
+    pthread_condattr_destroy(&a);
+}
+void cond_free     (Cond *c) { pthread_cond_destroy(&c->c); }
+void cond_signal   (Cond *c) { pthread_cond_signal(&c->c); }
+void cond_broadcast(Cond *c) { pthread_cond_broadcast(&c->c); }
+
+int cond_wait_ms(Cond *c, Mutex *m, uint32_t ms) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    ts.tv_sec  += ms / 1000u;
+    ts.tv_nsec += (long)(ms % 1000u) * 1000000L;
+    if (ts.tv_nsec >= 1000000000L) { ts.tv_sec++; ts.tv_nsec -= 1000000000L; }
+    return pthread_cond_timedwait(&c->c, &m->m, &ts) == 0;
+}
+#endif
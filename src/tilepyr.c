@@ -0,0 +1,176 @@
+/* tilepyr.c — Döşeme piramidi: dosya eşleme, düzen ve görünüm okuma */
+#include "tilepyr.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+/* ── Dosya eşleme ─────────────────────────────────────────────── */
+int filemap_open(FileMap *m, const char *path, uint64_t create_size) {
+    memset(m, 0, sizeof(*m));
+    int rw = create_size != 0;
+#ifdef _WIN32
+    HANDLE hf = CreateFileA(path, rw ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ,
+                            FILE_SHARE_READ, NULL, rw ? CREATE_ALWAYS : OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hf == INVALID_HANDLE_VALUE) return -1;
+    LARGE_INTEGER sz;
+    if (rw) sz.QuadPart = (LONGLONG)create_size;
+    else if (!GetFileSizeEx(hf, &sz) || sz.QuadPart == 0) { CloseHandle(hf); return -1; }
+    /* Yazılabilir eşleme dosyayı istenen boya büyütür */
+    HANDLE hm = CreateFileMappingA(hf, NULL, rw ? PAGE_READWRITE : PAGE_READONLY,
+                                   (DWORD)(sz.QuadPart >> 32), (DWORD)sz.QuadPart, NULL);
+    void *p = hm ? MapViewOfFile(hm, rw ? FILE_MAP_ALL_ACCESS : FILE_MAP_READ, 0, 0, 0)
+                 : NULL;
+    if (!p) {
+        if (hm) CloseHandle(hm);
+        CloseHandle(hf);
+        return -1;
+    }
+    m->h_file = hf;
+    m->h_map  = hm;
+    m->size   = (uint64_t)sz.QuadPart;
+#else
+    int fd = open(path, rw ? O_RDWR | O_CREAT | O_TRUNC : O_RDONLY, 0644);
+    if (fd < 0) return -1;
+    struct stat st;
+    if (rw ? ftruncate(fd, (off_t)create_size) != 0
+           : (fstat(fd, &st) != 0 || st.st_size == 0)) {
+        close(fd);
+        return -1;
+    }
+    m->size = rw ? create_size : (uint64_t)st.st_size;
+    void *p = mmap(NULL, m->size, rw ? PROT_READ | PROT_WRITE : PROT_READ,
+                   MAP_SHARED, fd, 0);
+    close(fd);   /* eşleme dosyayı açık tutar */
+    if (p == MAP_FAILED) return -1;
+#endif
+    m->base = p;
+    return 0;
+}
+
+void filemap_close(FileMap *m) {
+    if (!m->base) return;
+#ifdef _WIN32
+    UnmapViewOfFile(m->base);
+    CloseHandle(m->h_map);
+    CloseHandle(m->h_file);
+#else
+    munmap(m->base, m->size);
+#endif
+    memset(m, 0, sizeof(*m));
+}
+
+/* ── Düzen ────────────────────────────────────────────────────── */
+void pyr_layout(PyrHeader *h, uint64_t rows0, uint32_t fft_size) {
+    memset(h, 0, sizeof(*h));
+    h->magic    = PYR_MAGIC;
+    h->version  = PYR_VERSION;
+    h->fft_size = fft_size;
+
+    uint64_t rows = rows0 ? rows0 : 1;
+    uint32_t bins = fft_size;
+    uint64_t off  = PYR_DATA_OFF;
+    for (int lv = 0; lv < PYR_MAX_LEVELS; lv++) {
+        PyrLevel *L = &h->level[lv];
+        L->rows   = rows;
+        L->bins   = bins;
+        L->tile_w = bins < PYR_TILE_BINS ? bins : PYR_TILE_BINS;
+        L->off    = off;
+        uint64_t tile_rows = (rows + PYR_TILE_ROWS - 1) / PYR_TILE_ROWS;
+        off += (tile_rows * PYR_TILE_ROWS * bins + 4095u) & ~(uint64_t)4095u;
+        h->n_levels = (uint32_t)lv + 1;
+
+        /* Tek döşeme satırına sığınca genel görünüm hazır */
+        if (rows <= PYR_TILE_ROWS) break;
+        rows = (rows + 1) / 2;
+        if (bins > PYR_MIN_BINS) bins /= 2;
+    }
+    h->total_bytes = off;
+}
+
+/* ── Okuyucu ──────────────────────────────────────────────────── */
+int pyr_open(TilePyr *p, const char *path) {
+    memset(p, 0, sizeof(*p));
+    if (filemap_open(&p->map, path, 0) != 0) {
+        fprintf(stderr, "[PYR] Dosya acilamadi: %s\n", path);
+        return -1;
+    }
+    const PyrHeader *h = (const PyrHeader *)p->map.base;
+    if (p->map.size < PYR_DATA_OFF || h->magic != PYR_MAGIC ||
+        h->version != PYR_VERSION || h->n_levels == 0 ||
+        h->n_levels > PYR_MAX_LEVELS || h->total_bytes > p->map.size) {
+        fprintf(stderr, "[PYR] Gecersiz ya da eksik piramit: %s\n", path);
+        filemap_close(&p->map);
+        return -1;
+    }
+    p->hdr = h;
+    printf("[PYR] %s: %llu satir x %u bin, %u duzey, %.1f MB\n", path,
+           (unsigned long long)h->level[0].rows, h->fft_size, h->n_levels,
+           h->total_bytes / 1048576.0);
+    return 0;
+}
+
+void pyr_close(TilePyr *p) {
+    filemap_close(&p->map);
+    p->hdr = NULL;
+}
+
+#define PYR_PIX_CELLS 32.0   /* piksel başına okunacak en çok hücre (yaklaşık) */
+
+void pyr_render(const TilePyr *p, double t0, double t1, double b0, double b1,
+                int w, int h, uint8_t *out) {
+    const PyrHeader *hd = p->hdr;
+    double rpp = (t1 - t0) / h, bpp = (b1 - b0) / w;
+
+    /* Piksel başına hücre bütçesini aşmayan en ince düzey */
+    int lv = 0;
+    for (; lv + 1 < (int)hd->n_levels; lv++) {
+        double rs = rpp / (double)(1u << lv);
+        double bs = bpp * hd->level[lv].bins / hd->fft_size;
+        if ((rs > 1.0 ? rs : 1.0) * (bs > 1.0 ? bs : 1.0) <= PYR_PIX_CELLS) break;
+    }
+    const PyrLevel *L  = &hd->level[lv];
+    double          tf = 1.0 / (double)(1u << lv);
+    double          bf = (double)L->bins / hd->fft_size;
+    uint8_t        *base = p->map.base;
+
+    uint32_t *xa = malloc(sizeof(uint32_t) * 2 * (size_t)w);
+    if (!xa) { memset(out, 0, (size_t)w * h); return; }
+    uint32_t *xb = xa + w;
+    for (int x = 0; x < w; x++) {
+        double a = (b0 + x * bpp) * bf, b = (b0 + (x + 1) * bpp) * bf;
+        if (b <= 0.0 || a >= L->bins) { xa[x] = xb[x] = 0; continue; }   /* bant dışı */
+        if (a < 0.0) a = 0.0;
+        if (b > L->bins) b = L->bins;
+        xa[x] = (uint32_t)a;
+        xb[x] = (uint32_t)b > xa[x] ? (uint32_t)b : xa[x] + 1;
+    }
+
+    for (int y = 0; y < h; y++) {
+        uint8_t *o = out + (size_t)y * w;
+        double   a = (t0 + y * rpp) * tf, b = (t0 + (y + 1) * rpp) * tf;
+        if (a < 0.0 || a >= (double)L->rows) { memset(o, 0, (size_t)w); continue; }
+        uint64_t ra = (uint64_t)a, rb = (uint64_t)b;
+        if (rb <= ra) rb = ra + 1;
+        if (rb > L->rows) rb = L->rows;
+        for (int x = 0; x < w; x++) {
+            uint8_t m = 0;
+            for (uint64_t r = ra; r < rb; r++)
+                for (uint32_t k = xa[x]; k < xb[x]; k++) {
+                    uint8_t v = *pyr_cell_ptr(base, hd, lv, r, k);
+                    if (v > m) m = v;
+                }
+            o[x] = m;
+        }
+    }
+    free(xa);
+}
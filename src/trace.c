@@ -0,0 +1,67 @@
+/* trace.c — Kalıcı spektrum izleri (max/min/EMA/tepe-düşüş) */
+#include "trace.h"
+#include <math.h>
+#include <string.h>
+
+void trace_init(TraceSet *t) {
+    memset(t, 0, sizeof(*t));
+    t->tau_s      = 1.0f;
+    t->decay_db_s = 10.0f;
+    t->shown      = 0;
+}
+
+void trace_reset(TraceSet *t) {
+    t->seeded = 0;
+    t->rows   = 0;
+}
+
+/*
+ * Tek geçişte dört iz. restrict parametreler derleyiciye takma ad (alias)
+ * olmadığını söyler; -O2'de de sürüm kontrolü olmadan SIMD'e çevrilir.
+ */
+static void trace_kernel(float *restrict mx, float *restrict mn,
+                         float *restrict av, float *restrict pk,
+                         const float *restrict x, float a, float decay) {
+    for (int k = 0; k < FFT_SIZE; k++) {
+        float v = x[k];
+        float p = pk[k] - decay;
+        mx[k] = v > mx[k] ? v : mx[k];
+        mn[k] = v < mn[k] ? v : mn[k];
+        av[k] = av[k] + a * (v - av[k]);
+        pk[k] = v > p ? v : p;
+    }
+}
+
+void trace_update(TraceSet *t, const float *psd, float dt_s) {
+    if (!t->seeded) {
+        memcpy(t->max_db,  psd, sizeof(t->max_db));
+        memcpy(t->min_db,  psd, sizeof(t->min_db));
+        memcpy(t->avg_db,  psd, sizeof(t->avg_db));
+        memcpy(t->peak_db, psd, sizeof(t->peak_db));
+        t->seeded = 1;
+        t->rows   = 1;
+        return;
+    }
+
+    /* Satır başına bir kez: EMA katsayısı ve düşüş miktarı */
+    float a     = (t->tau_s > 0.0f) ? 1.0f - expf(-dt_s / t->tau_s) : 1.0f;
+    float decay = t->decay_db_s * dt_s;
+
+    trace_kernel(t->max_db, t->min_db, t->avg_db, t->peak_db, psd, a, decay);
+    t->rows++;
+}
+
+const float *trace_get(const TraceSet *t, TraceKind k) {
+    switch (k) {
+    case TRACE_MAX:  return t->max_db;
+    case TRACE_MIN:  return t->min_db;
+    case TRACE_AVG:  return t->avg_db;
+    case TRACE_PEAK: return t->peak_db;
+    default:         return NULL;
+    }
+}
+
+const char *trace_name(TraceKind k) {
+    static const char *names[TRACE_COUNT] = { "Max", "Min", "Ort", "Tepe" };
+    return (k >= 0 && k < TRACE_COUNT) ? names[k] : "";
+}
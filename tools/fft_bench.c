@@ -0,0 +1,271 @@
+/*
+ * fft_bench.c — Sabit noktalı FFT yolunun float yola göre doğruluğu ve hızı,
+ *               büyük FFT'nin (bigfft.h) doğruluğu ve dönüşüm süresi
+ *
+ *   fft_bench            doğruluk tablosu + blok/s karşılaştırması, 2^20 büyük FFT
+ *   fft_bench 5          ölçüm süresi 5 s (yol başına)
+ *   fft_bench 2 18 4     büyük FFT 2^18 nokta, 4 thread (varsayılan tüm çekirdekler)
+ *
+ * Doğruluk: her deneme sinyali (tek ton, iki ton, zayıf ton + gürültü,
+ * doymuş giriş, sessizlik) iki yoldan geçirilir; tepe bininden en çok
+ * 20 dB ve 20-60 dB aşağıdaki binlerde dB farkının en büyüğü ile RMS'i
+ * yazılır. Tepe bini farklıysa ya da fark 0.05 dB / 1 dB sınırını aşarsa
+ * çıkış kodu 1'dir. Hız: fft_compute_power blok/s (DSP thread'inin blok
+ * başına yaptığı iş) ve ortalanmış satırın dB'ye çevrilmesi (log10f ile
+ * tablo; fark 0.02 dB'yi aşarsa çıkış kodu 1).
+ *
+ * Büyük FFT: rastgele girişin birkaç bin'i doğrudan DFT (long double) ile
+ * karşılaştırılır (göreli hata BIG_ERR'i aşarsa çıkış kodu 1); ardından
+ * ham IQ → güç dönüşümünün süresi bir ekran karesiyle (60 Hz) ve satırın
+ * kapsadığı örnek süresiyle (2.048 MS/s'de gerçek zaman sınırı) kıyaslanır.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "fft.h"
+#include "fftq.h"
+#include "bigfft.h"
+#include "thread.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define DYN_NEAR 20.0f    /* tepeye yakın binler ... */
+#define ERR_NEAR 0.05f    /* ... için kabul sınırı (dB) */
+#define DYN_DB   60.0f    /* karşılaştırılan toplam dinamik aralık */
+#define ERR_DEEP 1.00f    /* 20-60 dB aşağıdaki binler için sınır */
+#define BIG_ERR  1e-5     /* büyük FFT: bin hatası / bin RMS'i */
+#define FRAME_MS (1000.0 / 60.0)
+
+static uint32_t s_rng = 12345u;
+
+static float frand(void) {   /* [-1, 1) */
+    s_rng = s_rng * 1664525u + 1013904223u;
+    return (float)(s_rng >> 8) / 8388608.0f - 1.0f;
+}
+
+static uint8_t to_u8(float v) {
+    float s = 127.5f + v * 127.5f;
+    if (s < 0.0f)   s = 0.0f;
+    if (s > 255.0f) s = 255.0f;
+    return (uint8_t)lrintf(s);
+}
+
+/* Tonlar (bin, genlik) + gürültü; genlik 1.0 tam ölçek */
+static void make_block(uint8_t *raw, const float *bin, const float *amp, int n_tone,
+                       float noise) {
+    for (int n = 0; n < FFT_SIZE; n++) {
+        float i = noise * frand(), q = noise * frand();
+        for (int t = 0; t < n_tone; t++) {
+            float ph = 2.0f * (float)M_PI * bin[t] * n / FFT_SIZE;
+            i += amp[t] * cosf(ph);
+            q += amp[t] * sinf(ph);
+        }
+        raw[2*n]     = to_u8(i);
+        raw[2*n + 1] = to_u8(q);
+    }
+}
+
+static int peak_bin(const float *db) {
+    int p = 0;
+    for (int k = 1; k < FFT_SIZE; k++) if (db[k] > db[p]) p = k;
+    return p;
+}
+
+/*
+ * İki yolun PSD'sini karşılaştır; başarısızsa 1.
+ * Tepeye yakın binler (DYN_NEAR dB) sıkı, derindekiler (DYN_DB dB) gevşek
+ * sınırla ölçülür: int16 yuvarlama gürültüsü tepe altında ~75-80 dB'dedir.
+ */
+static int compare(const char *name, const uint8_t *raw) {
+    float ref[FFT_SIZE], fix[FFT_SIZE];
+    fft_set_fixed(0); fft_compute_psd(raw, ref);
+    fft_set_fixed(1); fft_compute_psd(raw, fix);
+
+    int   pr = peak_bin(ref), pf = peak_bin(fix);
+    float near_max = 0.0f, deep_max = 0.0f;
+    double esq = 0.0;
+    int   n = 0;
+    for (int k = 0; k < FFT_SIZE; k++) {
+        float below = ref[pr] - ref[k];
+        if (below > DYN_DB) continue;
+        float e = fabsf(fix[k] - ref[k]);
+        if (below <= DYN_NEAR) { if (e > near_max) near_max = e; }
+        else                   { if (e > deep_max) deep_max = e; }
+        esq += (double)e * e;
+        n++;
+    }
+    float erms = n ? (float)sqrt(esq / n) : 0.0f;
+    int   bad  = (pr != pf) || near_max > ERR_NEAR || deep_max > ERR_DEEP;
+    printf("  %-22s tepe %4d/%4d  %4d bin  max %.3f / %.3f dB  rms %.3f dB  %s\n",
+           name, pr, pf, n, near_max, deep_max, erms, bad ? "HATA" : "ok");
+    return bad;
+}
+
+static double blocks_per_s(int fixed, const uint8_t *raw, int n_blk, double secs) {
+    float  out[FFT_SIZE];
+    long   done = 0;
+    fft_set_fixed(fixed);
+    clock_t t0 = clock(), lim = t0 + (clock_t)(secs * CLOCKS_PER_SEC);
+    while (clock() < lim) {
+        for (int b = 0; b < 256; b++)
+            fft_compute_power(raw + (size_t)(b % n_blk) * FFT_SIZE * 2, out);
+        done += 256;
+    }
+    double el = (double)(clock() - t0) / CLOCKS_PER_SEC;
+    return done / el;
+}
+
+/* Ortalanmış güç satırı → dB (fft_power_db), satır başına ns */
+static double row_db_ns(int fixed, const float *pwr, double secs) {
+    float  out[FFT_SIZE];
+    long   done = 0;
+    fft_set_fixed(fixed);
+    clock_t t0 = clock(), lim = t0 + (clock_t)(secs * CLOCKS_PER_SEC);
+    while (clock() < lim) {
+        for (int r = 0; r < 256; r++)
+            fft_power_db(pwr, 1.0f / (float)(r + 1), out, FFT_SIZE);
+        done += 256;
+    }
+    double el = (double)(clock() - t0) / CLOCKS_PER_SEC;
+    return el * 1e9 / done;
+}
+
+/* Büyük FFT: birkaç bin'de doğrudan DFT ile karşılaştırma + dönüşüm süresi */
+static int bench_big(int log2n, int threads, double secs) {
+    BigFft *b = bigfft_create(log2n, threads);
+    if (!b) return 1;
+    int      n   = bigfft_size(b);
+    FftCpx  *in  = malloc(sizeof(FftCpx) * (size_t)n);
+    FftCpx  *out = malloc(sizeof(FftCpx) * (size_t)n);
+    uint8_t *raw = malloc((size_t)n * 2);
+    float   *pwr = malloc(sizeof(float) * (size_t)n);
+    if (!in || !out || !raw || !pwr) {
+        free(in); free(out); free(raw); free(pwr);
+        bigfft_free(b);
+        return 1;
+    }
+    for (int j = 0; j < n; j++) in[j] = (FftCpx){ frand(), frand() };
+    bigfft_forward(b, in, out);
+
+    /* Rastgele girişte bin RMS'i sqrt(n · 2/3) */
+    const int bins[] = { 0, 1, 7, n / 3, n / 2, n / 2 + 1, n - 5, n - 1 };
+    double emax = 0.0, rms = sqrt(n * 2.0 / 3.0);
+    for (size_t q = 0; q < sizeof(bins) / sizeof(bins[0]); q++) {
+        long double sr = 0.0L, si = 0.0L;
+        for (int j = 0; j < n; j++) {
+            long double a = -2.0L * (long double)M_PI *
+                            (long double)((int64_t)j * bins[q] % n) / n;
+            long double c = cosl(a), s = sinl(a);
+            sr += in[j].r * c - in[j].i * s;
+            si += in[j].r * s + in[j].i * c;
+        }
+        double e = hypot(out[bins[q]].r - (double)sr, out[bins[q]].i - (double)si) / rms;
+        if (e > emax) emax = e;
+    }
+
+    for (int j = 0; j < 2 * n; j++) raw[j] = to_u8(0.3f * frand());
+    double t0 = (double)wall_ms(), t_end = t0 + secs * 1000.0;
+    int    done = 0;
+    do {
+        bigfft_power_u8(b, raw, pwr);
+        done++;
+    } while ((double)wall_ms() < t_end);
+    double ms = ((double)wall_ms() - t0) / done;
+
+    /* Gerçek zaman sınırı: bir satır n örnek sürer (2.048 MS/s'de) */
+    double rt_ms = n / 2.048e3;
+    int bad = emax > BIG_ERR;
+    printf("[BENCH] buyuk FFT 2^%d, %d thread: hata %.2e (%s), %.2f ms/donusum "
+           "(kare %.1f ms: %s; gercek zaman %.0f ms: %s)\n", log2n, bigfft_threads(b),
+           emax, bad ? "HATA" : "ok", ms, FRAME_MS, ms <= FRAME_MS ? "sigar" : "sigmaz",
+           rt_ms, ms <= rt_ms ? "sigar" : "sigmaz");
+    free(in); free(out); free(raw); free(pwr);
+    bigfft_free(b);
+    return bad;
+}
+
+int main(int argc, char *argv[]) {
+    double secs = (argc > 1) ? atof(argv[1]) : 2.0;
+    if (secs <= 0.0) secs = 2.0;
+
+    fft_init();
+#ifdef __SSE2__
+    printf("[BENCH] FFT_SIZE %d, tamsayi yol: SSE2\n", FFT_SIZE);
+#else
+    printf("[BENCH] FFT_SIZE %d, tamsayi yol: tasinabilir C\n", FFT_SIZE);
+#endif
+
+    /* ── Doğruluk ─────────────────────────────────────────────── */
+    static uint8_t raw[FFT_SIZE * 2];
+    int fails = 0;
+    {
+        float b[2] = { 100.0f }, a[2] = { 0.9f };
+        make_block(raw, b, a, 1, 0.0f);
+        fails += compare("tek ton, tam olcek", raw);
+    }
+    {
+        float b[2] = { -200.3f, 317.7f }, a[2] = { 0.5f, 0.05f };
+        make_block(raw, b, a, 2, 0.0f);
+        fails += compare("iki ton, -20 dB fark", raw);
+    }
+    {
+        float b[1] = { 42.5f }, a[1] = { 0.02f };
+        make_block(raw, b, a, 1, 0.05f);
+        fails += compare("zayif ton + gurultu", raw);
+    }
+    {
+        float b[1] = { 7.0f }, a[1] = { 1.6f };   /* kırpılan giriş */
+        make_block(raw, b, a, 1, 0.0f);
+        fails += compare("doymus giris", raw);
+    }
+    {
+        make_block(raw, NULL, NULL, 0, 0.3f);
+        fails += compare("yalniz gurultu", raw);
+    }
+    {
+        make_block(raw, NULL, NULL, 0, 0.0f);
+        fails += compare("sessizlik (127/128)", raw);
+    }
+
+    /* ── Hız ──────────────────────────────────────────────────── */
+    enum { N_BLK = 64 };
+    uint8_t *stream = malloc((size_t)N_BLK * FFT_SIZE * 2);
+    if (!stream) return 1;
+    for (int b = 0; b < N_BLK; b++) {
+        float f[1] = { 50.0f + b }, a[1] = { 0.3f };
+        make_block(stream + (size_t)b * FFT_SIZE * 2, f, a, 1, 0.1f);
+    }
+    double bf = blocks_per_s(0, stream, N_BLK, secs);
+    double bq = blocks_per_s(1, stream, N_BLK, secs);
+    printf("[BENCH] float : %9.0f blok/s  (%.1f MS/s)\n", bf, bf * FFT_SIZE / 1e6);
+    printf("[BENCH] int16 : %9.0f blok/s  (%.1f MS/s)  x%.2f\n",
+           bq, bq * FFT_SIZE / 1e6, bq / bf);
+
+    /* DSP thread'inin satır dB dönüşümü: log10f ve tablo, en büyük fark */
+    {
+        float pwr[FFT_SIZE], ref[FFT_SIZE], fix[FFT_SIZE], err = 0.0f;
+        fft_set_fixed(0);
+        fft_compute_power(stream, pwr);
+        fft_power_db(pwr, 1.0f, ref, FFT_SIZE);
+        fft_set_fixed(1);
+        fft_power_db(pwr, 1.0f, fix, FFT_SIZE);
+        for (int k = 0; k < FFT_SIZE; k++)
+            if (ref[k] > -90.0f && fabsf(fix[k] - ref[k]) > err) err = fabsf(fix[k] - ref[k]);
+        double nf = row_db_ns(0, pwr, secs / 4), nq = row_db_ns(1, pwr, secs / 4);
+        printf("[BENCH] satir dB: log10f %.0f ns, tablo %.0f ns  x%.2f, en buyuk fark %.4f dB\n",
+               nf, nq, nf / nq, err);
+        if (err > 0.02f) fails++;
+    }
+    free(stream);
+
+    int big_log2 = (argc > 2) ? atoi(argv[2]) : BIGFFT_MAX_LOG2;
+    int big_thr  = (argc > 3) ? atoi(argv[3]) : 0;
+    fails += bench_big(big_log2, big_thr, secs);
+
+    printf("[BENCH] Dogruluk: %s\n", fails ? "BASARISIZ" : "tamam");
+    return fails ? 1 : 0;
+}
@@ -0,0 +1,641 @@
+/*
+ * occupancy.c — Kayıtlardan çevrimdışı kanal doluluk / görev döngüsü çözümleyici
+ *
+ *   occupancy -c 145.5:12.5 -c 145.525:12.5 iq_d0_*.bin     → occupancy.csv/.json
+ *   occupancy -g 433.05:434.79:25 -k 8 -o rapor gun1/iq_*.bin 433 MHz ISM, 25 kHz ızgara
+ *   occupancy -p plan.csv -l -15 -a 40 -t 8 kayit.bin         plan dosyası, mutlak eşik
+ *
+ * Kayıtlar belleğe eşlenir; "_marks.csv" dosyasından her ayar bölümünün
+ * merkezi, hızı ve zamanı okunur (oturma süresindeki bloklar atlanır).
+ * Bölümler UNIT_ROWS satırlık işlere bölünüp tüm çekirdeklere dağıtılır.
+ * Satır = avg bloğun doğrusal ortalama gücü (fft_compute_power); kanal
+ * düzeyi kanal bin'lerinin ortalamasıdır (dB / bin, spektrum ölçeği).
+ * Dolu: düzey ≥ satır medyanı (gürültü tabanı) + k dB, ya da -l ile mutlak.
+ *
+ * Her thread kendi kısmi istatistiğini (süre, düzey histogramı, saatlik
+ * doluluk) tutar; iletim sayısı / süresi iş başına ayrı tutulup iş sırasıyla
+ * birleştirilir, böylece işlerin sınırında süren iletim bölünmez.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "fft.h"
+#include "thread.h"
+#include "tilepyr.h"   /* FileMap */
+
+#define ROW_RATE     60      /* varsayılan satır hızı (pipeline PIPE_ROW_RATE) */
+#define OCC_MAX_CH   256
+#define OCC_MAX_FILES 1024
+#define UNIT_ROWS    4096    /* iş başına satır */
+#define OCC_EDGE     0.9     /* bandın kenar %10'u (süzgeç eğimi) gözlenmiş sayılmaz */
+#define HIST_N       256     /* düzey histogramı: 0.5 dB, -40 dB'den */
+#define HIST_DB_MIN  (-40.0)
+#define HIST_DB_STEP 0.5
+
+typedef struct {
+    char   name[32];
+    double f_hz, bw_hz;
+} OccChan;
+
+/* Kayıt içinde aynı ayarlı, kesintisiz bölüm */
+typedef struct {
+    int      file;
+    uint64_t sample0, samples;   /* dosya içi örnek */
+    uint32_t freq, sr;
+    uint32_t avg;                /* satır başına blok */
+    double   t0;                 /* dosya başından saniye */
+    int     *lo, *hi;            /* kanal bin aralığı [lo, hi); lo < 0 gözlenmedi */
+} Seg;
+
+typedef struct {
+    int      seg;
+    uint64_t row0, rows;
+} Unit;
+
+/* İş başına bir kanalın iletimleri: baştaki / sondaki açık iletim ayrı */
+typedef struct {
+    double   lead, tail;         /* s */
+    double   sum, max;           /* tamamı iş içinde kalan iletimler */
+    uint32_t n;
+    int      all;                /* işin tamamı dolu */
+} Runs;
+
+/* Thread başına bir kanalın kısmi istatistiği */
+typedef struct {
+    double obs_s, occ_s;
+    double pwr_s;                /* doğrusal güç × s (ortalama düzey için) */
+    double max_db;
+    double hist[HIST_N];         /* düzey başına s */
+    double hour_obs[24], hour_occ[24];
+} Part;
+
+typedef struct {
+    char     path[512];
+    FileMap  map;
+    int      tod;                /* kayıt başlangıcı, gün içi saniye (-1 bilinmiyor) */
+} InFile;
+
+typedef struct {
+    InFile  *files;
+    int      n_files;
+    Seg     *segs;
+    int      n_segs;
+    Unit    *units;
+    uint64_t n_units;
+    OccChan *ch;
+    int      n_ch;
+    double   rel_db, abs_db;
+    int      use_abs;
+    Runs    *runs;               /* n_units × n_ch */
+    Part    *parts;              /* n_thr × n_ch */
+    volatile uint64_t next, done;
+} Job;
+
+typedef struct {
+    Job *j;
+    int  idx;
+} Worker;
+
+/*
+ * Satır medyanı (quickselect, O(n)): kanal dışı sinyaller bin'lerin
+ * çoğunu kaplamadıkça gürültü tabanı
+ */
+static float row_median(const float *p, float *tmp) {
+    memcpy(tmp, p, sizeof(float) * FFT_SIZE);
+    int lo = 0, hi = FFT_SIZE - 1, k = FFT_SIZE / 2;
+    while (lo < hi) {
+        float piv = tmp[(lo + hi) / 2];
+        int   i = lo, j = hi;
+        while (i <= j) {
+            while (tmp[i] < piv) i++;
+            while (tmp[j] > piv) j--;
+            if (i <= j) {
+                float t = tmp[i];
+                tmp[i++] = tmp[j];
+                tmp[j--] = t;
+            }
+        }
+        if      (k <= j) hi = j;
+        else if (k >= i) lo = i;
+        else break;
+    }
+    return tmp[k];
+}
+
+static void run_unit(Job *j, uint64_t u, Part *pt) {
+    const Unit *un = &j->units[u];
+    const Seg  *sg = &j->segs[un->seg];
+    const InFile *f = &j->files[sg->file];
+    Runs       *rs = &j->runs[u * j->n_ch];
+    float       acc[FFT_SIZE], pwr[FFT_SIZE], tmp[FFT_SIZE];
+    double      cur[OCC_MAX_CH];
+    uint8_t     gap[OCC_MAX_CH];
+    double      dt  = (double)sg->avg * FFT_SIZE / sg->sr;
+    float       inv = 1.0f / (float)sg->avg;
+
+    memset(cur, 0, sizeof(double) * j->n_ch);
+    memset(gap, 0, (size_t)j->n_ch);
+    memset(rs,  0, sizeof(Runs) * j->n_ch);
+
+    for (uint64_t r = un->row0; r < un->row0 + un->rows; r++) {
+        const uint8_t *blk = f->map.base +
+            (sg->sample0 + r * sg->avg * (uint64_t)FFT_SIZE) * 2;
+        memset(acc, 0, sizeof(acc));
+        for (uint32_t b = 0; b < sg->avg; b++, blk += FFT_SIZE * 2) {
+            fft_compute_power(blk, pwr);
+            for (int k = 0; k < FFT_SIZE; k++) acc[k] += pwr[k];
+        }
+        for (int k = 0; k < FFT_SIZE; k++) acc[k] *= inv;
+        double noise = 10.0 * log10(row_median(acc, tmp) + 1e-10);
+        double thr   = j->use_abs ? j->abs_db : noise + j->rel_db;
+
+        double t    = sg->t0 + (double)r * dt;
+        int    hour = f->tod < 0 ? -1 : (int)(fmod(f->tod + t, 86400.0) / 3600.0);
+
+        for (int c = 0; c < j->n_ch; c++) {
+            if (sg->lo[c] < 0) continue;
+            double s = 0.0;
+            for (int k = sg->lo[c]; k < sg->hi[c]; k++) s += acc[k];
+            s /= sg->hi[c] - sg->lo[c];
+            double db = 10.0 * log10(s + 1e-10);
+
+            Part *p = &pt[c];
+            p->obs_s += dt;
+            p->pwr_s += s * dt;
+            if (db > p->max_db) p->max_db = db;
+            int h = (int)((db - HIST_DB_MIN) / HIST_DB_STEP);
+            p->hist[h < 0 ? 0 : h >= HIST_N ? HIST_N - 1 : h] += dt;
+            if (hour >= 0) p->hour_obs[hour] += dt;
+
+            if (db >= thr) {
+                p->occ_s += dt;
+                if (hour >= 0) p->hour_occ[hour] += dt;
+                cur[c] += dt;
+            } else if (cur[c] > 0.0 || !gap[c]) {
+                Runs *q = &rs[c];
+                if (!gap[c])  q->lead = cur[c];
+                else {
+                    q->n++;
+                    q->sum += cur[c];
+                    if (cur[c] > q->max) q->max = cur[c];
+                }
+                cur[c] = 0.0;
+                gap[c] = 1;
+            }
+        }
+    }
+    for (int c = 0; c < j->n_ch; c++) {
+        if (sg->lo[c] < 0) continue;
+        if (!gap[c]) { rs[c].all = 1; rs[c].lead = cur[c]; }
+        rs[c].tail = cur[c];
+    }
+}
+
+static void worker(void *arg) {
+    Worker *w = (Worker *)arg;
+    Job    *j = w->j;
+    for (;;) {
+        uint64_t u = ATOMIC_ADD(&j->next, 1) - 1;
+        if (u >= j->n_units) break;
+        run_unit(j, u, &j->parts[(size_t)w->idx * j->n_ch]);
+        ATOMIC_ADD(&j->done, 1);
+    }
+}
+
+/* ── İletim birleştirme (iş sırasıyla) ───────────────────────── */
+static void runs_close(Runs *tot, double len) {
+    if (len <= 0.0) return;
+    tot->n++;
+    tot->sum += len;
+    if (len > tot->max) tot->max = len;
+}
+
+/* Bölüm sonu: açık iletimleri kapat */
+static void runs_flush(Runs *tot, Runs *a) {
+    if (a->all) runs_close(tot, a->lead);
+    else {
+        runs_close(tot, a->lead);
+        runs_close(tot, a->tail);
+    }
+    tot->n   += a->n;
+    tot->sum += a->sum;
+    if (a->max > tot->max) tot->max = a->max;
+    memset(a, 0, sizeof(*a));
+}
+
+/* a'nın hemen ardından gelen b'yi a'ya kat */
+static void runs_append(Runs *a, const Runs *b) {
+    if (a->all && b->all) {
+        a->lead = a->tail = a->lead + b->lead;
+        return;
+    }
+    if (a->all) {
+        a->lead += b->lead;
+        a->all   = 0;
+    } else {
+        runs_close(a, a->tail + b->lead);
+    }
+    a->tail = b->tail;
+    a->n   += b->n;
+    a->sum += b->sum;
+    if (b->max > a->max) a->max = b->max;
+}
+
+/* ── Girdi: kayıtlar, işaretler, kanal planı ─────────────────── */
+
+/* "iq_<etiket>_YYYYMMDD_HHMMSS.bin" → gün içi saniye */
+static int file_tod(const char *path) {
+    const char *b = strrchr(path, '/'), *b2 = strrchr(path, '\\');
+    if (b2 && (!b || b2 > b)) b = b2;
+    b = b ? b + 1 : path;
+    size_t n = strlen(b);
+    int hh, mm, ss;
+    if (n < 11 || sscanf(b + n - 10, "%2d%2d%2d.bin", &hh, &mm, &ss) != 3 ||
+        b[n - 11] != '_' || hh > 23 || mm > 59 || ss > 59)
+        return -1;
+    return hh * 3600 + mm * 60 + ss;
+}
+
+static Seg *add_seg(Job *j, int *cap) {
+    if (j->n_segs == *cap) {
+        *cap = *cap ? *cap * 2 : 64;
+        Seg *s = realloc(j->segs, sizeof(Seg) * (size_t)*cap);
+        if (!s) return NULL;
+        j->segs = s;
+    }
+    Seg *s = &j->segs[j->n_segs++];
+    memset(s, 0, sizeof(*s));
+    return s;
+}
+
+/*
+ * Dosyayı işaretlere göre bölümlere ayır. Bir "settled" işaretinden önceki
+ * bölüm (start / retune sonrası oturma) atlanır; "gap" zamanı t_us'tan alır.
+ * İşaret yoksa tüm dosya tek bölüm, hız / merkez komut satırından.
+ */
+static int split_file(Job *j, int fi, uint32_t def_freq, uint32_t def_sr, int *cap) {
+    InFile  *f      = &j->files[fi];
+    uint64_t n_samp = f->map.size / 2;
+    char     path[512], line[256];
+    size_t   n = strlen(f->path);
+    FILE    *fp = NULL;
+    if (n > 4 && strcmp(f->path + n - 4, ".bin") == 0) {
+        snprintf(path, sizeof(path), "%.*s_marks.csv", (int)(n - 4), f->path);
+        fp = fopen(path, "r");
+    }
+
+    uint64_t t_first = 0;
+    int      have    = 0;
+    Seg     *cur     = NULL;
+    if (fp && fgets(line, sizeof(line), fp)) {
+        while (fgets(line, sizeof(line), fp)) {
+            unsigned long long fs, ss, tu;
+            unsigned gen, fr, sr;
+            char ev[32];
+            if (sscanf(line, "%llu,%llu,%llu,%u,%u,%u,%*f,%*u,%31s",
+                       &fs, &ss, &tu, &gen, &fr, &sr, ev) != 7 || fs > n_samp)
+                continue;
+            if (!have) { t_first = tu; have = 1; }
+            if (cur) {
+                cur->samples = fs - cur->sample0;
+                if (!strcmp(ev, "settled")) j->n_segs--;   /* oturma bölümü */
+            }
+            cur = add_seg(j, cap);
+            if (!cur) break;
+            cur->file    = fi;
+            cur->sample0 = fs;
+            cur->freq    = def_freq ? def_freq : fr;
+            cur->sr      = def_sr   ? def_sr   : sr;
+            cur->t0      = (tu - t_first) / 1e6;
+        }
+    }
+    if (fp) fclose(fp);
+    if (!have) {
+        cur = add_seg(j, cap);
+        if (!cur) return -1;
+        cur->file = fi;
+        cur->freq = def_freq;
+        cur->sr   = def_sr ? def_sr : 2048000;
+    }
+    if (!cur) return -1;
+    cur->samples = n_samp - cur->sample0;
+    return have;
+}
+
+/* Kanal bin'leri: merkezi [f - bw/2, f + bw/2) içinde kalan, en az bir bin */
+static int plan_seg(Job *j, Seg *s) {
+    s->lo = malloc(sizeof(int) * 2 * (size_t)j->n_ch);
+    if (!s->lo) return -1;
+    s->hi = s->lo + j->n_ch;
+    double bin_hz = (double)s->sr / FFT_SIZE;
+    for (int c = 0; c < j->n_ch; c++) {
+        double off = j->ch[c].f_hz - s->freq, half = j->ch[c].bw_hz / 2.0;
+        s->lo[c] = -1;
+        if (!s->freq || fabs(off) + half > OCC_EDGE * s->sr / 2.0) continue;
+        int lo = (int)ceil((off - half) / bin_hz) + FFT_SIZE / 2;
+        int hi = (int)ceil((off + half) / bin_hz) + FFT_SIZE / 2;
+        if (hi <= lo) { lo = (int)lround(off / bin_hz) + FFT_SIZE / 2; hi = lo + 1; }
+        s->lo[c] = lo;
+        s->hi[c] = hi;
+    }
+    return 0;
+}
+
+static int add_chan(Job *j, const char *name, double mhz, double khz) {
+    if (mhz <= 0.0 || khz <= 0.0) return -1;
+    if (j->n_ch == OCC_MAX_CH) {
+        fprintf(stderr, "[OCC] En cok %d kanal\n", OCC_MAX_CH);
+        return -1;
+    }
+    OccChan *c = &j->ch[j->n_ch++];
+    c->f_hz  = mhz * 1e6;
+    c->bw_hz = khz * 1e3;
+    if (name && *name) snprintf(c->name, sizeof(c->name), "%s", name);
+    else               snprintf(c->name, sizeof(c->name), "%.4f", mhz);
+    return 0;
+}
+
+/* Plan dosyası: "ad,MHz,kHz" ya da "MHz,kHz"; '#' yorum */
+static int load_plan(Job *j, const char *path) {
+    FILE *fp = fopen(path, "r");
+    if (!fp) {
+        fprintf(stderr, "[OCC] Plan dosyasi acilamadi: %s\n", path);
+        return -1;
+    }
+    char line[256];
+    int  ln = 0, rc = 0;
+    while (fgets(line, sizeof(line), fp)) {
+        ln++;
+        char *h = strchr(line, '#');
+        if (h) *h = '\0';
+        char   name[32] = "";
+        double mhz, khz;
+        if (sscanf(line, " %31[^,],%lf,%lf", name, &mhz, &khz) == 3 ||
+            (name[0] = '\0', sscanf(line, "%lf,%lf", &mhz, &khz) == 2)) {
+            if (add_chan(j, name, mhz, khz) != 0) { rc = -1; break; }
+        } else if (strspn(line, " \t\r\n") != strlen(line)) {
+            fprintf(stderr, "[OCC] %s:%d: gecersiz satir\n", path, ln);
+        }
+    }
+    fclose(fp);
+    return rc;
+}
+
+/* ── Çıktı ────────────────────────────────────────────────────── */
+static double hist_pct(const double *h, double total, double q) {
+    double acc = 0.0;
+    for (int i = 0; i < HIST_N; i++) {
+        acc += h[i];
+        if (acc >= q * total) return HIST_DB_MIN + (i + 0.5) * HIST_DB_STEP;
+    }
+    return HIST_DB_MIN + HIST_N * HIST_DB_STEP;
+}
+
+static void write_report(const Job *j, const Part *tot, const Runs *tx,
+                         const char *prefix, double span_s, double el) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s.csv", prefix);
+    FILE *fc = fopen(path, "w");
+    snprintf(path, sizeof(path), "%s.json", prefix);
+    FILE *fj = fopen(path, "w");
+    if (!fc || !fj) {
+        fprintf(stderr, "[OCC] Cikti yazilamadi: %s.*\n", prefix);
+        if (fc) fclose(fc);
+        if (fj) fclose(fj);
+        return;
+    }
+    int hourly = 0;
+    for (int c = 0; c < j->n_ch && !hourly; c++)
+        for (int h = 0; h < 24; h++) if (tot[c].hour_obs[h] > 0.0) hourly = 1;
+
+    fprintf(fc, "name,freq_mhz,bw_khz,observed_s,occupied_s,duty_pct,"
+                "mean_db,max_db,p10_db,p50_db,p90_db,tx_count,tx_mean_s,tx_max_s\n");
+    fprintf(fj, "{\n  \"files\": %d,\n  \"recorded_s\": %.3f,\n"
+                "  \"threshold\": { \"%s\": %.1f },\n  \"elapsed_s\": %.3f,\n"
+                "  \"channels\": [\n",
+            j->n_files, span_s, j->use_abs ? "abs_db" : "above_noise_db",
+            j->use_abs ? j->abs_db : j->rel_db, el);
+
+    for (int c = 0; c < j->n_ch; c++) {
+        const Part *p = &tot[c];
+        const Runs *r = &tx[c];
+        double duty = p->obs_s > 0.0 ? 100.0 * p->occ_s / p->obs_s : 0.0;
+        double mean = p->obs_s > 0.0 ? 10.0 * log10(p->pwr_s / p->obs_s + 1e-10) : 0.0;
+        double mx   = p->obs_s > 0.0 ? p->max_db : 0.0;
+        double p10  = hist_pct(p->hist, p->obs_s, 0.10);
+        double p50  = hist_pct(p->hist, p->obs_s, 0.50);
+        double p90  = hist_pct(p->hist, p->obs_s, 0.90);
+        double txm  = r->n ? r->sum / r->n : 0.0;
+
+        fprintf(fc, "%s,%.6f,%.3f,%.1f,%.1f,%.3f,%.1f,%.1f,%.1f,%.1f,%.1f,%u,%.3f,%.3f\n",
+                j->ch[c].name, j->ch[c].f_hz / 1e6, j->ch[c].bw_hz / 1e3,
+                p->obs_s, p->occ_s, duty, mean, mx, p10, p50, p90, r->n, txm, r->max);
+
+        fprintf(fj, "    { \"name\": \"%s\", \"freq_mhz\": %.6f, \"bw_khz\": %.3f,\n"
+                    "      \"observed_s\": %.1f, \"occupied_s\": %.1f, \"duty_pct\": %.3f,\n"
+                    "      \"level_db\": { \"mean\": %.1f, \"max\": %.1f, \"p10\": %.1f, "
+                    "\"p50\": %.1f, \"p90\": %.1f },\n"
+                    "      \"tx\": { \"count\": %u, \"mean_s\": %.3f, \"max_s\": %.3f }",
+                j->ch[c].name, j->ch[c].f_hz / 1e6, j->ch[c].bw_hz / 1e3,
+                p->obs_s, p->occ_s, duty, mean, mx, p10, p50, p90, r->n, txm, r->max);
+        if (hourly) {
+            fprintf(fj, ",\n      \"hourly_duty_pct\": [");
+            for (int h = 0; h < 24; h++) {
+                if (p->hour_obs[h] > 0.0)
+                    fprintf(fj, "%s%.2f", h ? ", " : "", 100.0 * p->hour_occ[h] / p->hour_obs[h]);
+                else
+                    fprintf(fj, "%snull", h ? ", " : "");
+            }
+            fprintf(fj, "]");
+        }
+        fprintf(fj, " }%s\n", c + 1 < j->n_ch ? "," : "");
+    }
+    fprintf(fj, "  ]\n}\n");
+    fclose(fc);
+    fclose(fj);
+    printf("[OCC] Rapor: %s.csv, %s.json\n", prefix, prefix);
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+        "Kullanim: %s [secenekler] <iq.bin>...\n"
+        "  -c MHz:kHz         kanal (tekrarlanabilir)\n"
+        "  -g MHz0:MHz1:kHz   esit aralikli kanal izgarasi\n"
+        "  -p plan.csv        kanal plani (ad,MHz,kHz)\n"
+        "  -k dB              gurultu tabaninin ustundeki esik (varsayilan 10)\n"
+        "  -l dB              mutlak esik (dB / bin)\n"
+        "  -a blok            satir basina blok (varsayilan ~%d satir/s)\n"
+        "  -t thread          varsayilan: tum cekirdekler\n"
+        "  -w MHz / -f MHz    hiz / merkez (isaret dosyasi yoksa)\n"
+        "  -o onek            cikti onek (varsayilan occupancy)\n"
+        "  -q                 int16 FFT\n", prog, ROW_RATE);
+}
+
+int main(int argc, char *argv[]) {
+    static OccChan chans[OCC_MAX_CH];
+    static InFile  files[OCC_MAX_FILES];
+    Job j;
+    memset(&j, 0, sizeof(j));
+    j.ch     = chans;
+    j.files  = files;
+    j.rel_db = 10.0;
+
+    const char *prefix = "occupancy";
+    uint32_t avg = 0, freq = 0, sr = 0;
+    int n_thr = 0, fixed = 0;
+    for (int i = 1; i < argc; i++) {
+        double a, b, k;
+        if (!strcmp(argv[i], "-c") && i + 1 < argc) {
+            if (sscanf(argv[++i], "%lf:%lf", &a, &b) != 2 || add_chan(&j, NULL, a, b) != 0) {
+                fprintf(stderr, "Gecersiz kanal: %s (MHz:kHz)\n", argv[i]);
+                return 1;
+            }
+        } else if (!strcmp(argv[i], "-g") && i + 1 < argc) {
+            if (sscanf(argv[++i], "%lf:%lf:%lf", &a, &b, &k) != 3 || b <= a || k <= 0.0) {
+                fprintf(stderr, "Gecersiz izgara: %s (MHz0:MHz1:kHz)\n", argv[i]);
+                return 1;
+            }
+            for (double f = a + k / 2e3; f <= b - k / 2e3 + 1e-9; f += k / 1e3)
+                if (add_chan(&j, NULL, f, k) != 0) return 1;
+        } else if (!strcmp(argv[i], "-p") && i + 1 < argc) {
+            if (load_plan(&j, argv[++i]) != 0) return 1;
+        }
+        else if (!strcmp(argv[i], "-k") && i + 1 < argc) j.rel_db = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-l") && i + 1 < argc) { j.abs_db = atof(argv[++i]); j.use_abs = 1; }
+        else if (!strcmp(argv[i], "-a") && i + 1 < argc) avg    = (uint32_t)atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-t") && i + 1 < argc) n_thr  = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-w") && i + 1 < argc) sr     = (uint32_t)(atof(argv[++i]) * 1e6);
+        else if (!strcmp(argv[i], "-f") && i + 1 < argc) freq   = (uint32_t)(atof(argv[++i]) * 1e6);
+        else if (!strcmp(argv[i], "-o") && i + 1 < argc) prefix = argv[++i];
+        else if (!strcmp(argv[i], "-q")) fixed = 1;
+        else if (argv[i][0] == '-') { usage(argv[0]); return 1; }
+        else if (j.n_files == OCC_MAX_FILES) {
+            fprintf(stderr, "[OCC] En cok %d kayit\n", OCC_MAX_FILES);
+            return 1;
+        } else {
+            snprintf(files[j.n_files++].path, sizeof(files[0].path), "%s", argv[i]);
+        }
+    }
+    if (j.n_files == 0 || j.n_ch == 0) { usage(argv[0]); return 1; }
+    if (n_thr <= 0) n_thr = cpu_count();
+    if (n_thr > 64) n_thr = 64;
+
+    /* Kayıtları eşle, bölümlere ayır */
+    int    seg_cap = 0, n_ok = 0;
+    double rec_s   = 0.0;
+    for (int fi = 0; fi < j.n_files; fi++) {
+        InFile *f = &files[fi];
+        if (filemap_open(&f->map, f->path, 0) != 0) {
+            fprintf(stderr, "[OCC] Kayit acilamadi, atlaniyor: %s\n", f->path);
+            continue;
+        }
+        f->tod = file_tod(f->path);
+        int s0 = j.n_segs;
+        if (split_file(&j, fi, freq, sr, &seg_cap) < 0) {
+            fprintf(stderr, "[OCC] Bellek hatasi\n");
+            return 1;
+        }
+        if (j.segs[s0].freq == 0)
+            fprintf(stderr, "[OCC] %s: merkez frekansi bilinmiyor (-f), atlaniyor\n", f->path);
+        n_ok++;
+        rec_s += (double)(f->map.size / 2) / j.segs[s0].sr;
+    }
+    if (n_ok == 0) return 1;
+
+    uint64_t cap = 0, rows = 0, samples = 0;
+    for (int s = 0; s < j.n_segs; s++) {
+        Seg *sg = &j.segs[s];
+        sg->avg = avg ? avg : (sg->sr / FFT_SIZE / ROW_RATE ? sg->sr / FFT_SIZE / ROW_RATE : 1);
+        if (plan_seg(&j, sg) != 0) { fprintf(stderr, "[OCC] Bellek hatasi\n"); return 1; }
+        if (!sg->freq) continue;
+        uint64_t n = sg->samples / FFT_SIZE / sg->avg;
+        for (uint64_t r = 0; r < n; r += UNIT_ROWS) {
+            if (j.n_units == cap) {
+                cap = cap ? cap * 2 : 256;
+                Unit *u = realloc(j.units, sizeof(Unit) * cap);
+                if (!u) { fprintf(stderr, "[OCC] Bellek hatasi\n"); return 1; }
+                j.units = u;
+            }
+            Unit *u = &j.units[j.n_units++];
+            u->seg  = s;
+            u->row0 = r;
+            u->rows = n - r < UNIT_ROWS ? n - r : UNIT_ROWS;
+        }
+        rows    += n;
+        samples += n * sg->avg * FFT_SIZE;
+    }
+    j.runs  = calloc(j.n_units ? j.n_units : 1, sizeof(Runs) * j.n_ch);
+    j.parts = calloc((size_t)n_thr, sizeof(Part) * j.n_ch);
+    if (!j.runs || !j.parts) { fprintf(stderr, "[OCC] Bellek hatasi\n"); return 1; }
+    for (int i = 0; i < n_thr * j.n_ch; i++) j.parts[i].max_db = -1e9;
+
+    fft_init();
+    fft_set_fixed(fixed);
+    printf("[OCC] %d kayit, %.1f saat, %d bolum, %llu satir, %d kanal, %d thread%s\n",
+           n_ok, rec_s / 3600.0, j.n_segs, (unsigned long long)rows, j.n_ch, n_thr,
+           fixed ? ", int16 FFT" : "");
+    fflush(stdout);
+
+    uint64_t t0 = wall_ms();
+    Thread   th[64];
+    Worker   wk[64];
+    for (int i = 0; i < n_thr; i++) {
+        wk[i] = (Worker){ &j, i };
+        thread_start(&th[i], worker, &wk[i], NULL);
+    }
+    while (ATOMIC_LOAD(&j.done) < j.n_units) {
+        sleep_ms(500);
+        fprintf(stderr, "\r[OCC] %5.1f%%", 100.0 * ATOMIC_LOAD(&j.done) / j.n_units);
+    }
+    fprintf(stderr, "\n");
+    for (int i = 0; i < n_thr; i++) thread_join(&th[i]);
+    double el = (wall_ms() - t0) / 1000.0;
+
+    /* Thread kısmileri toplanır; iletimler iş sırasıyla, bölüm sınırında kapanır */
+    Part *tot = calloc((size_t)j.n_ch, sizeof(Part));
+    Runs *tx  = calloc((size_t)j.n_ch, sizeof(Runs));
+    Runs *acc = calloc((size_t)j.n_ch, sizeof(Runs));
+    if (!tot || !tx || !acc) { fprintf(stderr, "[OCC] Bellek hatasi\n"); return 1; }
+    for (int c = 0; c < j.n_ch; c++) {
+        Part *p = &tot[c];
+        p->max_db = -1e9;
+        for (int t = 0; t < n_thr; t++) {
+            const Part *q = &j.parts[(size_t)t * j.n_ch + c];
+            p->obs_s += q->obs_s;
+            p->occ_s += q->occ_s;
+            p->pwr_s += q->pwr_s;
+            if (q->max_db > p->max_db) p->max_db = q->max_db;
+            for (int h = 0; h < HIST_N; h++) p->hist[h] += q->hist[h];
+            for (int h = 0; h < 24; h++) {
+                p->hour_obs[h] += q->hour_obs[h];
+                p->hour_occ[h] += q->hour_occ[h];
+            }
+        }
+    }
+    for (uint64_t u = 0; u < j.n_units; u++) {
+        int first = u == 0 || j.units[u].seg != j.units[u - 1].seg;
+        for (int c = 0; c < j.n_ch; c++) {
+            if (first) runs_flush(&tx[c], &acc[c]);
+            if (first) acc[c] = j.runs[u * j.n_ch + c];
+            else       runs_append(&acc[c], &j.runs[u * j.n_ch + c]);
+        }
+    }
+    for (int c = 0; c < j.n_ch; c++) runs_flush(&tx[c], &acc[c]);
+
+    write_report(&j, tot, tx, prefix, rec_s, el);
+    printf("[OCC] %.1f s (%.1f MS/s, gercek zamanin %.0f kati)\n", el,
+           samples / 1e6 / (el > 0 ? el : 1e-3), rec_s / (el > 0 ? el : 1e-3));
+
+    free(tot);
+    free(tx);
+    free(acc);
+    for (int s = 0; s < j.n_segs; s++) free(j.segs[s].lo);
+    free(j.segs);
+    free(j.units);
+    free(j.runs);
+    free(j.parts);
+    for (int fi = 0; fi < j.n_files; fi++) filemap_close(&files[fi].map);
+    return 0;
+}
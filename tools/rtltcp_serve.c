@@ -0,0 +1,176 @@
+/*
+ * rtltcp_serve.c — Kayıtlı IQ dosyasını rtl_tcp sunucusu gibi yayınlar
+ *
+ * Gerçek bir direk/dongle olmadan rtl_tcp istemcisini denemek için:
+ *   rtltcp_serve.exe C:\RtlSdr\iq_d0_20250101_120000.bin [port]
+ *   radar.exe -r 127.0.0.1:1234
+ *
+ * - Bağlanan istemciye standart 12 baytlık "RTL0" başlığını yollar
+ *   (tuner tipi 5 = R820T, 29 kazanç adımı).
+ * - Dosyayı, istemcinin istediği örnekleme hızında (varsayılan
+ *   2.048 MS/s) gerçek zamanlı tempoyla ve döngüsel olarak akıtır.
+ * - Gelen 5 baytlık komutları konsola yazar; 0x02 (sample rate) tempoyu
+ *   değiştirir. Frekans/kazanç komutları yalnızca kaydedilir.
+ * - Aynı anda tek istemci; istemci kopunca yenisini bekler.
+ */
+#ifdef _WIN32
+#include <winsock2.h>
+#include <windows.h>
+typedef SOCKET sock_t;
+#define SOCK_BAD     INVALID_SOCKET
+#define sock_close   closesocket
+#define sleep_ms(ms) Sleep(ms)
+#else
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <netinet/in.h>
+#include <unistd.h>
+#include <signal.h>
+#include <time.h>
+typedef int sock_t;
+#define SOCK_BAD     (-1)
+#define sock_close   close
+#define sleep_ms(ms) usleep((ms) * 1000u)
+#endif
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHUNK_MS   10          /* her gönderim ~10 ms'lik veri */
+
+static uint64_t mono_ms(void) {
+#ifdef _WIN32
+    return GetTickCount64();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000u + (uint64_t)ts.tv_nsec / 1000000u;
+#endif
+}
+
+static uint32_t rd_be32(const uint8_t *p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+           ((uint32_t)p[2] <<  8) |  (uint32_t)p[3];
+}
+
+static void wr_be32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24); p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >>  8); p[3] = (uint8_t)v;
+}
+
+static int send_all(sock_t s, const uint8_t *buf, size_t n) {
+    while (n > 0) {
+        int r = send(s, (const char *)buf, (int)n, 0);
+        if (r <= 0) return -1;
+        buf += r;
+        n   -= (size_t)r;
+    }
+    return 0;
+}
+
+/* Bekleyen komutları oku (bloklamadan). Bağlantı koptuysa -1. */
+static int poll_cmds(sock_t s, uint8_t *cmd, int *cmd_len, uint32_t *sr) {
+    for (;;) {
+        fd_set rf;
+        struct timeval tv = {0, 0};
+        FD_ZERO(&rf);
+        FD_SET(s, &rf);
+        if (select((int)s + 1, &rf, NULL, NULL, &tv) <= 0) return 0;
+
+        int r = recv(s, (char *)cmd + *cmd_len, 5 - *cmd_len, 0);
+        if (r <= 0) return -1;
+        *cmd_len += r;
+        if (*cmd_len < 5) continue;
+        *cmd_len = 0;
+
+        uint32_t v = rd_be32(cmd + 1);
+        printf("[SRV] Komut 0x%02x  parametre %u\n", cmd[0], v);
+        if (cmd[0] == 0x02 && v >= 225000u && v <= 3200000u) *sr = v;
+    }
+}
+
+static void serve_client(sock_t c, FILE *fp) {
+    uint8_t hdr[12] = {'R', 'T', 'L', '0'};
+    wr_be32(hdr + 4, 5);    /* R820T */
+    wr_be32(hdr + 8, 29);
+    if (send_all(c, hdr, sizeof(hdr)) != 0) return;
+
+    uint32_t sr = 2048000u;
+    uint8_t  cmd[5];
+    int      cmd_len = 0;
+    uint8_t *buf     = malloc(3200000u * 2u * CHUNK_MS / 1000u);
+    if (!buf) return;
+
+    uint64_t t0   = mono_ms();
+    uint64_t sent = 0;             /* t0'dan beri yollanan örnek */
+    uint32_t cur_sr = sr;
+    while (poll_cmds(c, cmd, &cmd_len, &sr) == 0) {
+        if (sr != cur_sr) {        /* yeni tempo: saati sıfırla */
+            cur_sr = sr;
+            t0     = mono_ms();
+            sent   = 0;
+        }
+        uint64_t due = (mono_ms() - t0) * cur_sr / 1000u;
+        if (sent >= due) { sleep_ms(1); continue; }
+
+        size_t n = (size_t)cur_sr * 2u * CHUNK_MS / 1000u;
+        size_t got = fread(buf, 1, n, fp);
+        if (got < n) {             /* dosya sonu: başa dön */
+            rewind(fp);
+            got += fread(buf + got, 1, n - got, fp);
+        }
+        got &= ~(size_t)1;         /* I/Q çifti bölünmesin */
+        if (got == 0 || send_all(c, buf, got) != 0) break;
+        sent += got / 2u;
+    }
+    free(buf);
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "Kullanim: %s <iq.bin> [port]\n", argv[0]);
+        return 1;
+    }
+    uint16_t port = (argc > 2) ? (uint16_t)atoi(argv[2]) : 1234;
+    setvbuf(stdout, NULL, _IONBF, 0);   /* günlük yönlendirilse de anında görünsün */
+
+    FILE *fp = fopen(argv[1], "rb");
+    if (!fp) {
+        fprintf(stderr, "[SRV] Dosya acilamadi: %s\n", argv[1]);
+        return 1;
+    }
+
+#ifdef _WIN32
+    WSADATA wd;
+    WSAStartup(MAKEWORD(2, 2), &wd);
+#else
+    signal(SIGPIPE, SIG_IGN);   /* kopan istemci süreci öldürmesin */
+#endif
+
+    sock_t ls = socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    setsockopt(ls, SOL_SOCKET, SO_REUSEADDR, (const char *)&one, sizeof(one));
+    struct sockaddr_in a;
+    memset(&a, 0, sizeof(a));
+    a.sin_family      = AF_INET;
+    a.sin_addr.s_addr = htonl(INADDR_ANY);
+    a.sin_port        = htons(port);
+    if (ls == SOCK_BAD || bind(ls, (struct sockaddr *)&a, sizeof(a)) != 0 ||
+        listen(ls, 1) != 0) {
+        fprintf(stderr, "[SRV] Port %u dinlenemiyor\n", port);
+        fclose(fp);
+        return 1;
+    }
+    printf("[SRV] %s  →  port %u\n", argv[1], port);
+
+    for (;;) {
+        sock_t c = accept(ls, NULL, NULL);
+        if (c == SOCK_BAD) continue;
+        printf("[SRV] Istemci baglandi\n");
+        serve_client(c, fp);
+        sock_close(c);
+        printf("[SRV] Istemci ayrildi\n");
+    }
+}
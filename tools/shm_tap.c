@@ -0,0 +1,90 @@
+/*
+ * shm_tap.c — Paylaşılan bellek halkasına bağlanan örnek okuyucu
+ *
+ *   shm_tap radar_d0              IQ akışının hız / gecikme / kayıp özeti
+ *   shm_tap radar_d0 psd          PSD satırları için aynısı
+ *   shm_tap radar_d0 iq -o | dec  ham IQ'yu stdout'a (boru ile çözücüye)
+ *
+ * Üretici yeniden başlarsa yeni bölüte otomatik yeniden bağlanır.
+ * Özetler stderr'e yazılır; -o ile stdout yalnızca veri taşır.
+ */
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#include <fcntl.h>
+#define sleep_ms(ms) Sleep(ms)
+#else
+#include <unistd.h>
+#include <time.h>
+#define sleep_ms(ms) usleep((ms) * 1000u)
+#endif
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "shmring.h"
+
+static uint64_t mono_ms(void) {
+#ifdef _WIN32
+    return GetTickCount64();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000u + (uint64_t)ts.tv_nsec / 1000000u;
+#endif
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "Kullanim: %s <ad> [iq|psd] [-o]\n", argv[0]);
+        return 1;
+    }
+    int psd = argc > 2 && !strcmp(argv[2], "psd");
+    int out = argc > 3 && !strcmp(argv[3], "-o");
+#ifdef _WIN32
+    if (out) _setmode(_fileno(stdout), _O_BINARY);
+#endif
+
+    ShmReader rd;
+    while (shmring_attach(&rd, argv[1]) != 0) {
+        fprintf(stderr, "[TAP] %s bekleniyor...\n", argv[1]);
+        sleep_ms(1000);
+    }
+    fprintf(stderr, "[TAP] Baglandi: %s  (IQ %u x %u B, PSD %u x %u kutu)\n",
+            argv[1], rd.hdr->iq_slots, rd.hdr->iq_bytes,
+            rd.hdr->psd_slots, rd.hdr->psd_bins);
+
+    uint8_t *buf = malloc(rd.hdr->iq_bytes > rd.hdr->psd_bins * 4u
+                          ? rd.hdr->iq_bytes : rd.hdr->psd_bins * 4u);
+    if (!buf) return 1;
+
+    uint64_t n = 0, t_last = mono_ms();
+    for (;;) {
+        ShmSlotMeta m;
+        int got = psd ? shmring_read_psd(&rd, (float *)buf, &m)
+                      : shmring_read_iq (&rd, buf, &m);
+        if (got) {
+            n++;
+            if (out) fwrite(buf, 1, m.len, stdout);
+        } else {
+            if (!shmring_alive(&rd)) {
+                fprintf(stderr, "[TAP] Uretici kapandi, yeniden baglaniliyor\n");
+                shmring_detach(&rd);
+                while (shmring_attach(&rd, argv[1]) != 0) sleep_ms(1000);
+            }
+            sleep_ms(1);
+        }
+
+        uint64_t now = mono_ms();
+        if (now - t_last >= 1000) {
+            fprintf(stderr, "[TAP] %llu/s  gecikme %llu  kayip %llu (ezilen %llu)\n",
+                    (unsigned long long)n,
+                    (unsigned long long)(psd ? shmring_psd_lag(&rd) : shmring_iq_lag(&rd)),
+                    (unsigned long long)(psd ? rd.psd_lost : rd.iq_lost),
+                    (unsigned long long)(psd ? rd.psd_torn : rd.iq_torn));
+            n = 0;
+            t_last = now;
+        }
+    }
+}
@@ -0,0 +1,220 @@
+/*
+ * spec_tiles.c — Kayıttan çevrimdışı spektrogram döşeme piramidi (tilepyr.h)
+ *
+ *   spec_tiles iq_d0_20250101_120000.bin            → aynı adla .pyr
+ *   spec_tiles kayit.bin cikti.pyr -a 16 -t 8       satır başına 16 blok, 8 thread
+ *   spec_tiles kayit.bin -w 2.4 -f 433.92 -q        hız / merkez elle, int16 FFT
+ *
+ * Kayıt belleğe eşlenir ve döşeme satırları (256 spektrum satırı) tüm
+ * çekirdeklere dağıtılır; her thread fft_compute_power ile kendi satırlarını
+ * hesaplayıp çıktı eşlemesine doğrudan yazar. Ardından her üst düzey bir
+ * öncekinin 2×2 tepe indirgemesi olarak yine paralel üretilir.
+ *
+ * Örnek hızı ve merkez frekansı varsa "<kayıt>_marks.csv" ilk satırından
+ * okunur. Başlığın magic alanı en son yazılır: yarıda kalan dosya açılmaz.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "fft.h"
+#include "thread.h"
+#include "tilepyr.h"
+
+#define ROW_RATE 60   /* varsayılan düzey 0 satır hızı (pipeline PIPE_ROW_RATE) */
+
+typedef struct {
+    const uint8_t    *iq;
+    uint8_t          *out;      /* çıktı eşlemesi (başlık dahil) */
+    const PyrHeader  *hdr;
+    int               lv;
+    uint32_t          avg;
+    uint64_t          n_units;  /* döşeme satırı */
+    volatile uint64_t next, done;
+} Job;
+
+/* Tam satırı (bins bayt) düzeyin döşemelerine dağıt */
+static void put_row(const Job *j, int lv, uint64_t r, const uint8_t *row) {
+    const PyrLevel *L = &j->hdr->level[lv];
+    for (uint32_t b = 0; b < L->bins; b += L->tile_w)
+        memcpy(pyr_cell_ptr(j->out, j->hdr, lv, r, b), row + b, L->tile_w);
+}
+
+/* Düzey 0: satır = avg bloğun doğrusal ortalaması → dB → uint8 */
+static void unit_level0(const Job *j, uint64_t tr) {
+    float   pwr[FFT_SIZE], acc[FFT_SIZE];
+    uint8_t row[FFT_SIZE];
+    uint64_t r_end = (tr + 1) * PYR_TILE_ROWS;
+    if (r_end > j->hdr->level[0].rows) r_end = j->hdr->level[0].rows;
+
+    for (uint64_t r = tr * PYR_TILE_ROWS; r < r_end; r++) {
+        memset(acc, 0, sizeof(acc));
+        const uint8_t *blk = j->iq + r * j->avg * (uint64_t)(FFT_SIZE * 2);
+        for (uint32_t b = 0; b < j->avg; b++, blk += FFT_SIZE * 2) {
+            fft_compute_power(blk, pwr);
+            for (int k = 0; k < FFT_SIZE; k++) acc[k] += pwr[k];
+        }
+        float inv = 1.0f / (float)j->avg;
+        for (int k = 0; k < FFT_SIZE; k++)
+            row[k] = pyr_quant(10.0f * log10f(acc[k] * inv + 1e-10f));
+        put_row(j, 0, r, row);
+    }
+}
+
+/* Düzey L: L-1'in 2 satır × (1 ya da 2) bin tepe değeri */
+static void unit_reduce(const Job *j, uint64_t tr) {
+    const PyrLevel *L = &j->hdr->level[j->lv], *P = &j->hdr->level[j->lv - 1];
+    uint32_t fk = P->bins / L->bins;
+    uint8_t  row[FFT_SIZE];
+    uint64_t r_end = (tr + 1) * PYR_TILE_ROWS;
+    if (r_end > L->rows) r_end = L->rows;
+
+    for (uint64_t r = tr * PYR_TILE_ROWS; r < r_end; r++) {
+        memset(row, 0, L->bins);
+        for (uint64_t pr = 2 * r; pr < 2 * r + 2 && pr < P->rows; pr++)
+            for (uint32_t k = 0; k < L->bins; k++)
+                for (uint32_t i = 0; i < fk; i++) {
+                    uint8_t v = *pyr_cell_ptr(j->out, j->hdr, j->lv - 1, pr, k * fk + i);
+                    if (v > row[k]) row[k] = v;
+                }
+        put_row(j, j->lv, r, row);
+    }
+}
+
+static void worker(void *arg) {
+    Job *j = (Job *)arg;
+    for (;;) {
+        uint64_t u = ATOMIC_ADD(&j->next, 1) - 1;
+        if (u >= j->n_units) break;
+        if (j->lv == 0) unit_level0(j, u);
+        else            unit_reduce(j, u);
+        ATOMIC_ADD(&j->done, 1);
+    }
+}
+
+/* Düzeyi n_thr thread ile üret; düzey 0'da ilerleme yazılır */
+static void run_level(Job *j, int lv, int n_thr) {
+    Thread th[64];
+    j->lv      = lv;
+    j->n_units = (j->hdr->level[lv].rows + PYR_TILE_ROWS - 1) / PYR_TILE_ROWS;
+    j->next    = 0;
+    j->done    = 0;
+    for (int i = 0; i < n_thr; i++) thread_start(&th[i], worker, j, NULL);
+    if (lv == 0) {
+        while (ATOMIC_LOAD(&j->done) < j->n_units) {
+            sleep_ms(500);
+            fprintf(stderr, "\r[TILES] Duzey 0: %5.1f%%",
+                    100.0 * ATOMIC_LOAD(&j->done) / j->n_units);
+        }
+        fprintf(stderr, "\n");
+    }
+    for (int i = 0; i < n_thr; i++) thread_join(&th[i]);
+}
+
+/* "<kayıt>_marks.csv" ilk veri satırından merkez ve örnek hızı */
+static void read_marks(const char *iq_path, uint32_t *freq, uint32_t *sr) {
+    char path[512], line[256];
+    size_t n = strlen(iq_path);
+    if (n < 4 || strcmp(iq_path + n - 4, ".bin") != 0) return;
+    snprintf(path, sizeof(path), "%.*s_marks.csv", (int)(n - 4), iq_path);
+    FILE *fp = fopen(path, "r");
+    if (!fp) return;
+    unsigned long long fs, ss, t;
+    unsigned gen, f, s;
+    if (fgets(line, sizeof(line), fp) && fgets(line, sizeof(line), fp) &&
+        sscanf(line, "%llu,%llu,%llu,%u,%u,%u", &fs, &ss, &t, &gen, &f, &s) == 6) {
+        if (!*freq) *freq = f;
+        if (!*sr)   *sr   = s;
+        printf("[TILES] Isaretler: %s\n", path);
+    }
+    fclose(fp);
+}
+
+int main(int argc, char *argv[]) {
+    const char *in = NULL, *out = NULL;
+    uint32_t avg = 0, freq = 0, sr = 0;
+    int n_thr = 0, fixed = 0;
+    for (int i = 1; i < argc; i++) {
+        if      (!strcmp(argv[i], "-a") && i + 1 < argc) avg   = (uint32_t)atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-t") && i + 1 < argc) n_thr = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-w") && i + 1 < argc) sr    = (uint32_t)(atof(argv[++i]) * 1e6);
+        else if (!strcmp(argv[i], "-f") && i + 1 < argc) freq  = (uint32_t)(atof(argv[++i]) * 1e6);
+        else if (!strcmp(argv[i], "-q")) fixed = 1;
+        else if (!in)  in  = argv[i];
+        else if (!out) out = argv[i];
+        else { fprintf(stderr, "Bilinmeyen arguman: %s\n", argv[i]); return 1; }
+    }
+    if (!in) {
+        fprintf(stderr, "Kullanim: %s <iq.bin> [cikti.pyr] [-a blok] [-t thread] "
+                        "[-w MHz] [-f MHz] [-q]\n", argv[0]);
+        return 1;
+    }
+    char out_def[512];
+    if (!out) {
+        size_t n = strlen(in);
+        int    k = (n > 4 && !strcmp(in + n - 4, ".bin")) ? (int)(n - 4) : (int)n;
+        snprintf(out_def, sizeof(out_def), "%.*s.pyr", k, in);
+        out = out_def;
+    }
+    read_marks(in, &freq, &sr);
+    if (!sr) sr = 2048000;
+    if (!avg) avg = sr / FFT_SIZE / ROW_RATE ? sr / FFT_SIZE / ROW_RATE : 1;
+    if (n_thr <= 0) n_thr = cpu_count();
+    if (n_thr > 64) n_thr = 64;
+
+    FileMap src;
+    if (filemap_open(&src, in, 0) != 0) {
+        fprintf(stderr, "[TILES] Kayit acilamadi: %s\n", in);
+        return 1;
+    }
+    uint64_t blocks = src.size / (FFT_SIZE * 2);
+    uint64_t rows0  = blocks / avg;
+    if (rows0 == 0) {
+        fprintf(stderr, "[TILES] Kayit cok kisa (%llu blok)\n", (unsigned long long)blocks);
+        filemap_close(&src);
+        return 1;
+    }
+
+    PyrHeader h;
+    pyr_layout(&h, rows0, FFT_SIZE);
+    h.avg_blocks  = avg;
+    h.sample_rate = sr;
+    h.center_hz   = freq;
+
+    FileMap dst;
+    if (filemap_open(&dst, out, h.total_bytes) != 0) {
+        fprintf(stderr, "[TILES] Cikti olusturulamadi: %s\n", out);
+        filemap_close(&src);
+        return 1;
+    }
+    PyrHeader *oh = (PyrHeader *)dst.base;
+    *oh = h;
+    oh->magic = 0;   /* tamamlanınca yazılır */
+
+    fft_init();
+    fft_set_fixed(fixed);
+    printf("[TILES] %s: %.1f dk kayit, %llu satir x %d bin, %u duzey, %d thread%s\n",
+           in, blocks * (double)FFT_SIZE / sr / 60.0, (unsigned long long)rows0,
+           FFT_SIZE, h.n_levels, n_thr, fixed ? ", int16 FFT" : "");
+    fflush(stdout);
+
+    uint64_t t0 = wall_ms();
+    Job j;
+    memset(&j, 0, sizeof(j));
+    j.iq  = src.base;
+    j.out = dst.base;
+    j.hdr = oh;
+    j.avg = avg;
+    for (int lv = 0; lv < (int)h.n_levels; lv++) run_level(&j, lv, n_thr);
+
+    ATOMIC_STORE(&oh->magic, PYR_MAGIC);
+    double el = (wall_ms() - t0) / 1000.0;
+    printf("[TILES] %s: %.1f MB, %.1f s (%.1f MS/s, gercek zamanin %.0f kati)\n",
+           out, h.total_bytes / 1048576.0, el,
+           rows0 * avg * (double)FFT_SIZE / 1e6 / (el > 0 ? el : 1e-3),
+           rows0 * avg * (double)FFT_SIZE / sr / (el > 0 ? el : 1e-3));
+    filemap_close(&dst);
+    filemap_close(&src);
+    return 0;
+}
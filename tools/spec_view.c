@@ -0,0 +1,168 @@
+/*
+ * spec_view.c — Spektrum yayın sunucusu için komut satırı izleyicisi
+ *
+ * Çerçeveleri çözer ve her saniye özet yazar (çerçeve hızı, çerçeve başına
+ * bayt, ham float satıra göre oran, en güçlü kutu). Uzak konsollara
+ * geçmeden önce yayını loopback üzerinden denemek için:
+ *   radar.exe -S 5555
+ *   spec_view.exe 127.0.0.1 5555 [seyreltme] [kutu] [hat maskesi]
+ */
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <windows.h>
+typedef SOCKET sock_t;
+#define SOCK_BAD     INVALID_SOCKET
+#else
+#include <sys/socket.h>
+#include <netdb.h>
+#include <unistd.h>
+#include <time.h>
+typedef int sock_t;
+#define SOCK_BAD     (-1)
+#endif
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "specsrv.h"
+#include "fft.h"
+
+static uint64_t mono_ms(void) {
+#ifdef _WIN32
+    return GetTickCount64();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000u + (uint64_t)ts.tv_nsec / 1000000u;
+#endif
+}
+
+static uint32_t rd_le32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+           ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+static uint64_t rd_le64(const uint8_t *p) {
+    return (uint64_t)rd_le32(p) | ((uint64_t)rd_le32(p + 4) << 32);
+}
+static float  rd_f32(const uint8_t *p) { uint32_t u = rd_le32(p); float  v; memcpy(&v, &u, 4); return v; }
+static double rd_f64(const uint8_t *p) { uint64_t u = rd_le64(p); double v; memcpy(&v, &u, 8); return v; }
+
+static int recv_all(sock_t s, uint8_t *buf, uint32_t n) {
+    uint32_t got = 0;
+    while (got < n) {
+        int r = recv(s, (char *)buf + got, (int)(n - got), 0);
+        if (r <= 0) return -1;
+        got += (uint32_t)r;
+    }
+    return 0;
+}
+
+static void send_cmd(sock_t s, uint8_t cmd, uint32_t v) {
+    uint8_t p[5] = { cmd, (uint8_t)(v >> 24), (uint8_t)(v >> 16),
+                     (uint8_t)(v >> 8), (uint8_t)v };
+    send(s, (const char *)p, 5, 0);
+}
+
+/* 4 bit öbek fark kodunu ref üzerine uygula; tutarsızsa -1 */
+static int unpack_delta(const uint8_t *in, uint32_t len, uint8_t *ref, uint32_t n) {
+    uint32_t nib = 0, max_nib = len * 2;
+#define GET() ((nib < max_nib) ? ((in[nib >> 1] >> ((nib & 1) ? 0 : 4)) & 0xF) : 0x100u)
+    for (uint32_t i = 0; i < n; i++) {
+        unsigned v = GET(); nib++;
+        int d;
+        if (v == 0x100u) return -1;
+        if (v == 0x8) {
+            unsigned hi = GET(); nib++;
+            unsigned lo = GET(); nib++;
+            if (hi == 0x100u || lo == 0x100u) return -1;
+            d = (int8_t)(uint8_t)((hi << 4) | lo);
+        } else {
+            d = (v & 0x8) ? (int)v - 16 : (int)v;
+        }
+        ref[i] = (uint8_t)(ref[i] + d);
+    }
+#undef GET
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        fprintf(stderr, "Kullanim: %s <host> <port> [seyreltme] [kutu] [hat maskesi]\n",
+                argv[0]);
+        return 1;
+    }
+#ifdef _WIN32
+    WSADATA wd;
+    WSAStartup(MAKEWORD(2, 2), &wd);
+#endif
+    struct addrinfo hints, *res = NULL;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family   = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    if (getaddrinfo(argv[1], argv[2], &hints, &res) != 0 || !res) {
+        fprintf(stderr, "Adres cozulemedi: %s\n", argv[1]);
+        return 1;
+    }
+    sock_t s = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+    if (s == SOCK_BAD || connect(s, res->ai_addr, (int)res->ai_addrlen) != 0) {
+        fprintf(stderr, "Baglanilamadi: %s:%s\n", argv[1], argv[2]);
+        return 1;
+    }
+    freeaddrinfo(res);
+
+    if (argc > 3) send_cmd(s, SPECSRV_CMD_DECIM, (uint32_t)atoi(argv[3]));
+    if (argc > 4) send_cmd(s, SPECSRV_CMD_BINS,  (uint32_t)atoi(argv[4]));
+    if (argc > 5) send_cmd(s, SPECSRV_CMD_PIPES, (uint32_t)strtoul(argv[5], NULL, 0));
+
+    static uint8_t ref[SPECSRV_MAX_PIPES][FFT_SIZE];
+    static uint8_t payload[FFT_SIZE * 2];
+    uint8_t  h[SPECSRV_HDR_SIZE];
+    uint32_t frames = 0, keys = 0, bytes = 0, bins = 0;
+    uint64_t t_last = mono_ms();
+
+    while (recv_all(s, h, SPECSRV_HDR_SIZE) == 0) {
+        if (memcmp(h, "SPF1", 4) != 0) {
+            fprintf(stderr, "Gecersiz cerceve\n");
+            return 1;
+        }
+        int      key  = h[4] & SPECSRV_F_KEY;
+        int      pipe = h[5] % SPECSRV_MAX_PIPES;
+        uint32_t n    = (uint32_t)h[6] | ((uint32_t)h[7] << 8);
+        uint32_t len  = rd_le32(h + 44);
+        if (n > FFT_SIZE || len > sizeof(payload) || recv_all(s, payload, len) != 0)
+            break;
+
+        if (key) {
+            memcpy(ref[pipe], payload, n);
+            keys++;
+        } else if (unpack_delta(payload, len, ref[pipe], n) != 0) {
+            fprintf(stderr, "Bozuk fark cercevesi\n");
+            return 1;
+        }
+        frames++;
+        bytes += SPECSRV_HDR_SIZE + len;
+        bins   = n;
+
+        uint64_t now = mono_ms();
+        if (now - t_last >= 1000) {
+            double center = rd_f64(h + 20), span = rd_f64(h + 28);
+            float  base   = rd_f32(h + 36), step = rd_f32(h + 40);
+            uint32_t pk = 0;
+            for (uint32_t i = 1; i < n; i++) if (ref[pipe][i] > ref[pipe][pk]) pk = i;
+            double bpf = frames ? (double)bytes / frames : 0.0;
+            printf("hat %d  %u cerceve/s (%u anahtar)  %.0f B/cerceve  "
+                   "ham %u B (x%.1f)  seq %u  tepe %.3f MHz %.1f dB\n",
+                   pipe, frames, keys, bpf, bins * 4u,
+                   bpf > 0.0 ? bins * 4.0 / bpf : 0.0, rd_le32(h + 8),
+                   (center - span / 2.0 + span * (pk + 0.5) / n) / 1e6,
+                   base + ref[pipe][pk] * step);
+            fflush(stdout);
+            frames = keys = bytes = 0;
+            t_last = now;
+        }
+    }
+    printf("Baglanti kapandi\n");
+    return 0;
+}
@@ -0,0 +1,112 @@
+/*
+ * stage_example.c — Örnek DSP aşama eklentisi: blok gücü + satır tepesi günlüğü
+ *
+ *   make tools/stage_example.dll          (Linux: make tools/stage_example.so)
+ *   radar_d -d 0 -L tools/stage_example.dll,500
+ *
+ * Her hat için "<outdir>/stage_power_<etiket>.csv" açar; argüman günlük
+ * aralığıdır (ms, varsayılan 1000). Aralık boyunca ham IQ'nun ortalama gücü
+ * (dBFS) ve PSD satırlarının en güçlü bin'i yazılır. Yalnız stage_api.h'a
+ * bağlıdır; radar kaynaklarıyla birlikte derlenmez.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "stage_api.h"
+
+#ifdef _WIN32
+#define PATH_SEP "\\"
+#else
+#define PATH_SEP "/"
+#endif
+
+typedef struct {
+    FILE    *fp;
+    uint32_t bs;               /* blok başına IQ çifti */
+    uint64_t period_us, t0_us;
+    double   pwr_sum;          /* |x|² toplamı, tam ölçek = 1 */
+    uint64_t n_samples, n_blocks;
+    uint64_t next_sample, gaps;
+    float    peak_db;
+    double   peak_hz;
+    uint32_t n_rows;
+} PowerLog;
+
+static void *pl_open(const StageInfo *info) {
+    PowerLog *p = calloc(1, sizeof(*p));
+    if (!p) return NULL;
+    int ms = atoi(info->args);
+    p->period_us = (uint64_t)(ms > 0 ? ms : 1000) * 1000u;
+    p->peak_db   = -1e9f;
+    p->bs        = info->block_samples;
+
+    char path[320];
+    snprintf(path, sizeof(path), "%s" PATH_SEP "stage_power_%s.csv",
+             info->out_dir, info->tag);
+    p->fp = fopen(path, "w");
+    if (!p->fp) {
+        free(p);
+        return NULL;
+    }
+    fputs("t_us,freq_hz,blocks,gaps,power_dbfs,rows,peak_hz,peak_db\n", p->fp);
+    return p;
+}
+
+/* Aralık doldu: özet satırı, sayaçlar sıfırlanır */
+static void flush(PowerLog *p, uint64_t t_us, uint32_t freq) {
+    double db = p->n_samples ? 10.0 * log10(p->pwr_sum / p->n_samples + 1e-20) : -200.0;
+    fprintf(p->fp, "%llu,%u,%llu,%llu,%.2f,%u,%.0f,%.1f\n",
+            (unsigned long long)t_us, freq, (unsigned long long)p->n_blocks,
+            (unsigned long long)p->gaps, db, p->n_rows, p->peak_hz, p->peak_db);
+    fflush(p->fp);
+    p->pwr_sum   = 0.0;
+    p->n_samples = p->n_blocks = p->gaps = 0;
+    p->n_rows    = 0;
+    p->peak_db   = -1e9f;
+    p->t0_us     = t_us;
+}
+
+static void pl_block(void *ctx, const uint8_t *iq, const SdrBlockMeta *m) {
+    PowerLog *p = (PowerLog *)ctx;
+    if (p->next_sample && m->sample != p->next_sample) p->gaps++;
+    p->next_sample = m->sample + p->bs;
+    if (m->settling) return;
+
+    double acc = 0.0;
+    for (uint32_t k = 0; k < 2 * p->bs; k += 2) {
+        double i = (iq[k] - 127.5) / 127.5, q = (iq[k + 1] - 127.5) / 127.5;
+        acc += i * i + q * q;
+    }
+    p->pwr_sum   += acc;
+    p->n_samples += p->bs;
+    p->n_blocks++;
+    if (!p->t0_us) p->t0_us = m->t_us;
+    if (m->t_us - p->t0_us >= p->period_us) flush(p, m->t_us, m->freq);
+}
+
+static void pl_row(void *ctx, const float *psd, const StageRowMeta *r) {
+    PowerLog *p = (PowerLog *)ctx;
+    uint32_t best = 0;
+    for (uint32_t k = 1; k < r->bins; k++)
+        if (psd[k] > psd[best]) best = k;
+    if (psd[best] > p->peak_db) {
+        p->peak_db = psd[best];
+        p->peak_hz = r->center_hz + ((double)best / r->bins - 0.5) * r->span_hz;
+    }
+    p->n_rows++;
+}
+
+static void pl_close(void *ctx) {
+    PowerLog *p = (PowerLog *)ctx;
+    fclose(p->fp);
+    free(p);
+}
+
+static const StageDesc POWER_LOG = {
+    STAGE_API_VERSION, "power_log", STAGE_BEST_EFFORT,
+    STAGE_WANT_IQ | STAGE_WANT_PSD,
+    pl_open, pl_block, pl_row, pl_close,
+};
+
+STAGE_EXPORT const StageDesc *radar_stage_entry(void) { return &POWER_LOG; }
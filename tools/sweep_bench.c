@@ -0,0 +1,207 @@
+/*
+ * sweep_bench.c — Tarama zamanlayıcısının (sweep.h) benzetilmiş tuner ile
+ *                 hızı ve panoramik birleştirmenin dar taşıyıcı doğruluğu
+ *
+ *   sweep_bench                  24-1700 MHz, 2.4 MS/s, 1 tarama
+ *   sweep_bench 88 108           aralık (MHz)
+ *   sweep_bench 88 108 2.048 5   örnekleme hızı (MS/s), tarama sayısı
+ *
+ * Benzetilmiş tuner gerçek cihaz gibi davranır: yeniden ayardan sonra
+ * havadaki aktarımlar (SIM_INFLIGHT blok) hâlâ eski frekansın verisini ve
+ * kuşağını taşır, ardından SIM_SETTLE_MS boyunca settling bayraklı bloklar
+ * gelir. Bloklar gürültü + SIM_N_CAR sabit dar taşıyıcıdır (gerçek
+ * frekanslarında, ayarlı merkeze göre karıştırılmış). Adım merkezlerindeki
+ * DC çentiği (±1.5 bin) hiçbir adımca kapsanmadığından taşıyıcılar oraya
+ * konmaz.
+ *
+ * Yazılanlar: örnek zaman çizgisinde tarama hızı (MHz/s, gerçek cihazda
+ * beklenen), yeniden ayar / oturma kaybı, sweep_feed'in duvar saati
+ * işleme hızı (gerçek zamanın kaç katı) ve her taşıyıcının panoramada
+ * tabandan yüksekliği (en büyük ve ortalama indirmeyle). En büyük
+ * indirmede bir taşıyıcı tabandan CAR_MIN_DB yüksek görünmezse ya da
+ * işleme gerçek zamandan yavaşsa çıkış kodu 1'dir.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "fft.h"
+#include "sweep.h"
+#include "thread.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define SIM_INFLIGHT  64      /* eski ayarla gelen blok (2 x 32 blokluk aktarım) */
+#define SIM_SETTLE_MS 5.0     /* PLL oturma: settling bayraklı */
+#define SIM_NOISE     0.06f   /* kol başına gürültü (tam ölçek 1) */
+#define SIM_N_CAR     3
+#define CAR_AMP       0.05f
+#define CAR_MIN_DB    10.0f
+
+typedef struct {
+    uint32_t freq, gen;       /* istenen ayar */
+    uint32_t blk_freq;        /* blokların yakalandığı frekans */
+    int      inflight;        /* eski ayarla gelecek kalan blok */
+    int      settle;          /* settling bayraklı kalan blok */
+    int      settle_blocks;
+    uint32_t retunes;
+} FakeTuner;
+
+static uint32_t fake_tune(uint32_t hz, void *ud) {
+    FakeTuner *t = (FakeTuner *)ud;
+    t->freq     = hz;
+    t->gen++;
+    t->inflight = SIM_INFLIGHT;
+    t->settle   = t->settle_blocks;
+    t->retunes++;
+    return t->gen;
+}
+
+static uint32_t s_rng = 12345u;
+
+static float nrand(void) {   /* yaklaşık normal, birim varyans */
+    float s = 0.0f;
+    for (int i = 0; i < 4; i++) {
+        s_rng = s_rng * 1664525u + 1013904223u;
+        s += (float)(s_rng >> 8) / 16777216.0f;
+    }
+    return (s - 2.0f) * 1.7320508f;
+}
+
+static uint8_t to_u8(float v) {
+    float s = 127.5f + v * 127.5f;
+    if (s < 0.0f)   s = 0.0f;
+    if (s > 255.0f) s = 255.0f;
+    return (uint8_t)lrintf(s);
+}
+
+/* Bir blok: gürültü + bant içindeki taşıyıcılar (fazlar bloklar arası sürer) */
+static void make_block(uint8_t *blk, uint32_t center, uint32_t sr,
+                       const double *car, double *ph) {
+    double w[SIM_N_CAR];
+    for (int c = 0; c < SIM_N_CAR; c++) {
+        double off = car[c] - center;
+        w[c] = fabs(off) < sr / 2.0 ? 2.0 * M_PI * off / sr : 0.0;
+    }
+    for (int n = 0; n < FFT_SIZE; n++) {
+        float i = SIM_NOISE * nrand(), q = SIM_NOISE * nrand();
+        for (int c = 0; c < SIM_N_CAR; c++) {
+            if (w[c] == 0.0) continue;
+            i += CAR_AMP * (float)cos(ph[c]);
+            q += CAR_AMP * (float)sin(ph[c]);
+            ph[c] += w[c];
+        }
+        blk[2 * n]     = to_u8(i);
+        blk[2 * n + 1] = to_u8(q);
+    }
+    for (int c = 0; c < SIM_N_CAR; c++) ph[c] = fmod(ph[c], 2.0 * M_PI);
+}
+
+static int cmp_float(const void *a, const void *b) {
+    float x = *(const float *)a, y = *(const float *)b;
+    return (x > y) - (x < y);
+}
+
+int main(int argc, char *argv[]) {
+    double   f0 = argc > 1 ? atof(argv[1]) : 24.0;
+    double   f1 = argc > 2 ? atof(argv[2]) : 1700.0;
+    uint32_t sr = (uint32_t)((argc > 3 ? atof(argv[3]) : 2.4) * 1e6);
+    int      n_sweeps = argc > 4 ? atoi(argv[4]) : 1;
+    if (n_sweeps < 1) n_sweeps = 1;
+
+    fft_init();
+
+    FakeTuner tn;
+    memset(&tn, 0, sizeof(tn));
+    tn.settle_blocks = (int)ceil(SIM_SETTLE_MS * 1e-3 * sr / FFT_SIZE);
+
+    Sweep *w = malloc(sizeof(Sweep));
+    if (!w) return 1;
+    sweep_init(w, fake_tune, &tn);
+    w->settle_blocks = SIM_INFLIGHT + tn.settle_blocks;
+    if (sweep_start(w, (uint32_t)(f0 * 1e6), (uint32_t)(f1 * 1e6), sr) != 0) {
+        fprintf(stderr, "Gecersiz aralik\n");
+        return 1;
+    }
+
+    /* Taşıyıcılar: aralığın %25 / %50 / %75'i, bin ortasına denk gelmesin */
+    double car[SIM_N_CAR], ph[SIM_N_CAR] = {0};
+    for (int c = 0; c < SIM_N_CAR; c++) {
+        car[c] = w->f_start + (w->f_stop - (double)w->f_start) * (c + 1) / (SIM_N_CAR + 1)
+               + 777.0;
+        for (int h = 0; h < w->n_hops; h++)
+            if (fabs(car[c] - w->hops[h]) < 2.0 * sr / FFT_SIZE)
+                car[c] += 4.0 * sr / FFT_SIZE;   /* DC çentiğinden çık */
+    }
+
+    uint8_t      blk[FFT_SIZE * 2];
+    float        row[FFT_SIZE], mean[FFT_SIZE];
+    SdrBlockMeta m;
+    memset(&m, 0, sizeof(m));
+    m.sr = sr;
+    uint64_t sample = 0, blocks = 0;
+    int      got = 0, rc = 0;
+    uint64_t t0 = wall_ms();
+
+    while (got < n_sweeps) {
+        /* Havadaki aktarımlar bitene dek eski frekans ve kuşak */
+        if (tn.inflight > 0) {
+            tn.inflight--;
+        } else {
+            tn.blk_freq = tn.freq;
+            m.gen       = tn.gen;
+        }
+        m.settling = tn.inflight > 0 || tn.settle > 0;
+        if (!tn.inflight && tn.settle > 0) tn.settle--;
+        m.freq   = tn.blk_freq;
+        m.sample = sample;
+        make_block(blk, tn.blk_freq, sr, car, ph);
+        sweep_feed(w, blk, &m);
+        sample += FFT_SIZE;
+        blocks++;
+        if (sweep_pop_row(w, row, mean, FFT_SIZE)) got++;
+    }
+    double wall = (wall_ms() - t0) / 1000.0 + 1e-3;
+    double rt   = (double)sample / sr / wall;
+
+    printf("Aralik %.3f - %.3f MHz, %.3f MS/s, %d adim, dwell %d blok\n",
+           w->f_start / 1e6, w->f_stop / 1e6, sr / 1e6, w->n_hops, w->dwell_blocks);
+    printf("Tarama: %.2f s (ornek zamani), %.1f MHz/s, %u yeniden ayar, "
+           "oturma kaybi %u blok (%.1f%%)\n",
+           w->sweep_s, w->rate_mhz_s, tn.retunes / (uint32_t)n_sweeps,
+           w->settle_skipped,
+           100.0 * w->settle_skipped * FFT_SIZE / (w->sweep_s * sr + 1e-9));
+    printf("Isleme: %llu blok %.2f s'de, gercek zamanin %.1f kati\n",
+           (unsigned long long)blocks, wall, rt);
+    if (rt < 1.0) rc = 1;
+
+    /* Taban: ortalama satırın medyanı */
+    float srt[FFT_SIZE];
+    memcpy(srt, mean, sizeof(srt));
+    qsort(srt, FFT_SIZE, sizeof(float), cmp_float);
+    float floor_db = srt[FFT_SIZE / 2];
+    printf("Panorama %d bin (%.1f kHz/bin), taban %.1f dB\n", w->n_bins,
+           (w->f_stop - (double)w->f_start) / w->n_bins / 1e3, floor_db);
+
+    for (int c = 0; c < SIM_N_CAR; c++) {
+        int col = (int)((car[c] - w->f_start) / ((double)w->f_stop - w->f_start) * FFT_SIZE);
+        float pk = -1e9f, mn = -1e9f;
+        for (int k = col - 1; k <= col + 1; k++) {
+            if (k < 0 || k >= FFT_SIZE) continue;
+            if (row[k]  > pk) pk = row[k];
+            if (mean[k] > mn) mn = mean[k];
+        }
+        int ok = pk - floor_db >= CAR_MIN_DB;
+        printf("  tasiyici %10.4f MHz  en buyuk +%5.1f dB  ortalama +%5.1f dB  %s\n",
+               car[c] / 1e6, pk - floor_db, mn - floor_db, ok ? "tamam" : "KAYIP");
+        if (!ok) rc = 1;
+    }
+
+    sweep_stop(w);
+    sweep_free(w);
+    free(w);
+    return rc;
+}